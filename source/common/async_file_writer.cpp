@@ -0,0 +1,235 @@
+#include "async_file_writer.h"
+
+#include "exception.h"
+#include "file_util.h"
+#include "logger.h"
+#include "profiler.h"
+
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pagoda
+{
+FileWriteGroup::FileWriteGroup() : m_pendingWrites(0) {}
+
+void FileWriteGroup::Flush()
+{
+	START_PROFILE;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this]() { return m_pendingWrites == 0; });
+	if (!m_errors.empty())
+	{
+		auto message = m_errors.front();
+		m_errors.clear();
+		throw Exception(message);
+	}
+}
+
+void FileWriteGroup::AddWrite()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	++m_pendingWrites;
+}
+
+void FileWriteGroup::FinishWrite(const std::string &error)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		--m_pendingWrites;
+		if (!error.empty())
+		{
+			m_errors.push_back(error);
+		}
+	}
+	m_idle.notify_all();
+}
+
+class AsyncFileWriter::Impl
+{
+public:
+	Impl(uint32_t workerCount, std::size_t maxPendingWrites)
+	    : m_maxPendingWrites(std::max<std::size_t>(1, maxPendingWrites)), m_inFlight(0), m_writtenFiles(0), m_stop(false)
+	{
+		for (auto i = 0u; i < std::max(1u, workerCount); ++i)
+		{
+			m_workers.emplace_back([this]() { WorkerLoop(); });
+		}
+	}
+
+	~Impl()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_idle.wait(lock, [this]() { return m_pending.empty() && m_inFlight == 0; });
+			m_stop = true;
+		}
+		m_workAvailable.notify_all();
+		for (auto &w : m_workers)
+		{
+			w.join();
+		}
+	}
+
+	void Write(const std::string &filePath, std::string &&contents, FileWriteGroupPtr group)
+	{
+		START_PROFILE;
+		if (group != nullptr)
+		{
+			group->AddWrite();
+		}
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_spaceAvailable.wait(lock, [this]() { return m_pending.size() < m_maxPendingWrites; });
+		m_pending.push_back(PendingWrite{filePath, std::move(contents), std::move(group)});
+		lock.unlock();
+		m_workAvailable.notify_one();
+	}
+
+	void Flush()
+	{
+		START_PROFILE;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_idle.wait(lock, [this]() { return m_pending.empty() && m_inFlight == 0; });
+		if (!m_errors.empty())
+		{
+			auto message = m_errors.front();
+			m_errors.clear();
+			throw Exception(message);
+		}
+	}
+
+	std::size_t GetWrittenFileCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_writtenFiles;
+	}
+
+private:
+	struct PendingWrite
+	{
+		std::string m_path;
+		std::string m_contents;
+		FileWriteGroupPtr m_group;
+	};
+
+	void WorkerLoop()
+	{
+		while (true)
+		{
+			PendingWrite write;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_workAvailable.wait(lock, [this]() { return m_stop || !m_pending.empty(); });
+				if (m_pending.empty())
+				{
+					return;
+				}
+				write = std::move(m_pending.front());
+				m_pending.pop_front();
+				++m_inFlight;
+			}
+			m_spaceAvailable.notify_one();
+
+			std::string error;
+			try
+			{
+				WriteFile(write);
+			}
+			catch (const Exception &e)
+			{
+				error = e.What();
+			}
+			catch (...)
+			{
+				error = "Unable to write file '" + write.m_path + "'.";
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				--m_inFlight;
+				if (error.empty())
+				{
+					++m_writtenFiles;
+				}
+				else
+				{
+					LOG_ERROR(error);
+					if (write.m_group == nullptr)
+					{
+						m_errors.push_back(error);
+					}
+				}
+			}
+			if (write.m_group != nullptr)
+			{
+				write.m_group->FinishWrite(error);
+			}
+			m_idle.notify_all();
+		}
+	}
+
+	void WriteFile(const PendingWrite &write)
+	{
+		START_PROFILE;
+		// Plain stdio is considerably faster than an ofstream for big files
+		std::FILE *file = std::fopen(write.m_path.c_str(), "wb");
+		if (file == nullptr)
+		{
+			// Only touch the file system to create the directory when it is missing
+			file_util::CreateDirectories(boost::filesystem::path(write.m_path).parent_path());
+			file = std::fopen(write.m_path.c_str(), "wb");
+		}
+		if (file == nullptr)
+		{
+			throw Exception("Unable to open file '" + write.m_path + "' for writing.");
+		}
+		const auto written = std::fwrite(write.m_contents.data(), 1, write.m_contents.size(), file);
+		const auto closed = std::fclose(file);
+		if (written != write.m_contents.size() || closed != 0)
+		{
+			throw Exception("Unable to write file '" + write.m_path + "'.");
+		}
+	}
+
+	const std::size_t m_maxPendingWrites;
+	std::deque<PendingWrite> m_pending;
+	std::size_t m_inFlight;
+	std::size_t m_writtenFiles;
+	std::vector<std::string> m_errors;
+	bool m_stop;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_spaceAvailable;
+	std::condition_variable m_idle;
+	std::vector<std::thread> m_workers;
+};  // class AsyncFileWriter::Impl
+
+AsyncFileWriter::AsyncFileWriter(uint32_t workerCount, std::size_t maxPendingWrites)
+    : m_implementation(std::make_unique<Impl>(workerCount, maxPendingWrites))
+{
+}
+
+AsyncFileWriter::~AsyncFileWriter() {}
+
+void AsyncFileWriter::Write(const std::string &filePath, std::string &&contents, FileWriteGroupPtr group)
+{
+	m_implementation->Write(filePath, std::move(contents), std::move(group));
+}
+
+void AsyncFileWriter::Flush() { m_implementation->Flush(); }
+
+std::size_t AsyncFileWriter::GetWrittenFileCount() const { return m_implementation->GetWrittenFileCount(); }
+
+AsyncFileWriter &AsyncFileWriter::Instance()
+{
+	static AsyncFileWriter s_instance;
+	return s_instance;
+}
+}  // namespace pagoda
@@ -0,0 +1,91 @@
+#ifndef PAGODA_COMMON_ASYNC_FILE_WRITER_H_
+#define PAGODA_COMMON_ASYNC_FILE_WRITER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pagoda
+{
+/**
+ * Tracks the writes scheduled in an \c AsyncFileWriter by one of its clients, such as a graph execution,
+ * so that they can be flushed without waiting for the writes of other clients or being reported their errors.
+ */
+class FileWriteGroup
+{
+public:
+	FileWriteGroup();
+
+	/**
+	 * Waits until all the writes scheduled in this group are on disk.
+	 * Throws an \c Exception if any of them failed. Each error is only reported once.
+	 */
+	void Flush();
+
+private:
+	friend class AsyncFileWriter;
+
+	void AddWrite();
+	void FinishWrite(const std::string &error);
+
+	std::size_t m_pendingWrites;
+	std::vector<std::string> m_errors;
+	std::mutex m_mutex;
+	std::condition_variable m_idle;
+};  // class FileWriteGroup
+using FileWriteGroupPtr = std::shared_ptr<FileWriteGroup>;
+
+/**
+ * Writes files in a pool of background threads.
+ *
+ * \c Write() hands the contents of a file over to the pool and returns immediately, unless
+ * there are already too many pending writes, in which case it waits for one to finish.
+ * This bounds the memory held by the pending file contents.
+ *
+ * Missing directories are created when a file is written.
+ */
+class AsyncFileWriter
+{
+public:
+	/**
+	 * Creates an \c AsyncFileWriter with \p workerCount threads that holds up to
+	 * \p maxPendingWrites files waiting to be written.
+	 */
+	AsyncFileWriter(uint32_t workerCount = 2, std::size_t maxPendingWrites = 64);
+	/**
+	 * Waits for all pending writes to finish.
+	 */
+	~AsyncFileWriter();
+
+	/**
+	 * Schedules \p contents to be written to the file in \p filePath.
+	 * If \p group isn't nullptr, the write is flushed and its errors reported by \p group instead of by Flush().
+	 */
+	void Write(const std::string &filePath, std::string &&contents, FileWriteGroupPtr group = nullptr);
+
+	/**
+	 * Waits until all scheduled writes are on disk.
+	 * Throws an \c Exception if any of the writes without a \c FileWriteGroup failed.
+	 */
+	void Flush();
+
+	/**
+	 * Returns the number of files written since this \c AsyncFileWriter was created.
+	 */
+	std::size_t GetWrittenFileCount() const;
+
+	/**
+	 * Returns the \c AsyncFileWriter shared by the whole process.
+	 */
+	static AsyncFileWriter &Instance();
+
+private:
+	class Impl;
+	std::unique_ptr<Impl> m_implementation;
+};  // class AsyncFileWriter
+}  // namespace pagoda
+
+#endif
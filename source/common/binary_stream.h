@@ -0,0 +1,97 @@
+#ifndef PAGODA_COMMON_BINARY_STREAM_H_
+#define PAGODA_COMMON_BINARY_STREAM_H_
+
+#include "exception.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace pagoda
+{
+/**
+ * Appends values to a byte buffer in the native byte order.
+ *
+ * Strings are written as their uint32_t size followed by their characters.
+ */
+class BinaryWriter
+{
+public:
+	explicit BinaryWriter(std::string &buffer) : m_buffer(buffer) {}
+
+	template<typename T>
+	void Write(const T &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written");
+		m_buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	void WriteString(const std::string &str)
+	{
+		Write(static_cast<uint32_t>(str.size()));
+		m_buffer.append(str);
+	}
+
+	/**
+	 * Overwrites the value at \p offset, previously written with \c Write.
+	 */
+	template<typename T>
+	void Overwrite(std::size_t offset, const T &value)
+	{
+		std::memcpy(&m_buffer[offset], &value, sizeof(T));
+	}
+
+	std::size_t GetSize() const { return m_buffer.size(); }
+
+private:
+	std::string &m_buffer;
+};  // class BinaryWriter
+
+/**
+ * Reads the values written by a \c BinaryWriter from a byte buffer.
+ *
+ * Throws an \c Exception when reading past the end of the buffer.
+ */
+class BinaryReader
+{
+public:
+	BinaryReader(const char *data, std::size_t size) : m_current(data), m_end(data + size) {}
+
+	template<typename T>
+	T Read()
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read");
+		CheckAvailable(sizeof(T));
+		T value;
+		std::memcpy(&value, m_current, sizeof(T));
+		m_current += sizeof(T);
+		return value;
+	}
+
+	std::string ReadString()
+	{
+		const auto size = Read<uint32_t>();
+		CheckAvailable(size);
+		std::string str(m_current, size);
+		m_current += size;
+		return str;
+	}
+
+	bool AtEnd() const { return m_current == m_end; }
+
+private:
+	void CheckAvailable(std::size_t size) const
+	{
+		if (static_cast<std::size_t>(m_end - m_current) < size)
+		{
+			throw Exception("Unexpected end of binary data");
+		}
+	}
+
+	const char *m_current;
+	const char *m_end;
+};  // class BinaryReader
+}  // namespace pagoda
+
+#endif
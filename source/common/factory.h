@@ -26,7 +26,7 @@ public:
 	{
 		LOG_TRACE(Common, "Factory " << m_name << " creating object of type " << name)
 
-		auto methods = factoryMethods();
+		const auto& methods = factoryMethods();
 		auto iter = methods.find(name);
 		if (iter == std::end(methods))
 		{
@@ -39,7 +39,7 @@ public:
 	std::vector<std::string> RegisteredTypes()
 	{
 		std::vector<std::string> typeNames;
-		auto methods = factoryMethods();
+		const auto& methods = factoryMethods();
 		typeNames.reserve(methods.size());
 
 		for (auto k : methods)
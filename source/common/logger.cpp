@@ -3,6 +3,7 @@
 #include <stdarg.h>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 namespace pagoda
 {
@@ -14,6 +15,12 @@ std::unique_ptr<Logger> Logger::sError = nullptr;
 std::unique_ptr<Logger> Logger::sFatal = nullptr;
 std::list<typename Logger::LogFile> Logger::sLogFiles;
 
+namespace
+{
+/// Serializes the creation of the loggers and the writing of messages from multiple threads.
+std::mutex sLoggerMutex;
+}  // namespace
+
 const bool Logger::trace_enabled[static_cast<uint32_t>(Logger::TraceLogs::Max)] = {
     false,  // Core,
     false,  // Common,
@@ -28,6 +35,7 @@ const bool Logger::trace_enabled[static_cast<uint32_t>(Logger::TraceLogs::Max)]
 
 Logger *Logger::trace()
 {
+	std::lock_guard<std::mutex> lock(sLoggerMutex);
 	if (sTrace == nullptr)
 	{
 		sTrace = std::make_unique<Logger>("debug.log");
@@ -37,6 +45,7 @@ Logger *Logger::trace()
 
 Logger *Logger::debug()
 {
+	std::lock_guard<std::mutex> lock(sLoggerMutex);
 	if (sDebug == nullptr)
 	{
 		sDebug = std::make_unique<Logger>("debug.log", ConsoleOutput::StdErr);
@@ -46,6 +55,7 @@ Logger *Logger::debug()
 
 Logger *Logger::info()
 {
+	std::lock_guard<std::mutex> lock(sLoggerMutex);
 	if (sInfo == nullptr)
 	{
 		sInfo = std::make_unique<Logger>("pagoda.log");
@@ -55,6 +65,7 @@ Logger *Logger::info()
 
 Logger *Logger::warning()
 {
+	std::lock_guard<std::mutex> lock(sLoggerMutex);
 	if (sWarning == nullptr)
 	{
 		sWarning = std::make_unique<Logger>("pagoda.log", ConsoleOutput::StdOut);
@@ -64,6 +75,7 @@ Logger *Logger::warning()
 
 Logger *Logger::error()
 {
+	std::lock_guard<std::mutex> lock(sLoggerMutex);
 	if (sError == nullptr)
 	{
 		sError = std::make_unique<Logger>("pagoda.log", ConsoleOutput::StdErr);
@@ -73,6 +85,7 @@ Logger *Logger::error()
 
 Logger *Logger::fatal()
 {
+	std::lock_guard<std::mutex> lock(sLoggerMutex);
 	if (sFatal == nullptr)
 	{
 		sFatal = std::make_unique<Logger>("pagoda.log", ConsoleOutput::StdErr);
@@ -140,6 +153,7 @@ void Logger::Log(const std::string &message)
 
 void Logger::Write(const char *message)
 {
+	std::lock_guard<std::mutex> lock(sLoggerMutex);
 	if (m_file)
 	{
 		std::fprintf(m_file, "%s\n", message);
@@ -205,6 +219,7 @@ void Logger::ReleaseFile(std::FILE *file)
 
 void Logger::Shutdown()
 {
+	std::lock_guard<std::mutex> lock(sLoggerMutex);
 	sTrace = nullptr;
 	sDebug = nullptr;
 	sInfo = nullptr;
@@ -0,0 +1,41 @@
+#include "mapped_file.h"
+
+#include "exception.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace pagoda
+{
+class MappedFile::Impl
+{
+public:
+	explicit Impl(const std::string &filePath)
+	{
+		try
+		{
+			m_mapping = boost::interprocess::file_mapping(filePath.c_str(), boost::interprocess::read_only);
+			m_region = boost::interprocess::mapped_region(m_mapping, boost::interprocess::read_only);
+		}
+		catch (const boost::interprocess::interprocess_exception &e)
+		{
+			throw Exception("Unable to map file '" + filePath + "': " + e.what());
+		}
+	}
+
+	const char *GetData() const { return static_cast<const char *>(m_region.get_address()); }
+	std::size_t GetSize() const { return m_region.get_size(); }
+
+private:
+	boost::interprocess::file_mapping m_mapping;
+	boost::interprocess::mapped_region m_region;
+};  // class MappedFile::Impl
+
+MappedFile::MappedFile(const std::string &filePath) : m_implementation(std::make_unique<Impl>(filePath)) {}
+
+MappedFile::~MappedFile() {}
+
+const char *MappedFile::GetData() const { return m_implementation->GetData(); }
+
+std::size_t MappedFile::GetSize() const { return m_implementation->GetSize(); }
+}  // namespace pagoda
@@ -0,0 +1,34 @@
+#ifndef PAGODA_COMMON_MAPPED_FILE_H_
+#define PAGODA_COMMON_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace pagoda
+{
+/**
+ * Maps a file into memory for reading.
+ *
+ * The contents are available through \c GetData() until the \c MappedFile is destroyed,
+ * without being copied into a buffer.
+ */
+class MappedFile
+{
+public:
+	/**
+	 * Maps the file in \p filePath. Throws an \c Exception if it can't be mapped.
+	 */
+	explicit MappedFile(const std::string &filePath);
+	~MappedFile();
+
+	const char *GetData() const;
+	std::size_t GetSize() const;
+
+private:
+	class Impl;
+	std::unique_ptr<Impl> m_implementation;
+};  // class MappedFile
+}  // namespace pagoda
+
+#endif
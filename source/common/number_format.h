@@ -0,0 +1,34 @@
+#ifndef PAGODA_COMMON_NUMBER_FORMAT_H_
+#define PAGODA_COMMON_NUMBER_FORMAT_H_
+
+#include <charconv>
+#include <string>
+#include <type_traits>
+
+namespace pagoda
+{
+/**
+ * Appends the text representation of \p value to \p out.
+ *
+ * Floating point values are written with 6 significant digits in the shortest of the fixed or
+ * scientific notations, exactly as the default formatting of an \c std::ostream, but without
+ * going through the stream and its locale.
+ */
+template<typename T>
+void AppendNumber(std::string &out, const T &value)
+{
+	char buffer[32];
+	std::to_chars_result result;
+	if constexpr (std::is_floating_point_v<T>)
+	{
+		result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, 6);
+	}
+	else
+	{
+		result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+	}
+	out.append(buffer, result.ptr);
+}
+}  // namespace pagoda
+
+#endif
@@ -0,0 +1,147 @@
+#include "sha256.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace pagoda
+{
+namespace
+{
+constexpr std::array<uint32_t, 64> s_roundConstants = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+inline uint32_t RotateRight(uint32_t x, uint32_t n) { return (x >> n) | (x << (32 - n)); }
+}  // namespace
+
+Sha256::Sha256()
+    : m_state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+      m_blockSize(0),
+      m_length(0)
+{
+}
+
+void Sha256::Update(const void *data, std::size_t size)
+{
+	const auto *bytes = static_cast<const uint8_t *>(data);
+	m_length += size;
+	if (m_blockSize > 0)
+	{
+		const auto count = std::min(size, m_block.size() - m_blockSize);
+		std::memcpy(&m_block[m_blockSize], bytes, count);
+		m_blockSize += count;
+		bytes += count;
+		size -= count;
+		if (m_blockSize < m_block.size())
+		{
+			return;
+		}
+		ProcessBlock(m_block.data());
+		m_blockSize = 0;
+	}
+	// Whole blocks are processed in place
+	for (; size >= m_block.size(); bytes += m_block.size(), size -= m_block.size())
+	{
+		ProcessBlock(bytes);
+	}
+	std::memcpy(m_block.data(), bytes, size);
+	m_blockSize = size;
+}
+
+auto Sha256::Finish() -> Digest_t
+{
+	const uint64_t bitLength = m_length * 8;
+	const uint8_t one = 0x80;
+	Update(&one, 1);
+	const uint8_t zero = 0;
+	while (m_blockSize != m_block.size() - sizeof(bitLength))
+	{
+		Update(&zero, 1);
+	}
+	for (auto i = 0u; i < sizeof(bitLength); ++i)
+	{
+		const auto byte = static_cast<uint8_t>(bitLength >> (56 - 8 * i));
+		Update(&byte, 1);
+	}
+
+	Digest_t digest;
+	for (auto i = 0u; i < m_state.size(); ++i)
+	{
+		for (auto b = 0u; b < 4; ++b)
+		{
+			digest[4 * i + b] = static_cast<uint8_t>(m_state[i] >> (24 - 8 * b));
+		}
+	}
+	return digest;
+}
+
+std::string Sha256::ToHex(const Digest_t &digest)
+{
+	static const char *s_digits = "0123456789abcdef";
+	std::string hex;
+	hex.reserve(2 * digest.size());
+	for (const auto byte : digest)
+	{
+		hex.push_back(s_digits[byte >> 4]);
+		hex.push_back(s_digits[byte & 0xf]);
+	}
+	return hex;
+}
+
+void Sha256::ProcessBlock(const uint8_t *block)
+{
+	std::array<uint32_t, 64> w;
+	for (auto i = 0u; i < 16; ++i)
+	{
+		w[i] = (uint32_t(block[4 * i]) << 24) | (uint32_t(block[4 * i + 1]) << 16) |
+		       (uint32_t(block[4 * i + 2]) << 8) | uint32_t(block[4 * i + 3]);
+	}
+	for (auto i = 16u; i < 64; ++i)
+	{
+		const auto s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+		const auto s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+		w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+	}
+
+	auto a = m_state[0];
+	auto b = m_state[1];
+	auto c = m_state[2];
+	auto d = m_state[3];
+	auto e = m_state[4];
+	auto f = m_state[5];
+	auto g = m_state[6];
+	auto h = m_state[7];
+	for (auto i = 0u; i < 64; ++i)
+	{
+		const auto s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+		const auto choice = (e & f) ^ (~e & g);
+		const auto t1 = h + s1 + choice + s_roundConstants[i] + w[i];
+		const auto s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+		const auto majority = (a & b) ^ (a & c) ^ (b & c);
+		const auto t2 = s0 + majority;
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	m_state[0] += a;
+	m_state[1] += b;
+	m_state[2] += c;
+	m_state[3] += d;
+	m_state[4] += e;
+	m_state[5] += f;
+	m_state[6] += g;
+	m_state[7] += h;
+}
+}  // namespace pagoda
@@ -0,0 +1,55 @@
+#ifndef PAGODA_COMMON_SHA256_H_
+#define PAGODA_COMMON_SHA256_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace pagoda
+{
+/**
+ * Computes the SHA-256 digest of data given in any number of pieces, so that it doesn't have
+ * to be gathered in a buffer first.
+ */
+class Sha256
+{
+public:
+	using Digest_t = std::array<uint8_t, 32>;
+
+	Sha256();
+
+	/**
+	 * Adds \p size bytes in \p data to the digested data.
+	 */
+	void Update(const void *data, std::size_t size);
+
+	template<typename T>
+	void UpdateValue(const T &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be digested");
+		Update(&value, sizeof(T));
+	}
+
+	/**
+	 * Returns the digest of all the data added so far. No more data can be added afterwards.
+	 */
+	Digest_t Finish();
+
+	/**
+	 * Returns \p digest as a string of lower case hexadecimal digits.
+	 */
+	static std::string ToHex(const Digest_t &digest);
+
+private:
+	void ProcessBlock(const uint8_t *block);
+
+	std::array<uint32_t, 8> m_state;
+	std::array<uint8_t, 64> m_block;
+	std::size_t m_blockSize;
+	uint64_t m_length;
+};  // class Sha256
+}  // namespace pagoda
+
+#endif
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "binary_ops.h"
+#include "unary_ops.h"
+
+#include "../get_value_as.h"
+#include "../tagged_value.h"
+
+#include "common/exception.h"
+
+namespace pagoda
+{
+/**
+ * Native implementation of the binary operations for the scalars held inline by a \c TaggedValue.
+ *
+ * \c s_booleans is true if the operation is also defined between two booleans.
+ */
+template<class OP>
+struct native_binary_op;
+
+// clang-format off
+template<> struct native_binary_op<add> { static constexpr bool s_booleans = false; template<typename T> static T apply(T l, T r) { return l + r; } };
+template<> struct native_binary_op<sub> { static constexpr bool s_booleans = false; template<typename T> static T apply(T l, T r) { return l - r; } };
+template<> struct native_binary_op<mul> { static constexpr bool s_booleans = false; template<typename T> static T apply(T l, T r) { return l * r; } };
+template<> struct native_binary_op<eq> { static constexpr bool s_booleans = true; template<typename T> static bool apply(T l, T r) { return l == r; } };
+template<> struct native_binary_op<neq> { static constexpr bool s_booleans = true; template<typename T> static bool apply(T l, T r) { return l != r; } };
+template<> struct native_binary_op<gt> { static constexpr bool s_booleans = false; template<typename T> static bool apply(T l, T r) { return l > r; } };
+template<> struct native_binary_op<gte> { static constexpr bool s_booleans = false; template<typename T> static bool apply(T l, T r) { return l >= r; } };
+template<> struct native_binary_op<lt> { static constexpr bool s_booleans = false; template<typename T> static bool apply(T l, T r) { return l < r; } };
+template<> struct native_binary_op<lte> { static constexpr bool s_booleans = false; template<typename T> static bool apply(T l, T r) { return l <= r; } };
+// clang-format on
+
+template<>
+struct native_binary_op<div>
+{
+	static constexpr bool s_booleans = false;
+	template<typename T>
+	static T apply(T l, T r)
+	{
+		if constexpr (std::is_same<T, int>::value)
+		{
+			if (r == 0)
+			{
+				throw Exception("Integer division by zero");
+			}
+		}
+		return l / r;
+	}
+};
+
+namespace detail
+{
+inline TaggedValue make_tagged(bool b) { return TaggedValue::FromBoolean(b); }
+inline TaggedValue make_tagged(int i) { return TaggedValue::FromInteger(i); }
+inline TaggedValue make_tagged(float f) { return TaggedValue::FromFloat(f); }
+}  // namespace detail
+
+/**
+ * Applies the binary operation \c OP to \p lhs and \p rhs.
+ *
+ * Operations between integers, floats and booleans are done natively. Mixing integers and floats
+ * promotes to float, as the \c Integer and \c FloatValue operators do. Every other combination
+ * is boxed and dispatched with the \c binary_op_dispatcher.
+ */
+template<class OP>
+TaggedValue apply_binary_op(const TaggedValue &lhs, const TaggedValue &rhs)
+{
+	using Type = TaggedValue::Type;
+	if (lhs.IsScalar() && rhs.IsScalar())
+	{
+		if (lhs.m_type == Type::Integer && rhs.m_type == Type::Integer)
+		{
+			return detail::make_tagged(native_binary_op<OP>::apply(lhs.m_integer, rhs.m_integer));
+		}
+		return detail::make_tagged(native_binary_op<OP>::apply(lhs.AsFloat(), rhs.AsFloat()));
+	}
+
+	if constexpr (native_binary_op<OP>::s_booleans)
+	{
+		if (lhs.m_type == Type::Boolean && rhs.m_type == Type::Boolean)
+		{
+			return detail::make_tagged(native_binary_op<OP>::apply(lhs.m_boolean, rhs.m_boolean));
+		}
+	}
+
+	auto boxedLhs = lhs.ToDynamicValue();
+	auto boxedRhs = rhs.ToDynamicValue();
+	binary_op_dispatcher<OP> v(boxedLhs, boxedRhs);
+	return TaggedValue::FromDynamicValue(apply_visitor(v, *boxedLhs));
+}
+
+/**
+ * Applies the unary operation \c OP to \p value.
+ *
+ * The minus of integers and floats and the negation of booleans are done natively. Every other
+ * value is boxed and dispatched with the \c unary_ops_dispatcher.
+ */
+template<class OP>
+TaggedValue apply_unary_op(const TaggedValue &value)
+{
+	using Type = TaggedValue::Type;
+	if constexpr (std::is_same<OP, minus>::value)
+	{
+		if (value.m_type == Type::Integer)
+		{
+			return TaggedValue::FromInteger(-value.m_integer);
+		}
+		if (value.m_type == Type::Float)
+		{
+			return TaggedValue::FromFloat(-value.m_float);
+		}
+	}
+	if constexpr (std::is_same<OP, negate>::value)
+	{
+		if (value.m_type == Type::Boolean)
+		{
+			return TaggedValue::FromBoolean(!value.m_boolean);
+		}
+	}
+
+	auto boxed = value.ToDynamicValue();
+	unary_ops_dispatcher<OP> v;
+	return TaggedValue::FromDynamicValue(apply_visitor(v, *boxed));
+}
+
+/**
+ * Returns \p value as a boolean, as in the conditions of if statements and loops.
+ */
+inline bool is_true(const TaggedValue &value)
+{
+	if (value.m_type == TaggedValue::Type::Boolean)
+	{
+		return value.m_boolean;
+	}
+	auto boxed = value.ToDynamicValue();
+	if (boxed == nullptr)
+	{
+		throw Exception("Unable to use an undefined value as a boolean");
+	}
+	return get_value_as<bool>(*boxed);
+}
+}  // namespace pagoda
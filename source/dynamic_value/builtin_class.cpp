@@ -12,6 +12,11 @@ BuiltinClass::BuiltinClass(const TypeInfoPtr& typeInfo) : DynamicValueBase(typeI
 {
 }
 
+BuiltinClass::BuiltinClass(const TypeInfoPtr& typeInfo, std::shared_ptr<DynamicValueTable> memberTable)
+    : DynamicValueBase(typeInfo), ClassBase(std::move(memberTable))
+{
+}
+
 FunctionPtr BuiltinClass::Bind(std::shared_ptr<ICallableBody> callable, std::shared_ptr<DynamicValueTable> globals)
 {
 	auto boundMethod = std::make_shared<Function>(callable);
@@ -12,6 +12,10 @@ class BuiltinClass : public DynamicValueBase, public ClassBase
 {
 public:
 	BuiltinClass(const TypeInfoPtr &typeInfo);
+	/**
+	 * Creates a \c BuiltinClass whose members are stored in \p memberTable.
+	 */
+	BuiltinClass(const TypeInfoPtr &typeInfo, std::shared_ptr<DynamicValueTable> memberTable);
 
 	FunctionPtr Bind(std::shared_ptr<ICallableBody> callable, std::shared_ptr<DynamicValueTable> globals = nullptr);
 };
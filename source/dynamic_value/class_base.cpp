@@ -5,6 +5,7 @@
 namespace pagoda
 {
 ClassBase::ClassBase(const std::string &name) : m_memberTable(std::make_shared<DynamicValueTable>(name)) {}
+ClassBase::ClassBase(std::shared_ptr<DynamicValueTable> memberTable) : m_memberTable(std::move(memberTable)) {}
 
 void ClassBase::RegisterMember(const std::string &name, DynamicValueBasePtr v) { m_memberTable->Declare(name, v); }
 
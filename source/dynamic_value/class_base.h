@@ -19,6 +19,10 @@ class ClassBase
 {
 public:
 	ClassBase(const std::string &name);
+	/**
+	 * Creates a \c ClassBase whose members are stored in \p memberTable.
+	 */
+	explicit ClassBase(std::shared_ptr<DynamicValueTable> memberTable);
 
 	void RegisterMember(const std::string &name, DynamicValueBasePtr v);
 	void SetMember(const std::string &name, DynamicValueBasePtr v);
@@ -3,27 +3,59 @@
 #include "dynamic_value_base.h"
 #include "value_not_found.h"
 
+#include "common/exception.h"
+
 #include <ostream>
 
 namespace pagoda
 {
-DynamicValueTable::DynamicValueTable(const std::string &tableName) : m_tableName(tableName) {}
+DynamicValueTable::DynamicValueTable(const std::string &tableName) : m_tableName(tableName), m_readOnly(false) {}
 
 DynamicValueTable::DynamicValueTable(const std::string &tableName,
                                      const std::shared_ptr<DynamicValueTable> &parentTable)
-    : m_parentTable(parentTable), m_tableName(tableName)
+    : m_parentTable(parentTable), m_tableName(tableName), m_readOnly(false)
 {
 }
 
-void DynamicValueTable::Declare(const std::string &name, DynamicValueBasePtr value) { m_values[name] = {value}; }
+void DynamicValueTable::Declare(const std::string &name, DynamicValueBasePtr value)
+{
+	CheckWritable();
+	m_values[name] = {TaggedValue::FromObject(value)};
+}
 
 void DynamicValueTable::Assign(const std::string &name, DynamicValueBasePtr value)
 {
-	auto &storedValue = FindValue(name);
+	auto &storedValue = FindValue(name, true);
+	storedValue.m_value = TaggedValue::FromObject(value);
+}
+
+DynamicValueBasePtr DynamicValueTable::Get(const std::string &name) { return FindValue(name).m_value.ToDynamicValue(); }
+
+void DynamicValueTable::DeclareValue(const std::string &name, const TaggedValue &value)
+{
+	CheckWritable();
+	m_values[name] = {value};
+}
+
+void DynamicValueTable::AssignValue(const std::string &name, const TaggedValue &value)
+{
+	auto &storedValue = FindValue(name, true);
 	storedValue.m_value = value;
 }
 
-DynamicValueBasePtr DynamicValueTable::Get(const std::string &name) { return FindValue(name).m_value; }
+TaggedValue DynamicValueTable::GetValue(const std::string &name)
+{
+	const auto &value = FindValue(name).m_value;
+	if (value.m_type == TaggedValue::Type::Object)
+	{
+		return TaggedValue::FromDynamicValue(value.m_object);
+	}
+	return value;
+}
+
+void DynamicValueTable::SetReadOnly() { m_readOnly = true; }
+
+bool DynamicValueTable::IsReadOnly() const { return m_readOnly; }
 
 std::shared_ptr<DynamicValueTable> DynamicValueTable::GetParent() const { return m_parentTable.lock(); }
 
@@ -38,7 +70,7 @@ void DynamicValueTable::DumpSymbols(std::ostream &out) const
 	out << "Symbols for " << m_tableName << ":" << std::endl;
 	for (auto value : m_values)
 	{
-		out << value.first << ": " << value.second.m_value->ToString() << std::endl;
+		out << value.first << ": " << value.second.m_value.ToDynamicValue()->ToString() << std::endl;
 	}
 
 	if (!m_parentTable.expired())
@@ -47,17 +79,29 @@ void DynamicValueTable::DumpSymbols(std::ostream &out) const
 	}
 }
 
-typename DynamicValueTable::Entry &DynamicValueTable::FindValue(const std::string &name)
+typename DynamicValueTable::Entry &DynamicValueTable::FindValue(const std::string &name, bool forWriting)
 {
 	auto iter = m_values.find(name);
 	if (iter != std::end(m_values))
 	{
+		if (forWriting)
+		{
+			CheckWritable();
+		}
 		return iter->second;
 	}
 	if (!m_parentTable.expired())
 	{
-		return m_parentTable.lock()->FindValue(name);
+		return m_parentTable.lock()->FindValue(name, forWriting);
 	}
 	throw ValueNotFoundException(name);
 }
+
+void DynamicValueTable::CheckWritable() const
+{
+	if (m_readOnly)
+	{
+		throw Exception("Unable to modify the read only table " + m_tableName);
+	}
+}
 }  // namespace pagoda
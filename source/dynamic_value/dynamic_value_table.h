@@ -1,14 +1,13 @@
 #pragma once
 
+#include "tagged_value.h"
+
 #include <memory>
 #include <string>
 #include <unordered_map>
 
 namespace pagoda
 {
-class DynamicValueBase;
-using DynamicValueBasePtr = std::shared_ptr<DynamicValueBase>;
-
 /**
  * Holds a table of \c DynamicValueBase.
  */
@@ -17,10 +16,13 @@ class DynamicValueTable
 public:
 	/**
 	 * An entry for the table.
+	 *
+	 * Values declared with a \c DynamicValueBasePtr are held by pointer. Values declared with a
+	 * \c TaggedValue may be held inline.
 	 */
 	struct Entry
 	{
-		DynamicValueBasePtr m_value;
+		TaggedValue m_value;
 	};
 
 	/**
@@ -51,6 +53,28 @@ public:
 	 */
 	DynamicValueBasePtr Get(const std::string &name);
 
+	/**
+	 * Declare a \c TaggedValue in this table with the given \p name.
+	 * Integers, floats and booleans are stored inline.
+	 */
+	void DeclareValue(const std::string &name, const TaggedValue &value);
+	/**
+	 * Assign the \c TaggedValue \p value to the \p name.
+	 */
+	void AssignValue(const std::string &name, const TaggedValue &value);
+	/**
+	 * Gets the value mapped to the \p name as a \c TaggedValue, unboxing it if it is a scalar.
+	 * Unlike Get(), doesn't allocate for values stored inline.
+	 */
+	TaggedValue GetValue(const std::string &name);
+
+	/**
+	 * Makes this table read only, so that declaring or assigning its values throws.
+	 * A read only table can be shared between threads.
+	 */
+	void SetReadOnly();
+	bool IsReadOnly() const;
+
 	/**
 	 * Returns the parent \c DynamicValueTable.
 	 */
@@ -69,12 +93,14 @@ public:
 	void DumpSymbols(std::ostream &out) const;
 
 private:
-	Entry &FindValue(const std::string &name);
+	Entry &FindValue(const std::string &name, bool forWriting = false);
+	void CheckWritable() const;
 
 	std::unordered_map<std::string, Entry> m_values;
 	std::weak_ptr<DynamicValueTable> m_parentTable;
 	std::weak_ptr<DynamicValueTable> m_globals;
 	std::string m_tableName;
+	bool m_readOnly;
 };
 
 }  // namespace pagoda
@@ -14,11 +14,16 @@
 
 #include "pgscript/intermediate/ast.h"
 #include "pgscript/intermediate/ast_visitor.h"
+#include "pgscript/interpreter/bytecode_compiler.h"
 #include "pgscript/interpreter/interpreter.h"
 #include "pgscript/parser/parser.h"
 
+#include "common/exception.h"
 #include "common/profiler.h"
 
+#include <algorithm>
+#include <mutex>
+#include <set>
 #include <unordered_map>
 
 namespace pagoda
@@ -28,9 +33,13 @@ const TypeInfoPtr Expression::s_typeInfo = std::make_shared<TypeInfo>("Expressio
 class ExpressionInterpreter : public Interpreter
 {
 public:
+	/**
+	 * Returns the \c ExpressionInterpreter of the calling thread.
+	 * Each evaluation runs in its own scope, so evaluations don't need to be serialized.
+	 */
 	static ExpressionInterpreter &GetInstance()
 	{
-		static ExpressionInterpreter sInterpreter;
+		static thread_local ExpressionInterpreter sInterpreter;
 		return sInterpreter;
 	}
 
@@ -40,10 +49,7 @@ public:
 	}
 
 private:
-	ExpressionInterpreter() : Interpreter()
-	{
-		// TODO: Add built-in functions
-	}
+	ExpressionInterpreter() : Interpreter() {}
 
 	static const DynamicClassPtr m_parameterClass;
 };
@@ -209,23 +215,33 @@ public:
 	{
 		START_PROFILE;
 
+		// Only one thread evaluates an expression at a time, the others wait for its value
+		std::lock_guard<std::mutex> lock(m_mutex);
 		if (m_lastComputedValue == nullptr)
 		{
 			auto &interpreter = ExpressionInterpreter::GetInstance();
 
+			if (m_bytecode != nullptr)
+			{
+				m_externalValues.assign(m_bytecode->m_externals.size(), nullptr);
+				for (auto &var : m_variableValues)
+				{
+					const auto &externals = m_bytecode->m_externals;
+					auto slot = std::find(externals.begin(), externals.end(), var.first.GetIdentifiers().front());
+					m_externalValues[std::distance(externals.begin(), slot)] = EvaluateIfExpression(var.second);
+				}
+				m_lastComputedValue = interpreter.Run(*m_bytecode, m_externalValues);
+				return m_lastComputedValue;
+			}
+
 			auto variables = std::make_shared<DynamicValueTable>("variables");
 			for (auto &var : m_variableValues)
 			{
 				const std::list<std::string> &variableIdentifiers = var.first.GetIdentifiers();
 				variables->Declare(variableIdentifiers.front(), EvaluateIfExpression(var.second));
 			}
-			interpreter.PushExternalSymbols(variables);
-
-			interpreter.Interpret(m_expression);
+			interpreter.Interpret(m_expression, variables);
 			m_lastComputedValue = interpreter.GetLastEvaluatedExpression();
-
-			// TODO: this would not be needed if ExpressionInterpreter wasn't a singleton
-			interpreter.PopExternalSymbols();
 		}
 
 		return m_lastComputedValue;
@@ -248,7 +264,10 @@ public:
 		dependent_expression_adder adder(m_expressionInterface);
 		apply_visitor(adder, *value);
 
-		m_variableValues[variableName] = value;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_variableValues[variableName] = value;
+		}
 		SetDirty();
 	}
 
@@ -257,29 +276,66 @@ public:
 		SetVariableValue(Variable(variableName), value);
 	}
 
-	void AddDependentExpression(ExpressionPtr e) { m_dependentExpressions.push_back(e); }
+	void AddDependentExpression(ExpressionPtr e)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_dependentExpressions.push_back(e);
+	}
 
-	const std::vector<std::weak_ptr<Expression>> GetDependentExpressions() const { return m_dependentExpressions; }
+	const std::vector<std::weak_ptr<Expression>> GetDependentExpressions() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_dependentExpressions;
+	}
 
 	void SetDirty()
 	{
-		m_lastComputedValue = nullptr;
-		for (const auto &e : m_dependentExpressions)
+		// The lock isn't held while propagating, because evaluating a dependent expression
+		// locks the dependent before this one
+		std::vector<std::weak_ptr<Expression>> dependentExpressions;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_lastComputedValue = nullptr;
+			dependentExpressions = m_dependentExpressions;
+		}
+		for (const auto &e : dependentExpressions)
 		{
 			e.lock()->SetDirty();
 		}
 	}
 
-	bool IsDirty() const { return m_lastComputedValue == nullptr; }
+	bool IsDirty() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_lastComputedValue == nullptr;
+	}
+
+	DynamicValueBasePtr GetVariableValue(const std::string &variableName) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto iter = m_variableValues.find(Variable(variableName));
+		if (iter == m_variableValues.end())
+		{
+			return nullptr;
+		}
+		return iter->second;
+	}
 
 	std::string ToString() const { return "<Expression>"; }
 
 	ast::ProgramPtr m_expression;
+	/// The compiled m_expression, or nullptr if it can only be interpreted.
+	BytecodeProgramPtr m_bytecode;
+	/// The value of each external variable of m_bytecode, reused between evaluations.
+	std::vector<DynamicValueBasePtr> m_externalValues;
+	std::string m_expressionString;
 	std::unordered_set<Variable, Variable::Hash> m_variables;
 	std::unordered_map<Variable, DynamicValueBasePtr, Variable::Hash> m_variableValues;
 	std::vector<std::weak_ptr<Expression>> m_dependentExpressions;
 	DynamicValueBasePtr m_lastComputedValue;
 	ExpressionPtr m_expressionInterface;
+	/// Guards the variables and the computed value, which are shared by the threads evaluating the expression.
+	mutable std::mutex m_mutex;
 };
 
 std::shared_ptr<Expression> Expression::CreateExpression(const std::string &expressionString)
@@ -290,14 +346,41 @@ std::shared_ptr<Expression> Expression::CreateExpression(const std::string &expr
 	Parser p;
 	expression->m_implementation = std::make_unique<Expression::Impl>(p.Parse(expressionString));
 	expression->m_implementation->m_expressionInterface = expression;
+	expression->m_implementation->m_expressionString = expressionString;
 
 	ExpressionValidator validator;
 	expression->m_implementation->m_expression->AcceptVisitor(&validator);
 
+	std::set<std::string> externals;
 	for (const auto &v : validator.m_symbols)
 	{
 		expression->m_implementation->m_variables.insert(v);
+		externals.insert(v.GetIdentifiers().front());
 	}
+	expression->m_implementation->m_bytecode = BytecodeCompiler::Compile(
+	    expression->m_implementation->m_expression, std::vector<std::string>(externals.begin(), externals.end()));
+
+	return expression;
+}
+
+std::shared_ptr<Expression> Expression::CreateCompiledExpression(const std::string &expressionString,
+                                                                 const std::vector<Variable> &variables,
+                                                                 BytecodeProgramPtr bytecode)
+{
+	START_PROFILE;
+
+	if (bytecode == nullptr)
+	{
+		throw Exception("Compiled expressions need their bytecode");
+	}
+
+	auto expression = std::make_shared<Expression>();
+	// Without an ast the expression is always run from its bytecode
+	expression->m_implementation = std::make_unique<Expression::Impl>(nullptr);
+	expression->m_implementation->m_expressionInterface = expression;
+	expression->m_implementation->m_expressionString = expressionString;
+	expression->m_implementation->m_variables.insert(variables.begin(), variables.end());
+	expression->m_implementation->m_bytecode = bytecode;
 
 	return expression;
 }
@@ -319,6 +402,15 @@ void Expression::SetVariableValue(const std::string &variableName, DynamicValueB
 	m_implementation->SetVariableValue(variableName, value);
 }
 
+DynamicValueBasePtr Expression::GetVariableValue(const std::string &variableName) const
+{
+	return m_implementation->GetVariableValue(variableName);
+}
+
+const std::string &Expression::GetExpressionString() const { return m_implementation->m_expressionString; }
+
+BytecodeProgramPtr Expression::GetBytecode() const { return m_implementation->m_bytecode; }
+
 void Expression::SetDirty() { m_implementation->SetDirty(); }
 
 bool Expression::IsDirty() const { return m_implementation->IsDirty(); }
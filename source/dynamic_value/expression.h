@@ -14,6 +14,8 @@ namespace pagoda
 {
 class TypeInfo;
 using TypeInfoPtr = std::shared_ptr<TypeInfo>;
+struct BytecodeProgram;
+using BytecodeProgramPtr = std::shared_ptr<BytecodeProgram>;
 
 /**
  * Implements expressions that can be evaluated to a parameter.
@@ -29,6 +31,14 @@ public:
 	 */
 	static std::shared_ptr<Expression> CreateExpression(const std::string& expressionString);
 
+	/**
+	 * Creates an expression from the \p bytecode previously compiled from \p expressionString,
+	 * with the given \p variables. The \p expressionString isn't parsed.
+	 */
+	static std::shared_ptr<Expression> CreateCompiledExpression(const std::string& expressionString,
+	                                                            const std::vector<Variable>& variables,
+	                                                            BytecodeProgramPtr bytecode);
+
 	Expression();
 
 	/**
@@ -48,6 +58,21 @@ public:
 	 */
 	void SetVariableValue(const std::string& variableName, DynamicValueBasePtr value);
 
+	/**
+	 * Returns the value set for the variable with \p variableName or nullptr if none was set.
+	 */
+	DynamicValueBasePtr GetVariableValue(const std::string& variableName) const;
+
+	/**
+	 * Returns the source string this \c Expression was created from.
+	 */
+	const std::string& GetExpressionString() const;
+
+	/**
+	 * Returns the compiled expression or nullptr if it can only be interpreted.
+	 */
+	BytecodeProgramPtr GetBytecode() const;
+
 	/**
 	 * Adds \p e as an \c Expression that is dependent on this \c Expression's value
 	 * to be evaluated.
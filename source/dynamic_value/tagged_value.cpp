@@ -0,0 +1,51 @@
+#include "tagged_value.h"
+
+#include "boolean_value.h"
+#include "float_value.h"
+#include "integer_value.h"
+
+#include <typeinfo>
+
+namespace pagoda
+{
+TaggedValue TaggedValue::FromDynamicValue(const DynamicValueBasePtr &value)
+{
+	if (value == nullptr)
+	{
+		return TaggedValue();
+	}
+
+	// Not every value accepts a ValueVisitorBase, so the type is checked directly
+	const auto &type = typeid(*value);
+	if (type == typeid(Integer))
+	{
+		return TaggedValue::FromInteger(static_cast<int>(static_cast<const Integer &>(*value)));
+	}
+	if (type == typeid(FloatValue))
+	{
+		return TaggedValue::FromFloat(static_cast<float>(static_cast<const FloatValue &>(*value)));
+	}
+	if (type == typeid(Boolean))
+	{
+		return TaggedValue::FromBoolean(static_cast<bool>(static_cast<const Boolean &>(*value)));
+	}
+	return TaggedValue::FromObject(value);
+}
+
+DynamicValueBasePtr TaggedValue::ToDynamicValue() const
+{
+	switch (m_type)
+	{
+		case Type::Boolean:
+			return std::make_shared<Boolean>(m_boolean);
+		case Type::Integer:
+			return std::make_shared<Integer>(m_integer);
+		case Type::Float:
+			return std::make_shared<FloatValue>(m_float);
+		case Type::Object:
+			return m_object;
+		default:
+			return nullptr;
+	}
+}
+}  // namespace pagoda
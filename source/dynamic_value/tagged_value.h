@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace pagoda
+{
+class DynamicValueBase;
+using DynamicValueBasePtr = std::shared_ptr<DynamicValueBase>;
+
+/**
+ * A small value that holds integers, floats and booleans inline.
+ *
+ * Every other value (strings, vectors, instances, functions...) is held by pointer in \c m_object.
+ * Used in the stacks of the pgscript interpreters and in the \c DynamicValueTable so that
+ * evaluating scalar expressions doesn't allocate a \c DynamicValueBase for each intermediate result.
+ */
+struct TaggedValue
+{
+	enum class Type : uint8_t
+	{
+		Null,
+		Boolean,
+		Integer,
+		Float,
+		Object
+	};
+
+	TaggedValue() : m_type(Type::Null), m_integer(0) {}
+
+	static TaggedValue FromBoolean(bool b)
+	{
+		TaggedValue v;
+		v.m_type = Type::Boolean;
+		v.m_boolean = b;
+		return v;
+	}
+
+	static TaggedValue FromInteger(int i)
+	{
+		TaggedValue v;
+		v.m_type = Type::Integer;
+		v.m_integer = i;
+		return v;
+	}
+
+	static TaggedValue FromFloat(float f)
+	{
+		TaggedValue v;
+		v.m_type = Type::Float;
+		v.m_float = f;
+		return v;
+	}
+
+	/**
+	 * Creates a \c TaggedValue that holds \p value by pointer, without unboxing it.
+	 */
+	static TaggedValue FromObject(const DynamicValueBasePtr &value)
+	{
+		TaggedValue v;
+		v.m_type = Type::Object;
+		v.m_object = value;
+		return v;
+	}
+
+	/**
+	 * Creates a \c TaggedValue from \p value, unboxing it if it is an \c Integer, \c FloatValue or \c Boolean.
+	 * A nullptr \p value results in a Null \c TaggedValue.
+	 */
+	static TaggedValue FromDynamicValue(const DynamicValueBasePtr &value);
+
+	/**
+	 * Returns this value as a \c DynamicValueBase, boxing scalars in a new object.
+	 */
+	DynamicValueBasePtr ToDynamicValue() const;
+
+	bool IsScalar() const { return m_type == Type::Integer || m_type == Type::Float; }
+	float AsFloat() const { return m_type == Type::Float ? m_float : static_cast<float>(m_integer); }
+
+	Type m_type;
+	union
+	{
+		bool m_boolean;
+		int m_integer;
+		float m_float;
+	};
+	DynamicValueBasePtr m_object;
+};
+}  // namespace pagoda
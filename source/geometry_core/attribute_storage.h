@@ -0,0 +1,233 @@
+#ifndef PAGODA_GEOMETRY_CORE_ATTRIBUTE_STORAGE_H_
+#define PAGODA_GEOMETRY_CORE_ATTRIBUTE_STORAGE_H_
+
+#include "indexed_container.h"
+
+#include <common/profiler.h>
+#include <math_lib/matrix_base.h>
+
+#include <boost/qvm/vec_access.hpp>
+#include <boost/qvm/vec_traits.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace pagoda
+{
+/**
+ * Attribute storage policy for \c GeometryBase that keeps positions and attributes in hash maps
+ * keyed by the topology index.
+ *
+ * Suited for sparse geometries where only a few of the indices have attributes.
+ */
+struct AssociativeAttributeStorage
+{
+	template<class Index_t, class PositionType, class FaceAttributes, class EdgeAttributes, class VertexAttributes>
+	class Storage
+	{
+	public:
+		void SetPosition(const Index_t &index, const PositionType &p) { m_vertexPositions.GetOrCreate(index, p) = p; }
+		PositionType GetPosition(const Index_t &index) { return m_vertexPositions.GetOrCreate(index); }
+
+		/**
+		 * Sets the positions of the indices [0, count) from one array per coordinate.
+		 */
+		template<class Scalar_t>
+		void SetPositions(const Scalar_t *x, const Scalar_t *y, const Scalar_t *z, std::size_t count)
+		{
+			for (auto i = 0u; i < count; ++i)
+			{
+				SetPosition(i, PositionType{x[i], y[i], z[i]});
+			}
+		}
+
+		/**
+		 * Transforms every position with the affine \p matrix.
+		 */
+		template<class Scalar_t>
+		void TransformPositions(const boost::qvm::mat<Scalar_t, 3, 4> &matrix)
+		{
+			for (auto &position : m_vertexPositions)
+			{
+				auto &p = position.second;
+				TransformPoints(matrix, &boost::qvm::X(p), &boost::qvm::Y(p), &boost::qvm::Z(p), 1);
+			}
+		}
+
+		VertexAttributes &GetVertexAttributes(const Index_t &vertex) { return m_vertexAttributes.GetOrCreate(vertex); }
+		EdgeAttributes &GetEdgeAttributes(const Index_t &edge) { return m_edgeAttributes.GetOrCreate(edge); }
+		FaceAttributes &GetFaceAttributes(const Index_t &face) { return m_faceAttributes.GetOrCreate(face); }
+
+		/**
+		 * Returns an estimate of the memory used by the positions and attributes.
+		 */
+		std::size_t GetMemoryBytes() const
+		{
+			return m_vertexPositions.Count() * (sizeof(Index_t) + sizeof(PositionType)) +
+			       m_vertexAttributes.Count() * (sizeof(Index_t) + sizeof(VertexAttributes)) +
+			       m_edgeAttributes.Count() * (sizeof(Index_t) + sizeof(EdgeAttributes)) +
+			       m_faceAttributes.Count() * (sizeof(Index_t) + sizeof(FaceAttributes));
+		}
+
+		/**
+		 * Moves the attributes to follow the renumbering of points, edges and faces.
+		 */
+		void Remap(const std::vector<Index_t> &points, const std::vector<Index_t> &edges,
+		           const std::vector<Index_t> &faces)
+		{
+			m_vertexPositions.Remap(points);
+			m_vertexAttributes.Remap(points);
+			m_edgeAttributes.Remap(edges);
+			m_faceAttributes.Remap(faces);
+		}
+
+	private:
+		AssociativeIndexedContainer<Index_t, PositionType> m_vertexPositions;
+		AssociativeIndexedContainer<Index_t, VertexAttributes> m_vertexAttributes;
+		AssociativeIndexedContainer<Index_t, EdgeAttributes> m_edgeAttributes;
+		AssociativeIndexedContainer<Index_t, FaceAttributes> m_faceAttributes;
+	};
+};  // struct AssociativeAttributeStorage
+
+/**
+ * Attribute storage policy for \c GeometryBase that keeps positions and attributes in arrays
+ * indexed directly by the topology index.
+ *
+ * Positions are stored as a structure of arrays (one array per coordinate) so that iterating
+ * over the points of a geometry walks contiguous memory.
+ * Arrays grow on demand to the largest index accessed, which makes this policy suited for
+ * the dense indices created by the topologies.
+ */
+struct DenseAttributeStorage
+{
+	template<class Index_t, class PositionType, class FaceAttributes, class EdgeAttributes, class VertexAttributes>
+	class Storage
+	{
+	public:
+		using Scalar_t = typename boost::qvm::vec_traits<PositionType>::scalar_type;
+		static_assert(boost::qvm::vec_traits<PositionType>::dim == 3, "Only 3D positions are supported");
+
+		void SetPosition(const Index_t &index, const PositionType &p)
+		{
+			START_PROFILE;
+			if (index >= m_x.size())
+			{
+				ResizePositions(index + 1);
+			}
+			m_x[index] = boost::qvm::X(p);
+			m_y[index] = boost::qvm::Y(p);
+			m_z[index] = boost::qvm::Z(p);
+		}
+
+		PositionType GetPosition(const Index_t &index) const
+		{
+			START_PROFILE;
+			if (index >= m_x.size())
+			{
+				return PositionType{0, 0, 0};
+			}
+			return PositionType{m_x[index], m_y[index], m_z[index]};
+		}
+
+		/**
+		 * Sets the positions of the indices [0, count) from one array per coordinate.
+		 * As positions are stored in the same layout, each array is copied in one go.
+		 */
+		void SetPositions(const Scalar_t *x, const Scalar_t *y, const Scalar_t *z, std::size_t count)
+		{
+			START_PROFILE;
+			if (m_x.size() < count)
+			{
+				ResizePositions(count);
+			}
+			std::copy(x, x + count, m_x.begin());
+			std::copy(y, y + count, m_y.begin());
+			std::copy(z, z + count, m_z.begin());
+		}
+
+		/**
+		 * Transforms every position with the affine \p matrix, in a single pass over the coordinate arrays.
+		 */
+		void TransformPositions(const boost::qvm::mat<Scalar_t, 3, 4> &matrix)
+		{
+			START_PROFILE;
+			TransformPoints(matrix, m_x.data(), m_y.data(), m_z.data(), m_x.size());
+		}
+
+		VertexAttributes &GetVertexAttributes(const Index_t &vertex) { return GetOrCreate(m_vertexAttributes, vertex); }
+		EdgeAttributes &GetEdgeAttributes(const Index_t &edge) { return GetOrCreate(m_edgeAttributes, edge); }
+		FaceAttributes &GetFaceAttributes(const Index_t &face) { return GetOrCreate(m_faceAttributes, face); }
+
+		/**
+		 * Returns the memory used by the positions and attributes.
+		 */
+		std::size_t GetMemoryBytes() const
+		{
+			return 3 * m_x.size() * sizeof(Scalar_t) + m_vertexAttributes.size() * sizeof(VertexAttributes) +
+			       m_edgeAttributes.size() * sizeof(EdgeAttributes) + m_faceAttributes.size() * sizeof(FaceAttributes);
+		}
+
+		/**
+		 * Moves the attributes to follow the renumbering of points, edges and faces.
+		 */
+		void Remap(const std::vector<Index_t> &points, const std::vector<Index_t> &edges,
+		           const std::vector<Index_t> &faces)
+		{
+			START_PROFILE;
+			RemapArray(m_x, points);
+			RemapArray(m_y, points);
+			RemapArray(m_z, points);
+			RemapArray(m_vertexAttributes, points);
+			RemapArray(m_edgeAttributes, edges);
+			RemapArray(m_faceAttributes, faces);
+		}
+
+	private:
+		template<class T>
+		void RemapArray(std::vector<T> &container, const std::vector<Index_t> &remap)
+		{
+			std::vector<T> remapped;
+			for (auto i = 0u; i < std::min(container.size(), remap.size()); ++i)
+			{
+				if (remap[i] == std::numeric_limits<Index_t>::max())
+				{
+					continue;
+				}
+				if (remap[i] >= remapped.size())
+				{
+					remapped.resize(remap[i] + 1);
+				}
+				remapped[remap[i]] = std::move(container[i]);
+			}
+			container = std::move(remapped);
+		}
+
+		void ResizePositions(std::size_t size)
+		{
+			m_x.resize(size, 0);
+			m_y.resize(size, 0);
+			m_z.resize(size, 0);
+		}
+
+		template<class T>
+		T &GetOrCreate(std::vector<T> &container, const Index_t &index)
+		{
+			if (index >= container.size())
+			{
+				container.resize(index + 1);
+			}
+			return container[index];
+		}
+
+		std::vector<Scalar_t> m_x;
+		std::vector<Scalar_t> m_y;
+		std::vector<Scalar_t> m_z;
+		std::vector<VertexAttributes> m_vertexAttributes;
+		std::vector<EdgeAttributes> m_edgeAttributes;
+		std::vector<FaceAttributes> m_faceAttributes;
+	};
+};  // struct DenseAttributeStorage
+}  // namespace pagoda
+
+#endif
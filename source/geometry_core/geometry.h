@@ -8,7 +8,7 @@
 
 #include <cstdint>
 
-#include "indexed_container.h"
+#include "attribute_storage.h"
 #include "split_point_topology.h"
 
 #include <boost/qvm/vec_operations.hpp>
@@ -59,8 +59,12 @@ inline typename Geometry::PositionType face_normal(std::shared_ptr<Geometry> geo
 	return boost::qvm::normalized(boost::qvm::cross(pos2 - pos1, pos0 - pos1));
 }
 
+/**
+ * A geometry with the connectivity given by \c Topology and the attributes stored according
+ * to the \c Storage policy (see \c AssociativeAttributeStorage and \c DenseAttributeStorage).
+ */
 template<class Topology = SplitPointTopology, class F = DefaultFaceAttributes, class E = DefaultEdgeAttributes,
-         class V = DefaultVertexAttributes>
+         class V = DefaultVertexAttributes, class Storage = AssociativeAttributeStorage>
 class GeometryBase : public Topology
 {
 public:
@@ -69,20 +73,51 @@ public:
 	using EdgeAttributes = E;
 	using VertexAttributes = V;
 	using PositionType = Vec3F;
+	using AttributeStorage_t =
+	    typename Storage::template Storage<Index_t, PositionType, FaceAttributes, EdgeAttributes, VertexAttributes>;
+
+	void SetPosition(const Index_t &index, const PositionType &p) { m_attributes.SetPosition(index, p); }
+	PositionType GetPosition(const Index_t &index) { return m_attributes.GetPosition(index); }
+	/**
+	 * Sets the positions of the points [0, count) from one array per coordinate.
+	 */
+	template<class Scalar_t>
+	void SetPositions(const Scalar_t *x, const Scalar_t *y, const Scalar_t *z, std::size_t count)
+	{
+		m_attributes.SetPositions(x, y, z, count);
+	}
+	/**
+	 * Transforms the positions of all points with the affine \p matrix.
+	 */
+	template<class Scalar_t>
+	void TransformPositions(const boost::qvm::mat<Scalar_t, 3, 4> &matrix)
+	{
+		m_attributes.TransformPositions(matrix);
+	}
 
-	void SetPosition(const Index_t &index, const PositionType &p) { m_vertexPositions.GetOrCreate(index, p) = p; }
+	VertexAttributes &GetVertexAttributes(const Index_t &vertex) { return m_attributes.GetVertexAttributes(vertex); }
+	EdgeAttributes &GetEdgeAttributes(const Index_t &edge) { return m_attributes.GetEdgeAttributes(edge); }
+	FaceAttributes &GetFaceAttributes(const Index_t &face) { return m_attributes.GetFaceAttributes(face); }
 
-	PositionType &GetPosition(const Index_t &index) { return m_vertexPositions.GetOrCreate(index); }
+	/**
+	 * Returns an estimate of the memory used by the topology and the attributes.
+	 */
+	std::size_t GetMemoryBytes() const { return Topology::GetMemoryBytes() + m_attributes.GetMemoryBytes(); }
 
-	VertexAttributes &GetVertexAttributes(const Index_t &vertex) { return m_vertexAttributes.GetOrCreate(vertex); }
-	EdgeAttributes &GetEdgeAttributes(const Index_t &edge) { return m_edgeAttributes.GetOrCreate(edge); }
-	FaceAttributes &GetFaceAttributes(const Index_t &face) { return m_faceAttributes.GetOrCreate(face); }
+	/**
+	 * Compacts the \c Topology (see \c SplitPointTopologyBase::Compact()) and moves the attributes
+	 * to the new indices.
+	 */
+	typename Topology::CompactResult Compact()
+	{
+		START_PROFILE;
+		auto result = Topology::Compact();
+		m_attributes.Remap(result.m_points, result.m_edges, result.m_faces);
+		return result;
+	}
 
 private:
-	AssociativeIndexedContainer<Index_t, PositionType> m_vertexPositions;
-	AssociativeIndexedContainer<Index_t, VertexAttributes> m_vertexAttributes;
-	AssociativeIndexedContainer<Index_t, EdgeAttributes> m_edgeAttributes;
-	AssociativeIndexedContainer<Index_t, FaceAttributes> m_faceAttributes;
+	AttributeStorage_t m_attributes;
 };  // class Geometry
 
 }  // namespace pagoda
@@ -0,0 +1,354 @@
+#ifndef PAGODA_GEOMETRY_CORE_GEOMETRY_BINARY_FORMAT_H_
+#define PAGODA_GEOMETRY_CORE_GEOMETRY_BINARY_FORMAT_H_
+
+#include "geometry.h"
+#include "scope.h"
+
+#include "common/exception.h"
+#include "common/mapped_file.h"
+#include "common/profiler.h"
+
+#include <boost/qvm/mat_traits.hpp>
+#include <boost/qvm/vec_access.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pagoda
+{
+/**
+ * Compact binary format for geometries, meant to be loaded without parsing.
+ *
+ * All values are 32 bit little-endian. The file starts with a \c Header followed by flat arrays:
+ *  - x, y and z of the point positions (one array per coordinate, \c m_pointCount each)
+ *  - x, y and z of the point normals
+ *  - number of points in each face (\c m_faceCount)
+ *  - point indices of all faces (\c m_indexCount)
+ *  - position of the split point of each face index in the split point order (\c m_indexCount)
+ *  - x, y and z of the face normals
+ *
+ * Faces are stored in their iteration order and points are numbered in the order they first appear
+ * in the faces. A loaded geometry iterates its faces, each starting at the same point, and its split
+ * points in the same order as the geometry that was written, so both export the same Obj file.
+ */
+struct GeometryBinaryFormat
+{
+	static constexpr char s_magic[4] = {'P', 'G', 'G', 'M'};
+	static constexpr uint32_t s_version = 2;
+	/// Extension for files in this format.
+	static constexpr const char *s_extension = ".pgg";
+
+	struct Header
+	{
+		char m_magic[4];
+		uint32_t m_version;
+		uint32_t m_pointCount;
+		uint32_t m_faceCount;
+		uint32_t m_indexCount;
+		float m_scopePosition[3];
+		float m_scopeSize[3];
+		float m_scopeRotation[9];  ///< Row major
+	};
+	static_assert(sizeof(Header) == 80, "Header must not have padding");
+
+	static bool IsLittleEndian()
+	{
+		const uint32_t one = 1;
+		char firstByte;
+		std::memcpy(&firstByte, &one, 1);
+		return firstByte == 1;
+	}
+
+	/**
+	 * Returns the size in bytes of a file with the counts in \p header.
+	 */
+	static std::size_t GetFileSize(const Header &header)
+	{
+		return sizeof(Header) +
+		       sizeof(uint32_t) * (6 * std::size_t(header.m_pointCount) + 4 * std::size_t(header.m_faceCount) +
+		                           2 * std::size_t(header.m_indexCount));
+	}
+};  // struct GeometryBinaryFormat
+
+/**
+ * Writes a geometry in the \c GeometryBinaryFormat.
+ */
+template<class G>
+class GeometryBinaryWriter
+{
+public:
+	using Geometry = G;
+	using GeometryPtr = std::shared_ptr<Geometry>;
+	using Index_t = typename Geometry::Index_t;
+
+	explicit GeometryBinaryWriter(GeometryPtr geom) : m_geometry(geom)
+	{
+		if (!GeometryBinaryFormat::IsLittleEndian())
+		{
+			throw Exception("The binary geometry format is only supported in little-endian platforms");
+		}
+	}
+
+	/**
+	 * Appends the geometry together with its \p scope to \p buffer.
+	 */
+	void Write(std::string &buffer, const Scope &scope)
+	{
+		START_PROFILE;
+		std::vector<uint32_t> exportIndices;
+		std::vector<typename Geometry::PointHandle> points;
+		std::vector<uint32_t> faceSizes;
+		std::vector<uint32_t> indices;
+		std::vector<uint32_t> splitPointOrder;
+		std::vector<typename Geometry::FaceHandle> faces;
+
+		std::vector<uint32_t> splitPointPositions;
+		uint32_t splitPointCount = 0;
+		for (auto iter = m_geometry->SplitPointsBegin(); iter != m_geometry->SplitPointsEnd(); ++iter)
+		{
+			if (*iter >= splitPointPositions.size())
+			{
+				splitPointPositions.resize(*iter * 2 + 1);
+			}
+			splitPointPositions[*iter] = splitPointCount++;
+		}
+
+		for (auto faceIter = m_geometry->FacesBegin(); faceIter != m_geometry->FacesEnd(); ++faceIter)
+		{
+			// Start at the split point after the face's own split point so that, when loading,
+			// the face's split point is created last, like SplitPointTopologyBase::CreatePolygon does
+			const auto first = m_geometry->GetNextSplitPoint(m_geometry->GetSplitPoint(*faceIter));
+			uint32_t faceSize = 0;
+			auto splitPoint = first;
+			do
+			{
+				const auto point = m_geometry->GetPoint(splitPoint);
+				if (point >= exportIndices.size())
+				{
+					exportIndices.resize(point * 2 + 1, Geometry::s_invalidIndex);
+				}
+				if (exportIndices[point] == Geometry::s_invalidIndex)
+				{
+					exportIndices[point] = static_cast<uint32_t>(points.size());
+					points.push_back(point);
+				}
+				indices.push_back(exportIndices[point]);
+				splitPointOrder.push_back(splitPointPositions[splitPoint]);
+				++faceSize;
+				splitPoint = m_geometry->GetNextSplitPoint(splitPoint);
+			} while (splitPoint != first);
+			faceSizes.push_back(faceSize);
+			faces.push_back(*faceIter);
+		}
+
+		GeometryBinaryFormat::Header header;
+		std::memcpy(header.m_magic, GeometryBinaryFormat::s_magic, sizeof(header.m_magic));
+		header.m_version = GeometryBinaryFormat::s_version;
+		header.m_pointCount = static_cast<uint32_t>(points.size());
+		header.m_faceCount = static_cast<uint32_t>(faceSizes.size());
+		header.m_indexCount = static_cast<uint32_t>(indices.size());
+		WriteVector(header.m_scopePosition, scope.GetPosition());
+		WriteVector(header.m_scopeSize, scope.GetSize());
+		const auto rotation = scope.GetRotation();
+		for (auto i = 0u; i < 9; ++i)
+		{
+			header.m_scopeRotation[i] = boost::qvm::mat_traits<Mat3x3F>::read_element_idx(i / 3, i % 3, rotation);
+		}
+
+		const auto start = buffer.size();
+		buffer.resize(start + GeometryBinaryFormat::GetFileSize(header));
+		char *out = &buffer[start];
+		out = Append(out, &header, 1);
+
+		std::vector<float> coordinates(points.size());
+		auto appendCoordinates = [&](auto getVector) {
+			for (auto c = 0u; c < 3; ++c)
+			{
+				for (auto i = 0u; i < points.size(); ++i)
+				{
+					coordinates[i] = GetCoordinate(getVector(points[i]), c);
+				}
+				out = Append(out, coordinates.data(), coordinates.size());
+			}
+		};
+		appendCoordinates([this](Index_t p) { return m_geometry->GetPosition(p); });
+		appendCoordinates([this](Index_t p) { return m_geometry->GetVertexAttributes(p).m_normal; });
+
+		out = Append(out, faceSizes.data(), faceSizes.size());
+		out = Append(out, indices.data(), indices.size());
+		out = Append(out, splitPointOrder.data(), splitPointOrder.size());
+
+		coordinates.resize(faces.size());
+		for (auto c = 0u; c < 3; ++c)
+		{
+			for (auto i = 0u; i < faces.size(); ++i)
+			{
+				coordinates[i] = GetCoordinate(m_geometry->GetFaceAttributes(faces[i]).m_normal, c);
+			}
+			out = Append(out, coordinates.data(), coordinates.size());
+		}
+	}
+
+private:
+	template<class T>
+	static char *Append(char *out, const T *data, std::size_t count)
+	{
+		std::memcpy(out, data, count * sizeof(T));
+		return out + count * sizeof(T);
+	}
+
+	static float GetCoordinate(const Vec3F &v, uint32_t c)
+	{
+		return c == 0 ? boost::qvm::X(v) : (c == 1 ? boost::qvm::Y(v) : boost::qvm::Z(v));
+	}
+
+	static void WriteVector(float *out, const Vec3F &v)
+	{
+		out[0] = boost::qvm::X(v);
+		out[1] = boost::qvm::Y(v);
+		out[2] = boost::qvm::Z(v);
+	}
+
+	GeometryPtr m_geometry;
+};  // class GeometryBinaryWriter
+
+/**
+ * Reads geometries in the \c GeometryBinaryFormat.
+ */
+template<class G>
+class GeometryBinaryReader
+{
+public:
+	using Geometry = G;
+	using GeometryPtr = std::shared_ptr<Geometry>;
+
+	/**
+	 * Creates a geometry from the \p size bytes in \p data, storing its scope in \p scope.
+	 * Throws an \c Exception if \p data isn't a valid geometry.
+	 */
+	static GeometryPtr Read(const char *data, std::size_t size, Scope &scope)
+	{
+		START_PROFILE;
+		if (!GeometryBinaryFormat::IsLittleEndian())
+		{
+			throw Exception("The binary geometry format is only supported in little-endian platforms");
+		}
+
+		GeometryBinaryFormat::Header header;
+		if (size < sizeof(header))
+		{
+			throw Exception("Binary geometry is too small");
+		}
+		std::memcpy(&header, data, sizeof(header));
+		if (std::memcmp(header.m_magic, GeometryBinaryFormat::s_magic, sizeof(header.m_magic)) != 0)
+		{
+			throw Exception("Not a binary geometry");
+		}
+		if (header.m_version != GeometryBinaryFormat::s_version)
+		{
+			throw Exception("Unsupported binary geometry version " + std::to_string(header.m_version));
+		}
+		if (size < GeometryBinaryFormat::GetFileSize(header))
+		{
+			throw Exception("Binary geometry is truncated");
+		}
+
+		Mat3x3F rotation;
+		for (auto i = 0u; i < 9; ++i)
+		{
+			boost::qvm::mat_traits<Mat3x3F>::write_element_idx(i / 3, i % 3, rotation) = header.m_scopeRotation[i];
+		}
+		scope = Scope(ReadVector(header.m_scopePosition), ReadVector(header.m_scopeSize), rotation);
+
+		const auto pointCount = header.m_pointCount;
+		const auto faceCount = header.m_faceCount;
+		// The arrays are 4 byte aligned as long as data is, which is the case for mapped files
+		const float *positions = reinterpret_cast<const float *>(data + sizeof(header));
+		const float *normals = positions + 3 * pointCount;
+		const uint32_t *faceSizes = reinterpret_cast<const uint32_t *>(normals + 3 * pointCount);
+		const uint32_t *indices = faceSizes + faceCount;
+		const uint32_t *splitPointOrder = indices + header.m_indexCount;
+		const float *faceNormals = reinterpret_cast<const float *>(splitPointOrder + header.m_indexCount);
+
+		auto geometry = std::make_shared<Geometry>();
+		geometry->Reserve(pointCount, header.m_indexCount, header.m_indexCount, faceCount);
+
+		std::vector<typename Geometry::PointHandle> facePoints;
+		std::vector<typename Geometry::SplitPointHandle> faceSplitPoints;
+		std::vector<bool> usedSplitPoints(header.m_indexCount, false);
+		std::size_t faceStart = 0;
+		uint32_t nextPoint = 0;
+		for (auto f = 0u; f < faceCount; ++f)
+		{
+			if (faceSizes[f] < 3 || faceStart + faceSizes[f] > header.m_indexCount)
+			{
+				throw Exception("Invalid face in binary geometry");
+			}
+			const auto createdPoints = nextPoint;
+			facePoints.clear();
+			faceSplitPoints.clear();
+			for (auto i = 0u; i < faceSizes[f]; ++i)
+			{
+				const auto splitPoint = splitPointOrder[faceStart + i];
+				if (splitPoint >= header.m_indexCount || usedSplitPoints[splitPoint])
+				{
+					throw Exception("Invalid split point in binary geometry");
+				}
+				usedSplitPoints[splitPoint] = true;
+				faceSplitPoints.push_back(splitPoint);
+
+				// Points are numbered by first appearance, so new points get their index in the file
+				const auto index = indices[faceStart + i];
+				if (index < createdPoints)
+				{
+					facePoints.push_back(index);
+				}
+				else if (index == nextPoint && index < pointCount)
+				{
+					facePoints.push_back(Geometry::s_invalidIndex);
+					++nextPoint;
+				}
+				else
+				{
+					throw Exception("Invalid point index in binary geometry");
+				}
+			}
+			auto face = geometry->CreatePolygon(facePoints.data(), facePoints.size(), faceSplitPoints.data());
+			geometry->GetFaceAttributes(face).m_normal =
+			    Vec3F{faceNormals[f], faceNormals[faceCount + f], faceNormals[2 * faceCount + f]};
+			faceStart += faceSizes[f];
+		}
+		if (nextPoint != pointCount)
+		{
+			throw Exception("Binary geometry has points that don't belong to any face");
+		}
+
+		geometry->SetPositions(positions, positions + pointCount, positions + 2 * pointCount, pointCount);
+		for (auto p = 0u; p < pointCount; ++p)
+		{
+			geometry->GetVertexAttributes(p).m_normal =
+			    Vec3F{normals[p], normals[pointCount + p], normals[2 * pointCount + p]};
+		}
+
+		return geometry;
+	}
+
+	/**
+	 * Maps the file in \p filePath and creates a geometry from it, storing its scope in \p scope.
+	 */
+	static GeometryPtr ReadFile(const std::string &filePath, Scope &scope)
+	{
+		START_PROFILE;
+		MappedFile file(filePath);
+		return Read(file.GetData(), file.GetSize(), scope);
+	}
+
+private:
+	static Vec3F ReadVector(const float *v) { return Vec3F{v[0], v[1], v[2]}; }
+};  // class GeometryBinaryReader
+}  // namespace pagoda
+
+#endif
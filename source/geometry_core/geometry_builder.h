@@ -5,6 +5,7 @@
 #include "common/logger.h"
 #include "common/profiler.h"
 #include "indexed_container.h"
+#include "math_lib/vec_base.h"
 
 #include <boost/qvm/vec_access.hpp>
 #include <boost/qvm/vec_operations.hpp>
@@ -247,6 +248,106 @@ private:
 	AssociativeIndexedContainer<Index_t, PointData> m_pointData;
 };  // class GeometryBuilderT
 
+/**
+ * Builds a geometry from flat arrays in a single call.
+ *
+ * Faces are given by a flat array of point indices and an array with the number of points in each face,
+ * with each index referring to a position in the positions array. All topology containers are reserved
+ * up front and every face is created directly with all of its points, instead of splitting the edges
+ * of a triangle as \c GeometryBuilderT does.
+ *
+ * Produces the same geometry as adding the positions with \c GeometryBuilderT::AddPoint and creating
+ * each face with a \c GeometryBuilderT::FaceBuilder.
+ */
+template<class Geometry>
+class BulkGeometryBuilderT
+{
+public:
+	/// The Geometry index type
+	using Index_t = typename Geometry::Index_t;
+	/// The Geometry position type.
+	using PositionType = typename Geometry::PositionType;
+
+	/**
+	 * Creates a bulk geometry builder for the given geometry.
+	 */
+	explicit BulkGeometryBuilderT(std::shared_ptr<Geometry> geom) : m_geometry(geom) {}
+
+	/**
+	 * Creates the faces defined by \p indices and \p faceSizes.
+	 * Positions that aren't referenced by any face are not added to the geometry.
+	 */
+	void Build(const std::vector<PositionType> &positions, const std::vector<Index_t> &indices,
+	           const std::vector<uint32_t> &faceSizes)
+	{
+		START_PROFILE;
+		LOG_TRACE(GeometryCore, "Building " << faceSizes.size() << " faces with " << positions.size() << " points");
+
+		m_geometry->Reserve(positions.size(), indices.size(), indices.size(), faceSizes.size());
+
+		std::vector<typename Geometry::PointHandle> points(positions.size(), Geometry::s_invalidIndex);
+		std::vector<typename Geometry::PointHandle> facePoints;
+		std::size_t faceStart = 0;
+		for (const auto &faceSize : faceSizes)
+		{
+			DBG_ASSERT_MSG(faceSize >= 3, "Trying to create a face with less than 3 points");
+			DBG_ASSERT_MSG(faceStart + faceSize <= indices.size(), "Face indices past the end of the index array");
+
+			facePoints.clear();
+			for (auto i = 0u; i < faceSize; ++i)
+			{
+				facePoints.push_back(points[indices[faceStart + i]]);
+			}
+			const auto normal = FaceNormal(positions, &indices[faceStart], faceSize);
+
+			auto face = m_geometry->CreatePolygon(facePoints.data(), faceSize);
+			m_geometry->GetFaceAttributes(face).m_normal = normal;
+			for (auto i = 0u; i < faceSize; ++i)
+			{
+				auto &point = points[indices[faceStart + i]];
+				if (point.GetIndex() == Geometry::s_invalidIndex)
+				{
+					point = facePoints[i];
+					m_geometry->SetPosition(point, positions[indices[faceStart + i]]);
+				}
+				m_geometry->GetVertexAttributes(point).m_normal = normal;
+			}
+
+			faceStart += faceSize;
+		}
+	}
+
+	/**
+	 * Returns the normal given by Build() to the face with the \p faceSize points at \p indices in \p positions.
+	 */
+	static Vec3F FaceNormal(const std::vector<PositionType> &positions, const Index_t *indices, uint32_t faceSize)
+	{
+		Vec3F normal{0, 0, 0};
+		for (auto i = 0u; i < faceSize; ++i)
+		{
+			const auto &curr = positions[indices[i]];
+			const auto &next = positions[indices[(i + 1) % faceSize]];
+
+			// Newell's Method
+			X(normal) += (Y(curr) - Y(next)) * (Z(curr) + Z(next));
+			Y(normal) += (Z(curr) - Z(next)) * (X(curr) + X(next));
+			Z(normal) += (X(curr) - X(next)) * (Y(curr) + Y(next));
+		}
+		DBG_ASSERT_MSG(boost::qvm::mag_sqr(normal) > 0, "The normal's magnitude is 0. Are all face points collinear?");
+		boost::qvm::normalize(normal);
+		return normal;
+	}
+
+	/**
+	 * Returns the geometry that is being built.
+	 */
+	std::shared_ptr<Geometry> GetGeometry() { return m_geometry; }
+
+private:
+	/// The Geometry to build.
+	std::shared_ptr<Geometry> m_geometry;
+};  // class BulkGeometryBuilderT
+
 }  // namespace pagoda
 
 #endif
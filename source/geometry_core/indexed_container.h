@@ -6,8 +6,10 @@
 #include "common/profiler.h"
 #include "common/range.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <unordered_map>
-
 #include <vector>
 
 namespace pagoda
@@ -19,11 +21,40 @@ public:
 	IndexedDeletedException(const IndexType& i) : Exception("Tried to access deleted index " + std::to_string(i)) {}
 };
 
+/**
+ * Returns the number of trailing zero bits in \p bits, which must not be 0.
+ */
+inline uint32_t count_trailing_zeros(uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<uint32_t>(__builtin_ctzll(bits));
+#else
+	uint32_t count = 0;
+	while ((bits & 1) == 0)
+	{
+		bits >>= 1;
+		++count;
+	}
+	return count;
+#endif
+}
+
+/**
+ * Stores values in a contiguous array where the index of a value never changes until
+ * \c Compact() is called.
+ *
+ * Valid indices are tracked in a bitmap so that iteration can skip 64 deleted indices at a time.
+ * \c Create() doesn't reuse deleted indices, so that values are always visited in the order they
+ * were created, which is what determines the order of exported geometries. The memory of deleted
+ * values is reclaimed with \c Compact().
+ */
 template<class IndexType, class ValueType>
 class IndexedContainer
 {
 private:
 	using IndexedContainer_t = IndexedContainer<IndexType, ValueType>;
+	using Word_t = uint64_t;
+	static constexpr std::size_t s_bitsPerWord = 64;
 
 public:
 	struct IndexValuePair
@@ -35,6 +66,9 @@ public:
 	};
 
 	using ContainerType = std::vector<ValueType>;
+	/// Maps old indices to new indices. Deleted indices are mapped to \c s_invalidIndex.
+	using RemapTable_t = std::vector<IndexType>;
+	static constexpr IndexType s_invalidIndex = std::numeric_limits<IndexType>::max();
 
 	IndexedContainer() : m_nextIndex(0), m_count(0) {}
 
@@ -42,7 +76,7 @@ public:
 	{
 		START_PROFILE;
 		DBG_ASSERT(index < m_container.size());
-		if (!m_validIndex[index])
+		if (!IsValid(index))
 		{
 			throw IndexedDeletedException(index);
 		}
@@ -53,7 +87,7 @@ public:
 	{
 		START_PROFILE;
 		DBG_ASSERT(index < m_container.size());
-		if (!m_validIndex[index])
+		if (!IsValid(index))
 		{
 			throw IndexedDeletedException(index);
 		}
@@ -90,40 +124,82 @@ public:
 
 	void Delete(const IndexType& index)
 	{
-		if (m_container.size() <= index)
+		if (!HasIndex(index))
 		{
 			return;
 		}
 		--m_count;
-		m_validIndex[index] = false;
+		SetValid(index, false);
 	}
 
-	bool HasIndex(const IndexType& index) { return m_container.size() > index && m_validIndex[index]; }
+	bool HasIndex(const IndexType& index) const { return m_container.size() > index && IsValid(index); }
 
 	std::size_t Count() const { return m_count; }
 
+	/**
+	 * Allocates space for \p count more values so that creating them doesn't reallocate the container.
+	 */
+	void Reserve(const std::size_t& count)
+	{
+		const auto capacity = m_container.size() + count;
+		m_container.reserve(capacity);
+		m_validBits.reserve((capacity + s_bitsPerWord - 1) / s_bitsPerWord);
+	}
+
+	/**
+	 * Moves all values to the lowest indices, keeping their relative order, and releases
+	 * the deleted indices.
+	 *
+	 * Returns a table mapping the previous indices to the new ones, which can be used to
+	 * update anything that refers to the values in this container.
+	 */
+	RemapTable_t Compact()
+	{
+		START_PROFILE;
+		RemapTable_t remap(m_container.size(), s_invalidIndex);
+		std::size_t newIndex = 0;
+		for (auto i = FindNextValid(0); i < m_container.size(); i = FindNextValid(i + 1))
+		{
+			remap[i] = static_cast<IndexType>(newIndex);
+			if (i != newIndex)
+			{
+				m_container[newIndex] = std::move(m_container[i]);
+			}
+			++newIndex;
+		}
+
+		m_container.resize(newIndex);
+		m_validBits.assign((newIndex + s_bitsPerWord - 1) / s_bitsPerWord, 0);
+		for (auto i = 0u; i < newIndex; ++i)
+		{
+			SetValid(i, true);
+		}
+		m_nextIndex = static_cast<IndexType>(newIndex);
+		return remap;
+	}
+
 	class iterator
 	{
 	public:
 		iterator(IndexedContainer_t& container, const std::size_t& index)
-		    : m_container(container), m_currentIndex(FindNextValid(index))
+		    : m_container(container), m_currentIndex(m_container.FindNextValid(index))
 		{
 		}
 
 		IndexValuePair operator*()
 		{
-			return IndexValuePair{static_cast<IndexType>(m_currentIndex), m_container.m_container.at(m_currentIndex)};
+			return IndexValuePair{static_cast<IndexType>(m_currentIndex), m_container.m_container[m_currentIndex]};
 		}
 
 		iterator& operator++()
 		{
-			m_currentIndex = FindNextValid(m_currentIndex + 1);
+			m_currentIndex = m_container.FindNextValid(m_currentIndex + 1);
 			return *this;
 		}
 
 		iterator& operator++(int)
 		{
-			m_currentIndex = FindNextValid(m_currentIndex + 1);
+			m_currentIndex = m_container.FindNextValid(m_currentIndex + 1);
 			return *this;
 		}
 
@@ -132,18 +208,6 @@ public:
 		bool operator!=(const iterator& other) { return m_currentIndex != other.m_currentIndex; }
 
 	private:
-		std::size_t FindNextValid(const std::size_t index) const
-		{
-			for (auto i = index; i < m_container.m_container.size(); ++i)
-			{
-				if (m_container.m_validIndex[i])
-				{
-					return i;
-				}
-			}
-			return m_container.m_container.size();
-		}
-
 		IndexedContainer_t& m_container;
 		std::size_t m_currentIndex;
 	};
@@ -152,32 +216,106 @@ public:
 	iterator end() { return iterator(*this, m_container.size()); }
 
 private:
+	bool IsValid(const std::size_t& index) const
+	{
+		return (m_validBits[index / s_bitsPerWord] >> (index % s_bitsPerWord)) & 1;
+	}
+
+	void SetValid(const std::size_t& index, bool valid)
+	{
+		const Word_t mask = Word_t(1) << (index % s_bitsPerWord);
+		if (valid)
+		{
+			m_validBits[index / s_bitsPerWord] |= mask;
+		}
+		else
+		{
+			m_validBits[index / s_bitsPerWord] &= ~mask;
+		}
+	}
+
+	/**
+	 * Returns the first valid index starting at \p index or the size of the container if there is none.
+	 */
+	std::size_t FindNextValid(const std::size_t index) const
+	{
+		const auto size = m_container.size();
+		if (index >= size)
+		{
+			return size;
+		}
+
+		auto word = index / s_bitsPerWord;
+		Word_t bits = m_validBits[word] & (~Word_t(0) << (index % s_bitsPerWord));
+		while (bits == 0)
+		{
+			if (++word >= m_validBits.size())
+			{
+				return size;
+			}
+			bits = m_validBits[word];
+		}
+		return word * s_bitsPerWord + count_trailing_zeros(bits);
+	}
+
+	/**
+	 * Returns the first index starting at \p index that doesn't hold a value, which may be past the end
+	 * of the container.
+	 */
+	std::size_t FindNextFree(const std::size_t index) const
+	{
+		auto word = index / s_bitsPerWord;
+		if (word >= m_validBits.size())
+		{
+			return index;
+		}
+
+		Word_t bits = ~m_validBits[word] & (~Word_t(0) << (index % s_bitsPerWord));
+		while (bits == 0)
+		{
+			if (++word >= m_validBits.size())
+			{
+				return word * s_bitsPerWord;
+			}
+			bits = ~m_validBits[word];
+		}
+		return word * s_bitsPerWord + count_trailing_zeros(bits);
+	}
+
 	IndexType CreateAtIndex(const IndexType& index, const ValueType& v)
 	{
-		if (m_container.size() <= index)
+		// The vector grows its capacity geometrically
+		if (m_container.size() == index)
 		{
-			m_container.resize(index * 2 + 1);
-			m_validIndex.resize(index * 2 + 1);
+			m_container.push_back(v);
+		}
+		else
+		{
+			if (m_container.size() < index)
+			{
+				m_container.resize(index + 1);
+			}
+			m_container[index] = v;
+		}
+		if (m_validBits.size() * s_bitsPerWord <= index)
+		{
+			m_validBits.resize(index / s_bitsPerWord + 1, 0);
 		}
-		DBG_ASSERT(index < m_container.size());
 		++m_count;
-		m_container[index] = v;
-		m_validIndex[index] = true;
+		SetValid(index, true);
 		return index;
 	}
 
 	IndexType CreateIndex()
 	{
-		while (m_nextIndex < m_container.size() && m_validIndex[m_nextIndex])
-		{
-			++m_nextIndex;
-		}
+		m_nextIndex = static_cast<IndexType>(FindNextFree(m_nextIndex));
 		return m_nextIndex;
 	}
 
+	/// Index from which Create() looks for an index without a value.
 	IndexType m_nextIndex;
 	ContainerType m_container;
-	std::vector<bool> m_validIndex;
+	std::vector<Word_t> m_validBits;
 	std::size_t m_count;
 };
 
@@ -248,6 +386,30 @@ public:
 
 	bool HasIndex(const IndexType& index) { return m_container.find(index) != std::end(m_container); }
 
+	/**
+	 * Moves each value to the index given by \p remap (see \c IndexedContainer::Compact()).
+	 * Values whose index isn't mapped are removed.
+	 */
+	void Remap(const std::vector<IndexType>& remap)
+	{
+		START_PROFILE;
+		ContainerType remapped;
+		remapped.reserve(m_container.size());
+		for (auto& value : m_container)
+		{
+			if (value.first < remap.size() && remap[value.first] != std::numeric_limits<IndexType>::max())
+			{
+				remapped.emplace(remap[value.first], std::move(value.second));
+			}
+		}
+		m_container = std::move(remapped);
+		m_nextIndex = 0;
+		for (const auto& value : m_container)
+		{
+			m_nextIndex = std::max<IndexType>(m_nextIndex, value.first + 1);
+		}
+	}
+
 	std::size_t Count() const { return m_container.size(); }
 
 	iterator begin() { return m_container.begin(); }
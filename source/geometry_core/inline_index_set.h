@@ -0,0 +1,102 @@
+#ifndef PAGODA_GEOMETRY_CORE_INLINE_INDEX_SET_H_
+#define PAGODA_GEOMETRY_CORE_INLINE_INDEX_SET_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace pagoda
+{
+/**
+ * A set of indices that stores up to \p InlineSize indices without allocating memory.
+ *
+ * Indices are kept in a contiguous array, so lookups are linear. This is meant for the
+ * small sets found in mesh adjacency (e.g., the edges leaving a point) where a linear scan
+ * is faster than hashing and avoiding an allocation per set matters.
+ *
+ * The most recently inserted index is iterated first.
+ */
+template<class IndexType, std::size_t InlineSize>
+class InlineIndexSet
+{
+public:
+	using value_type = IndexType;
+	using iterator = const IndexType *;
+	using const_iterator = const IndexType *;
+
+	InlineIndexSet() : m_inline{}, m_size(0) {}
+
+	/**
+	 * Inserts \p index if it is not yet in the set.
+	 */
+	void insert(const IndexType &index)
+	{
+		if (find(index) != end())
+		{
+			return;
+		}
+
+		if (m_size < InlineSize)
+		{
+			std::copy_backward(m_inline.begin(), m_inline.begin() + m_size, m_inline.begin() + m_size + 1);
+			m_inline[0] = index;
+		}
+		else
+		{
+			if (m_size == InlineSize)
+			{
+				m_overflow.assign(m_inline.begin(), m_inline.end());
+			}
+			m_overflow.insert(m_overflow.begin(), index);
+		}
+		++m_size;
+	}
+
+	/**
+	 * Removes \p index from the set. Returns the number of removed indices.
+	 */
+	std::size_t erase(const IndexType &index)
+	{
+		auto iter = std::find(data(), data() + m_size, index);
+		if (iter == data() + m_size)
+		{
+			return 0;
+		}
+
+		if (m_size > InlineSize)
+		{
+			m_overflow.erase(m_overflow.begin() + (iter - data()));
+			if (m_overflow.size() == InlineSize)
+			{
+				std::copy(m_overflow.begin(), m_overflow.end(), m_inline.begin());
+				m_overflow.clear();
+			}
+		}
+		else
+		{
+			auto position = m_inline.begin() + (iter - data());
+			std::copy(position + 1, m_inline.begin() + m_size, position);
+		}
+		--m_size;
+		return 1;
+	}
+
+	const_iterator find(const IndexType &index) const { return std::find(begin(), end(), index); }
+
+	std::size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+
+	const_iterator begin() const { return data(); }
+	const_iterator end() const { return data() + m_size; }
+
+private:
+	const IndexType *data() const { return m_size > InlineSize ? m_overflow.data() : m_inline.data(); }
+
+	std::array<IndexType, InlineSize> m_inline;
+	std::vector<IndexType> m_overflow;
+	uint32_t m_size;
+};  // class InlineIndexSet
+}  // namespace pagoda
+
+#endif
@@ -7,6 +7,8 @@
 #include <boost/qvm/map_vec_mat.hpp>
 #include <boost/qvm/vec_operations.hpp>
 
+#include <algorithm>
+
 namespace pagoda
 {
 Scope::Scope() : m_position{0, 0, 0}, m_size{0, 0, 0}, m_rotation(boost::qvm::diag_mat(Vec3F{1, 1, 1})) {}
@@ -128,4 +130,32 @@ Vec3F Scope::GetCenterPointInLocal() const
 {
 	return 0.5f * (GetLocalPoint(BoxPoints::LowerBottomLeft) + GetLocalPoint(BoxPoints::HigherTopRight));
 }
+
+Scope Scope::Transformed(const Mat3x4F &matrix, const Mat3x3F &rotation) const
+{
+	std::array<Vec3F, 8> boxPoints = GetWorldPoints();
+	for (auto &p : boxPoints)
+	{
+		TransformPoints(matrix, &X(p), &Y(p), &Z(p), 1);
+	}
+
+	const auto xAxis = Vec3F(boost::qvm::col<0>(rotation));
+	const auto yAxis = Vec3F(boost::qvm::col<1>(rotation));
+	const auto zAxis = Vec3F(boost::qvm::col<2>(rotation));
+	const auto p0 = boxPoints[0];
+	Vec3F min{0, 0, 0};
+	Vec3F max{0, 0, 0};
+	for (const auto &p : boxPoints)
+	{
+		const auto diff = p - p0;
+		const Vec3F projection{boost::qvm::dot(xAxis, diff), boost::qvm::dot(yAxis, diff),
+		                       boost::qvm::dot(zAxis, diff)};
+		for (auto i = 0u; i < 3; ++i)
+		{
+			min.a[i] = std::min(min.a[i], projection.a[i]);
+			max.a[i] = std::max(max.a[i], projection.a[i]);
+		}
+	}
+	return Scope(p0 + xAxis * X(min) + yAxis * Y(min) + zAxis * Z(min), max - min, rotation);
+}
 }  // namespace pagoda
@@ -88,6 +88,13 @@ public:
 	Vec3F GetCenterPointInWorld() const;
 	Vec3F GetCenterPointInLocal() const;
 
+	/**
+	 * Returns the scope with \p rotation that bounds this scope's box after being transformed by the affine
+	 * \p matrix. It is the scope of a geometry bounded by this scope, once transformed, as long as \p matrix
+	 * maps the axes of this scope to the axes of \p rotation.
+	 */
+	Scope Transformed(const Mat3x4F &matrix, const Mat3x3F &rotation) const;
+
 	template<class Geometry>
 	static Scope FromGeometryAndConstrainedRotation(const std::shared_ptr<Geometry> geom, const Mat3x3F &rotation)
 	{
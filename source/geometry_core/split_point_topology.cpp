@@ -4,63 +4,84 @@
 
 namespace pagoda
 {
-const SplitPointTopology::Index_t SplitPointTopology::s_invalidIndex =
-    std::numeric_limits<SplitPointTopology::Index_t>::max();
+template<class PointEdges>
+std::size_t SplitPointTopologyBase<PointEdges>::GetFaceCount() const { return m_faces.Count(); }
 
-std::size_t SplitPointTopology::GetFaceCount() const { return m_faces.Count(); }
-std::size_t SplitPointTopology::GetPointCount() const { return m_points.Count(); }
-std::size_t SplitPointTopology::GetSplitPointCount() const { return m_splitPoints.Count(); }
-std::size_t SplitPointTopology::GetEdgeCount() const { return m_edges.Count(); }
+template<class PointEdges>
+std::size_t SplitPointTopologyBase<PointEdges>::GetPointCount() const { return m_points.Count(); }
+
+template<class PointEdges>
+std::size_t SplitPointTopologyBase<PointEdges>::GetSplitPointCount() const { return m_splitPoints.Count(); }
+
+template<class PointEdges>
+std::size_t SplitPointTopologyBase<PointEdges>::GetEdgeCount() const { return m_edges.Count(); }
+
+template<class PointEdges>
+std::size_t SplitPointTopologyBase<PointEdges>::GetMemoryBytes() const
+{
+	return m_points.Count() * sizeof(Point) + m_splitPoints.Count() * sizeof(SplitPoint) +
+	       m_edges.Count() * sizeof(Edge) + m_faces.Count() * sizeof(Face);
+}
 
 /*
  * Operations
  */
-SplitPointTopology::PointHandle SplitPointTopology::GetPoint(const SplitPointHandle &s) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetPoint(const SplitPointHandle &s) const -> PointHandle
 {
 	return PointHandle(m_splitPoints.Get(s).m_point);
 }
 
-SplitPointTopology::EdgeHandle SplitPointTopology::GetInEdge(const SplitPointHandle &s) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetInEdge(const SplitPointHandle &s) const -> EdgeHandle
 {
 	return EdgeHandle(m_splitPoints.Get(s).m_incomingEdge);
 }
 
-SplitPointTopology::EdgeHandle SplitPointTopology::GetOutEdge(const SplitPointHandle &s) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetOutEdge(const SplitPointHandle &s) const -> EdgeHandle
 {
 	return EdgeHandle(m_splitPoints.Get(s).m_outgoingEdge);
 }
 
-SplitPointTopology::FaceHandle SplitPointTopology::GetFace(const SplitPointHandle &s) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetFace(const SplitPointHandle &s) const -> FaceHandle
 {
 	return FaceHandle(m_splitPoints.Get(s).m_face);
 }
 
-SplitPointTopology::SplitPointHandle SplitPointTopology::GetSource(const EdgeHandle &e) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetSource(const EdgeHandle &e) const -> SplitPointHandle
 {
 	return SplitPointHandle(m_edges.Get(e).m_source);
 }
 
-SplitPointTopology::SplitPointHandle SplitPointTopology::GetDestination(const EdgeHandle &e) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetDestination(const EdgeHandle &e) const -> SplitPointHandle
 {
 	return SplitPointHandle(m_edges.Get(e).m_destination);
 }
 
-SplitPointTopology::FaceHandle SplitPointTopology::GetFace(const EdgeHandle &e) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetFace(const EdgeHandle &e) const -> FaceHandle
 {
 	return FaceHandle(m_splitPoints.Get(GetSource(e)).m_face);
 }
 
-SplitPointTopology::SplitPointHandle SplitPointTopology::GetSplitPoint(const FaceHandle &f) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetSplitPoint(const FaceHandle &f) const -> SplitPointHandle
 {
 	return SplitPointHandle(m_faces.Get(f).m_splitPoint);
 }
 
-SplitPointTopology::EdgeHandle SplitPointTopology::GetEdge(const FaceHandle &f) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetEdge(const FaceHandle &f) const -> EdgeHandle
 {
 	return EdgeHandle(GetOutEdge(GetSplitPoint(FaceHandle(f))));
 }
 
-SplitPointTopology::EdgeHandleSet SplitPointTopology::GetOutEdges(const PointHandle &p)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetOutEdges(const PointHandle &p) -> EdgeHandleSet
 {
 	EdgeHandleSet result;
 	const auto &point = m_points.Get(p);
@@ -76,42 +97,48 @@ SplitPointTopology::EdgeHandleSet SplitPointTopology::GetOutEdges(const PointHan
 /*
  * Navigating the topology
  */
-SplitPointTopology::EdgeHandle SplitPointTopology::GetNextEdge(const EdgeHandle &e) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetNextEdge(const EdgeHandle &e) const -> EdgeHandle
 {
 	auto &edge = m_edges.Get(e);
 	auto &nextSplitPoint = m_splitPoints.Get(edge.m_destination);
 	return nextSplitPoint.m_outgoingEdge;
 }
 
-SplitPointTopology::EdgeHandle SplitPointTopology::GetPrevEdge(const EdgeHandle &e) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetPrevEdge(const EdgeHandle &e) const -> EdgeHandle
 {
 	auto &edge = m_edges.Get(e);
 	auto &splitPoint = m_splitPoints.Get(edge.m_source);
 	return splitPoint.m_incomingEdge;
 }
 
-SplitPointTopology::PointHandle SplitPointTopology::GetNextPoint(const PointHandle &p, const EdgeHandle &e) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetNextPoint(const PointHandle &p, const EdgeHandle &e) const -> PointHandle
 {
 	auto &edge = m_edges.Get(e);
 	auto &nextSplitPoint = m_splitPoints.Get(edge.m_destination);
 	return nextSplitPoint.m_point;
 }
 
-SplitPointTopology::PointHandle SplitPointTopology::GetPrevPoint(const PointHandle &p, const EdgeHandle &e) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetPrevPoint(const PointHandle &p, const EdgeHandle &e) const -> PointHandle
 {
 	auto &edge = m_edges.Get(e);
 	auto &splitPoint = m_splitPoints.Get(edge.m_source);
 	return splitPoint.m_point;
 }
 
-SplitPointTopology::SplitPointHandle SplitPointTopology::GetNextSplitPoint(const SplitPointHandle &s) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetNextSplitPoint(const SplitPointHandle &s) const -> SplitPointHandle
 {
 	auto &splitPoint = m_splitPoints.Get(s);
 	auto &edge = m_edges.Get(splitPoint.m_outgoingEdge);
 	return edge.m_destination;
 }
 
-SplitPointTopology::SplitPointHandle SplitPointTopology::GetPrevSplitPoint(const SplitPointHandle &s) const
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetPrevSplitPoint(const SplitPointHandle &s) const -> SplitPointHandle
 {
 	auto &splitPoint = m_splitPoints.Get(s);
 	auto &prevEdge = m_edges.Get(splitPoint.m_incomingEdge);
@@ -122,7 +149,8 @@ SplitPointTopology::SplitPointHandle SplitPointTopology::GetPrevSplitPoint(const
  * Creating the Topology
  */
 
-SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace()
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::CreateFace() -> CreateFaceResult
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Creating a Face with 3 new points");
@@ -139,7 +167,8 @@ SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace()
 	return CreateFace(points, splitPoints, edges);
 }
 
-SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace(const PointHandle &p0)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::CreateFace(const PointHandle &p0) -> CreateFaceResult
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Creating a face with point " << p0.GetIndex() << " and 2 new points");
@@ -155,7 +184,8 @@ SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace(const PointH
 	return CreateFace(points, splitPoints, edges);
 }
 
-SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace(const PointHandle &p0, const PointHandle &p1)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::CreateFace(const PointHandle &p0, const PointHandle &p1) -> CreateFaceResult
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore,
@@ -172,8 +202,9 @@ SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace(const PointH
 	return CreateFace(points, splitPoints, edges);
 }
 
-SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace(const PointHandle &p0, const PointHandle &p1,
-                                                                    const PointHandle &p2)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::CreateFace(const PointHandle &p0, const PointHandle &p1,
+                                                    const PointHandle &p2) -> CreateFaceResult
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore,
@@ -197,9 +228,10 @@ SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace(const PointH
 	return CreateFace(points, splitPoints, edges);
 }
 
-SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace(const PointHandleArray_t<3> &points,
-                                                                    const SplitPointHandleArray_t<3> &splitPoints,
-                                                                    const EdgeHandleArray_t<3> &edges)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::CreateFace(const PointHandleArray_t<3> &points,
+                                                    const SplitPointHandleArray_t<3> &splitPoints,
+                                                    const EdgeHandleArray_t<3> &edges) -> CreateFaceResult
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Creating a face");
@@ -221,7 +253,7 @@ SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace(const PointH
 	}
 #endif
 
-	FaceContainer_t::IndexValuePair face = m_faces.CreateAndGet();
+	typename FaceContainer_t::IndexValuePair face = m_faces.CreateAndGet();
 	LOG_TRACE(GeometryCore, "New Face " << face.m_index);
 
 	// Connect the elements
@@ -243,8 +275,91 @@ SplitPointTopology::CreateFaceResult SplitPointTopology::CreateFace(const PointH
 	return CreateFaceResult(face.m_index, {splitPoints[0], splitPoints[1], splitPoints[2]});
 }
 
-void SplitPointTopology::SetOutgoingEdge(SplitPoint &splitPoint, Edge &edge, const SplitPointHandle &s,
-                                         const EdgeHandle &e)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::CreatePoint() -> PointHandle
+{
+	return m_points.Create();
+}
+
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::CreatePolygon(PointHandle *points, std::size_t pointCount,
+                                                       const SplitPointHandle *splitPoints) -> FaceHandle
+{
+	START_PROFILE;
+	LOG_TRACE(GeometryCore, "Creating a face with " << pointCount << " points");
+	DBG_ASSERT_MSG(pointCount >= 3, "Trying to create a face with less than 3 points");
+
+	// Elements are created in the same order as CreateFace followed by SplitEdge would so that
+	// both produce the same indices.
+	for (auto i = 0u; i < pointCount; ++i)
+	{
+		if (points[i].GetIndex() == s_invalidIndex)
+		{
+			points[i] = m_points.Create();
+		}
+	}
+
+	const Index_t face = m_faces.Create();
+	Index_t firstSplitPoint = s_invalidIndex;
+	Index_t previousEdge = s_invalidIndex;
+	for (auto i = 0u; i < pointCount; ++i)
+	{
+		Index_t splitPointIndex;
+		if (splitPoints == nullptr)
+		{
+			splitPointIndex = m_splitPoints.Create();
+		}
+		else
+		{
+			splitPointIndex = splitPoints[i].GetIndex();
+			DBG_ASSERT_MSG(!m_splitPoints.HasIndex(splitPointIndex), "SplitPoint handle is already in use");
+			m_splitPoints.GetOrCreate(splitPointIndex);
+		}
+		const Index_t edgeIndex = m_edges.Create();
+		auto &splitPoint = m_splitPoints.Get(splitPointIndex);
+		auto &edge = m_edges.Get(edgeIndex);
+
+		splitPoint.m_point = points[i];
+		splitPoint.m_face = face;
+		splitPoint.m_outgoingEdge = edgeIndex;
+		edge.m_source = splitPointIndex;
+		if (i == 0)
+		{
+			firstSplitPoint = splitPointIndex;
+		}
+		else
+		{
+			splitPoint.m_incomingEdge = previousEdge;
+			m_edges.Get(previousEdge).m_destination = splitPointIndex;
+		}
+		m_points.Get(points[i]).m_edges.insert(edgeIndex);
+		previousEdge = edgeIndex;
+	}
+	// Close the loop. The last SplitPoint is the Face's SplitPoint, as when splitting the edges of a triangle.
+	m_splitPoints.Get(firstSplitPoint).m_incomingEdge = previousEdge;
+	m_edges.Get(previousEdge).m_destination = firstSplitPoint;
+	m_faces.Get(face).m_splitPoint = m_edges.Get(previousEdge).m_source;
+
+#ifdef DEBUG
+	LOG_TRACE(GeometryCore, "CreatePolygon: IsValid: " << IsValid());
+#endif
+	return face;
+}
+
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::Reserve(std::size_t points, std::size_t splitPoints, std::size_t edges,
+                                                 std::size_t faces)
+{
+	START_PROFILE;
+	m_points.Reserve(points);
+	m_splitPoints.Reserve(splitPoints);
+	m_edges.Reserve(edges);
+	m_faces.Reserve(faces);
+}
+
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::SetOutgoingEdge(SplitPoint &splitPoint, Edge &edge, const SplitPointHandle &s,
+                                                         const EdgeHandle &e)
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Setting outgoing edge of SplitPoint " << s << " to " << e);
@@ -252,8 +367,9 @@ void SplitPointTopology::SetOutgoingEdge(SplitPoint &splitPoint, Edge &edge, con
 	edge.m_source = s;
 }
 
-void SplitPointTopology::SetIncomingEdge(SplitPoint &splitPoint, Edge &edge, const SplitPointHandle &s,
-                                         const EdgeHandle &e)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::SetIncomingEdge(SplitPoint &splitPoint, Edge &edge, const SplitPointHandle &s,
+                                                         const EdgeHandle &e)
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Setting incoming edge of SplitPoint " << s << " to " << e);
@@ -261,18 +377,23 @@ void SplitPointTopology::SetIncomingEdge(SplitPoint &splitPoint, Edge &edge, con
 	edge.m_destination = s;
 }
 
-void SplitPointTopology::SetSource(Edge &edge, SplitPoint &splitPoint, const EdgeHandle &e, const SplitPointHandle &s)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::SetSource(Edge &edge, SplitPoint &splitPoint, const EdgeHandle &e,
+                                                   const SplitPointHandle &s)
 {
 	SetIncomingEdge(splitPoint, edge, s, e);
 }
 
-void SplitPointTopology::SetDestination(Edge &edge, SplitPoint &splitPoint, const EdgeHandle &e,
-                                        const SplitPointHandle &s)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::SetDestination(Edge &edge, SplitPoint &splitPoint, const EdgeHandle &e,
+                                                        const SplitPointHandle &s)
 {
 	SetOutgoingEdge(splitPoint, edge, s, e);
 }
 
-void SplitPointTopology::SetFace(SplitPoint &splitPoint, Face &face, const SplitPointHandle &s, const FaceHandle &f)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::SetFace(SplitPoint &splitPoint, Face &face, const SplitPointHandle &s,
+                                                 const FaceHandle &f)
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Setting face of SplitPoint " << s << " to " << f);
@@ -280,13 +401,16 @@ void SplitPointTopology::SetFace(SplitPoint &splitPoint, Face &face, const Split
 	face.m_splitPoint = s;
 }
 
-void SplitPointTopology::SetSplitPoint(Face &face, SplitPoint &splitPoint, const FaceHandle &f,
-                                       const SplitPointHandle &s)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::SetSplitPoint(Face &face, SplitPoint &splitPoint, const FaceHandle &f,
+                                                       const SplitPointHandle &s)
 {
 	SetFace(splitPoint, face, s, f);
 }
 
-void SplitPointTopology::SetPoint(SplitPoint &splitPoint, Point &point, const SplitPointHandle &s, const PointHandle &p)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::SetPoint(SplitPoint &splitPoint, Point &point, const SplitPointHandle &s,
+                                                  const PointHandle &p)
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Setting point of SplitPoint " << s << " to " << p);
@@ -294,7 +418,8 @@ void SplitPointTopology::SetPoint(SplitPoint &splitPoint, Point &point, const Sp
 	point.m_edges.insert(splitPoint.m_outgoingEdge);
 }
 
-void SplitPointTopology::AddEdge(const PointHandle &p, const EdgeHandle &e)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::AddEdge(const PointHandle &p, const EdgeHandle &e)
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Adding Edge " << e << " to Point " << p);
@@ -305,7 +430,8 @@ void SplitPointTopology::AddEdge(const PointHandle &p, const EdgeHandle &e)
 /*
  * Modifying the topology
  */
-SplitPointTopology::SplitPointHandle SplitPointTopology::SplitEdge(const EdgeHandle &e)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::SplitEdge(const EdgeHandle &e) -> SplitPointHandle
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Splitting Edge " << e << " with a new Point");
@@ -313,7 +439,8 @@ SplitPointTopology::SplitPointHandle SplitPointTopology::SplitEdge(const EdgeHan
 	return SplitEdge(e, newPoint);
 }
 
-SplitPointTopology::SplitPointHandle SplitPointTopology::SplitEdge(const EdgeHandle &e, const PointHandle &p)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::SplitEdge(const EdgeHandle &e, const PointHandle &p) -> SplitPointHandle
 {
 	/*
 	 *   A----B             A----B
@@ -349,7 +476,8 @@ SplitPointTopology::SplitPointHandle SplitPointTopology::SplitEdge(const EdgeHan
 	return splitPointP;
 }
 
-SplitPointTopology::SplitPointHandle SplitPointTopology::CollapseEdge(const EdgeHandle &e)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::CollapseEdge(const EdgeHandle &e) -> SplitPointHandle
 {
 	/*
 	 *         prevEdge
@@ -394,8 +522,8 @@ SplitPointTopology::SplitPointHandle SplitPointTopology::CollapseEdge(const Edge
 	return splitPointB;
 }
 
-SplitPointTopology::FaceHandle SplitPointTopology::SplitFace(const FaceHandle &f, const EdgeHandle &e0,
-                                                             const EdgeHandle &e1)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::SplitFace(const FaceHandle &f, const EdgeHandle &e0, const EdgeHandle &e1) -> FaceHandle
 {
 	/*
 	 *        e1
@@ -486,14 +614,15 @@ SplitPointTopology::FaceHandle SplitPointTopology::SplitFace(const FaceHandle &f
 /*
  * Deleting parts of the topology.
  */
-void SplitPointTopology::DeleteFace(const FaceHandle &f)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::DeleteFace(const FaceHandle &f)
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Deleting Face " << f);
 
-	PointHandleSet pointsToDelete;
-	SplitPointHandleSet splitPointsToDelete;
-	EdgeHandleSet edgesToDelete;
+	// Each split point and edge of the face is visited once, and a point is only added when its last edge is removed
+	std::vector<Index_t> pointsToDelete;
+	std::vector<std::pair<Index_t, Index_t>> splitPointsAndEdgesToDelete;
 	for (auto iter = FaceSplitPointCirculatorBegin(f); iter; ++iter)
 	{
 		Index_t splitPointIndex = (*iter).GetIndex();
@@ -509,10 +638,9 @@ void SplitPointTopology::DeleteFace(const FaceHandle &f)
 		if (point.m_edges.size() == 0)
 		{
 			LOG_TRACE(GeometryCore, "   Adding to delete list");
-			pointsToDelete.insert(splitPoint.m_point);
+			pointsToDelete.push_back(splitPoint.m_point);
 		}
-		splitPointsToDelete.insert(splitPointIndex);
-		edgesToDelete.insert(splitPoint.m_outgoingEdge);
+		splitPointsAndEdgesToDelete.emplace_back(splitPointIndex, splitPoint.m_outgoingEdge);
 	}
 
 	for (auto &p : pointsToDelete)
@@ -520,15 +648,11 @@ void SplitPointTopology::DeleteFace(const FaceHandle &f)
 		LOG_TRACE(GeometryCore, " Deleting Point " << p);
 		m_points.Delete(p);
 	}
-	for (auto &sp : splitPointsToDelete)
-	{
-		LOG_TRACE(GeometryCore, " Deleting Split Point " << sp);
-		m_splitPoints.Delete(sp);
-	}
-	for (auto &e : edgesToDelete)
+	for (auto &spe : splitPointsAndEdgesToDelete)
 	{
-		LOG_TRACE(GeometryCore, " Deleting Edge " << e);
-		m_edges.Delete(e);
+		LOG_TRACE(GeometryCore, " Deleting Split Point " << spe.first << " and Edge " << spe.second);
+		m_splitPoints.Delete(spe.first);
+		m_edges.Delete(spe.second);
 	}
 
 	m_faces.Delete(f);
@@ -537,7 +661,8 @@ void SplitPointTopology::DeleteFace(const FaceHandle &f)
 #endif
 }
 
-void SplitPointTopology::DeletePoint(const PointHandle &p)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::DeletePoint(const PointHandle &p)
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Deleting Point " << p);
@@ -555,7 +680,8 @@ void SplitPointTopology::DeletePoint(const PointHandle &p)
 #endif
 }
 
-void SplitPointTopology::DeleteEdge(const EdgeHandle &e)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::DeleteEdge(const EdgeHandle &e)
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Deleting Edge " << e);
@@ -567,7 +693,8 @@ void SplitPointTopology::DeleteEdge(const EdgeHandle &e)
 #endif
 }
 
-void SplitPointTopology::DeleteSplitPoint(const SplitPointHandle &s)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::DeleteSplitPoint(const SplitPointHandle &s)
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Deleting Split Point " << s);
@@ -578,36 +705,81 @@ void SplitPointTopology::DeleteSplitPoint(const SplitPointHandle &s)
 #endif
 }
 
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::Compact() -> CompactResult
+{
+	START_PROFILE;
+	LOG_TRACE(GeometryCore, "Compacting topology");
+
+	CompactResult result;
+	result.m_points = m_points.Compact();
+	result.m_splitPoints = m_splitPoints.Compact();
+	result.m_edges = m_edges.Compact();
+	result.m_faces = m_faces.Compact();
+
+	std::vector<Index_t> edges;
+	for (auto p : m_points)
+	{
+		// Re-inserted in reverse so that sets keeping the insertion order iterate in the same order
+		edges.assign(p.m_value.m_edges.begin(), p.m_value.m_edges.end());
+		p.m_value.m_edges = PointEdges();
+		for (auto e = edges.rbegin(); e != edges.rend(); ++e)
+		{
+			p.m_value.m_edges.insert(result.m_edges[*e]);
+		}
+	}
+	for (auto s : m_splitPoints)
+	{
+		s.m_value.m_point = result.m_points[s.m_value.m_point];
+		s.m_value.m_face = result.m_faces[s.m_value.m_face];
+		s.m_value.m_incomingEdge = result.m_edges[s.m_value.m_incomingEdge];
+		s.m_value.m_outgoingEdge = result.m_edges[s.m_value.m_outgoingEdge];
+	}
+	for (auto e : m_edges)
+	{
+		e.m_value.m_source = result.m_splitPoints[e.m_value.m_source];
+		e.m_value.m_destination = result.m_splitPoints[e.m_value.m_destination];
+	}
+	for (auto f : m_faces)
+	{
+		f.m_value.m_splitPoint = result.m_splitPoints[f.m_value.m_splitPoint];
+	}
+
+#ifdef DEBUG
+	IsValid();
+#endif
+
+	return result;
+}
+
 /*
  * Querying the topology.
  */
-SplitPointTopology::EdgeHandleSet SplitPointTopology::GetEdges(const PointHandle &p0, const PointHandle &p1)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetEdges(const PointHandle &p0, const PointHandle &p1) -> EdgeHandleSet
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Getting edges shared by Points " << p0 << " and " << p1);
 	EdgeHandleSet edges;
-	const Point &point0 = m_points.Get(p0);
-	const Point &point1 = m_points.Get(p1);
-
-	std::unordered_set<Index_t> edgesToCheck = point0.m_edges;
-	edgesToCheck.insert(std::begin(point1.m_edges), std::end(point1.m_edges));
-
-	for (const auto &edgeIndex : edgesToCheck)
-	{
-		const Index_t sourcePointIndex = GetPoint(GetSource(edgeIndex));
-		const Index_t destinationPointIndex = GetPoint(GetDestination(edgeIndex));
 
-		if ((sourcePointIndex == p0 && destinationPointIndex == p1) ||
-		    (sourcePointIndex == p1 && destinationPointIndex == p0))
+	// An edge leaves exactly one point, so it is enough to look at the edges leaving each point
+	auto checkEdges = [this, &edges](const PointEdges &pointEdges, const PointHandle &other) {
+		for (const auto &edgeIndex : pointEdges)
 		{
-			edges.insert(EdgeHandle(edgeIndex));
+			if (GetPoint(GetDestination(edgeIndex)) == other)
+			{
+				edges.insert(EdgeHandle(edgeIndex));
+			}
 		}
-	}
+	};
+	checkEdges(m_points.Get(p0).m_edges, p1);
+	checkEdges(m_points.Get(p1).m_edges, p0);
 
 	return edges;
 }
 
-SplitPointTopology::FaceHandleSet SplitPointTopology::GetFaces(const PointHandle &p)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetFaces(const PointHandle &p) -> FaceHandleSet
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Getting Faces adjacent to Point " << p);
@@ -621,7 +793,8 @@ SplitPointTopology::FaceHandleSet SplitPointTopology::GetFaces(const PointHandle
 	return faces;
 }
 
-SplitPointTopology::FaceHandleSet SplitPointTopology::GetFaces(const PointHandle &p0, const PointHandle &p1)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::GetFaces(const PointHandle &p0, const PointHandle &p1) -> FaceHandleSet
 {
 	START_PROFILE;
 	LOG_TRACE(GeometryCore, "Getting Faces shared by Points " << p0 << " and " << p1);
@@ -637,76 +810,94 @@ SplitPointTopology::FaceHandleSet SplitPointTopology::GetFaces(const PointHandle
 	return faces;
 }
 
-SplitPointTopology::PointIterator SplitPointTopology::PointsBegin() { return PointIterator(m_points.begin()); }
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::PointsBegin() -> PointIterator { return PointIterator(m_points.begin()); }
 
-SplitPointTopology::PointIterator SplitPointTopology::PointsEnd() { return PointIterator(m_points.end()); }
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::PointsEnd() -> PointIterator { return PointIterator(m_points.end()); }
 
-SplitPointTopology::SplitPointIterator SplitPointTopology::SplitPointsBegin()
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::SplitPointsBegin() -> SplitPointIterator
 {
 	return SplitPointIterator(m_splitPoints.begin());
 }
 
-SplitPointTopology::SplitPointIterator SplitPointTopology::SplitPointsEnd()
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::SplitPointsEnd() -> SplitPointIterator
 {
 	return SplitPointIterator(m_splitPoints.end());
 }
 
-SplitPointTopology::EdgeIterator SplitPointTopology::EdgesBegin() { return EdgeIterator(m_edges.begin()); }
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::EdgesBegin() -> EdgeIterator { return EdgeIterator(m_edges.begin()); }
 
-SplitPointTopology::EdgeIterator SplitPointTopology::EdgesEnd() { return EdgeIterator(m_edges.end()); }
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::EdgesEnd() -> EdgeIterator { return EdgeIterator(m_edges.end()); }
 
-SplitPointTopology::FaceIterator SplitPointTopology::FacesBegin() { return FaceIterator(m_faces.begin()); }
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::FacesBegin() -> FaceIterator { return FaceIterator(m_faces.begin()); }
 
-SplitPointTopology::FaceIterator SplitPointTopology::FacesEnd() { return FaceIterator(m_faces.end()); }
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::FacesEnd() -> FaceIterator { return FaceIterator(m_faces.end()); }
 
-SplitPointTopology::PointEdgeIterator SplitPointTopology::PointEdgesBegin(const PointHandle &p)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::PointEdgesBegin(const PointHandle &p) -> PointEdgeIterator
 {
 	auto &point = m_points.Get(p);
 	return PointEdgeIterator(point.m_edges.begin());
 }
 
-SplitPointTopology::PointEdgeIterator SplitPointTopology::PointEdgesEnd(const PointHandle &p)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::PointEdgesEnd(const PointHandle &p) -> PointEdgeIterator
 {
 	auto &point = m_points.Get(p);
 	return PointEdgeIterator(point.m_edges.end());
 }
 
-SplitPointTopology::PointSplitPointIterator SplitPointTopology::PointSplitPointBegin(const PointHandle &p)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::PointSplitPointBegin(const PointHandle &p) -> PointSplitPointIterator
 {
 	return PointSplitPointIterator(this, PointEdgesBegin(p));
 }
 
-SplitPointTopology::PointSplitPointIterator SplitPointTopology::PointSplitPointEnd(const PointHandle &p)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::PointSplitPointEnd(const PointHandle &p) -> PointSplitPointIterator
 {
 	return PointSplitPointIterator(this, PointEdgesEnd(p));
 }
 
-SplitPointTopology::PointFaceIterator SplitPointTopology::PointFaceBegin(const PointHandle &p)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::PointFaceBegin(const PointHandle &p) -> PointFaceIterator
 {
 	return PointFaceIterator(this, PointEdgesBegin(p));
 }
 
-SplitPointTopology::PointFaceIterator SplitPointTopology::PointFaceEnd(const PointHandle &p)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::PointFaceEnd(const PointHandle &p) -> PointFaceIterator
 {
 	return PointFaceIterator(this, PointEdgesEnd(p));
 }
 
-SplitPointTopology::FaceEdgeCirculator SplitPointTopology::FaceEdgeCirculatorBegin(const FaceHandle &f)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::FaceEdgeCirculatorBegin(const FaceHandle &f) -> FaceEdgeCirculator
 {
 	return FaceEdgeCirculator(this, f);
 }
 
-SplitPointTopology::FaceSplitPointCirculator SplitPointTopology::FaceSplitPointCirculatorBegin(const FaceHandle &f)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::FaceSplitPointCirculatorBegin(const FaceHandle &f) -> FaceSplitPointCirculator
 {
 	return FaceSplitPointCirculator(this, FaceEdgeCirculatorBegin(f));
 }
 
-SplitPointTopology::FacePointCirculator SplitPointTopology::FacePointCirculatorBegin(const FaceHandle &f)
+template<class PointEdges>
+auto SplitPointTopologyBase<PointEdges>::FacePointCirculatorBegin(const FaceHandle &f) -> FacePointCirculator
 {
 	return FacePointCirculator(this, FaceEdgeCirculatorBegin(f));
 }
 
-bool SplitPointTopology::IsValid()
+template<class PointEdges>
+bool SplitPointTopologyBase<PointEdges>::IsValid()
 {
 	bool isValid = true;
 	for (const auto &p : m_points)
@@ -733,7 +924,8 @@ bool SplitPointTopology::IsValid()
 	return isValid;
 }
 
-bool SplitPointTopology::ValidatePoint(const Index_t &p)
+template<class PointEdges>
+bool SplitPointTopologyBase<PointEdges>::ValidatePoint(const Index_t &p)
 {
 	if (!m_points.HasIndex(p))
 	{
@@ -762,7 +954,8 @@ bool SplitPointTopology::ValidatePoint(const Index_t &p)
 	return isValid;
 }
 
-bool SplitPointTopology::ValidateSplitPoint(const Index_t &s)
+template<class PointEdges>
+bool SplitPointTopologyBase<PointEdges>::ValidateSplitPoint(const Index_t &s)
 {
 	if (!m_splitPoints.HasIndex(s))
 	{
@@ -818,7 +1011,8 @@ bool SplitPointTopology::ValidateSplitPoint(const Index_t &s)
 	return isValid;
 }
 
-bool SplitPointTopology::ValidateEdge(const Index_t &e)
+template<class PointEdges>
+bool SplitPointTopologyBase<PointEdges>::ValidateEdge(const Index_t &e)
 {
 	if (!m_edges.HasIndex(e))
 	{
@@ -868,7 +1062,8 @@ bool SplitPointTopology::ValidateEdge(const Index_t &e)
 	return isValid;
 }
 
-bool SplitPointTopology::ValidateFace(const Index_t &f)
+template<class PointEdges>
+bool SplitPointTopologyBase<PointEdges>::ValidateFace(const Index_t &f)
 {
 	if (!m_faces.HasIndex(f))
 	{
@@ -921,7 +1116,8 @@ bool SplitPointTopology::ValidateFace(const Index_t &f)
 	return isValid;
 }
 
-void SplitPointTopology::DumpToStream(std::ostream &outStream)
+template<class PointEdges>
+void SplitPointTopologyBase<PointEdges>::DumpToStream(std::ostream &outStream)
 {
 	outStream << "IsValid: " << (IsValid() ? "true" : "false") << std::endl;
 	outStream << "Points:" << std::endl;
@@ -966,4 +1162,6 @@ void SplitPointTopology::DumpToStream(std::ostream &outStream)
 	}
 	outStream << std::endl;
 }
+template class SplitPointTopologyBase<std::unordered_set<uint32_t>>;
+template class SplitPointTopologyBase<InlineIndexSet<uint32_t, 6>>;
 }  // namespace pagoda
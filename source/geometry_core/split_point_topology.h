@@ -2,21 +2,29 @@
 #define PAGODA_SPLIT_POINT_TOPOLOGY_H_
 
 #include "indexed_container.h"
+#include "inline_index_set.h"
 
 #include <array>
 #include <iostream>
+#include <limits>
 #include <unordered_set>
+#include <vector>
 
 namespace pagoda
 {
 /**
  * Implements a Split Point Topology to be used by \c Geometry.
+ *
+ * \p PointEdges is the set type used to store the edges that leave each \c Point.
+ * See \c SplitPointTopology and \c CompactSplitPointTopology.
  */
-class SplitPointTopology
+template<class PointEdges>
+class SplitPointTopologyBase
 {
 public:
-	using Index_t = uint32_t;             ///< Type used by indices.
-	static const Index_t s_invalidIndex;  ///< Indicate an invalid index.
+	using Index_t = uint32_t;  ///< Type used by indices.
+	/// Indicate an invalid index.
+	static constexpr Index_t s_invalidIndex = std::numeric_limits<Index_t>::max();
 
 private:
 	/**
@@ -46,7 +54,7 @@ private:
 	 */
 	struct Point
 	{
-		std::unordered_set<Index_t> m_edges;  ///< Contains a set of edges that leave the point.
+		PointEdges m_edges;  ///< Contains a set of edges that leave the point.
 	};
 
 	/**
@@ -107,6 +115,9 @@ public:
 
 		bool operator==(const PointHandle &p) const { return m_index == p.m_index; }
 		bool operator!=(const PointHandle &p) const { return m_index != p.m_index; }
+
+	protected:
+		using Handle::m_index;
 	};
 
 	/**
@@ -123,6 +134,9 @@ public:
 
 		bool operator==(const SplitPointHandle &s) const { return m_index == s.m_index; }
 		bool operator!=(const SplitPointHandle &s) const { return m_index != s.m_index; }
+
+	protected:
+		using Handle::m_index;
 	};
 
 	/**
@@ -139,6 +153,9 @@ public:
 
 		bool operator==(const EdgeHandle &e) const { return m_index == e.m_index; }
 		bool operator!=(const EdgeHandle &e) const { return m_index != e.m_index; }
+
+	protected:
+		using Handle::m_index;
 	};
 
 	/**
@@ -155,6 +172,9 @@ public:
 
 		bool operator==(const FaceHandle &f) const { return m_index == f.m_index; }
 		bool operator!=(const FaceHandle &f) const { return m_index != f.m_index; }
+
+	protected:
+		using Handle::m_index;
 	};
 
 	/// Set of \c PointHandle.
@@ -170,6 +190,10 @@ public:
 	std::size_t GetPointCount() const;
 	std::size_t GetSplitPointCount() const;
 	std::size_t GetEdgeCount() const;
+	/**
+	 * Returns an estimate of the memory used by the points, split points, edges and faces.
+	 */
+	std::size_t GetMemoryBytes() const;
 
 	/*
 	 * Operations
@@ -286,6 +310,28 @@ public:
 	 * If any of the points doesn't exist, it is created.
 	 */
 	CreateFaceResult CreateFace(const PointHandle &p0, const PointHandle &p1, const PointHandle &p2);
+	/**
+	 * Creates a \c Point that doesn't belong to any \c Face yet, to be used in CreatePolygon().
+	 * Allows choosing the order of the \c Point independently of the order of the faces.
+	 */
+	PointHandle CreatePoint();
+	/**
+	 * Creates a \c Face with the \p pointCount \c Point in \p points, connecting all of its
+	 * \c SplitPoint and \c Edge directly instead of splitting the edges of a triangle.
+	 * Entries of \p points set to \c s_invalidIndex are created and their handles written back to \p points.
+	 *
+	 * The resulting \c Face is identical to creating a triangle with the first three \c Point and
+	 * splitting its last \c Edge with each of the remaining ones.
+	 *
+	 * If \p splitPoints is given, the \c SplitPoint of each \c Point is created with the handle in
+	 * \p splitPoints instead of the next free one. These handles must not be in use.
+	 */
+	FaceHandle CreatePolygon(PointHandle *points, std::size_t pointCount, const SplitPointHandle *splitPoints = nullptr);
+	/**
+	 * Allocates space for the given number of elements on top of the existing ones, avoiding reallocations
+	 * when building large topologies.
+	 */
+	void Reserve(std::size_t points, std::size_t splitPoints, std::size_t edges, std::size_t faces);
 
 	/*
 	 * Modifying the topology
@@ -331,6 +377,23 @@ public:
 	 */
 	void DeleteSplitPoint(const SplitPointHandle &s);
 
+	/**
+	 * Tables mapping the indices before a call to \c Compact() to the new indices.
+	 * Indices of deleted elements are mapped to \c s_invalidIndex.
+	 */
+	struct CompactResult
+	{
+		std::vector<Index_t> m_points;
+		std::vector<Index_t> m_splitPoints;
+		std::vector<Index_t> m_edges;
+		std::vector<Index_t> m_faces;
+	};
+	/**
+	 * Renumbers all elements, removing the gaps left by deleted elements while keeping their relative order.
+	 * All existing handles are invalidated.
+	 */
+	CompactResult Compact();
+
 	/*
 	 * Querying the topology.
 	 */
@@ -402,7 +465,7 @@ public:
 	class PointEdgeIterator
 	{
 	public:
-		PointEdgeIterator(const std::unordered_set<Index_t>::iterator &iter) : m_currentIterator(iter) {}
+		PointEdgeIterator(const typename PointEdges::const_iterator &iter) : m_currentIterator(iter) {}
 
 		EdgeHandle operator*() { return EdgeHandle(*m_currentIterator); }
 		EdgeHandle operator->() { return EdgeHandle(*m_currentIterator); }
@@ -423,7 +486,7 @@ public:
 		bool operator!=(const PointEdgeIterator &other) { return m_currentIterator != other.m_currentIterator; }
 
 	private:
-		std::unordered_set<Index_t>::iterator m_currentIterator;
+		typename PointEdges::const_iterator m_currentIterator;
 	};
 
 	PointEdgeIterator PointEdgesBegin(const PointHandle &p);
@@ -432,7 +495,7 @@ public:
 	class PointSplitPointIterator
 	{
 	public:
-		PointSplitPointIterator(const SplitPointTopology *topology, const PointEdgeIterator &pointEdgeIterator)
+		PointSplitPointIterator(const SplitPointTopologyBase *topology, const PointEdgeIterator &pointEdgeIterator)
 		    : m_topology(topology), m_currentIterator(pointEdgeIterator)
 		{
 		}
@@ -456,7 +519,7 @@ public:
 		bool operator!=(const PointSplitPointIterator &other) { return m_currentIterator != other.m_currentIterator; }
 
 	private:
-		const SplitPointTopology *m_topology;
+		const SplitPointTopologyBase *m_topology;
 		PointEdgeIterator m_currentIterator;
 	};
 
@@ -466,7 +529,7 @@ public:
 	class PointFaceIterator
 	{
 	public:
-		PointFaceIterator(const SplitPointTopology *topology, const PointEdgeIterator &pointEdgeIterator)
+		PointFaceIterator(const SplitPointTopologyBase *topology, const PointEdgeIterator &pointEdgeIterator)
 		    : m_topology(topology), m_currentIterator(pointEdgeIterator)
 		{
 		}
@@ -490,7 +553,7 @@ public:
 		bool operator!=(const PointFaceIterator &other) { return m_currentIterator != other.m_currentIterator; }
 
 	private:
-		const SplitPointTopology *m_topology;
+		const SplitPointTopologyBase *m_topology;
 		PointEdgeIterator m_currentIterator;
 	};
 
@@ -500,7 +563,7 @@ public:
 	class FaceEdgeCirculator
 	{
 	public:
-		FaceEdgeCirculator(const SplitPointTopology *topology, const FaceHandle &faceHandle)
+		FaceEdgeCirculator(const SplitPointTopologyBase *topology, const FaceHandle &faceHandle)
 		    : m_topology(topology),
 		      m_currentEdge(m_topology->GetEdge(faceHandle)),
 		      m_lastEdge(m_currentEdge),
@@ -532,7 +595,7 @@ public:
 		bool operator!=(const FaceEdgeCirculator &other) { return m_currentEdge != other.m_currentEdge; }
 
 	private:
-		const SplitPointTopology *m_topology;
+		const SplitPointTopologyBase *m_topology;
 		EdgeHandle m_currentEdge;
 		EdgeHandle m_lastEdge;
 		bool m_initialPosition;
@@ -543,7 +606,7 @@ public:
 	class FaceSplitPointCirculator
 	{
 	public:
-		FaceSplitPointCirculator(const SplitPointTopology *topology, const FaceEdgeCirculator &circulator)
+		FaceSplitPointCirculator(const SplitPointTopologyBase *topology, const FaceEdgeCirculator &circulator)
 		    : m_topology(topology), m_currentCirculator(circulator)
 		{
 		}
@@ -576,7 +639,7 @@ public:
 		}
 
 	private:
-		const SplitPointTopology *m_topology;
+		const SplitPointTopologyBase *m_topology;
 		FaceEdgeCirculator m_currentCirculator;
 	};
 
@@ -585,7 +648,7 @@ public:
 	class FacePointCirculator
 	{
 	public:
-		FacePointCirculator(const SplitPointTopology *topology, const FaceEdgeCirculator &circulator)
+		FacePointCirculator(const SplitPointTopologyBase *topology, const FaceEdgeCirculator &circulator)
 		    : m_topology(topology), m_currentCirculator(circulator)
 		{
 		}
@@ -618,7 +681,7 @@ public:
 		bool operator!=(const FacePointCirculator &other) { return m_currentCirculator != other.m_currentCirculator; }
 
 	private:
-		const SplitPointTopology *m_topology;
+		const SplitPointTopologyBase *m_topology;
 		FaceEdgeCirculator m_currentCirculator;
 	};
 
@@ -628,13 +691,13 @@ public:
 
 private:
 	template<int size>
-	using IndexPointPairArray_t = std::array<PointContainer_t::IndexValuePair, size>;
+	using IndexPointPairArray_t = std::array<typename PointContainer_t::IndexValuePair, size>;
 	template<int size>
-	using IndexSplitPointPairArray_t = std::array<SplitPointContainer_t::IndexValuePair, size>;
+	using IndexSplitPointPairArray_t = std::array<typename SplitPointContainer_t::IndexValuePair, size>;
 	template<int size>
-	using IndexEdgePairArray_t = std::array<EdgeContainer_t::IndexValuePair, size>;
+	using IndexEdgePairArray_t = std::array<typename EdgeContainer_t::IndexValuePair, size>;
 	template<int size>
-	using IndexFacePairArray_t = std::array<FaceContainer_t::IndexValuePair, size>;
+	using IndexFacePairArray_t = std::array<typename FaceContainer_t::IndexValuePair, size>;
 	template<int size>
 	using PointHandleArray_t = std::array<PointHandle, size>;
 	template<int size>
@@ -667,6 +730,17 @@ private:
 	FaceContainer_t m_faces;
 };
 
+/// \c SplitPointTopologyBase storing the edges of each \c Point in a hash set.
+using SplitPointTopology = SplitPointTopologyBase<std::unordered_set<uint32_t>>;
+/**
+ * \c SplitPointTopologyBase storing the edges of each \c Point in a small inline array.
+ * Points with up to 6 edges don't allocate memory, making it more compact than \c SplitPointTopology
+ * for large meshes.
+ */
+using CompactSplitPointTopology = SplitPointTopologyBase<InlineIndexSet<uint32_t, 6>>;
+
+extern template class SplitPointTopologyBase<std::unordered_set<uint32_t>>;
+extern template class SplitPointTopologyBase<InlineIndexSet<uint32_t, 6>>;
 }  // namespace pagoda
 
 #endif
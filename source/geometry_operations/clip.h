@@ -7,6 +7,10 @@
 
 #include "geometry_core/geometry_builder.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 namespace pagoda
 {
 template<class G>
@@ -27,49 +31,78 @@ public:
 
 		*front = *geometryIn;
 
-		CheckPointsSide(front);
-		SplitEdges(front);
+		// The faces behind the plane are moved to the back geometry, built in one go
+		std::vector<typename Geometry::PositionType> backPositions;
+		std::vector<Index_t> backIndices;
+		std::vector<uint32_t> backFaceSizes;
+		std::vector<Index_t> pointsToBackIndex;
+
+		ClipInPlace(front, [&](const typename Geometry::FaceHandle &face) {
+			uint32_t faceSize = 0;
+			for (auto fpCirc = front->FacePointCirculatorBegin(face); fpCirc; ++fpCirc)
+			{
+				const Index_t point = *fpCirc;
+				if (point >= pointsToBackIndex.size())
+				{
+					pointsToBackIndex.resize(point + 1, s_invalidIndex);
+				}
+				if (pointsToBackIndex[point] == s_invalidIndex)
+				{
+					pointsToBackIndex[point] = static_cast<Index_t>(backPositions.size());
+					backPositions.push_back(front->GetPosition(point));
+				}
+
+				backIndices.push_back(pointsToBackIndex[point]);
+				++faceSize;
+			}
+			backFaceSizes.push_back(faceSize);
+		});
+		// The faces deleted by ClipInPlace are only reclaimed when compacting
+		front->Compact();
+		BulkGeometryBuilderT<Geometry>(back).Build(backPositions, backIndices, backFaceSizes);
+	}
 
-		auto facesEnd = front->FacesEnd();
-		for (auto fIter = front->FacesBegin(); fIter != facesEnd; ++fIter)
+	/**
+	 * Clips \p geometry, keeping only the faces in front of the plane.
+	 *
+	 * The faces behind the plane are passed to \p backFace, in order, before they are deleted, so that
+	 * callers can collect them without the copy of the geometry done by Execute().
+	 * The deleted faces keep their memory until \p geometry is compacted, which is left to the caller so that
+	 * geometries clipped several times are only compacted once.
+	 */
+	template<class BackFaceCallback>
+	void ClipInPlace(GeometryPtr geometry, BackFaceCallback &&backFace)
+	{
+		START_PROFILE;
+
+		CheckPointsSide(geometry);
+		SplitEdges(geometry);
+
+		auto facesEnd = geometry->FacesEnd();
+		for (auto fIter = geometry->FacesBegin(); fIter != facesEnd; ++fIter)
 		{
-			ClipFace(front, *fIter);
+			ClipFace(geometry, *fIter);
 		}
 
-		GeometryBuilderT<Geometry> builder(back);
-		std::map<Index_t, Index_t> pointsToBuilderIndex;
-
-		std::set<Index_t> facesToDelete;
-		for (auto fIter = front->FacesBegin(); fIter != front->FacesEnd(); ++fIter)
+		std::vector<Index_t> facesToDelete;
+		for (auto fIter = geometry->FacesBegin(); fIter != geometry->FacesEnd(); ++fIter)
 		{
-			if (m_faceSide[*fIter] == Plane<float>::PlaneSide::Back)
+			if (GetFaceSide(*fIter) == Plane<float>::PlaneSide::Back)
 			{
 				LOG_TRACE(GeometryOperations, "Face " << *fIter << " is behind the plane");
-				facesToDelete.insert(*fIter);
-
-				auto faceBuilder = builder.StartFace();
-				for (auto fpCirc = front->FacePointCirculatorBegin(*fIter); fpCirc; ++fpCirc)
-				{
-					auto mapIter = pointsToBuilderIndex.find(*fpCirc);
-					if (mapIter == std::end(pointsToBuilderIndex))
-					{
-						mapIter =
-						    pointsToBuilderIndex.emplace(*fpCirc, builder.AddPoint(front->GetPosition(*fpCirc))).first;
-					}
-
-					faceBuilder.AddIndex(mapIter->second);
-				}
-				faceBuilder.CloseFace();
+				facesToDelete.push_back(*fIter);
+				backFace(typename Geometry::FaceHandle(*fIter));
 			}
 		}
+
 		for (const auto &f : facesToDelete)
 		{
-			front->DeleteFace(f);
+			geometry->DeleteFace(f);
 		}
 	}
 
 private:
-	void ClipFace(GeometryPtr geometry, const SplitPointTopology::FaceHandle &face)
+	void ClipFace(GeometryPtr geometry, const typename Geometry::FaceHandle &face)
 	{
 		START_PROFILE;
 
@@ -87,7 +120,7 @@ private:
 
 		for (auto feIter = geometry->FaceEdgeCirculatorBegin(face); feIter; ++feIter)
 		{
-			if (m_newEdges.find(*feIter) != std::end(m_newEdges))
+			if (IsNewEdge(*feIter))
 			{
 				if (state == 0)
 				{
@@ -109,7 +142,7 @@ private:
 			          "Splitting face " << face << " from edge " << std::get<0>(e) << " to edge " << std::get<1>(e));
 			auto newFace = geometry->SplitFace(face, std::get<0>(e), std::get<1>(e));
 			auto faceSide = CheckFaceSide(geometry, newFace);
-			m_faceSide[newFace] = faceSide;
+			SetFaceSide(newFace, faceSide);
 
 #ifdef DEBUG
 			for (const auto &f : {face, newFace})
@@ -124,15 +157,15 @@ private:
 
 			if (faceSide == Plane<float>::PlaneSide::Front)
 			{
-				m_faceSide[face] = Plane<float>::PlaneSide::Back;
+				SetFaceSide(face, Plane<float>::PlaneSide::Back);
 			}
 			else if (faceSide == Plane<float>::PlaneSide::Back)
 			{
-				m_faceSide[face] = Plane<float>::PlaneSide::Front;
+				SetFaceSide(face, Plane<float>::PlaneSide::Front);
 			}
 			else  // Contained
 			{
-				m_faceSide[face] = Plane<float>::PlaneSide::Front;
+				SetFaceSide(face, Plane<float>::PlaneSide::Front);
 			}
 		}
 	}
@@ -153,26 +186,57 @@ private:
 		return planeSide;
 	}
 
+	/**
+	 * Classifies all points against the plane.
+	 * The positions are gathered in one array per coordinate so that they are classified in a single
+	 * vectorized pass, and the sides are kept in an array indexed by point.
+	 */
 	void CheckPointsSide(GeometryPtr geometry)
 	{
 		START_PROFILE;
 
+		std::vector<float> x, y, z;
+		x.reserve(geometry->GetPointCount());
+		y.reserve(geometry->GetPointCount());
+		z.reserve(geometry->GetPointCount());
 		auto pointsEnd = geometry->PointsEnd();
 		for (auto pIter = geometry->PointsBegin(); pIter != pointsEnd; ++pIter)
 		{
-			auto pos = geometry->GetPosition(*pIter);
-			auto planeSide = m_plane.GetPlaneSide(pos);
-			m_pointsSide[*pIter] = planeSide;
-			LOG_TRACE(GeometryOperations, "Point " << *pIter << " " << pos << " is " << to_string<float>(planeSide)
-			                                       << " Plane" << to_string<float>(planeSide).c_str());
+			const Index_t point = *pIter;
+			if (point >= x.size())
+			{
+				x.resize(point + 1, 0);
+				y.resize(point + 1, 0);
+				z.resize(point + 1, 0);
+			}
+			const auto pos = geometry->GetPosition(point);
+			x[point] = boost::qvm::X(pos);
+			y[point] = boost::qvm::Y(pos);
+			z[point] = boost::qvm::Z(pos);
 		}
+
+		m_pointsSide.resize(x.size());
+		m_plane.GetPlaneSides(x.data(), y.data(), z.data(), x.size(), m_pointsSide.data());
+
+#ifdef DEBUG
+		for (auto pIter = geometry->PointsBegin(); pIter != pointsEnd; ++pIter)
+		{
+			LOG_TRACE(GeometryOperations, "Point " << *pIter << " " << geometry->GetPosition(*pIter) << " is "
+			                                       << to_string<float>(m_pointsSide[*pIter]));
+		}
+#endif
 	}
 
+	/**
+	 * Splits all the edges crossing the plane at their intersection with it.
+	 */
 	void SplitEdges(GeometryPtr geometry)
 	{
 		START_PROFILE;
 
-		std::map<Index_t, typename Geometry::PositionType> edgesToSplit;
+		// The edges between the same two points are split at the same position, the one found from the
+		// last of them, so that the split points of adjacent faces match
+		std::vector<std::pair<Index_t, typename Geometry::PositionType>> edgesToSplit;
 
 		auto edgesEnd = geometry->EdgesEnd();
 		for (auto eIter = geometry->EdgesBegin(); eIter != edgesEnd; ++eIter)
@@ -198,26 +262,32 @@ private:
 				LOG_TRACE(GeometryOperations,
 				          " Intersection with plane: " << to_string(edgeIntersection.m_intersection));
 
-				auto edgesBetweenPoints = geometry->GetEdges(sourcePoint, destPoint);
-				for (const auto &e : edgesBetweenPoints)
+				for (const auto &e : geometry->GetEdges(sourcePoint, destPoint))
 				{
-					edgesToSplit[e] = edgeIntersection.m_intersection;
+					edgesToSplit.emplace_back(e, edgeIntersection.m_intersection);
 				}
 			}
 			else if (m_pointsSide[sourcePoint] == Plane<float>::PlaneSide::Back)
 			{
 				// It's a face behind the plane
-				m_faceSide[geometry->GetFace(*eIter)] = Plane<float>::PlaneSide::Back;
+				SetFaceSide(geometry->GetFace(*eIter), Plane<float>::PlaneSide::Back);
 			}
 		}
 
-		for (const auto &e : edgesToSplit)
+		// Edges are split in ascending order, each with the last position found for it
+		std::stable_sort(edgesToSplit.begin(), edgesToSplit.end(),
+		                 [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+		for (auto i = 0u; i < edgesToSplit.size(); ++i)
 		{
-			auto splitPoint = geometry->SplitEdge(e.first);
+			if (i + 1 < edgesToSplit.size() && edgesToSplit[i + 1].first == edgesToSplit[i].first)
+			{
+				continue;
+			}
+			auto splitPoint = geometry->SplitEdge(edgesToSplit[i].first);
 			auto newEdge = geometry->GetOutEdge(splitPoint);
-			m_newEdges.insert(newEdge);
+			SetNewEdge(newEdge);
 			auto newPoint = geometry->GetPoint(splitPoint);
-			geometry->SetPosition(newPoint, e.second);
+			geometry->SetPosition(newPoint, edgesToSplit[i].second);
 			LOG_TRACE(GeometryOperations, "Edge " << newEdge << " is a new edge");
 		}
 	}
@@ -231,9 +301,42 @@ private:
 		       p2Side == Plane<float>::PlaneSide::Contained;
 	}
 
-	std::set<Index_t> m_newEdges;
-	std::map<Index_t, Plane<float>::PlaneSide> m_pointsSide;
-	std::map<Index_t, Plane<float>::PlaneSide> m_faceSide;
+	/**
+	 * Returns the side of \p face, which is Front unless set otherwise.
+	 */
+	Plane<float>::PlaneSide GetFaceSide(const Index_t &face) const
+	{
+		return face < m_faceSide.size() ? m_faceSide[face] : Plane<float>::PlaneSide::Front;
+	}
+
+	void SetFaceSide(const Index_t &face, Plane<float>::PlaneSide side)
+	{
+		if (face >= m_faceSide.size())
+		{
+			m_faceSide.resize(face + 1, Plane<float>::PlaneSide::Front);
+		}
+		m_faceSide[face] = side;
+	}
+
+	bool IsNewEdge(const Index_t &edge) const { return edge < m_newEdges.size() && m_newEdges[edge]; }
+
+	void SetNewEdge(const Index_t &edge)
+	{
+		if (edge >= m_newEdges.size())
+		{
+			m_newEdges.resize(edge + 1, false);
+		}
+		m_newEdges[edge] = true;
+	}
+
+	static constexpr Index_t s_invalidIndex = std::numeric_limits<Index_t>::max();
+
+	/// Whether each edge was created by splitting an edge crossing the plane, by edge index.
+	std::vector<bool> m_newEdges;
+	/// Side of the plane of each point in the input geometry, by point index.
+	std::vector<Plane<float>::PlaneSide> m_pointsSide;
+	/// Side of the plane of each face, by face index.
+	std::vector<Plane<float>::PlaneSide> m_faceSide;
 	Plane<float> m_plane;
 };
 }  // namespace pagoda
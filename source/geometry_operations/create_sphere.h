@@ -1,10 +1,13 @@
 #pragma once
 
 #include <common/logger.h>
+#include <geometry_core/geometry_builder.h>
 #include <math_lib/math_utils.h>
 
 #include <boost/qvm/vec_operations.hpp>
 
+#include <vector>
+
 namespace pagoda
 {
 template<class G>
@@ -41,55 +44,57 @@ public:
 		float omega = 0;
 		float theta = stackIncrementAngle;
 
-		std::vector<typename Geometry::Index_t> points;
-		points.reserve(2 + m_slices * m_stacks);
-
-		GeometryBuilderT<Geometry> builder(geometryOut);
+		using Index_t = typename Geometry::Index_t;
+		const uint32_t pointCount = m_slices * m_stacks;
+		const uint32_t topIndex = pointCount;
+		const uint32_t bottomIndex = pointCount + 1;
 
+		std::vector<typename Geometry::PositionType> positions;
+		positions.reserve(pointCount + 2);
 		for (auto st = 0u; st < m_stacks; ++st, theta += stackIncrementAngle)
 		{
 			for (auto sl = 0u; sl < m_slices; ++sl, omega += sliceIncrementAngle)
 			{
 				auto sinTheta = std::sin(theta);
-				points.push_back(builder.AddPoint(
-				    m_radius * Vec3F{sinTheta * std::cos(omega), sinTheta * std::sin(omega), std::cos(theta)}));
+				positions.push_back(
+				    m_radius * Vec3F{sinTheta * std::cos(omega), sinTheta * std::sin(omega), std::cos(theta)});
 			}
 		}
-		auto topIndex = builder.AddPoint(top);
-		auto bottomIndex = builder.AddPoint(bottom);
+		positions.push_back(top);
+		positions.push_back(bottom);
+
+		std::vector<Index_t> indices;
+		std::vector<uint32_t> faceSizes;
+		indices.reserve(4 * (m_stacks - 1) * m_slices + 6 * m_slices);
+		faceSizes.reserve((m_stacks - 1) * m_slices + 2 * m_slices);
 
 		for (auto st = 0u; st < m_stacks - 1; ++st)
 		{
 			for (auto sl = 0u; sl < m_slices; ++sl)
 			{
-				auto p1 = sl + st * m_slices;
-				auto p2 = sl + (st + 1) * m_slices;
-				auto p3 = (sl + 1) % m_slices + (st + 1) * m_slices;
-				auto p4 = (sl + 1) % m_slices + st * m_slices;
-
-				auto face = builder.StartFace(4);
-				face.AddIndex(points[p1]);
-				face.AddIndex(points[p2]);
-				face.AddIndex(points[p3]);
-				face.AddIndex(points[p4]);
-				face.CloseFace();
+				indices.push_back(sl + st * m_slices);
+				indices.push_back(sl + (st + 1) * m_slices);
+				indices.push_back((sl + 1) % m_slices + (st + 1) * m_slices);
+				indices.push_back((sl + 1) % m_slices + st * m_slices);
+				faceSizes.push_back(4);
 			}
 		}
 
 		for (auto sl = 0u; sl < m_slices; ++sl)
 		{
-			auto topFace = builder.StartFace(3);
-			topFace.AddIndex(topIndex);
-			topFace.AddIndex(points[sl]);
-			topFace.AddIndex(points[(sl + 1) % m_slices]);
-			topFace.CloseFace();
-
-			auto bottomFace = builder.StartFace(3);
-			bottomFace.AddIndex(points[points.size() - (m_slices - sl)]);
-			bottomFace.AddIndex(bottomIndex);
-			bottomFace.AddIndex(points[points.size() - (m_slices - (sl + 1) % m_slices)]);
-			bottomFace.CloseFace();
+			indices.push_back(topIndex);
+			indices.push_back(sl);
+			indices.push_back((sl + 1) % m_slices);
+			faceSizes.push_back(3);
+
+			indices.push_back(pointCount - (m_slices - sl));
+			indices.push_back(bottomIndex);
+			indices.push_back(pointCount - (m_slices - (sl + 1) % m_slices));
+			faceSizes.push_back(3);
 		}
+
+		BulkGeometryBuilderT<Geometry> builder(geometryOut);
+		builder.Build(positions, indices, faceSizes);
 	}
 
 private:
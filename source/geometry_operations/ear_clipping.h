@@ -6,6 +6,10 @@
 
 #include <math_lib/math_utils.h>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include <vector>
 
 namespace pagoda
@@ -18,19 +22,6 @@ private:
 	using GeometryPtr = std::shared_ptr<Geometry>;
 	using Index_t = typename Geometry::Index_t;
 
-	struct VertexLinkedListNode
-	{
-		VertexLinkedListNode(const Index_t splitPoint, const Vec3F &position)
-		    : m_splitPoint(splitPoint), m_position(position)
-		{
-		}
-
-		Index_t m_splitPoint;
-		Vec3F m_position;
-		VertexLinkedListNode *m_next;
-		VertexLinkedListNode *m_prev;
-	};
-
 	struct Triangle
 	{
 		Triangle(typename Geometry::PointHandle p0, typename Geometry::PointHandle p1,
@@ -44,14 +35,232 @@ private:
 		typename Geometry::PointHandle m_p2;
 	};
 
-	struct Sorter
+	/**
+	 * The vertices of the face being triangulated, indexed by their position in the face.
+	 * The vertices not yet clipped form a circular list through m_next and m_prev.
+	 */
+	struct Polygon
+	{
+		void Clear()
+		{
+			m_splitPoints.clear();
+			m_x.clear();
+			m_y.clear();
+			m_z.clear();
+			m_next.clear();
+			m_prev.clear();
+			m_isReflex.clear();
+			m_isConvex.clear();
+			m_isEarTip.clear();
+		}
+
+		Vec3F GetPosition(uint32_t v) const { return Vec3F{m_x[v], m_y[v], m_z[v]}; }
+
+		std::vector<Index_t> m_splitPoints;
+		std::vector<float> m_x;
+		std::vector<float> m_y;
+		std::vector<float> m_z;
+		std::vector<uint32_t> m_next;
+		std::vector<uint32_t> m_prev;
+		std::vector<uint8_t> m_isReflex;
+		std::vector<uint8_t> m_isConvex;
+		std::vector<uint8_t> m_isEarTip;
+	};
+
+	/**
+	 * Uniform grid over the reflex vertices, projected once to the face plane, so that testing whether a
+	 * vertex is an ear only looks at the reflex vertices around its triangle.
+	 */
+	class ReflexGrid
+	{
+	public:
+		void Build(const Polygon &polygon, const Vec3F &normal)
+		{
+			// Projects to the coordinate plane closest to the face plane
+			const float absNormal[] = {std::abs(X(normal)), std::abs(Y(normal)), std::abs(Z(normal))};
+			const auto dropped = std::max_element(absNormal, absNormal + 3) - absNormal;
+			const std::vector<float> *coordinates[] = {&polygon.m_x, &polygon.m_y, &polygon.m_z};
+			m_u = *coordinates[dropped == 0 ? 1 : 0];
+			m_v = *coordinates[dropped == 2 ? 1 : 2];
+
+			const auto vertexCount = m_u.size();
+			m_minU = *std::min_element(m_u.begin(), m_u.end());
+			m_minV = *std::min_element(m_v.begin(), m_v.end());
+			const auto extent = std::max(*std::max_element(m_u.begin(), m_u.end()) - m_minU,
+			                             *std::max_element(m_v.begin(), m_v.end()) - m_minV);
+			// Points are tested in 3D, so the triangles' bounds are enlarged to cover rounding in the projection
+			m_margin = extent * 1e-4f;
+
+			const auto reflexCount = std::count(polygon.m_isReflex.begin(), polygon.m_isReflex.end(), 1);
+			m_size = std::max(1u, static_cast<uint32_t>(std::sqrt(static_cast<float>(reflexCount))));
+			m_cellSize = extent > 0 ? extent / m_size : 1.0f;
+
+			m_cellStarts.assign(m_size * m_size + 1, 0);
+			for (auto i = 0u; i < vertexCount; ++i)
+			{
+				if (polygon.m_isReflex[i])
+				{
+					++m_cellStarts[Cell(m_u[i], m_v[i]) + 1];
+				}
+			}
+			for (auto c = 0u; c < m_size * m_size; ++c)
+			{
+				m_cellStarts[c + 1] += m_cellStarts[c];
+			}
+			m_cellVertices.resize(m_cellStarts.back());
+			m_cellFill.assign(m_cellStarts.begin(), m_cellStarts.end() - 1);
+			for (auto i = 0u; i < vertexCount; ++i)
+			{
+				if (polygon.m_isReflex[i])
+				{
+					m_cellVertices[m_cellFill[Cell(m_u[i], m_v[i])]++] = i;
+				}
+			}
+			m_inGrid.assign(polygon.m_isReflex.begin(), polygon.m_isReflex.end());
+			m_added.clear();
+		}
+
+		/**
+		 * Adds a vertex that became reflex after the grid was built.
+		 */
+		void Add(uint32_t vertex)
+		{
+			if (!m_inGrid[vertex])
+			{
+				m_inGrid[vertex] = 1;
+				m_added.push_back(vertex);
+			}
+		}
+
+		/**
+		 * Calls \p f with the vertices in the grid that are within \p margin of the bounds of the triangle \p a, \p b,
+		 * \p c, until it returns false. Vertices that are no longer reflex are also passed.
+		 */
+		template<class F>
+		void ForEachNearTriangle(uint32_t a, uint32_t b, uint32_t c, float margin, F &&f) const
+		{
+			margin = std::max(margin, m_margin);
+			const auto minU = std::min({m_u[a], m_u[b], m_u[c]}) - margin;
+			const auto maxU = std::max({m_u[a], m_u[b], m_u[c]}) + margin;
+			const auto minV = std::min({m_v[a], m_v[b], m_v[c]}) - margin;
+			const auto maxV = std::max({m_v[a], m_v[b], m_v[c]}) + margin;
+			const auto firstU = Coordinate(minU, m_minU);
+			const auto lastU = Coordinate(maxU, m_minU);
+			const auto firstV = Coordinate(minV, m_minV);
+			const auto lastV = Coordinate(maxV, m_minV);
+
+			for (auto cv = firstV; cv <= lastV; ++cv)
+			{
+				for (auto cu = firstU; cu <= lastU; ++cu)
+				{
+					const auto cell = cv * m_size + cu;
+					for (auto i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; ++i)
+					{
+						const auto vertex = m_cellVertices[i];
+						if (m_u[vertex] >= minU && m_u[vertex] <= maxU && m_v[vertex] >= minV && m_v[vertex] <= maxV &&
+						    !f(vertex))
+						{
+							return;
+						}
+					}
+				}
+			}
+			for (const auto &vertex : m_added)
+			{
+				if (!f(vertex))
+				{
+					return;
+				}
+			}
+		}
+
+	private:
+		uint32_t Coordinate(float value, float min) const
+		{
+			const auto c = std::floor((value - min) / m_cellSize);
+			return static_cast<uint32_t>(std::min(std::max(c, 0.0f), static_cast<float>(m_size - 1)));
+		}
+
+		uint32_t Cell(float u, float v) const { return Coordinate(v, m_minV) * m_size + Coordinate(u, m_minU); }
+
+		/// Projected coordinates of every vertex.
+		std::vector<float> m_u;
+		std::vector<float> m_v;
+		float m_minU;
+		float m_minV;
+		float m_margin;
+		float m_cellSize;
+		/// Number of cells along each side.
+		uint32_t m_size;
+		/// Reflex vertices in each cell, with the ones in cell c in [m_cellStarts[c], m_cellStarts[c + 1]).
+		std::vector<uint32_t> m_cellStarts;
+		std::vector<uint32_t> m_cellVertices;
+		std::vector<uint32_t> m_cellFill;
+		/// Whether each vertex is in a cell or in m_added.
+		std::vector<uint8_t> m_inGrid;
+		/// Vertices that became reflex after the grid was built.
+		std::vector<uint32_t> m_added;
+	};
+
+	/**
+	 * Tests whether points are inside a triangle, with the barycentric coordinates of the points.
+	 */
+	class TriangleTest
 	{
-		bool operator()(const VertexLinkedListNode *lhs, const VertexLinkedListNode *rhs) const
+	public:
+		TriangleTest(const Vec3F &a, const Vec3F &b, const Vec3F &c) : m_a(a), m_e0(c - a), m_e1(b - a)
 		{
-			return lhs->m_splitPoint < rhs->m_splitPoint;
+			m_dot00 = boost::qvm::dot(m_e0, m_e0);
+			m_dot01 = boost::qvm::dot(m_e0, m_e1);
+			m_dot11 = boost::qvm::dot(m_e1, m_e1);
+			m_invDenom = 1 / (m_dot00 * m_dot11 - m_dot01 * m_dot01);
 		}
+
+		/**
+		 * Returns the square of the sine of the angle at the first point.
+		 */
+		float GetSinSquared() const { return (m_dot00 * m_dot11 - m_dot01 * m_dot01) / (m_dot00 * m_dot11); }
+
+		/**
+		 * Returns the length of the longest edge.
+		 */
+		float GetDiameter() const
+		{
+			return std::sqrt(std::max({m_dot00, m_dot11, boost::qvm::mag_sqr(Vec3F(m_e0 - m_e1))}));
+		}
+
+		/**
+		 * Returns whether the point at \p x, \p y, \p z is inside the triangle.
+		 * Branchless, so that it can be vectorized over many points.
+		 */
+		bool operator()(float x, float y, float z) const
+		{
+			const float e2x = x - X(m_a);
+			const float e2y = y - Y(m_a);
+			const float e2z = z - Z(m_a);
+			const float dot02 = X(m_e0) * e2x + Y(m_e0) * e2y + Z(m_e0) * e2z;
+			const float dot12 = X(m_e1) * e2x + Y(m_e1) * e2y + Z(m_e1) * e2z;
+
+			// Compute barycentric coordinates
+			const float u = (m_dot11 * dot02 - m_dot01 * dot12) * m_invDenom;
+			const float v = (m_dot00 * dot12 - m_dot01 * dot02) * m_invDenom;
+
+			return (u >= 0) & (v >= 0) & (u + v < 1);
+		}
+
+	private:
+		Vec3F m_a;
+		Vec3F m_e0;
+		Vec3F m_e1;
+		float m_dot00;
+		float m_dot01;
+		float m_dot11;
+		float m_invDenom;
 	};
 
+	/// An ear tip to clip, ordered by its split point.
+	using EarTip = std::pair<Index_t, uint32_t>;
+
 public:
 	EarClipping() {}
 
@@ -60,118 +269,117 @@ public:
 		START_PROFILE;
 
 		std::vector<Triangle> triangles;
+		Polygon polygon;
+		ReflexGrid reflexGrid;
+		// Min-heap of ear tips. Entries of vertices that stopped being ear tips are skipped when popped.
+		std::vector<EarTip> earTips;
 
 		for (auto faceIter = geometryIn->FacesBegin(); faceIter != geometryIn->FacesEnd(); ++faceIter)
 		{
-			std::vector<VertexLinkedListNode> vertexLinkedList;
 			Vec3F faceNormal = geometryIn->GetFaceAttributes(*faceIter).m_normal;
 
-			std::set<VertexLinkedListNode *, Sorter> reflexVertices;
-			std::set<VertexLinkedListNode *, Sorter> convexVertices;
-			std::set<VertexLinkedListNode *, Sorter> earTips;
-
+			polygon.Clear();
 			for (auto fspIter = geometryIn->FaceSplitPointCirculatorBegin(*faceIter); fspIter; ++fspIter)
 			{
-				Vec3F curr = geometryIn->GetPosition(geometryIn->GetPoint(*fspIter));
-				vertexLinkedList.emplace_back(*fspIter, curr);
+				polygon.m_splitPoints.push_back(*fspIter);
+				const auto position = geometryIn->GetPosition(geometryIn->GetPoint(*fspIter));
+				polygon.m_x.push_back(X(position));
+				polygon.m_y.push_back(Y(position));
+				polygon.m_z.push_back(Z(position));
 			}
 
-			for (auto i = 0u; i < vertexLinkedList.size(); ++i)
+			const auto vertexCount = static_cast<uint32_t>(polygon.m_splitPoints.size());
+			polygon.m_next.resize(vertexCount);
+			polygon.m_prev.resize(vertexCount);
+			polygon.m_isReflex.resize(vertexCount, 0);
+			polygon.m_isConvex.resize(vertexCount, 0);
+			polygon.m_isEarTip.resize(vertexCount, 0);
+			for (auto i = 0u; i < vertexCount; ++i)
 			{
-				auto prevIndex = i == 0 ? vertexLinkedList.size() - 1 : i - 1;
-				auto nextIndex = (i + 1) % vertexLinkedList.size();
-				vertexLinkedList[i].m_next = &(vertexLinkedList[nextIndex]);
-				vertexLinkedList[i].m_prev = &(vertexLinkedList[prevIndex]);
-
-				Vec3F prev = vertexLinkedList[i].m_prev->m_position;
-				Vec3F curr = vertexLinkedList[i].m_position;
-				Vec3F next = vertexLinkedList[i].m_next->m_position;
-
-				auto dot = boost::qvm::dot(boost::qvm::cross((next - curr), (prev - curr)), faceNormal);
-				if (dot < 0)
-				{
-					reflexVertices.insert(&(vertexLinkedList[i]));
-				}
-				else if (dot > 0)
-				{
-					convexVertices.insert(&(vertexLinkedList[i]));
-				}
+				polygon.m_next[i] = (i + 1) % vertexCount;
+				polygon.m_prev[i] = i == 0 ? vertexCount - 1 : i - 1;
+			}
+			for (auto i = 0u; i < vertexCount; ++i)
+			{
+				UpdateVertexType(polygon, faceNormal, i);
 			}
 
-			for (const auto &n : convexVertices)
+			reflexGrid.Build(polygon, faceNormal);
+
+			earTips.clear();
+			for (auto i = 0u; i < vertexCount; ++i)
 			{
-				if (isEar(*n, reflexVertices))
+				if (polygon.m_isConvex[i] && IsEar(polygon, reflexGrid, i))
 				{
-					earTips.insert(n);
+					AddEarTip(polygon, earTips, i);
 				}
 			}
 
 			uint32_t trianglesFound = 0;
 			// in a polygon with n vertices there are always n-2 trianges.
-			while (!earTips.empty() && trianglesFound < vertexLinkedList.size() - 2)
+			while (trianglesFound < vertexCount - 2)
 			{
-				VertexLinkedListNode *tip = *earTips.begin();
-				earTips.erase(tip);
+				// The ear tip with the lowest split point is clipped first
+				while (!earTips.empty() && !polygon.m_isEarTip[earTips.front().second])
+				{
+					std::pop_heap(earTips.begin(), earTips.end(), std::greater<EarTip>());
+					earTips.pop_back();
+				}
+				if (earTips.empty())
+				{
+					break;
+				}
+				const auto tip = earTips.front().second;
+				std::pop_heap(earTips.begin(), earTips.end(), std::greater<EarTip>());
+				earTips.pop_back();
+				polygon.m_isEarTip[tip] = 0;
 				++trianglesFound;
 
 				// remove the tip
-				VertexLinkedListNode *next = tip->m_next;
-				VertexLinkedListNode *prev = tip->m_prev;
-
-				next->m_prev = prev;
-				prev->m_next = next;
-				tip->m_next = nullptr;
-				tip->m_prev = nullptr;
+				const auto next = polygon.m_next[tip];
+				const auto prev = polygon.m_prev[tip];
+				polygon.m_prev[next] = prev;
+				polygon.m_next[prev] = next;
 
 				for (const auto &adj : {prev, next})
 				{
-					bool isConvex = false;
-
-					Vec3F prevPos = adj->m_prev->m_position;
-					Vec3F currPos = adj->m_position;
-					Vec3F nextPos = adj->m_next->m_position;
-
-					auto dot = boost::qvm::dot(boost::qvm::cross((nextPos - currPos), (prevPos - currPos)), faceNormal);
-					if (dot < 0)
+					UpdateVertexType(polygon, faceNormal, adj);
+					if (polygon.m_isReflex[adj])
 					{
-						reflexVertices.insert(adj);
-						convexVertices.erase(adj);
+						reflexGrid.Add(adj);
 					}
-					else if (dot > 0)
+					else if (polygon.m_isConvex[adj])
 					{
-						convexVertices.insert(adj);
-						reflexVertices.erase(adj);
-						isConvex = true;
-					}
-
-					if (isConvex)
-					{
-						if (isEar(*adj, reflexVertices))
+						if (IsEar(polygon, reflexGrid, adj))
 						{
-							earTips.insert(adj);
+							AddEarTip(polygon, earTips, adj);
 						}
 						else
 						{
-							earTips.erase(adj);
+							polygon.m_isEarTip[adj] = 0;
 						}
 					}
 				}
 
-				auto p0 = geometryIn->GetPoint(prev->m_splitPoint);
-				auto p1 = geometryIn->GetPoint(tip->m_splitPoint);
-				auto p2 = geometryIn->GetPoint(next->m_splitPoint);
+				auto p0 = geometryIn->GetPoint(polygon.m_splitPoints[prev]);
+				auto p1 = geometryIn->GetPoint(polygon.m_splitPoints[tip]);
+				auto p2 = geometryIn->GetPoint(polygon.m_splitPoints[next]);
 
 				triangles.emplace_back(p0, p1, p2);
 			}
 		}
 
 		GeometryBuilderT<Geometry> builder(geometryOut);
-		std::unordered_map<Index_t, Index_t> pointsMap;
+		std::vector<Index_t> pointsMap;
 		auto pointEndIter = geometryIn->PointsEnd();
 		for (auto pointIter = geometryIn->PointsBegin(); pointIter != pointEndIter; ++pointIter)
 		{
-			auto vertPos = geometryIn->GetPosition(*pointIter);
-			pointsMap[*pointIter] = builder.AddPoint(vertPos);
+			const Index_t point = *pointIter;
+			if (point >= pointsMap.size())
+			{
+				pointsMap.resize(point + 1);
+			}
+			pointsMap[point] = builder.AddPoint(geometryIn->GetPosition(point));
 		}
 
 		for (const auto &t : triangles)
@@ -185,47 +393,80 @@ public:
 	}
 
 private:
-	bool isEar(VertexLinkedListNode &v, std::set<VertexLinkedListNode *, Sorter> reflexVertices)
+	/**
+	 * Classifies the vertex \p v as reflex or convex from its neighbours.
+	 * Vertices collinear with their neighbours keep their previous type.
+	 */
+	void UpdateVertexType(Polygon &polygon, const Vec3F &faceNormal, uint32_t v)
 	{
-		Vec3F p0 = v.m_prev->m_position;
-		Vec3F p1 = v.m_position;
-		Vec3F p2 = v.m_next->m_position;
+		const Vec3F prev = polygon.GetPosition(polygon.m_prev[v]);
+		const Vec3F curr = polygon.GetPosition(v);
+		const Vec3F next = polygon.GetPosition(polygon.m_next[v]);
 
-		for (const auto rv : reflexVertices)
+		auto dot = boost::qvm::dot(boost::qvm::cross((next - curr), (prev - curr)), faceNormal);
+		if (dot < 0)
 		{
-			if (rv->m_splitPoint == v.m_splitPoint || rv->m_splitPoint == v.m_prev->m_splitPoint ||
-			    rv->m_splitPoint == v.m_next->m_splitPoint)
-			{
-				continue;
-			}
-
-			if (pointInsideTriangle(rv->m_position, p0, p1, p2))
-			{
-				return false;
-			}
+			polygon.m_isReflex[v] = 1;
+			polygon.m_isConvex[v] = 0;
 		}
+		else if (dot > 0)
+		{
+			polygon.m_isConvex[v] = 1;
+			polygon.m_isReflex[v] = 0;
+		}
+	}
 
-		return true;
+	void AddEarTip(Polygon &polygon, std::vector<EarTip> &earTips, uint32_t v)
+	{
+		if (!polygon.m_isEarTip[v])
+		{
+			polygon.m_isEarTip[v] = 1;
+			earTips.emplace_back(polygon.m_splitPoints[v], v);
+			std::push_heap(earTips.begin(), earTips.end(), std::greater<EarTip>());
+		}
 	}
 
-	bool pointInsideTriangle(const Vec3F &P, const Vec3F &a, const Vec3F &b, const Vec3F &c)
+	bool IsEar(const Polygon &polygon, const ReflexGrid &reflexGrid, uint32_t v)
 	{
-		Vec3F e0 = c - a;
-		Vec3F e1 = b - a;
-		Vec3F e2 = P - a;
-
-		float dot00 = boost::qvm::dot(e0, e0);
-		float dot01 = boost::qvm::dot(e0, e1);
-		float dot02 = boost::qvm::dot(e0, e2);
-		float dot11 = boost::qvm::dot(e1, e1);
-		float dot12 = boost::qvm::dot(e1, e2);
-
-		// Compute barycentric coordinates
-		float invDenom = 1 / (dot00 * dot11 - dot01 * dot01);
-		float u = (dot11 * dot02 - dot01 * dot12) * invDenom;
-		float v = (dot00 * dot12 - dot01 * dot02) * invDenom;
-
-		return (u >= 0) && (v >= 0) && (u + v < 1);
+		const auto prev = polygon.m_prev[v];
+		const auto next = polygon.m_next[v];
+		const TriangleTest isInside(polygon.GetPosition(prev), polygon.GetPosition(v), polygon.GetPosition(next));
+		auto isBlocking = [&](uint32_t rv) {
+			return polygon.m_isReflex[rv] && rv != v && rv != prev && rv != next &&
+			       isInside(polygon.m_x[rv], polygon.m_y[rv], polygon.m_z[rv]);
+		};
+
+		// Rounding in the barycentric coordinates can accept points outside the triangle, by a distance that grows
+		// as the angle at prev closes. Only the reflex vertices within that distance are tested.
+		const float tolerance = 128 * std::numeric_limits<float>::epsilon() / isInside.GetSinSquared();
+		if (tolerance > 0 && tolerance < 0.25f)
+		{
+			bool isEar = true;
+			reflexGrid.ForEachNearTriangle(prev, v, next, isInside.GetDiameter() * tolerance / (1 - tolerance),
+			                               [&](uint32_t rv) {
+				                               isEar = !isBlocking(rv);
+				                               return isEar;
+			                               });
+			return isEar;
+		}
+
+		// Degenerate and collinear triangles have no such distance, so every vertex is tested in a single pass
+		const auto vertexCount = polygon.m_x.size();
+		const auto *isReflex = polygon.m_isReflex.data();
+		const auto *x = polygon.m_x.data();
+		const auto *y = polygon.m_y.data();
+		const auto *z = polygon.m_z.data();
+		uint32_t blockingCount = 0;
+		for (std::size_t i = 0; i < vertexCount; ++i)
+		{
+			blockingCount += isReflex[i] & isInside(x[i], y[i], z[i]);
+		}
+		for (const auto &excluded : {v, prev, next})
+		{
+			blockingCount -= polygon.m_isReflex[excluded] &
+			                 isInside(polygon.m_x[excluded], polygon.m_y[excluded], polygon.m_z[excluded]);
+		}
+		return blockingCount == 0;
 	}
 };
 }  // namespace pagoda
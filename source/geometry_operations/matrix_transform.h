@@ -4,6 +4,7 @@
 #include "math_lib/matrix_base.h"
 
 #include <boost/qvm/mat_operations.hpp>
+#include <boost/qvm/swizzle.hpp>
 #include <boost/qvm/vec_mat_operations.hpp>
 
 namespace pagoda
@@ -19,19 +20,37 @@ public:
 	MatrixTransform(const Mat4x4F& matrix) : m_matrix(matrix) {}
 
 	void Execute(GeometryPtr geometryIn, GeometryPtr geometryOut)
+	{
+		if (geometryOut != geometryIn)
+		{
+			*geometryOut = *geometryIn;
+		}
+		Execute(geometryOut);
+	}
+
+	/**
+	 * Transforms \p geometry in place.
+	 * Affine matrices are applied to all positions in one pass, without the homogeneous divide.
+	 */
+	void Execute(GeometryPtr geometry)
 	{
 		START_PROFILE;
 		LOG_TRACE(GeometryOperations, "Transforming with matrix");
 		LOG_TRACE(GeometryOperations, m_matrix);
 
-		*geometryOut = *geometryIn;
+		if (IsAffine(m_matrix))
+		{
+			geometry->TransformPositions(AffineRows(m_matrix));
+			return;
+		}
 
-		for (auto iter = geometryOut->PointsBegin(); iter != geometryOut->PointsEnd(); ++iter)
+		for (auto iter = geometry->PointsBegin(); iter != geometry->PointsEnd(); ++iter)
 		{
-			auto& pos = geometryOut->GetPosition(*iter);
+			auto pos = geometry->GetPosition(*iter);
 			LOG_TRACE(GeometryOperations, "Applying matrix to " << pos);
 			Vec4F finalPos = m_matrix * XYZ1(pos);
 			pos = XYZ(finalPos) / W(finalPos);
+			geometry->SetPosition(*iter, pos);
 			LOG_TRACE(GeometryOperations, "Result: " << pos);
 		}
 	}
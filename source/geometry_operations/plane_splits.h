@@ -5,6 +5,20 @@
 
 namespace pagoda
 {
+/**
+ * Splits a geometry with a sequence of planes, clipping it with the first plane and what is behind each
+ * plane with the next one. Outputs the part in front of each plane, followed by what is behind the last one.
+ *
+ * Cutting with many parallel planes, as Split and RepeatSplit do, would rebuild the whole remaining geometry
+ * once per plane. Instead, what remains behind the planes is kept as the arrays that would be given to a
+ * \c BulkGeometryBuilderT to build it, and for each plane only the faces in the slab in front of it, or crossing
+ * it, are built and clipped. The faces entirely behind it are carried over in the arrays. The result is the
+ * same as clipping the whole geometry with each plane in turn.
+ *
+ * This is not a single-pass slicer. Edges are still cut one plane at a time, since the results depend on the
+ * intersections found on the edges left by the previous plane. Every plane also classifies all the points and
+ * faces remaining behind the previous ones, so that part still grows with planes x remaining faces.
+ */
 template<class G>
 class PlaneSplits
 {
@@ -12,6 +26,22 @@ private:
 	using Geometry = G;
 	using GeometryPtr = std::shared_ptr<Geometry>;
 	using Index_t = typename Geometry::Index_t;
+	using PositionType = typename Geometry::PositionType;
+	using PointHandle = typename Geometry::PointHandle;
+	using FaceHandle = typename Geometry::FaceHandle;
+	using Builder = BulkGeometryBuilderT<Geometry>;
+
+	/**
+	 * The faces behind the planes used so far, as given to Builder::Build().
+	 * Points are numbered in order of first appearance and the points of each face start where
+	 * its circulation in the built geometry starts.
+	 */
+	struct BackFaces
+	{
+		std::vector<PositionType> m_positions;
+		std::vector<Index_t> m_indices;
+		std::vector<uint32_t> m_faceSizes;
+	};
 
 public:
 	PlaneSplits(const std::vector<Plane<float>> &planes) : m_planes(planes) {}
@@ -31,29 +61,255 @@ public:
 		outGeometries.reserve(m_planes.size() + 1);
 		auto currentGeometry = std::make_shared<Geometry>();
 		*currentGeometry = *geometryIn;
+		if (m_planes.empty())
+		{
+			if (currentGeometry->GetFaceCount() > 0)
+			{
+				outGeometries.push_back(currentGeometry);
+			}
+			return;
+		}
 
-		for (const auto &plane : m_planes)
+		// The input geometry is clipped as a whole with the first plane
+		BackFaces back;
+		std::vector<Index_t> pointsToBackIndex;
+		Clip<Geometry>(m_planes.front()).ClipInPlace(currentGeometry, [&](const FaceHandle &face) {
+			uint32_t faceSize = 0;
+			for (auto fpCirc = currentGeometry->FacePointCirculatorBegin(face); fpCirc; ++fpCirc)
+			{
+				const Index_t point = *fpCirc;
+				if (point >= pointsToBackIndex.size())
+				{
+					pointsToBackIndex.resize(point + 1, s_invalidIndex);
+				}
+				if (pointsToBackIndex[point] == s_invalidIndex)
+				{
+					pointsToBackIndex[point] = static_cast<Index_t>(back.m_positions.size());
+					back.m_positions.push_back(currentGeometry->GetPosition(point));
+				}
+				back.m_indices.push_back(pointsToBackIndex[point]);
+				++faceSize;
+			}
+			back.m_faceSizes.push_back(faceSize);
+		});
+		if (currentGeometry->GetFaceCount() > 0)
+		{
+			currentGeometry->Compact();
+			outGeometries.push_back(currentGeometry);
+		}
+
+		for (auto i = 1u; i < m_planes.size(); ++i)
+		{
+			ClipBackFaces(m_planes[i], back, outGeometries);
+		}
+
+		if (!back.m_faceSizes.empty())
 		{
-			Clip<Geometry> clip(plane);
-			auto frontGeometry = std::make_shared<Geometry>();
 			auto backGeometry = std::make_shared<Geometry>();
+			Builder(backGeometry).Build(back.m_positions, back.m_indices, back.m_faceSizes);
+			outGeometries.push_back(backGeometry);
+		}
+	}
+
+private:
+	/**
+	 * Clips \p back with \p plane, adding the part in front of it to \p outGeometries and leaving the part
+	 * behind it in \p back.
+	 * All of \p back is classified and copied, but only the faces not entirely behind \p plane are built and clipped.
+	 */
+	template<class Container>
+	void ClipBackFaces(const Plane<float> &plane, BackFaces &back, Container &outGeometries)
+	{
+		START_PROFILE;
 
-			clip.Execute(currentGeometry, frontGeometry, backGeometry);
+		const auto pointCount = static_cast<Index_t>(back.m_positions.size());
+		const auto faceCount = back.m_faceSizes.size();
+
+		std::vector<float> x(pointCount), y(pointCount), z(pointCount);
+		for (auto p = 0u; p < pointCount; ++p)
+		{
+			x[p] = boost::qvm::X(back.m_positions[p]);
+			y[p] = boost::qvm::Y(back.m_positions[p]);
+			z[p] = boost::qvm::Z(back.m_positions[p]);
+		}
+		std::vector<Plane<float>::PlaneSide> pointsSide(pointCount);
+		plane.GetPlaneSides(x.data(), y.data(), z.data(), pointCount, pointsSide.data());
 
-			if (frontGeometry->GetFaceCount() > 0)
+		// A face with no edge crossing the plane and a point behind it is neither split nor clipped by Clip.
+		// The other faces are built in the slab geometry, with their points in the same relative order.
+		std::vector<bool> isBehind(faceCount);
+		std::vector<Index_t> faceStarts(faceCount);
+		std::vector<Index_t> lastFace(pointCount);
+		std::vector<Index_t> slabPoints(pointCount, s_invalidIndex);
+		Index_t faceStart = 0;
+		for (auto f = 0u; f < faceCount; ++f)
+		{
+			const auto faceSize = back.m_faceSizes[f];
+			const auto *indices = &back.m_indices[faceStart];
+			bool crossesPlane = false;
+			bool hasPointBehind = false;
+			for (auto i = 0u; i < faceSize; ++i)
+			{
+				const auto side = pointsSide[indices[i]];
+				const auto nextSide = pointsSide[indices[(i + 1) % faceSize]];
+				crossesPlane |= !SameSide(side, nextSide);
+				hasPointBehind |= side == Plane<float>::PlaneSide::Back;
+				lastFace[indices[i]] = f;
+			}
+			isBehind[f] = !crossesPlane && hasPointBehind;
+			if (!isBehind[f])
 			{
-				outGeometries.push_back(frontGeometry);
+				for (auto i = 0u; i < faceSize; ++i)
+				{
+					slabPoints[indices[i]] = 0;
+				}
 			}
-			currentGeometry = backGeometry;
+			faceStarts[f] = faceStart;
+			faceStart += faceSize;
 		}
 
-		if (currentGeometry->GetFaceCount() > 0)
+		std::vector<Index_t> slabToBack;
+		for (auto p = 0u; p < pointCount; ++p)
 		{
-			outGeometries.push_back(currentGeometry);
+			if (slabPoints[p] != s_invalidIndex)
+			{
+				slabPoints[p] = static_cast<Index_t>(slabToBack.size());
+				slabToBack.push_back(p);
+			}
 		}
+
+		std::vector<Index_t> behindIndices;
+		std::vector<std::pair<Index_t, uint32_t>> behindFaces;
+		std::vector<PositionType> newPositions;
+		if (!slabToBack.empty())
+		{
+			auto slab = std::make_shared<Geometry>();
+			const auto slabPointCount = static_cast<Index_t>(slabToBack.size());
+			for (const auto &p : slabToBack)
+			{
+				auto point = slab->CreatePoint();
+				slab->SetPosition(point, back.m_positions[p]);
+				// Builder::Build gives each point the normal of the last face it belongs to
+				const auto f = lastFace[p];
+				slab->GetVertexAttributes(point).m_normal =
+				    Builder::FaceNormal(back.m_positions, &back.m_indices[faceStarts[f]], back.m_faceSizes[f]);
+			}
+
+			std::vector<PointHandle> facePoints;
+			for (auto f = 0u; f < faceCount; ++f)
+			{
+				if (isBehind[f])
+				{
+					continue;
+				}
+				const auto faceSize = back.m_faceSizes[f];
+				const auto *indices = &back.m_indices[faceStarts[f]];
+				facePoints.clear();
+				for (auto i = 0u; i < faceSize; ++i)
+				{
+					facePoints.push_back(slabPoints[indices[i]]);
+				}
+				auto face = slab->CreatePolygon(facePoints.data(), faceSize);
+				slab->GetFaceAttributes(face).m_normal = Builder::FaceNormal(back.m_positions, indices, faceSize);
+			}
+
+			// Points created by splitting edges are numbered after the points in back
+			Clip<Geometry>(plane).ClipInPlace(slab, [&](const FaceHandle &face) {
+				uint32_t faceSize = 0;
+				for (auto fpCirc = slab->FacePointCirculatorBegin(face); fpCirc; ++fpCirc)
+				{
+					const Index_t point = *fpCirc;
+					if (point < slabPointCount)
+					{
+						behindIndices.push_back(slabToBack[point]);
+					}
+					else
+					{
+						const Index_t newPoint = point - slabPointCount;
+						if (newPoint >= newPositions.size())
+						{
+							newPositions.resize(newPoint + 1);
+						}
+						newPositions[newPoint] = slab->GetPosition(point);
+						behindIndices.push_back(pointCount + newPoint);
+					}
+					++faceSize;
+				}
+				behindFaces.emplace_back(face.GetIndex(), faceSize);
+			});
+			if (slab->GetFaceCount() > 0)
+			{
+				slab->Compact();
+				outGeometries.push_back(slab);
+			}
+		}
+
+		// The faces behind the plane, in the order of the back geometry built by Clip: the faces of back in order,
+		// followed by the ones created when splitting faces
+		BackFaces nextBack;
+		nextBack.m_indices.reserve(back.m_indices.size());
+		nextBack.m_faceSizes.reserve(faceCount);
+		std::vector<Index_t> pointsToBackIndex(pointCount + newPositions.size(), s_invalidIndex);
+		auto addPoint = [&](const Index_t &point) {
+			if (pointsToBackIndex[point] == s_invalidIndex)
+			{
+				pointsToBackIndex[point] = static_cast<Index_t>(nextBack.m_positions.size());
+				nextBack.m_positions.push_back(point < pointCount ? back.m_positions[point]
+				                                                  : newPositions[point - pointCount]);
+			}
+			nextBack.m_indices.push_back(pointsToBackIndex[point]);
+		};
+
+		auto behindFace = behindFaces.begin();
+		auto behindIndex = behindIndices.begin();
+		auto addBehindFace = [&]() {
+			for (auto i = 0u; i < behindFace->second; ++i)
+			{
+				addPoint(*behindIndex++);
+			}
+			nextBack.m_faceSizes.push_back(behindFace->second);
+			++behindFace;
+		};
+
+		Index_t slabFace = 0;
+		for (auto f = 0u; f < faceCount; ++f)
+		{
+			if (isBehind[f])
+			{
+				// Faces built from a list of points are circulated starting at the last one
+				const auto faceSize = back.m_faceSizes[f];
+				const auto *indices = &back.m_indices[faceStarts[f]];
+				addPoint(indices[faceSize - 1]);
+				for (auto i = 0u; i + 1 < faceSize; ++i)
+				{
+					addPoint(indices[i]);
+				}
+				nextBack.m_faceSizes.push_back(faceSize);
+			}
+			else
+			{
+				if (behindFace != behindFaces.end() && behindFace->first == slabFace)
+				{
+					addBehindFace();
+				}
+				++slabFace;
+			}
+		}
+		while (behindFace != behindFaces.end())
+		{
+			addBehindFace();
+		}
+
+		back = std::move(nextBack);
 	}
 
-private:
+	static bool SameSide(Plane<float>::PlaneSide lhs, Plane<float>::PlaneSide rhs)
+	{
+		return lhs == rhs || lhs == Plane<float>::PlaneSide::Contained || rhs == Plane<float>::PlaneSide::Contained;
+	}
+
+	static constexpr Index_t s_invalidIndex = std::numeric_limits<Index_t>::max();
+
 	std::vector<Plane<float>> m_planes;
 };
 }  // namespace pagoda
@@ -2,6 +2,7 @@
 
 #include <boost/qvm/mat.hpp>
 
+#include <cstddef>
 #include <ostream>
 
 namespace pagoda
@@ -25,5 +26,72 @@ std::ostream &operator<<(std::ostream &o, const boost::qvm::mat<Rep, NumRows, Nu
 using Mat2x2F = boost::qvm::mat<float, 2, 2>;
 using Mat3x3F = boost::qvm::mat<float, 3, 3>;
 using Mat4x4F = boost::qvm::mat<float, 4, 4>;
+/// Affine transformation, the first three rows of a \c Mat4x4F whose last row is (0, 0, 0, 1).
+using Mat3x4F = boost::qvm::mat<float, 3, 4>;
+
+/**
+ * Returns whether the last row of \p matrix is (0, 0, 0, 1), in which case it transforms points
+ * without a homogeneous divide.
+ */
+template<class Rep>
+bool IsAffine(const boost::qvm::mat<Rep, 4, 4> &matrix)
+{
+	return matrix.a[3][0] == Rep(0) && matrix.a[3][1] == Rep(0) && matrix.a[3][2] == Rep(0) && matrix.a[3][3] == Rep(1);
+}
+
+/**
+ * Returns the first three rows of \p matrix.
+ */
+template<class Rep>
+boost::qvm::mat<Rep, 3, 4> AffineRows(const boost::qvm::mat<Rep, 4, 4> &matrix)
+{
+	boost::qvm::mat<Rep, 3, 4> rows;
+	for (auto r = 0u; r < 3; ++r)
+	{
+		for (auto c = 0u; c < 4; ++c)
+		{
+			rows.a[r][c] = matrix.a[r][c];
+		}
+	}
+	return rows;
+}
+
+/**
+ * Returns the affine transformation that applies \p second after \p first.
+ */
+template<class Rep>
+boost::qvm::mat<Rep, 3, 4> ComposeAffine(const boost::qvm::mat<Rep, 3, 4> &second,
+                                         const boost::qvm::mat<Rep, 3, 4> &first)
+{
+	boost::qvm::mat<Rep, 3, 4> result;
+	for (auto r = 0u; r < 3; ++r)
+	{
+		for (auto c = 0u; c < 4; ++c)
+		{
+			result.a[r][c] = second.a[r][0] * first.a[0][c] + second.a[r][1] * first.a[1][c] +
+			                 second.a[r][2] * first.a[2][c] + (c == 3 ? second.a[r][3] : Rep(0));
+		}
+	}
+	return result;
+}
+
+/**
+ * Transforms in place the \p count points given by the coordinate arrays \p x, \p y and \p z with the
+ * affine \p matrix. The loop has no branches so that the compiler can vectorize it.
+ */
+template<class Rep>
+void TransformPoints(const boost::qvm::mat<Rep, 3, 4> &matrix, Rep *x, Rep *y, Rep *z, std::size_t count)
+{
+	const Rep m00 = matrix.a[0][0], m01 = matrix.a[0][1], m02 = matrix.a[0][2], m03 = matrix.a[0][3];
+	const Rep m10 = matrix.a[1][0], m11 = matrix.a[1][1], m12 = matrix.a[1][2], m13 = matrix.a[1][3];
+	const Rep m20 = matrix.a[2][0], m21 = matrix.a[2][1], m22 = matrix.a[2][2], m23 = matrix.a[2][3];
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const Rep px = x[i], py = y[i], pz = z[i];
+		x[i] = m00 * px + m01 * py + m02 * pz + m03;
+		y[i] = m10 * px + m11 * py + m12 * pz + m13;
+		z[i] = m20 * px + m21 * py + m22 * pz + m23;
+	}
+}
 
 }  // namespace pagoda
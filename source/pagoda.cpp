@@ -3,7 +3,9 @@
 #include "common/factory.h"
 #include "common/file_util.h"
 #include "common/logger.h"
+#include "common/mapped_file.h"
 
+#include <procedural_graph/compiled_graph_format.h>
 #include <procedural_graph/graph.h>
 #include <procedural_graph/input_interface_node.h>
 #include <procedural_graph/operation_node.h>
@@ -137,10 +139,22 @@ public:
 	{
 		LOG_TRACE(Core, "Creating Graph From File: " << filePath.c_str());
 		GraphReader reader(GetNodeFactory());
+		if (boost::filesystem::path(filePath).extension() == CompiledGraphFormat::s_extension)
+		{
+			MappedFile file(filePath);
+			return reader.ReadCompiled(file.GetData(), file.GetSize());
+		}
 		GraphPtr graph = reader.Read(file_util::LoadFileToString(filePath));
 		return graph;
 	}
 
+	void CompileGraphFile(const std::string &filePath, const std::string &outputPath)
+	{
+		LOG_TRACE(Core, "Compiling Graph File: " << filePath.c_str() << " to " << outputPath.c_str());
+		GraphReader reader(GetNodeFactory());
+		file_util::WriteStringToFile(outputPath, reader.Compile(file_util::LoadFileToString(filePath)));
+	}
+
 private:
 	ProceduralObjectSystemPtr m_proceduralObjectSystem;
 	OperationFactoryPtr m_operationFactory;
@@ -166,4 +180,9 @@ GraphPtr Pagoda::CreateGraphFromFile(const std::string &filePath)
 {
 	return m_implementation->CreateGraphFromFile(filePath);
 }
+
+void Pagoda::CompileGraphFile(const std::string &filePath, const std::string &outputPath)
+{
+	m_implementation->CompileGraphFile(filePath, outputPath);
+}
 }  // namespace pagoda
@@ -58,9 +58,16 @@ public:
 
     /**
      * Creates a \c Graph from the file given in \p filePath.
+     *
+     * Files with the \c CompiledGraphFormat extension are loaded as compiled graphs.
      */
 	GraphPtr CreateGraphFromFile(const std::string &filePath);
 
+    /**
+     * Compiles the graph in the file given in \p filePath, writing it to \p outputPath in the \c CompiledGraphFormat.
+     */
+	void CompileGraphFile(const std::string &filePath, const std::string &outputPath);
+
 private:
     class Impl;
     std::unique_ptr<Impl> m_implementation;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "symbol.h"
+
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
@@ -79,16 +81,44 @@ using StringPtr = std::shared_ptr<String>;
 
 struct Identifier : public Expression
 {
-	explicit Identifier(const std::string &i) : m_identifier(i) {}
-	explicit Identifier(const std::vector<char> &i) : m_identifier(i.begin(), i.end()) {}
+	explicit Identifier(const std::string &i)
+	    : m_identifier(i), m_symbol(SymbolInterner::Intern(m_identifier)), m_scopeDepth(0), m_scopeSlot(s_unresolved)
+	{
+	}
+	explicit Identifier(const std::vector<char> &i)
+	    : m_identifier(i.begin(), i.end()),
+	      m_symbol(SymbolInterner::Intern(m_identifier)),
+	      m_scopeDepth(0),
+	      m_scopeSlot(s_unresolved)
+	{
+	}
 	virtual ~Identifier();
 
 	const std::string &GetIdentifier() const { return m_identifier; }
+	SymbolId GetSymbol() const { return m_symbol; }
+
+	/**
+	 * Resolves this identifier to the \p slot of the block scope \p depth scopes up from where it is used.
+	 * Set by the \c ScopeResolver. Identifiers that aren't resolved are looked up by name.
+	 */
+	void Resolve(uint32_t depth, uint32_t slot)
+	{
+		m_scopeDepth = depth;
+		m_scopeSlot = slot;
+	}
+	bool IsResolved() const { return m_scopeSlot != s_unresolved; }
+	uint32_t GetScopeDepth() const { return m_scopeDepth; }
+	uint32_t GetScopeSlot() const { return m_scopeSlot; }
 
 	void AcceptVisitor(AstVisitor *v) override;
 
 private:
+	static constexpr uint32_t s_unresolved = UINT32_MAX;
+
 	std::string m_identifier;
+	SymbolId m_symbol;
+	uint32_t m_scopeDepth;
+	uint32_t m_scopeSlot;
 };
 using IdentifierPtr = std::shared_ptr<Identifier>;
 
@@ -322,10 +352,18 @@ struct StatementBlock : public Statement
 	const std::vector<StatementPtr> &GetStatements() const { return m_statements; }
 	void AddStatement(const StatementPtr &statement) { m_statements.push_back(statement); }
 
+	/**
+	 * The number of slots for the variables declared in this block, set by the \c ScopeResolver.
+	 * Blocks without slots don't need a scope.
+	 */
+	void SetSlotCount(uint32_t slotCount) { m_slotCount = slotCount; }
+	uint32_t GetSlotCount() const { return m_slotCount; }
+
 	void AcceptVisitor(AstVisitor *v) override;
 
 private:
 	std::vector<StatementPtr> m_statements;
+	uint32_t m_slotCount = 0;
 };
 using StatementBlockPtr = std::shared_ptr<StatementBlock>;
 
@@ -0,0 +1,206 @@
+#include "scope_resolver.h"
+
+#include <unordered_set>
+
+namespace pagoda
+{
+namespace
+{
+/**
+ * Returns the number of distinct symbols declared directly in \p block.
+ */
+uint32_t CountDeclarations(const ast::StatementBlockPtr &block)
+{
+	std::unordered_set<SymbolId> symbols;
+	for (const auto &statement : block->GetStatements())
+	{
+		if (auto v = std::dynamic_pointer_cast<ast::VarDecl>(statement))
+		{
+			symbols.insert(v->GetIdentifier()->GetSymbol());
+		}
+		else if (auto f = std::dynamic_pointer_cast<ast::FunctionDeclaration>(statement))
+		{
+			symbols.insert(f->GetIdentifier()->GetSymbol());
+		}
+		else if (auto c = std::dynamic_pointer_cast<ast::ClassDeclaration>(statement))
+		{
+			symbols.insert(c->GetIdentifier()->GetSymbol());
+		}
+	}
+	return static_cast<uint32_t>(symbols.size());
+}
+}  // namespace
+
+void ScopeResolver::Resolve(const ast::ProgramPtr &program)
+{
+	ScopeResolver resolver;
+	program->AcceptVisitor(&resolver);
+}
+
+void ScopeResolver::Visit(ast::AnonymousMethodPtr a)
+{
+	a->GetInstance()->AcceptVisitor(this);
+	VisitFunctionBody(a->GetBody());
+}
+
+void ScopeResolver::Visit(ast::ArithmeticOpPtr op)
+{
+	op->GetLhs()->AcceptVisitor(this);
+	op->GetRhs()->AcceptVisitor(this);
+}
+
+void ScopeResolver::Visit(ast::AssignmentPtr a)
+{
+	a->GetRhs()->AcceptVisitor(this);
+	a->GetIdentifier()->AcceptVisitor(this);
+}
+
+void ScopeResolver::Visit(ast::CallPtr c)
+{
+	c->GetCallee()->AcceptVisitor(this);
+	for (const auto &a : c->GetArguments())
+	{
+		a->AcceptVisitor(this);
+	}
+}
+
+void ScopeResolver::Visit(ast::ClassDeclarationPtr c)
+{
+	Declare(c->GetIdentifier());
+	for (const auto &m : c->GetMethods())
+	{
+		VisitFunctionBody(m->GetFunctionBody());
+	}
+}
+
+void ScopeResolver::Visit(ast::ComparisonOpPtr op)
+{
+	op->GetLhs()->AcceptVisitor(this);
+	op->GetRhs()->AcceptVisitor(this);
+}
+
+void ScopeResolver::Visit(ast::ExpressionStatementPtr e) { e->GetExpression()->AcceptVisitor(this); }
+
+void ScopeResolver::Visit(ast::FunctionDeclarationPtr f)
+{
+	Declare(f->GetIdentifier());
+	VisitFunctionBody(f->GetFunctionBody());
+}
+
+void ScopeResolver::Visit(ast::GetExpressionPtr g)
+{
+	// The identifier is a member name
+	g->GetLhs()->AcceptVisitor(this);
+}
+
+void ScopeResolver::Visit(ast::IdentifierPtr i)
+{
+	uint32_t depth = 0;
+	for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope)
+	{
+		auto slot = scope->m_slots.find(i->GetSymbol());
+		if (slot != scope->m_slots.end())
+		{
+			i->Resolve(depth, slot->second);
+			return;
+		}
+		if (scope->m_hasSlots)
+		{
+			++depth;
+		}
+	}
+}
+
+void ScopeResolver::Visit(ast::IfStatementPtr i)
+{
+	i->GetCondition()->AcceptVisitor(this);
+	i->GetTrueStatement()->AcceptVisitor(this);
+	if (auto falseStatement = i->GetFalseStatement())
+	{
+		falseStatement->AcceptVisitor(this);
+	}
+}
+
+void ScopeResolver::Visit(ast::LogicOpPtr op)
+{
+	op->GetLhs()->AcceptVisitor(this);
+	op->GetRhs()->AcceptVisitor(this);
+}
+
+void ScopeResolver::Visit(ast::LoopPtr l)
+{
+	l->GetCondition()->AcceptVisitor(this);
+	l->GetBody()->AcceptVisitor(this);
+}
+
+void ScopeResolver::Visit(ast::ProgramPtr p)
+{
+	for (const auto &statement : p->GetStatements())
+	{
+		statement->AcceptVisitor(this);
+	}
+}
+
+void ScopeResolver::Visit(ast::ReturnPtr r)
+{
+	if (auto returnExpression = r->GetReturnExpression())
+	{
+		returnExpression->AcceptVisitor(this);
+	}
+}
+
+void ScopeResolver::Visit(ast::SetExpressionPtr s)
+{
+	// The identifier is a member name
+	s->GetLhs()->AcceptVisitor(this);
+	s->GetRhs()->AcceptVisitor(this);
+}
+
+void ScopeResolver::Visit(ast::StatementBlockPtr b)
+{
+	const auto slotCount = CountDeclarations(b);
+	b->SetSlotCount(slotCount);
+	m_scopes.push_back(Scope{{}, slotCount > 0});
+	for (const auto &statement : b->GetStatements())
+	{
+		statement->AcceptVisitor(this);
+	}
+	m_scopes.pop_back();
+}
+
+void ScopeResolver::Visit(ast::UnaryPtr u) { u->GetRhs()->AcceptVisitor(this); }
+
+void ScopeResolver::Visit(ast::VarDeclPtr v)
+{
+	// The rhs is resolved first, so that it can refer to a variable the declaration shadows
+	if (auto rhs = v->GetRhs())
+	{
+		rhs->AcceptVisitor(this);
+	}
+	Declare(v->GetIdentifier());
+}
+
+void ScopeResolver::Declare(const ast::IdentifierPtr &identifier)
+{
+	if (m_scopes.empty())
+	{
+		return;
+	}
+	auto &slots = m_scopes.back().m_slots;
+	auto slot = slots.emplace(identifier->GetSymbol(), static_cast<uint32_t>(slots.size())).first->second;
+	identifier->Resolve(0, slot);
+}
+
+void ScopeResolver::VisitFunctionBody(const ast::StatementBlockPtr &body)
+{
+	if (body == nullptr)
+	{
+		return;
+	}
+	// Functions don't run in the scopes they are declared in
+	std::vector<Scope> enclosingScopes;
+	std::swap(enclosingScopes, m_scopes);
+	body->AcceptVisitor(this);
+	std::swap(enclosingScopes, m_scopes);
+}
+}  // namespace pagoda
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ast_visitor.h"
+#include "symbol.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace pagoda
+{
+/**
+ * Resolves the identifiers of variables declared in statement blocks to a (depth, slot) pair,
+ * so that the interpreter can find their values by indexing instead of looking them up by name.
+ *
+ * Identifiers declared at the top level of a program, external variables and the globals aren't
+ * resolved and are still looked up by name.
+ * Function bodies start with no enclosing block scopes.
+ */
+class ScopeResolver : public AstVisitor
+{
+public:
+	/**
+	 * Resolves the identifiers in \p program.
+	 */
+	static void Resolve(const ast::ProgramPtr &program);
+
+	void Visit(ast::AnonymousMethodPtr a) override;
+	void Visit(ast::ArithmeticOpPtr op) override;
+	void Visit(ast::AssignmentPtr a) override;
+	void Visit(ast::BooleanPtr) override {}
+	void Visit(ast::CallPtr c) override;
+	void Visit(ast::ClassDeclarationPtr c) override;
+	void Visit(ast::ComparisonOpPtr op) override;
+	void Visit(ast::ExpressionStatementPtr e) override;
+	void Visit(ast::FloatPtr) override {}
+	void Visit(ast::FunctionDeclarationPtr f) override;
+	void Visit(ast::GetExpressionPtr g) override;
+	void Visit(ast::IdentifierPtr i) override;
+	void Visit(ast::IfStatementPtr i) override;
+	void Visit(ast::IntegerPtr) override {}
+	void Visit(ast::LogicOpPtr op) override;
+	void Visit(ast::LoopPtr l) override;
+	void Visit(ast::Nullptr) override {}
+	void Visit(ast::ProgramPtr p) override;
+	void Visit(ast::ReturnPtr r) override;
+	void Visit(ast::SetExpressionPtr s) override;
+	void Visit(ast::StatementBlockPtr b) override;
+	void Visit(ast::StringPtr) override {}
+	void Visit(ast::UnaryPtr u) override;
+	void Visit(ast::VarDeclPtr v) override;
+	void Visit(ast::ParameterPtr) override {}
+
+private:
+	struct Scope
+	{
+		/// Slot of each symbol declared so far in the block.
+		std::unordered_map<SymbolId, uint32_t> m_slots;
+		/// Whether the block declares anything, and so has a scope at runtime.
+		bool m_hasSlots;
+	};
+
+	void Declare(const ast::IdentifierPtr &identifier);
+	void VisitFunctionBody(const ast::StatementBlockPtr &body);
+
+	std::vector<Scope> m_scopes;
+};
+}  // namespace pagoda
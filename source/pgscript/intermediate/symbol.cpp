@@ -0,0 +1,53 @@
+#include "symbol.h"
+
+#include "common/exception.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace pagoda
+{
+namespace
+{
+struct InternedSymbols
+{
+	std::mutex m_mutex;
+	std::unordered_map<std::string, SymbolId> m_ids;
+	/// Names by SymbolId. A deque doesn't move the names, so references to them stay valid.
+	std::deque<std::string> m_names;
+};
+
+InternedSymbols &GetInternedSymbols()
+{
+	static InternedSymbols sSymbols;
+	return sSymbols;
+}
+}  // namespace
+
+SymbolId SymbolInterner::Intern(const std::string &name)
+{
+	auto &symbols = GetInternedSymbols();
+	std::lock_guard<std::mutex> lock(symbols.m_mutex);
+	auto iter = symbols.m_ids.find(name);
+	if (iter != symbols.m_ids.end())
+	{
+		return iter->second;
+	}
+	auto id = static_cast<SymbolId>(symbols.m_names.size());
+	symbols.m_names.push_back(name);
+	symbols.m_ids.emplace(name, id);
+	return id;
+}
+
+const std::string &SymbolInterner::GetName(SymbolId symbol)
+{
+	auto &symbols = GetInternedSymbols();
+	std::lock_guard<std::mutex> lock(symbols.m_mutex);
+	if (symbol >= symbols.m_names.size())
+	{
+		throw Exception("Unknown symbol id " + std::to_string(symbol));
+	}
+	return symbols.m_names[symbol];
+}
+}  // namespace pagoda
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace pagoda
+{
+/**
+ * Integer id of an interned identifier.
+ */
+using SymbolId = uint32_t;
+
+/**
+ * Interns the identifiers of pgscript programs, so that they can be compared and hashed as integers.
+ *
+ * Interning is thread safe and interned identifiers are never released.
+ */
+class SymbolInterner
+{
+public:
+	/**
+	 * Returns the \c SymbolId of \p name, interning it if it hasn't been interned yet.
+	 */
+	static SymbolId Intern(const std::string &name);
+	/**
+	 * Returns the name interned as \p symbol.
+	 */
+	static const std::string &GetName(SymbolId symbol);
+};
+}  // namespace pagoda
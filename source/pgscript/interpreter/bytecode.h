@@ -0,0 +1,71 @@
+#pragma once
+
+#include "dynamic_value/tagged_value.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pagoda
+{
+/**
+ * Instructions of the \c VirtualMachine.
+ *
+ * The \c VirtualMachine is stack based. Instructions pop their operands from the stack and
+ * push their result. Binary operations pop the lhs first.
+ */
+enum class OpCode : uint8_t
+{
+	PushConstant,    ///< Pushes the constant at index operand.
+	Pop,             ///< Pops the top of the stack.
+	LoadLocal,       ///< Pushes the value of the local slot operand.
+	StoreLocal,      ///< Stores the top of the stack in the local slot operand without popping it.
+	LoadExternal,    ///< Pushes the value of the external variable operand.
+	LoadGlobal,      ///< Pushes the value of the global symbol with name operand.
+	StoreGlobal,     ///< Assigns the top of the stack to the global symbol with name operand without popping it.
+	GetMember,       ///< Replaces the object on the top of the stack with its member with name operand.
+	Call,            ///< Calls the callable below operand arguments, replacing them with the result.
+	Add,             ///< lhs + rhs
+	Sub,             ///< lhs - rhs
+	Mul,             ///< lhs * rhs
+	Div,             ///< lhs / rhs
+	Eq,              ///< lhs == rhs
+	Ne,              ///< lhs != rhs
+	Gt,              ///< lhs > rhs
+	Gte,             ///< lhs >= rhs
+	Lt,              ///< lhs < rhs
+	Lte,             ///< lhs <= rhs
+	Negate,          ///< !value
+	Minus,           ///< -value
+	ToBoolean,       ///< Converts the top of the stack to a boolean.
+	Jump,            ///< Jumps to the instruction operand.
+	JumpIfFalse,     ///< Pops the top of the stack and jumps to the instruction operand if it is false.
+	JumpIfTrue,      ///< Pops the top of the stack and jumps to the instruction operand if it is true.
+	DeclareGlobal    ///< Declares the global symbol with name operand with the top of the stack without popping it.
+};
+
+struct Instruction
+{
+	OpCode m_opCode;
+	uint32_t m_operand;
+};
+
+/**
+ * A pgscript program compiled by the \c BytecodeCompiler.
+ */
+struct BytecodeProgram
+{
+	/// The instructions of the program.
+	std::vector<Instruction> m_instructions;
+	/// Constants referenced by OpCode::PushConstant.
+	std::vector<TaggedValue> m_constants;
+	/// Names referenced by OpCode::LoadGlobal, OpCode::StoreGlobal and OpCode::GetMember.
+	std::vector<std::string> m_names;
+	/// Names of the external variables, in the order of their slots, referenced by OpCode::LoadExternal.
+	std::vector<std::string> m_externals;
+	/// The number of local variable slots.
+	uint32_t m_localCount = 0;
+};
+using BytecodeProgramPtr = std::shared_ptr<BytecodeProgram>;
+}  // namespace pagoda
@@ -0,0 +1,419 @@
+#include "bytecode_compiler.h"
+
+#include "virtual_machine.h"
+
+#include "../intermediate/ast.h"
+#include "../intermediate/ast_visitor.h"
+
+#include "dynamic_value/null_object_value.h"
+#include "dynamic_value/string_value.h"
+
+#include "common/exception.h"
+#include "common/profiler.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace pagoda
+{
+namespace
+{
+/**
+ * Thrown while compiling when a construct can't be compiled.
+ */
+struct UnsupportedConstruct
+{
+};
+
+class bytecode_compiler_visitor : public AstVisitor
+{
+public:
+	bytecode_compiler_visitor(BytecodeProgram &program, bool topLevelGlobals)
+	    : m_program(program), m_barrier(0), m_topLevelGlobals(topLevelGlobals)
+	{
+	}
+
+	void Visit(ast::FloatPtr n) override { EmitConstant(TaggedValue::FromFloat(n->GetNumber())); }
+
+	void Visit(ast::IntegerPtr n) override { EmitConstant(TaggedValue::FromInteger(n->GetInteger())); }
+
+	void Visit(ast::StringPtr s) override
+	{
+		EmitConstant(TaggedValue::FromObject(std::make_shared<String>(s->GetString())));
+	}
+
+	void Visit(ast::BooleanPtr b) override { EmitConstant(TaggedValue::FromBoolean(b->GetBoolean())); }
+
+	void Visit(ast::Nullptr) override { EmitNull(); }
+
+	void Visit(ast::IdentifierPtr i) override
+	{
+		const auto &name = i->GetIdentifier();
+		uint32_t slot;
+		if (FindLocal(name, slot))
+		{
+			Emit(OpCode::LoadLocal, slot);
+		}
+		else if (FindExternal(name, slot))
+		{
+			Emit(OpCode::LoadExternal, slot);
+		}
+		else
+		{
+			Emit(OpCode::LoadGlobal, GetName(name));
+		}
+	}
+
+	void Visit(ast::ArithmeticOpPtr op) override
+	{
+		// Operands are evaluated in the same order as the interpreter_visitor, leaving the lhs on top
+		op->GetRhs()->AcceptVisitor(this);
+		op->GetLhs()->AcceptVisitor(this);
+		switch (op->GetOperationType())
+		{
+			case ast::ArithmeticOp::types::Add:
+				EmitBinary(OpCode::Add);
+				break;
+			case ast::ArithmeticOp::types::Sub:
+				EmitBinary(OpCode::Sub);
+				break;
+			case ast::ArithmeticOp::types::Mul:
+				EmitBinary(OpCode::Mul);
+				break;
+			case ast::ArithmeticOp::types::Div:
+				EmitBinary(OpCode::Div);
+				break;
+		}
+	}
+
+	void Visit(ast::UnaryPtr u) override
+	{
+		u->GetRhs()->AcceptVisitor(this);
+		switch (u->GetOperationType())
+		{
+			case ast::Unary::types::Neg:
+				EmitUnary(OpCode::Negate);
+				break;
+			case ast::Unary::types::Min:
+				EmitUnary(OpCode::Minus);
+				break;
+		}
+	}
+
+	void Visit(ast::ComparisonOpPtr op) override
+	{
+		// Operands are evaluated in the same order as the interpreter_visitor, leaving the lhs on top
+		op->GetRhs()->AcceptVisitor(this);
+		op->GetLhs()->AcceptVisitor(this);
+		switch (op->GetOperationType())
+		{
+			case ast::ComparisonOp::types::Eq:
+				EmitBinary(OpCode::Eq);
+				break;
+			case ast::ComparisonOp::types::Ne:
+				EmitBinary(OpCode::Ne);
+				break;
+			case ast::ComparisonOp::types::Gt:
+				EmitBinary(OpCode::Gt);
+				break;
+			case ast::ComparisonOp::types::Gte:
+				EmitBinary(OpCode::Gte);
+				break;
+			case ast::ComparisonOp::types::Lt:
+				EmitBinary(OpCode::Lt);
+				break;
+			case ast::ComparisonOp::types::Lte:
+				EmitBinary(OpCode::Lte);
+				break;
+		}
+	}
+
+	void Visit(ast::LogicOpPtr op) override
+	{
+		// Both operators short-circuit, producing a constant when the rhs isn't evaluated
+		const bool isAnd = op->GetOperationType() == ast::LogicOp::types::And;
+		op->GetLhs()->AcceptVisitor(this);
+		auto shortCircuit = Emit(isAnd ? OpCode::JumpIfFalse : OpCode::JumpIfTrue, 0);
+		op->GetRhs()->AcceptVisitor(this);
+		Emit(OpCode::ToBoolean, 0);
+		auto end = Emit(OpCode::Jump, 0);
+		PatchJump(shortCircuit);
+		Emit(OpCode::PushConstant, AddConstant(TaggedValue::FromBoolean(!isAnd)));
+		PatchJump(end);
+	}
+
+	void Visit(ast::AssignmentPtr a) override
+	{
+		a->GetRhs()->AcceptVisitor(this);
+		const auto &name = a->GetIdentifier()->GetIdentifier();
+		uint32_t slot;
+		if (FindLocal(name, slot))
+		{
+			Emit(OpCode::StoreLocal, slot);
+		}
+		else if (FindExternal(name, slot))
+		{
+			throw UnsupportedConstruct();
+		}
+		else
+		{
+			Emit(OpCode::StoreGlobal, GetName(name));
+		}
+	}
+
+	void Visit(ast::ExpressionStatementPtr e) override
+	{
+		e->GetExpression()->AcceptVisitor(this);
+		Emit(OpCode::Pop, 0);
+	}
+
+	void Visit(ast::IfStatementPtr i) override
+	{
+		i->GetCondition()->AcceptVisitor(this);
+		auto falseJump = Emit(OpCode::JumpIfFalse, 0);
+		i->GetTrueStatement()->AcceptVisitor(this);
+		auto falseStatement = i->GetFalseStatement();
+		if (falseStatement)
+		{
+			auto end = Emit(OpCode::Jump, 0);
+			PatchJump(falseJump);
+			falseStatement->AcceptVisitor(this);
+			PatchJump(end);
+		}
+		else
+		{
+			PatchJump(falseJump);
+		}
+	}
+
+	void Visit(ast::LoopPtr l) override
+	{
+		auto start = static_cast<uint32_t>(m_program.m_instructions.size());
+		m_barrier = start;
+		l->GetCondition()->AcceptVisitor(this);
+		auto exit = Emit(OpCode::JumpIfFalse, 0);
+		l->GetBody()->AcceptVisitor(this);
+		Emit(OpCode::Jump, start);
+		PatchJump(exit);
+	}
+
+	void Visit(ast::VarDeclPtr v) override
+	{
+		auto rhs = v->GetRhs();
+		if (rhs)
+		{
+			rhs->AcceptVisitor(this);
+		}
+		else
+		{
+			EmitNull();
+		}
+		const auto &name = v->GetIdentifier()->GetIdentifier();
+		if (m_topLevelGlobals && m_scopes.size() == 1)
+		{
+			Emit(OpCode::DeclareGlobal, GetName(name));
+			Emit(OpCode::Pop, 0);
+			return;
+		}
+		// The slot is declared after compiling the rhs so that it can refer to a shadowed variable
+		auto slot = m_program.m_localCount++;
+		m_scopes.back()[name] = slot;
+		Emit(OpCode::StoreLocal, slot);
+		Emit(OpCode::Pop, 0);
+	}
+
+	void Visit(ast::StatementBlockPtr b) override
+	{
+		m_scopes.emplace_back();
+		for (const auto &statement : b->GetStatements())
+		{
+			statement->AcceptVisitor(this);
+		}
+		m_scopes.pop_back();
+	}
+
+	void Visit(ast::CallPtr c) override
+	{
+		c->GetCallee()->AcceptVisitor(this);
+		const auto &arguments = c->GetArguments();
+		for (const auto &a : arguments)
+		{
+			a->AcceptVisitor(this);
+		}
+		Emit(OpCode::Call, static_cast<uint32_t>(arguments.size()));
+	}
+
+	void Visit(ast::GetExpressionPtr e) override
+	{
+		e->GetLhs()->AcceptVisitor(this);
+		Emit(OpCode::GetMember, GetName(e->GetIdentifier()->GetIdentifier()));
+	}
+
+	void Visit(ast::ProgramPtr p) override
+	{
+		m_scopes.emplace_back();
+		for (const auto &statement : p->GetStatements())
+		{
+			statement->AcceptVisitor(this);
+		}
+		m_scopes.pop_back();
+	}
+
+	void Visit(ast::FunctionDeclarationPtr) override { throw UnsupportedConstruct(); }
+	void Visit(ast::ClassDeclarationPtr) override { throw UnsupportedConstruct(); }
+	void Visit(ast::AnonymousMethodPtr) override { throw UnsupportedConstruct(); }
+	void Visit(ast::SetExpressionPtr) override { throw UnsupportedConstruct(); }
+	void Visit(ast::ReturnPtr) override { throw UnsupportedConstruct(); }
+	void Visit(ast::ParameterPtr) override { throw UnsupportedConstruct(); }
+
+private:
+	void EmitNull()
+	{
+		EmitConstant(TaggedValue::FromObject(std::make_shared<NullObject>()));
+	}
+
+	uint32_t Emit(OpCode opCode, uint32_t operand)
+	{
+		m_program.m_instructions.push_back(Instruction{opCode, operand});
+		return static_cast<uint32_t>(m_program.m_instructions.size() - 1);
+	}
+
+	void EmitConstant(const TaggedValue &v) { Emit(OpCode::PushConstant, AddConstant(v)); }
+
+	uint32_t AddConstant(const TaggedValue &v)
+	{
+		m_program.m_constants.push_back(v);
+		return static_cast<uint32_t>(m_program.m_constants.size() - 1);
+	}
+
+	/**
+	 * Points the jump at \p instruction to the next instruction.
+	 */
+	void PatchJump(uint32_t instruction)
+	{
+		m_barrier = static_cast<uint32_t>(m_program.m_instructions.size());
+		m_program.m_instructions[instruction].m_operand = m_barrier;
+	}
+
+	/**
+	 * Returns true if the last \p count instructions push constants and none of them is a jump target.
+	 */
+	bool EndsWithConstants(std::size_t count) const
+	{
+		const auto &instructions = m_program.m_instructions;
+		if (instructions.size() < count || instructions.size() - count < m_barrier)
+		{
+			return false;
+		}
+		return std::all_of(instructions.end() - count, instructions.end(),
+		                   [](const Instruction &i) { return i.m_opCode == OpCode::PushConstant; });
+	}
+
+	void EmitBinary(OpCode opCode)
+	{
+		auto &instructions = m_program.m_instructions;
+		if (EndsWithConstants(2))
+		{
+			const auto &rhs = m_program.m_constants[instructions[instructions.size() - 2].m_operand];
+			const auto &lhs = m_program.m_constants[instructions[instructions.size() - 1].m_operand];
+			try
+			{
+				auto folded = VirtualMachine::ApplyBinary(opCode, lhs, rhs);
+				instructions.resize(instructions.size() - 2);
+				EmitConstant(folded);
+				return;
+			}
+			catch (Exception &)
+			{
+				// Undefined operations are left to fail when the program runs
+			}
+		}
+		Emit(opCode, 0);
+	}
+
+	void EmitUnary(OpCode opCode)
+	{
+		auto &instructions = m_program.m_instructions;
+		if (EndsWithConstants(1))
+		{
+			const auto &value = m_program.m_constants[instructions.back().m_operand];
+			try
+			{
+				auto folded = VirtualMachine::ApplyUnary(opCode, value);
+				instructions.pop_back();
+				EmitConstant(folded);
+				return;
+			}
+			catch (Exception &)
+			{
+			}
+		}
+		Emit(opCode, 0);
+	}
+
+	bool FindLocal(const std::string &name, uint32_t &slot) const
+	{
+		for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope)
+		{
+			auto iter = scope->find(name);
+			if (iter != scope->end())
+			{
+				slot = iter->second;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool FindExternal(const std::string &name, uint32_t &slot) const
+	{
+		const auto &externals = m_program.m_externals;
+		auto iter = std::find(externals.begin(), externals.end(), name);
+		if (iter == externals.end())
+		{
+			return false;
+		}
+		slot = static_cast<uint32_t>(std::distance(externals.begin(), iter));
+		return true;
+	}
+
+	uint32_t GetName(const std::string &name)
+	{
+		auto &names = m_program.m_names;
+		auto iter = std::find(names.begin(), names.end(), name);
+		if (iter != names.end())
+		{
+			return static_cast<uint32_t>(std::distance(names.begin(), iter));
+		}
+		names.push_back(name);
+		return static_cast<uint32_t>(names.size() - 1);
+	}
+
+	BytecodeProgram &m_program;
+	std::vector<std::unordered_map<std::string, uint32_t>> m_scopes;
+	/// Instructions before the barrier can be jumped to and must not be folded.
+	uint32_t m_barrier;
+	/// Whether the variables declared in the scope of the program are globals.
+	bool m_topLevelGlobals;
+};
+}  // namespace
+
+BytecodeProgramPtr BytecodeCompiler::Compile(const ast::ProgramPtr &program, const std::vector<std::string> &externals,
+                                             bool topLevelGlobals)
+{
+	START_PROFILE;
+
+	auto compiled = std::make_shared<BytecodeProgram>();
+	compiled->m_externals = externals;
+	bytecode_compiler_visitor visitor(*compiled, topLevelGlobals);
+	try
+	{
+		program->AcceptVisitor(&visitor);
+	}
+	catch (UnsupportedConstruct &)
+	{
+		return nullptr;
+	}
+	return compiled;
+}
+}  // namespace pagoda
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "bytecode.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pagoda
+{
+namespace ast
+{
+class Program;
+using ProgramPtr = std::shared_ptr<Program>;
+}  // namespace ast
+
+/**
+ * Compiles pgscript programs to \c BytecodeProgram to be run by the \c VirtualMachine.
+ *
+ * Variables declared in the program are resolved to local slots, unless they are globals, and
+ * operations between constants are folded at compile time.
+ */
+class BytecodeCompiler
+{
+public:
+	/**
+	 * Compiles \p program.
+	 *
+	 * Identifiers in \p externals that are not declared in the program are compiled as external
+	 * variables, whose values are given when running the program. All other undeclared identifiers
+	 * are looked up by name in the global symbols.
+	 *
+	 * If \p topLevelGlobals is true, the variables declared at the top level of \p program are declared
+	 * in the global symbols, where they remain after running it, as when it is run by the tree-walking
+	 * interpreter on its globals.
+	 *
+	 * Returns nullptr if \p program uses constructs that can't be compiled (function and class
+	 * declarations, anonymous methods, set expressions, return statements or assignments to
+	 * external variables), in which case it must be run by the tree-walking interpreter.
+	 */
+	static BytecodeProgramPtr Compile(const ast::ProgramPtr &program,
+	                                  const std::vector<std::string> &externals = std::vector<std::string>(),
+	                                  bool topLevelGlobals = false);
+};
+}  // namespace pagoda
@@ -0,0 +1,189 @@
+#include "bytecode_serializer.h"
+
+#include "common/binary_stream.h"
+#include "common/exception.h"
+
+#include "dynamic_value/null_object_value.h"
+#include "dynamic_value/string_value.h"
+
+#include <limits>
+#include <typeinfo>
+
+namespace pagoda
+{
+namespace
+{
+/// Constant types in the serialized program, extending the scalar TaggedValue types with the objects the compiler emits
+enum class ConstantType : uint8_t
+{
+	Null,
+	Boolean,
+	Integer,
+	Float,
+	String,
+	NullObject
+};
+
+void WriteNames(const std::vector<std::string> &names, BinaryWriter &writer)
+{
+	writer.Write(static_cast<uint32_t>(names.size()));
+	for (const auto &n : names)
+	{
+		writer.WriteString(n);
+	}
+}
+
+void ReadNames(std::vector<std::string> &names, BinaryReader &reader)
+{
+	const auto count = reader.Read<uint32_t>();
+	for (auto i = 0u; i < count; ++i)
+	{
+		names.push_back(reader.ReadString());
+	}
+}
+
+void WriteConstant(const TaggedValue &constant, BinaryWriter &writer)
+{
+	switch (constant.m_type)
+	{
+		case TaggedValue::Type::Null:
+			writer.Write(ConstantType::Null);
+			return;
+		case TaggedValue::Type::Boolean:
+			writer.Write(ConstantType::Boolean);
+			writer.Write(static_cast<uint8_t>(constant.m_boolean));
+			return;
+		case TaggedValue::Type::Integer:
+			writer.Write(ConstantType::Integer);
+			writer.Write(static_cast<int32_t>(constant.m_integer));
+			return;
+		case TaggedValue::Type::Float:
+			writer.Write(ConstantType::Float);
+			writer.Write(constant.m_float);
+			return;
+		case TaggedValue::Type::Object:
+		{
+			const auto &type = typeid(*constant.m_object);
+			if (type == typeid(String))
+			{
+				writer.Write(ConstantType::String);
+				writer.WriteString(static_cast<std::string>(static_cast<const String &>(*constant.m_object)));
+				return;
+			}
+			if (type == typeid(NullObject))
+			{
+				writer.Write(ConstantType::NullObject);
+				return;
+			}
+			break;
+		}
+	}
+	throw Exception("Unable to serialize bytecode constant " + constant.m_object->ToString());
+}
+
+TaggedValue ReadConstant(BinaryReader &reader)
+{
+	switch (reader.Read<ConstantType>())
+	{
+		case ConstantType::Null:
+			return TaggedValue();
+		case ConstantType::Boolean:
+			return TaggedValue::FromBoolean(reader.Read<uint8_t>() != 0);
+		case ConstantType::Integer:
+			return TaggedValue::FromInteger(reader.Read<int32_t>());
+		case ConstantType::Float:
+			return TaggedValue::FromFloat(reader.Read<float>());
+		case ConstantType::String:
+			return TaggedValue::FromObject(std::make_shared<String>(reader.ReadString()));
+		case ConstantType::NullObject:
+			return TaggedValue::FromObject(std::make_shared<NullObject>());
+	}
+	throw Exception("Invalid bytecode constant");
+}
+
+/**
+ * Returns the exclusive upper bound of the operand of \p opCode in \p program.
+ */
+std::size_t GetOperandLimit(const BytecodeProgram &program, OpCode opCode)
+{
+	switch (opCode)
+	{
+		case OpCode::PushConstant:
+			return program.m_constants.size();
+		case OpCode::LoadLocal:
+		case OpCode::StoreLocal:
+			return program.m_localCount;
+		case OpCode::LoadExternal:
+			return program.m_externals.size();
+		case OpCode::LoadGlobal:
+		case OpCode::StoreGlobal:
+		case OpCode::DeclareGlobal:
+		case OpCode::GetMember:
+			return program.m_names.size();
+		case OpCode::Jump:
+		case OpCode::JumpIfFalse:
+		case OpCode::JumpIfTrue:
+			return program.m_instructions.size() + 1;
+		default:
+			return std::numeric_limits<uint32_t>::max() + std::size_t(1);
+	}
+}
+}  // namespace
+
+void BytecodeSerializer::Write(const BytecodeProgram &program, BinaryWriter &writer)
+{
+	writer.Write(static_cast<uint32_t>(program.m_instructions.size()));
+	for (const auto &i : program.m_instructions)
+	{
+		writer.Write(i.m_opCode);
+		writer.Write(i.m_operand);
+	}
+
+	writer.Write(static_cast<uint32_t>(program.m_constants.size()));
+	for (const auto &c : program.m_constants)
+	{
+		WriteConstant(c, writer);
+	}
+
+	WriteNames(program.m_names, writer);
+	WriteNames(program.m_externals, writer);
+	writer.Write(program.m_localCount);
+}
+
+BytecodeProgramPtr BytecodeSerializer::Read(BinaryReader &reader)
+{
+	auto program = std::make_shared<BytecodeProgram>();
+
+	const auto instructionCount = reader.Read<uint32_t>();
+	for (auto i = 0u; i < instructionCount; ++i)
+	{
+		const auto opCode = reader.Read<OpCode>();
+		if (opCode > OpCode::DeclareGlobal)
+		{
+			throw Exception("Invalid bytecode instruction");
+		}
+		program->m_instructions.push_back({opCode, reader.Read<uint32_t>()});
+	}
+
+	const auto constantCount = reader.Read<uint32_t>();
+	for (auto i = 0u; i < constantCount; ++i)
+	{
+		program->m_constants.push_back(ReadConstant(reader));
+	}
+
+	ReadNames(program->m_names, reader);
+	ReadNames(program->m_externals, reader);
+	program->m_localCount = reader.Read<uint32_t>();
+
+	// The VirtualMachine trusts the operands, so they are checked once here
+	for (const auto &i : program->m_instructions)
+	{
+		if (i.m_operand >= GetOperandLimit(*program, i.m_opCode))
+		{
+			throw Exception("Invalid bytecode operand");
+		}
+	}
+
+	return program;
+}
+}  // namespace pagoda
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "bytecode.h"
+
+namespace pagoda
+{
+class BinaryReader;
+class BinaryWriter;
+
+/**
+ * Writes and reads \c BytecodeProgram so that compiled programs can be stored and run later
+ * without being parsed or compiled again.
+ */
+class BytecodeSerializer
+{
+public:
+	/**
+	 * Writes \p program with \p writer.
+	 *
+	 * Throws an \c Exception if \p program has constants other than integers, floats, booleans,
+	 * strings and null, which are the only ones emitted by the \c BytecodeCompiler.
+	 */
+	static void Write(const BytecodeProgram &program, BinaryWriter &writer);
+
+	/**
+	 * Reads a \c BytecodeProgram written by \c Write from \p reader.
+	 *
+	 * Throws an \c Exception if the data isn't a valid program.
+	 */
+	static BytecodeProgramPtr Read(BinaryReader &reader);
+};
+}  // namespace pagoda
@@ -1,14 +1,16 @@
 #include "interpreter.h"
 
-#include "dynamic_value/binding/make_free_function.h"
 #include "dynamic_value/dynamic_plane.h"
 #include "dynamic_value/dynamic_value_table.h"
 #include "dynamic_value/free_function_callable_body.h"
 #include "dynamic_value/value_not_found.h"
 #include "dynamic_value/vector3.h"
+#include "bytecode_compiler.h"
 #include "interpreter_visitor.h"
+#include "virtual_machine.h"
 
-#include <stack>
+#include <functional>
+#include <iostream>
 
 namespace pagoda
 {
@@ -19,31 +21,73 @@ std::shared_ptr<T> constructor_wrapper(const std::vector<DynamicValueBasePtr> &a
 	return instance;
 }
 
-void print(const std::vector<DynamicValueBasePtr> &args)
+template<class T>
+void RegisterBuiltinClass(DynamicValueTable &table)
 {
-	auto out = Interpreter::GetStdOutStream();
-	for (const auto &d : args)
-	{
-		(*out) << d->ToString();
-	}
-	(*out) << std::endl;
+	using ConstructorFunc_t = std::function<std::shared_ptr<T>(const std::vector<DynamicValueBasePtr> &)>;
+	using FreeFunctionCallableBody_t = FreeFunctionCallableBody<ConstructorFunc_t>;
+	std::shared_ptr<FreeFunctionCallableBody_t> constructor =
+	    std::make_shared<FreeFunctionCallableBody_t>(constructor_wrapper<T>);
+	std::shared_ptr<Function> constructorFunction = std::make_shared<Function>(constructor);
+
+	constructorFunction->SetVariadic(true);
+
+	table.Declare(T::s_typeInfo->GetTypeName(), constructorFunction);
+}
+
+/**
+ * Returns the built in classes.
+ * The table is read only and shared by the globals of every \c Interpreter, in every thread.
+ */
+const std::shared_ptr<DynamicValueTable> &GetBuiltins()
+{
+	static const std::shared_ptr<DynamicValueTable> sBuiltins = []() {
+		auto builtins = std::make_shared<DynamicValueTable>("Builtins");
+		RegisterBuiltinClass<Vector3>(*builtins);
+		RegisterBuiltinClass<DynamicPlane>(*builtins);
+		builtins->SetReadOnly();
+		return builtins;
+	}();
+	return sBuiltins;
 }
 
 class Interpreter::Impl
 {
 public:
 	Impl()
+	    : m_engine(Engine::Ast), m_lastRunOnVirtualMachine(false), m_runDepth(0), m_stdout(&std::cout),
+	      m_stderr(&std::cerr)
 	{
-		RegisterBuiltinClass<Vector3>();
-		RegisterBuiltinClass<DynamicPlane>();
+		m_visitor.GetGlobals()->SetParent(GetBuiltins());
 
-		RegisterFunction("print", make_free_function(print));
+		// print writes to this interpreter's stdout, so it isn't one of the shared builtins
+		RegisterFunction("print", std::function<void(const std::vector<DynamicValueBasePtr> &)>(
+		                              [this](const std::vector<DynamicValueBasePtr> &args) { Print(args); }));
 	}
 
 	~Impl() {}
 
+	void SetEngine(Engine engine) { m_engine = engine; }
+	Engine GetEngine() const { return m_engine; }
+
 	bool Interpret(const ast::ProgramPtr &program)
 	{
+		if (m_engine == Engine::Bytecode)
+		{
+			if (program != m_compiledProgramSource)
+			{
+				m_compiledProgramSource = program;
+				// Like in the tree-walking interpreter, the declarations of the program remain in the globals
+				m_compiledProgram = BytecodeCompiler::Compile(program, {}, true);
+			}
+			if (m_compiledProgram != nullptr)
+			{
+				Run(*m_compiledProgram, {});
+				return false;
+			}
+		}
+
+		m_lastRunOnVirtualMachine = false;
 		try
 		{
 			program->AcceptVisitor(&m_visitor);
@@ -57,53 +101,69 @@ public:
 		return false;
 	}
 
-	void PushExternalSymbols(std::shared_ptr<DynamicValueTable> &externalSymbols)
+	bool Interpret(const ast::ProgramPtr &program, const std::shared_ptr<DynamicValueTable> &externalSymbols)
 	{
-		if (m_externalSymbols.size() == 0)
+		// The program runs with externalSymbols as its scope, so its declarations don't outlive it
+		externalSymbols->SetParent(m_visitor.GetGlobals());
+		auto previousSymbolTable = m_visitor.GetCurrentSymbolTable();
+		m_visitor.SetCurrentSymbolTable(externalSymbols);
+
+		m_lastRunOnVirtualMachine = false;
+		try
 		{
-			m_visitor.GetGlobals()->SetParent(externalSymbols);
+			program->AcceptVisitor(&m_visitor);
 		}
-		else
+		catch (ValueNotFoundException &e)
 		{
-			m_externalSymbols.top()->SetParent(externalSymbols);
+			m_visitor.GetCurrentSymbolTable()->DumpSymbols(std::cout);
+			m_visitor.SetCurrentSymbolTable(previousSymbolTable);
+			throw e;
 		}
-		m_externalSymbols.push(externalSymbols);
+		catch (...)
+		{
+			m_visitor.SetCurrentSymbolTable(previousSymbolTable);
+			throw;
+		}
+		m_visitor.SetCurrentSymbolTable(previousSymbolTable);
+
+		return false;
 	}
 
-	void PopExternalSymbols()
+	DynamicValueBasePtr Run(const BytecodeProgram &program, const std::vector<DynamicValueBasePtr> &externals)
 	{
-		if (m_externalSymbols.size() == 0)
+		m_lastRunOnVirtualMachine = true;
+
+		// Values used by a program (e.g. expressions in the members of an object) may run other programs
+		// while it is running, which can't share its stack
+		VirtualMachine nestedVirtualMachine;
+		auto &virtualMachine = (m_runDepth == 0 ? m_virtualMachine : nestedVirtualMachine);
+		++m_runDepth;
+		try
 		{
-			return;
+			auto result = virtualMachine.Run(program, externals, m_visitor.GetCurrentSymbolTable());
+			--m_runDepth;
+			return result;
 		}
-
-		auto topExternalSymbols = m_externalSymbols.top();
-		m_externalSymbols.pop();
-
-		if (m_externalSymbols.size() == 0)
+		catch (ValueNotFoundException &e)
 		{
-			m_visitor.GetGlobals()->SetParent(nullptr);
+			--m_runDepth;
+			m_visitor.GetCurrentSymbolTable()->DumpSymbols(std::cout);
+			throw e;
 		}
-		else
+		catch (...)
 		{
-			m_externalSymbols.top()->SetParent(nullptr);
+			--m_runDepth;
+			throw;
 		}
 	}
 
-	DynamicValueBasePtr GetLastEvaluatedExpression() const { return m_visitor.GetLastEvaluatedExpression(); }
-
-	template<class T>
-	void RegisterBuiltinClass()
+	DynamicValueBasePtr GetLastEvaluatedExpression() const
 	{
-		using ConstructorFunc_t = std::function<std::shared_ptr<T>(const std::vector<DynamicValueBasePtr> &)>;
-		using FreeFunctionCallableBody_t = FreeFunctionCallableBody<ConstructorFunc_t>;
-		std::shared_ptr<FreeFunctionCallableBody_t> constructor =
-		    std::make_shared<FreeFunctionCallableBody_t>(constructor_wrapper<T>);
-		std::shared_ptr<Function> constructorFunction = std::make_shared<Function>(constructor);
-
-		constructorFunction->SetVariadic(true);
-
-		m_visitor.GetCurrentSymbolTable()->Declare(T::s_typeInfo->GetTypeName(), constructorFunction);
+		if (m_lastRunOnVirtualMachine)
+		{
+			return m_virtualMachine.GetLastEvaluatedExpression();
+		}
+		return m_visitor.GetLastEvaluatedExpression();
 	}
 
 	template<class F>
@@ -115,42 +175,63 @@ public:
 		m_visitor.GetCurrentSymbolTable()->Declare(functionName, dynamicFunction);
 	}
 
-	static void SetStdOutStream(std::ostream *o) { m_stdout = o; }
-	static std::ostream *GetStdOutStream() { return m_stdout; }
-	static void SetStdErrStream(std::ostream *o) { m_stderr = o; }
-	static std::ostream *GetStdErrStream() { return m_stderr; }
+	void Print(const std::vector<DynamicValueBasePtr> &args)
+	{
+		for (const auto &d : args)
+		{
+			(*m_stdout) << d->ToString();
+		}
+		(*m_stdout) << std::endl;
+	}
+
+	void SetStdOutStream(std::ostream *o) { m_stdout = o; }
+	std::ostream *GetStdOutStream() const { return m_stdout; }
+	void SetStdErrStream(std::ostream *o) { m_stderr = o; }
+	std::ostream *GetStdErrStream() const { return m_stderr; }
 
 private:
-	std::stack<std::shared_ptr<DynamicValueTable>> m_externalSymbols;
 	interpreter_visitor m_visitor;
-
-	static std::ostream *m_stdout;
-	static std::ostream *m_stderr;
+	Engine m_engine;
+	VirtualMachine m_virtualMachine;
+	/// Whether the last program was run by the VirtualMachine.
+	bool m_lastRunOnVirtualMachine;
+	/// The last program compiled by Interpret(), to avoid compiling it again.
+	ast::ProgramPtr m_compiledProgramSource;
+	std::shared_ptr<BytecodeProgram> m_compiledProgram;
+	/// How many calls to Run() are running.
+	uint32_t m_runDepth;
+
+	std::ostream *m_stdout;
+	std::ostream *m_stderr;
 };
 
-std::ostream *Interpreter::Impl::m_stdout = &std::cout;
-std::ostream *Interpreter::Impl::m_stderr = &std::cerr;
-
 Interpreter::Interpreter() : m_implementation(std::make_unique<typename Interpreter::Impl>()) {}
 
 Interpreter::~Interpreter() {}
 
+void Interpreter::SetEngine(Engine engine) { m_implementation->SetEngine(engine); }
+
+Interpreter::Engine Interpreter::GetEngine() const { return m_implementation->GetEngine(); }
+
 bool Interpreter::Interpret(const ast::ProgramPtr &program) { return m_implementation->Interpret(program); }
 
-void Interpreter::PushExternalSymbols(std::shared_ptr<DynamicValueTable> &externalSymbols)
+DynamicValueBasePtr Interpreter::Run(const BytecodeProgram &program, const std::vector<DynamicValueBasePtr> &externals)
 {
-	m_implementation->PushExternalSymbols(externalSymbols);
+	return m_implementation->Run(program, externals);
 }
 
-void Interpreter::PopExternalSymbols() { m_implementation->PopExternalSymbols(); }
+bool Interpreter::Interpret(const ast::ProgramPtr &program, const std::shared_ptr<DynamicValueTable> &externalSymbols)
+{
+	return m_implementation->Interpret(program, externalSymbols);
+}
 
 DynamicValueBasePtr Interpreter::GetLastEvaluatedExpression() const
 {
 	return m_implementation->GetLastEvaluatedExpression();
 }
 
-void Interpreter::SetStdOutStream(std::ostream *o) { Interpreter::Impl::SetStdOutStream(o); }
-std::ostream *Interpreter::GetStdOutStream() { return Interpreter::Impl::GetStdOutStream(); }
-void Interpreter::SetStdErrStream(std::ostream *o) { Interpreter::Impl::SetStdErrStream(o); }
-std::ostream *Interpreter::GetStdErrStream() { return Interpreter::Impl::GetStdErrStream(); }
+void Interpreter::SetStdOutStream(std::ostream *o) { m_implementation->SetStdOutStream(o); }
+std::ostream *Interpreter::GetStdOutStream() const { return m_implementation->GetStdOutStream(); }
+void Interpreter::SetStdErrStream(std::ostream *o) { m_implementation->SetStdErrStream(o); }
+std::ostream *Interpreter::GetStdErrStream() const { return m_implementation->GetStdErrStream(); }
 }  // namespace pagoda
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace pagoda
 {
@@ -15,24 +16,52 @@ class DynamicValueBase;
 using DynamicValueBasePtr = std::shared_ptr<DynamicValueBase>;
 
 class DynamicValueTable;
+struct BytecodeProgram;
 
 class Interpreter
 {
 public:
+	/**
+	 * The engines that can run a program.
+	 */
+	enum class Engine
+	{
+		Ast,      ///< Walks the AST with the interpreter_visitor.
+		Bytecode  ///< Compiles the program with the \c BytecodeCompiler and runs it in a \c VirtualMachine.
+	};
+
 	Interpreter();
 	~Interpreter();
 
+	/**
+	 * Sets the \c Engine used by Interpret(). Defaults to Engine::Ast.
+	 * Programs that can't be compiled to bytecode are always run by Engine::Ast.
+	 */
+	void SetEngine(Engine engine);
+	Engine GetEngine() const;
+
 	bool Interpret(const ast::ProgramPtr &program);
+	/**
+	 * Interprets \p program with \p externalSymbols as its scope, on top of this interpreter's globals.
+	 * Declarations made by \p program go to \p externalSymbols and aren't visible to later programs.
+	 */
+	bool Interpret(const ast::ProgramPtr &program, const std::shared_ptr<DynamicValueTable> &externalSymbols);
 
-	void PushExternalSymbols(std::shared_ptr<DynamicValueTable> &externalSymbols);
-	void PopExternalSymbols();
+	/**
+	 * Runs a \c BytecodeProgram with the value of each of its external variables in \p externals.
+	 * Returns the last evaluated value.
+	 */
+	DynamicValueBasePtr Run(const BytecodeProgram &program, const std::vector<DynamicValueBasePtr> &externals);
 
 	DynamicValueBasePtr GetLastEvaluatedExpression() const;
 
-	static void SetStdOutStream(std::ostream *o);
-	static std::ostream *GetStdOutStream();
-	static void SetStdErrStream(std::ostream *o);
-	static std::ostream *GetStdErrStream();
+	/**
+	 * Sets the streams used by this interpreter, e.g. by the print function.
+	 */
+	void SetStdOutStream(std::ostream *o);
+	std::ostream *GetStdOutStream() const;
+	void SetStdErrStream(std::ostream *o);
+	std::ostream *GetStdErrStream() const;
 
 private:
 	class Impl;
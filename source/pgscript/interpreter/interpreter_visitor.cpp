@@ -1,8 +1,7 @@
 #include "interpreter_visitor.h"
 
-#include "../../dynamic_value/binding/binary_ops.h"
 #include "../../dynamic_value/binding/make_free_function.h"
-#include "../../dynamic_value/binding/unary_ops.h"
+#include "../../dynamic_value/binding/tagged_ops.h"
 #include "../../dynamic_value/boolean_value.h"
 #include "../../dynamic_value/class_base.h"
 #include "../../dynamic_value/dynamic_class.h"
@@ -38,15 +37,23 @@ interpreter_visitor::interpreter_visitor()
 
 interpreter_visitor::~interpreter_visitor() {}
 
-void interpreter_visitor::Visit(ast::FloatPtr n) { PushValue(std::make_shared<FloatValue>(n->GetNumber())); }
+void interpreter_visitor::Visit(ast::FloatPtr n) { PushValue(TaggedValue::FromFloat(n->GetNumber())); }
 
-void interpreter_visitor::Visit(ast::IntegerPtr n) { PushValue(std::make_shared<Integer>(n->GetInteger())); }
+void interpreter_visitor::Visit(ast::IntegerPtr n) { PushValue(TaggedValue::FromInteger(n->GetInteger())); }
 
 void interpreter_visitor::Visit(ast::StringPtr s) { PushValue(std::make_shared<String>(s->GetString())); }
 
-void interpreter_visitor::Visit(ast::IdentifierPtr i) { PushValue(GetCurrentSymbolTable()->Get(i->GetIdentifier())); }
+void interpreter_visitor::Visit(ast::IdentifierPtr i)
+{
+	if (i->IsResolved())
+	{
+		PushValue(GetSlot(i));
+		return;
+	}
+	PushValue(GetCurrentSymbolTable()->GetValue(i->GetIdentifier()));
+}
 
-void interpreter_visitor::Visit(ast::BooleanPtr b) { PushValue(std::make_shared<Boolean>(b->GetBoolean())); }
+void interpreter_visitor::Visit(ast::BooleanPtr b) { PushValue(TaggedValue::FromBoolean(b->GetBoolean())); }
 
 void interpreter_visitor::Visit(ast::Nullptr n) { PushValue(std::make_shared<NullObject>()); }
 
@@ -61,29 +68,17 @@ void interpreter_visitor::Visit(ast::ArithmeticOpPtr op)
 	switch (op->GetOperationType())
 	{
 		case ast::ArithmeticOp::types::Add:
-		{
-			binary_op_dispatcher<add> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<add>(lhs, rhs));
 			break;
-		}
 		case ast::ArithmeticOp::types::Sub:
-		{
-			binary_op_dispatcher<sub> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<sub>(lhs, rhs));
 			break;
-		}
 		case ast::ArithmeticOp::types::Mul:
-		{
-			binary_op_dispatcher<mul> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<mul>(lhs, rhs));
 			break;
-		}
 		case ast::ArithmeticOp::types::Div:
-		{
-			binary_op_dispatcher<div> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<div>(lhs, rhs));
 			break;
-		}
 	}
 }
 
@@ -95,17 +90,11 @@ void interpreter_visitor::Visit(ast::UnaryPtr u)
 	switch (u->GetOperationType())
 	{
 		case ast::Unary::types::Neg:
-		{
-			unary_ops_dispatcher<negate> v;
-			PushValue(apply_visitor(v, *rhs));
+			PushValue(apply_unary_op<negate>(rhs));
 			break;
-		}
 		case ast::Unary::types::Min:
-		{
-			unary_ops_dispatcher<minus> v;
-			PushValue(apply_visitor(v, *rhs));
+			PushValue(apply_unary_op<minus>(rhs));
 			break;
-		}
 	}
 }
 
@@ -119,41 +108,23 @@ void interpreter_visitor::Visit(ast::ComparisonOpPtr op)
 	switch (op->GetOperationType())
 	{
 		case ast::ComparisonOp::types::Eq:
-		{
-			binary_op_dispatcher<eq> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<eq>(lhs, rhs));
 			break;
-		}
 		case ast::ComparisonOp::types::Ne:
-		{
-			binary_op_dispatcher<neq> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<neq>(lhs, rhs));
 			break;
-		}
 		case ast::ComparisonOp::types::Gt:
-		{
-			binary_op_dispatcher<gt> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<gt>(lhs, rhs));
 			break;
-		}
 		case ast::ComparisonOp::types::Gte:
-		{
-			binary_op_dispatcher<gte> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<gte>(lhs, rhs));
 			break;
-		}
 		case ast::ComparisonOp::types::Lt:
-		{
-			binary_op_dispatcher<lt> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<lt>(lhs, rhs));
 			break;
-		}
 		case ast::ComparisonOp::types::Lte:
-		{
-			binary_op_dispatcher<lte> v(lhs, rhs);
-			PushValue(apply_visitor(v, *lhs));
+			PushValue(apply_binary_op<lte>(lhs, rhs));
 			break;
-		}
 	}
 }
 
@@ -163,7 +134,7 @@ void interpreter_visitor::Visit(ast::LogicOpPtr op)
 
 	auto lhs = PopValue();
 
-	auto lhs_true = get_value_as<bool>(*lhs);
+	auto lhs_true = is_true(lhs);
 	switch (op->GetOperationType())
 	{
 		case ast::LogicOp::types::And:
@@ -172,22 +143,22 @@ void interpreter_visitor::Visit(ast::LogicOpPtr op)
 			{
 				op->GetRhs()->AcceptVisitor(this);
 				auto rhs = PopValue();
-				PushValue(std::make_shared<Boolean>(get_value_as<bool>(*rhs)));
+				PushValue(TaggedValue::FromBoolean(is_true(rhs)));
 				return;
 			}
-			PushValue(std::make_shared<Boolean>(false));
+			PushValue(TaggedValue::FromBoolean(false));
 			break;
 		}
 		case ast::LogicOp::types::Or:
 		{
 			if (lhs_true)
 			{
-				PushValue(std::make_shared<Boolean>(true));
+				PushValue(TaggedValue::FromBoolean(true));
 				return;
 			}
 			op->GetRhs()->AcceptVisitor(this);
 			auto rhs = PopValue();
-			PushValue(std::make_shared<Boolean>(get_value_as<bool>(*rhs)));
+			PushValue(TaggedValue::FromBoolean(is_true(rhs)));
 			break;
 		}
 	}
@@ -197,7 +168,15 @@ void interpreter_visitor::Visit(ast::AssignmentPtr a)
 {
 	a->GetRhs()->AcceptVisitor(this);
 	auto rhs = PopValue();
-	GetCurrentSymbolTable()->Assign(a->GetIdentifier()->GetIdentifier(), rhs);
+	const auto &identifier = a->GetIdentifier();
+	if (identifier->IsResolved())
+	{
+		GetSlot(identifier) = rhs;
+	}
+	else
+	{
+		GetCurrentSymbolTable()->AssignValue(identifier->GetIdentifier(), rhs);
+	}
 	PushValue(rhs);
 }
 
@@ -214,7 +193,7 @@ void interpreter_visitor::Visit(ast::IfStatementPtr i)
 
 	auto falseStatement = i->GetFalseStatement();
 
-	if (get_value_as<bool>(*condition))
+	if (is_true(condition))
 	{
 		i->GetTrueStatement()->AcceptVisitor(this);
 	}
@@ -230,7 +209,7 @@ void interpreter_visitor::Visit(ast::LoopPtr l)
 	{
 		l->GetCondition()->AcceptVisitor(this);
 		auto condition = PopValue();
-		if (!get_value_as<bool>(*condition))
+		if (!is_true(condition))
 		{
 			break;
 		}
@@ -242,28 +221,59 @@ void interpreter_visitor::Visit(ast::VarDeclPtr v)
 {
 	auto rhs = v->GetRhs();
 
+	TaggedValue value;
 	if (rhs)
 	{
 		rhs->AcceptVisitor(this);
-		GetCurrentSymbolTable()->Declare(v->GetIdentifier()->GetIdentifier(), PopValue());
+		value = PopValue();
 	}
 	else
 	{
-		GetCurrentSymbolTable()->Declare(v->GetIdentifier()->GetIdentifier(), std::make_shared<NullObject>());
+		value = TaggedValue::FromObject(std::make_shared<NullObject>());
+	}
+
+	const auto &identifier = v->GetIdentifier();
+	if (identifier->IsResolved())
+	{
+		GetSlot(identifier) = value;
+	}
+	else
+	{
+		GetCurrentSymbolTable()->DeclareValue(identifier->GetIdentifier(), value);
 	}
 }
 
 void interpreter_visitor::Visit(ast::StatementBlockPtr b)
 {
-	auto prevSymbolTable = GetCurrentSymbolTable();
-	EnterBlock();
-
-	for (const auto &statement : b->GetStatements())
+	// Blocks that don't declare variables don't need a scope
+	const auto slotCount = b->GetSlotCount();
+	if (slotCount == 0)
 	{
-		statement->AcceptVisitor(this);
+		for (const auto &statement : b->GetStatements())
+		{
+			statement->AcceptVisitor(this);
+		}
+		return;
 	}
 
-	ExitBlock(prevSymbolTable);
+	const auto base = m_slots.size();
+	m_scopeBases.push_back(base);
+	m_slots.resize(base + slotCount);
+	try
+	{
+		for (const auto &statement : b->GetStatements())
+		{
+			statement->AcceptVisitor(this);
+		}
+	}
+	catch (...)
+	{
+		m_slots.resize(base);
+		m_scopeBases.pop_back();
+		throw;
+	}
+	m_slots.resize(base);
+	m_scopeBases.pop_back();
 }
 
 void interpreter_visitor::EnterBlock()
@@ -298,13 +308,13 @@ void interpreter_visitor::Visit(ast::CallPtr c)
 {
 	c->GetCallee()->AcceptVisitor(this);
 	auto popped = PopValue();
-	auto callee = std::dynamic_pointer_cast<ICallable>(popped);
+	auto callee = std::dynamic_pointer_cast<ICallable>(popped.ToDynamicValue());
 
 	std::vector<DynamicValueBasePtr> args;
 	for (auto &a : c->GetArguments())
 	{
 		a->AcceptVisitor(this);
-		args.push_back(PopValue());
+		args.push_back(PopValue().ToDynamicValue());
 	}
 
 	if (!callee->IsVariadic() && callee->GetArity() != args.size())
@@ -312,6 +322,13 @@ void interpreter_visitor::Visit(ast::CallPtr c)
 		throw Exception("Wrong arity");
 	}
 
+	// Native functions don't use the interpreter's symbols, so they don't need a scope
+	if (callee->GetClosure() == nullptr)
+	{
+		PushValue(callee->Call(args));
+		return;
+	}
+
 	auto prevSymbolTable = GetCurrentSymbolTable();
 	EnterFunction(callee);
 	PushValue(callee->Call(args));
@@ -334,7 +351,14 @@ void interpreter_visitor::Visit(ast::FunctionDeclarationPtr func)
 	*/
 	callable->SetArity(parameters.size());
 
-	GetCurrentSymbolTable()->Declare(identifier->GetIdentifier(), callable);
+	if (identifier->IsResolved())
+	{
+		GetSlot(identifier) = TaggedValue::FromObject(callable);
+	}
+	else
+	{
+		GetCurrentSymbolTable()->Declare(identifier->GetIdentifier(), callable);
+	}
 }
 
 void interpreter_visitor::Visit(ast::ParameterPtr par) { throw Exception("Unimplemented"); }
@@ -345,7 +369,7 @@ void interpreter_visitor::Visit(ast::ReturnPtr r)
 	if (returnExression)
 	{
 		returnExression->AcceptVisitor(this);
-		throw static_cast<DynamicValueBasePtr>(PopValue());
+		throw PopValue().ToDynamicValue();
 	}
 
 	throw static_cast<DynamicValueBasePtr>(std::make_shared<NullObject>());
@@ -356,7 +380,14 @@ void interpreter_visitor::Visit(ast::ClassDeclarationPtr c)
 	auto &identifier = c->GetIdentifier();
 	auto klass = std::make_shared<DynamicClass>(identifier->GetIdentifier());
 
-	GetCurrentSymbolTable()->Declare(identifier->GetIdentifier(), klass);
+	if (identifier->IsResolved())
+	{
+		GetSlot(identifier) = TaggedValue::FromObject(klass);
+	}
+	else
+	{
+		GetCurrentSymbolTable()->Declare(identifier->GetIdentifier(), klass);
+	}
 
 	for (auto &m : c->GetMethods())
 	{
@@ -412,7 +443,7 @@ void interpreter_visitor::Visit(ast::AnonymousMethodPtr a)
 void interpreter_visitor::Visit(ast::GetExpressionPtr e)
 {
 	e->GetLhs()->AcceptVisitor(this);
-	auto lhs = std::dynamic_pointer_cast<ClassBase>(PopValue());
+	auto lhs = std::dynamic_pointer_cast<ClassBase>(PopValue().ToDynamicValue());
 	auto identifier = e->GetIdentifier()->GetIdentifier();
 
 	auto value = lhs->GetMember(identifier);
@@ -430,12 +461,12 @@ void interpreter_visitor::Visit(ast::GetExpressionPtr e)
 void interpreter_visitor::Visit(ast::SetExpressionPtr e)
 {
 	e->GetLhs()->AcceptVisitor(this);
-	auto lhs = std::dynamic_pointer_cast<ClassBase>(PopValue());
+	auto lhs = std::dynamic_pointer_cast<ClassBase>(PopValue().ToDynamicValue());
 	auto identifier = e->GetIdentifier()->GetIdentifier();
 	e->GetRhs()->AcceptVisitor(this);
 	auto rhs = PopValue();
 
-	lhs->GetInstanceValueTable()->Declare(identifier, rhs);
+	lhs->GetInstanceValueTable()->DeclareValue(identifier, rhs);
 	PushValue(rhs);
 }
 
@@ -447,9 +478,11 @@ void interpreter_visitor::Visit(ast::ProgramPtr p)
 	}
 }
 
-void interpreter_visitor::PushValue(const DynamicValueBasePtr &v) { m_values.push(v); }
+void interpreter_visitor::PushValue(const TaggedValue &v) { m_values.push(v); }
+
+void interpreter_visitor::PushValue(const DynamicValueBasePtr &v) { m_values.push(TaggedValue::FromDynamicValue(v)); }
 
-DynamicValueBasePtr interpreter_visitor::PopValue()
+TaggedValue interpreter_visitor::PopValue()
 {
 	m_lastValue = m_values.top();
 	m_values.pop();
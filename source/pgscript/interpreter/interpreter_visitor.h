@@ -2,8 +2,11 @@
 
 #include "../intermediate/ast_visitor.h"
 
+#include "dynamic_value/tagged_value.h"
+
 #include <memory>
 #include <stack>
+#include <vector>
 
 namespace pagoda
 {
@@ -51,8 +54,6 @@ class Program;
 using ProgramPtr = std::shared_ptr<Program>;
 }  // namespace ast
 
-class DynamicValueBase;
-using DynamicValueBasePtr = std::shared_ptr<DynamicValueBase>;
 class Function;
 using FunctionPtr = std::shared_ptr<Function>;
 class DynamicValueTable;
@@ -90,8 +91,9 @@ struct interpreter_visitor : public AstVisitor
 	void Visit(ast::VarDeclPtr v) override;
 	void Visit(ast::ParameterPtr p) override;
 
+	void PushValue(const TaggedValue &v);
 	void PushValue(const DynamicValueBasePtr &v);
-	DynamicValueBasePtr PopValue();
+	TaggedValue PopValue();
 
 	void EnterBlock();
 	void ExitBlock(const std::shared_ptr<DynamicValueTable> &previousSymbolTable);
@@ -99,13 +101,28 @@ struct interpreter_visitor : public AstVisitor
 	void ExitFunction(const std::shared_ptr<DynamicValueTable> &previousSymbolTable);
 
 	std::shared_ptr<DynamicValueTable> GetCurrentSymbolTable() { return m_symbolTable; }
+	void SetCurrentSymbolTable(const std::shared_ptr<DynamicValueTable> &symbolTable) { m_symbolTable = symbolTable; }
 	std::shared_ptr<DynamicValueTable> GetGlobals() { return m_globals; }
-	DynamicValueBasePtr GetLastEvaluatedExpression() const { return m_lastValue; }
+	DynamicValueBasePtr GetLastEvaluatedExpression() const { return m_lastValue.ToDynamicValue(); }
 
 private:
-	std::stack<DynamicValueBasePtr> m_values;
+	/**
+	 * Returns the slot of a variable declared in a statement block, resolved by the \c ScopeResolver.
+	 */
+	TaggedValue &GetSlot(const ast::IdentifierPtr &identifier)
+	{
+		return m_slots[m_scopeBases[m_scopeBases.size() - 1 - identifier->GetScopeDepth()] +
+		               identifier->GetScopeSlot()];
+	}
+
+	/// Integers, floats and booleans are kept unboxed in the stack.
+	std::stack<TaggedValue> m_values;
 	std::shared_ptr<DynamicValueTable> m_globals;
 	std::shared_ptr<DynamicValueTable> m_symbolTable;
-	DynamicValueBasePtr m_lastValue;
+	TaggedValue m_lastValue;
+	/// Values of the variables declared in statement blocks, for every block that is being run.
+	std::vector<TaggedValue> m_slots;
+	/// Index in m_slots of the first slot of each block that is being run and declares variables.
+	std::vector<std::size_t> m_scopeBases;
 };
 }  // namespace pagoda
@@ -0,0 +1,192 @@
+#include "virtual_machine.h"
+
+#include "dynamic_value/binding/tagged_ops.h"
+#include "dynamic_value/class_base.h"
+#include "dynamic_value/dynamic_value_table.h"
+#include "dynamic_value/function.h"
+#include "dynamic_value/icallable.h"
+
+#include "common/exception.h"
+
+namespace pagoda
+{
+VirtualMachine::VirtualMachine() {}
+
+VirtualMachine::~VirtualMachine() {}
+
+TaggedValue VirtualMachine::ApplyBinary(OpCode opCode, const TaggedValue &lhs, const TaggedValue &rhs)
+{
+	switch (opCode)
+	{
+		case OpCode::Add:
+			return apply_binary_op<add>(lhs, rhs);
+		case OpCode::Sub:
+			return apply_binary_op<sub>(lhs, rhs);
+		case OpCode::Mul:
+			return apply_binary_op<mul>(lhs, rhs);
+		case OpCode::Div:
+			return apply_binary_op<div>(lhs, rhs);
+		case OpCode::Eq:
+			return apply_binary_op<eq>(lhs, rhs);
+		case OpCode::Ne:
+			return apply_binary_op<neq>(lhs, rhs);
+		case OpCode::Gt:
+			return apply_binary_op<gt>(lhs, rhs);
+		case OpCode::Gte:
+			return apply_binary_op<gte>(lhs, rhs);
+		case OpCode::Lt:
+			return apply_binary_op<lt>(lhs, rhs);
+		case OpCode::Lte:
+			return apply_binary_op<lte>(lhs, rhs);
+		default:
+			throw Exception("Invalid binary operation");
+	}
+}
+
+TaggedValue VirtualMachine::ApplyUnary(OpCode opCode, const TaggedValue &value)
+{
+	if (opCode == OpCode::Minus)
+	{
+		return apply_unary_op<minus>(value);
+	}
+	return apply_unary_op<negate>(value);
+}
+
+bool VirtualMachine::IsTrue(const TaggedValue &value) { return is_true(value); }
+
+DynamicValueBasePtr VirtualMachine::Run(const BytecodeProgram &program,
+                                        const std::vector<DynamicValueBasePtr> &externals,
+                                        const std::shared_ptr<DynamicValueTable> &globals)
+{
+	m_stack.clear();
+	m_locals.assign(program.m_localCount, TaggedValue());
+	m_lastValue = TaggedValue();
+
+	const auto &instructions = program.m_instructions;
+	const auto instructionCount = instructions.size();
+	std::size_t pc = 0;
+	while (pc < instructionCount)
+	{
+		const auto &instruction = instructions[pc++];
+		switch (instruction.m_opCode)
+		{
+			case OpCode::PushConstant:
+				m_stack.push_back(program.m_constants[instruction.m_operand]);
+				break;
+			case OpCode::Pop:
+				m_lastValue = std::move(m_stack.back());
+				m_stack.pop_back();
+				break;
+			case OpCode::LoadLocal:
+				m_stack.push_back(m_locals[instruction.m_operand]);
+				break;
+			case OpCode::StoreLocal:
+				m_locals[instruction.m_operand] = m_stack.back();
+				break;
+			case OpCode::LoadExternal:
+			{
+				const auto slot = instruction.m_operand;
+				if (slot < externals.size() && externals[slot] != nullptr)
+				{
+					m_stack.push_back(TaggedValue::FromDynamicValue(externals[slot]));
+				}
+				else
+				{
+					m_stack.push_back(globals->GetValue(program.m_externals[slot]));
+				}
+				break;
+			}
+			case OpCode::LoadGlobal:
+				m_stack.push_back(globals->GetValue(program.m_names[instruction.m_operand]));
+				break;
+			case OpCode::StoreGlobal:
+				globals->AssignValue(program.m_names[instruction.m_operand], m_stack.back());
+				break;
+			case OpCode::DeclareGlobal:
+				globals->DeclareValue(program.m_names[instruction.m_operand], m_stack.back());
+				break;
+			case OpCode::GetMember:
+			{
+				auto object = std::dynamic_pointer_cast<ClassBase>(m_stack.back().ToDynamicValue());
+				const auto &name = program.m_names[instruction.m_operand];
+				if (object == nullptr)
+				{
+					throw Exception("Unable to get member '" + name + "' from a value without members");
+				}
+				auto value = object->GetMember(name);
+				if (auto method = std::dynamic_pointer_cast<Function>(value))
+				{
+					value = object->Bind(method->GetCallableBody(), globals);
+				}
+				m_stack.back() = TaggedValue::FromDynamicValue(value);
+				break;
+			}
+			case OpCode::Call:
+			{
+				const auto argumentCount = instruction.m_operand;
+				const auto firstArgument = m_stack.size() - argumentCount;
+				auto callee = std::dynamic_pointer_cast<ICallable>(m_stack[firstArgument - 1].ToDynamicValue());
+				if (callee == nullptr)
+				{
+					throw Exception("Unable to call a value that isn't callable");
+				}
+				if (!callee->IsVariadic() && callee->GetArity() != argumentCount)
+				{
+					throw Exception("Wrong arity");
+				}
+				std::vector<DynamicValueBasePtr> args;
+				args.reserve(argumentCount);
+				for (auto i = firstArgument; i < m_stack.size(); ++i)
+				{
+					args.push_back(m_stack[i].ToDynamicValue());
+				}
+				auto result = callee->Call(args);
+				m_stack.resize(firstArgument - 1);
+				m_stack.push_back(TaggedValue::FromDynamicValue(result));
+				break;
+			}
+			case OpCode::Add:
+			case OpCode::Sub:
+			case OpCode::Mul:
+			case OpCode::Div:
+			case OpCode::Eq:
+			case OpCode::Ne:
+			case OpCode::Gt:
+			case OpCode::Gte:
+			case OpCode::Lt:
+			case OpCode::Lte:
+			{
+				auto result = ApplyBinary(instruction.m_opCode, m_stack[m_stack.size() - 1], m_stack[m_stack.size() - 2]);
+				m_stack.pop_back();
+				m_stack.back() = std::move(result);
+				break;
+			}
+			case OpCode::Negate:
+			case OpCode::Minus:
+				m_stack.back() = ApplyUnary(instruction.m_opCode, m_stack.back());
+				break;
+			case OpCode::ToBoolean:
+				m_stack.back() = TaggedValue::FromBoolean(IsTrue(m_stack.back()));
+				break;
+			case OpCode::Jump:
+				pc = instruction.m_operand;
+				break;
+			case OpCode::JumpIfFalse:
+			case OpCode::JumpIfTrue:
+			{
+				m_lastValue = std::move(m_stack.back());
+				m_stack.pop_back();
+				if (IsTrue(m_lastValue) == (instruction.m_opCode == OpCode::JumpIfTrue))
+				{
+					pc = instruction.m_operand;
+				}
+				break;
+			}
+		}
+	}
+
+	return GetLastEvaluatedExpression();
+}
+
+DynamicValueBasePtr VirtualMachine::GetLastEvaluatedExpression() const { return m_lastValue.ToDynamicValue(); }
+}  // namespace pagoda
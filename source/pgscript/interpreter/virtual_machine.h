@@ -0,0 +1,61 @@
+#pragma once
+
+#include "bytecode.h"
+
+#include <memory>
+#include <vector>
+
+namespace pagoda
+{
+class DynamicValueTable;
+
+/**
+ * Runs the \c BytecodeProgram created by the \c BytecodeCompiler.
+ *
+ * Arithmetic and comparisons between integers, floats and booleans are done on unboxed values.
+ * Other values are boxed and use the same operators as the interpreter_visitor.
+ *
+ * The stack and the local slots are kept between runs so that running a program doesn't allocate
+ * unless it creates objects.
+ */
+class VirtualMachine
+{
+public:
+	VirtualMachine();
+	~VirtualMachine();
+
+	/**
+	 * Runs \p program.
+	 *
+	 * \p externals holds the value of each external variable of \p program. External variables
+	 * whose value is nullptr, as well as global symbols, are looked up in \p globals.
+	 *
+	 * Returns the last evaluated value.
+	 */
+	DynamicValueBasePtr Run(const BytecodeProgram &program, const std::vector<DynamicValueBasePtr> &externals,
+	                        const std::shared_ptr<DynamicValueTable> &globals);
+
+	/**
+	 * Returns the last value evaluated in the last call to Run().
+	 */
+	DynamicValueBasePtr GetLastEvaluatedExpression() const;
+
+	/**
+	 * Applies the binary operation \p opCode to \p lhs and \p rhs.
+	 */
+	static TaggedValue ApplyBinary(OpCode opCode, const TaggedValue &lhs, const TaggedValue &rhs);
+	/**
+	 * Applies the unary operation \p opCode to \p value.
+	 */
+	static TaggedValue ApplyUnary(OpCode opCode, const TaggedValue &value);
+	/**
+	 * Returns \p value as a boolean, as in the conditions of if statements and loops.
+	 */
+	static bool IsTrue(const TaggedValue &value);
+
+private:
+	std::vector<TaggedValue> m_stack;
+	std::vector<TaggedValue> m_locals;
+	TaggedValue m_lastValue;
+};
+}  // namespace pagoda
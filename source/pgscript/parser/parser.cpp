@@ -3,6 +3,7 @@
 #include "grammar.h"
 
 #include "../intermediate/ast.h"
+#include "../intermediate/scope_resolver.h"
 
 #include <boost/spirit/include/support_line_pos_iterator.hpp>
 
@@ -33,6 +34,10 @@ ast::ProgramPtr Parser::Parse(const std::string &source)
 		std::cout << line << std::endl;
 	}
 
+	if (program != nullptr)
+	{
+		ScopeResolver::Resolve(program);
+	}
 	return program;
 }
 }  // namespace pagoda
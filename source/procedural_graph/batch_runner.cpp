@@ -0,0 +1,274 @@
+#include "batch_runner.h"
+
+#include "compiled_graph_format.h"
+#include "graph.h"
+#include "node.h"
+#include "operation_node.h"
+#include "parameter_override.h"
+#include "reader.h"
+
+#include "common/exception.h"
+#include "common/file_util.h"
+#include "common/logger.h"
+#include "common/profiler.h"
+#include "dynamic_value/string_value.h"
+#include "dynamic_value/value_not_found.h"
+#include "procedural_objects/procedural_operation.h"
+
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace pagoda
+{
+namespace
+{
+/**
+ * Sets the output directory of every operation in \p nodes that writes files.
+ */
+void SetOutputDirectory(const NodeSet<Node> &nodes, const std::string &outputDirectory)
+{
+	for (const auto &n : nodes)
+	{
+		auto operationNode = std::dynamic_pointer_cast<OperationNode>(n);
+		if (operationNode == nullptr)
+		{
+			continue;
+		}
+		try
+		{
+			operationNode->GetOperation()->GetMember("output_directory");
+		}
+		catch (ValueNotFoundException &)
+		{
+			continue;
+		}
+		operationNode->RegisterOrSetMember("output_directory", std::make_shared<String>(outputDirectory));
+	}
+}
+
+std::string QuoteCsv(const std::string &field)
+{
+	std::string quoted = "\"";
+	for (auto c : field)
+	{
+		quoted += c;
+		if (c == '"')
+		{
+			quoted += c;
+		}
+	}
+	return quoted + "\"";
+}
+}  // namespace
+
+class BatchRunner::Impl
+{
+public:
+	using CompiledGraph_t = std::shared_ptr<const std::string>;
+
+	Impl(NodeFactoryPtr nodeFactory, uint32_t workerCount) : m_nodeFactory(nodeFactory), m_workerCount(workerCount)
+	{
+		if (m_workerCount == 0)
+		{
+			m_workerCount = std::max(1u, std::thread::hardware_concurrency());
+		}
+	}
+
+	std::vector<BatchJobResult> Run(const std::vector<BatchJob> &jobs)
+	{
+		START_PROFILE;
+
+		std::vector<BatchJobResult> results(jobs.size());
+		std::atomic<std::size_t> nextJob(0);
+		auto work = [&]() {
+			for (auto j = nextJob++; j < jobs.size(); j = nextJob++)
+			{
+				results[j] = RunJob(jobs[j]);
+			}
+		};
+
+		const auto threadCount = std::min<std::size_t>(m_workerCount, jobs.size());
+		std::vector<std::thread> workers;
+		for (auto i = 1u; i < threadCount; ++i)
+		{
+			workers.emplace_back(work);
+		}
+		work();
+		for (auto &w : workers)
+		{
+			w.join();
+		}
+		return results;
+	}
+
+	BatchJobResult RunJob(const BatchJob &job)
+	{
+		BatchJobResult result;
+		result.m_job = job;
+
+		const auto start = std::chrono::steady_clock::now();
+		try
+		{
+			auto compiled = GetCompiledGraph(job.m_graphFile);
+			GraphReader reader(m_nodeFactory);
+			auto graph = reader.ReadCompiled(compiled->data(), compiled->size());
+
+			auto nodes = graph->GetGraphNodes();
+			file_util::CreateDirectories(job.m_outputDirectory);
+			SetOutputDirectory(nodes, job.m_outputDirectory);
+			for (const auto &p : job.m_parameters)
+			{
+				OverrideParameter(nodes, p);
+			}
+
+			// Throws the errors writing the files of this job only, after they are all flushed
+			graph->Execute();
+			result.m_succeeded = true;
+		}
+		catch (const Exception &e)
+		{
+			result.m_error = e.What();
+		}
+		catch (const std::exception &e)
+		{
+			result.m_error = e.what();
+		}
+		result.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		LOG_INFO("Job '" << job.m_graphFile << "' -> '" << job.m_outputDirectory << "' "
+		                 << (result.m_succeeded ? "succeeded" : "failed: " + result.m_error) << " in "
+		                 << result.m_seconds << "s");
+		return result;
+	}
+
+	/**
+	 * Returns the graph in \p graphFile in the \c CompiledGraphFormat, parsing it the first time it is used.
+	 * Jobs that need a graph that is being parsed wait for it instead of parsing it again.
+	 */
+	CompiledGraph_t GetCompiledGraph(const std::string &graphFile)
+	{
+		std::promise<CompiledGraph_t> promise;
+		std::shared_future<CompiledGraph_t> future;
+		bool compile = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto iter = m_compiledGraphs.find(graphFile);
+			if (iter != m_compiledGraphs.end())
+			{
+				future = iter->second;
+			}
+			else
+			{
+				future = promise.get_future().share();
+				m_compiledGraphs.emplace(graphFile, future);
+				compile = true;
+			}
+		}
+
+		if (compile)
+		{
+			try
+			{
+				promise.set_value(CompileGraph(graphFile));
+			}
+			catch (...)
+			{
+				promise.set_exception(std::current_exception());
+			}
+		}
+		return future.get();
+	}
+
+	std::size_t GetLoadedGraphCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_compiledGraphs.size();
+	}
+
+	uint32_t GetWorkerCount() const { return m_workerCount; }
+
+private:
+	CompiledGraph_t CompileGraph(const std::string &graphFile)
+	{
+		LOG_TRACE(ProceduralGraph, "Loading graph for batch jobs: " << graphFile);
+		auto contents = file_util::LoadFileToString(graphFile);
+		if (boost::filesystem::path(graphFile).extension() == CompiledGraphFormat::s_extension)
+		{
+			if (!CompiledGraphFormat::HasMagic(contents.data(), contents.size()))
+			{
+				throw Exception("Not a compiled graph: " + graphFile);
+			}
+			return std::make_shared<const std::string>(std::move(contents));
+		}
+		GraphReader reader(m_nodeFactory);
+		return std::make_shared<const std::string>(reader.Compile(contents));
+	}
+
+	NodeFactoryPtr m_nodeFactory;
+	uint32_t m_workerCount;
+	std::unordered_map<std::string, std::shared_future<CompiledGraph_t>> m_compiledGraphs;
+	mutable std::mutex m_mutex;
+};
+
+BatchRunner::BatchRunner(NodeFactoryPtr nodeFactory, uint32_t workerCount)
+    : m_implementation(std::make_unique<Impl>(nodeFactory, workerCount))
+{
+}
+
+BatchRunner::~BatchRunner() {}
+
+std::vector<BatchJob> BatchRunner::ReadManifest(const std::string &manifest)
+{
+	std::vector<BatchJob> jobs;
+	std::istringstream lines(manifest);
+	std::string line;
+	for (auto lineNumber = 1u; std::getline(lines, line); ++lineNumber)
+	{
+		std::istringstream tokens(line);
+		BatchJob job;
+		if (!(tokens >> job.m_graphFile) || job.m_graphFile[0] == '#')
+		{
+			continue;
+		}
+		if (!(tokens >> job.m_outputDirectory))
+		{
+			throw Exception("Batch job in line " + std::to_string(lineNumber) + " has no output directory");
+		}
+		std::string parameter;
+		while (tokens >> parameter)
+		{
+			job.m_parameters.push_back(parameter);
+		}
+		jobs.push_back(job);
+	}
+	return jobs;
+}
+
+std::vector<BatchJobResult> BatchRunner::Run(const std::vector<BatchJob> &jobs)
+{
+	return m_implementation->Run(jobs);
+}
+
+void BatchRunner::WriteReport(const std::vector<BatchJobResult> &results, std::ostream &out)
+{
+	out << "job,graph,output_directory,status,seconds,error\n";
+	for (auto i = 0u; i < results.size(); ++i)
+	{
+		const auto &r = results[i];
+		out << i << "," << QuoteCsv(r.m_job.m_graphFile) << "," << QuoteCsv(r.m_job.m_outputDirectory) << ","
+		    << (r.m_succeeded ? "ok" : "failed") << "," << r.m_seconds << "," << QuoteCsv(r.m_error) << "\n";
+	}
+}
+
+uint32_t BatchRunner::GetWorkerCount() const { return m_implementation->GetWorkerCount(); }
+
+std::size_t BatchRunner::GetLoadedGraphCount() const { return m_implementation->GetLoadedGraphCount(); }
+}  // namespace pagoda
@@ -0,0 +1,94 @@
+#ifndef PAGODA_PROCEDURAL_GRAPH_BATCH_RUNNER_H_
+#define PAGODA_PROCEDURAL_GRAPH_BATCH_RUNNER_H_
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace pagoda
+{
+class NodeFactory;
+using NodeFactoryPtr = std::shared_ptr<NodeFactory>;
+
+/**
+ * A graph to execute with a set of parameter overrides, writing its files to an output directory.
+ */
+struct BatchJob
+{
+	/// The graph file, either in the text format or in the \c CompiledGraphFormat.
+	std::string m_graphFile;
+	/// Directory where the relative paths of the exported files are written.
+	std::string m_outputDirectory;
+	/// Parameter overrides in the '<node name>.<param name>=<value>' format.
+	std::vector<std::string> m_parameters;
+};
+
+/**
+ * The outcome of running a \c BatchJob.
+ */
+struct BatchJobResult
+{
+	BatchJob m_job;
+	bool m_succeeded = false;
+	/// The error that made the job fail.
+	std::string m_error;
+	/// Time spent in the job, including loading the graph.
+	double m_seconds = 0.0;
+};
+
+/**
+ * Runs many \c BatchJob in a pool of threads.
+ *
+ * Each graph file is parsed once and kept in the \c CompiledGraphFormat, from which every job
+ * that uses it creates its own \c Graph. Each worker holds at most one \c Graph at a time, so the
+ * memory used by the running jobs is bounded by the number of workers.
+ *
+ * The files exported by a job are flushed in the \c FileWriteGroup of its graph execution, so that a job
+ * only waits for its own files and only fails if one of them can't be written.
+ */
+class BatchRunner
+{
+public:
+	/**
+	 * Creates a \c BatchRunner that creates nodes with \p nodeFactory and runs \p workerCount jobs at a time.
+	 * If \p workerCount is 0, the number of hardware threads is used.
+	 */
+	BatchRunner(NodeFactoryPtr nodeFactory, uint32_t workerCount = 0);
+	~BatchRunner();
+
+	/**
+	 * Reads the jobs in the \p manifest, one per line.
+	 *
+	 * Each line has the graph file, the output directory and any number of parameter overrides, separated
+	 * by white space. Empty lines and lines starting with '#' are ignored.
+	 * Throws an \c Exception if a line doesn't have a graph file and an output directory.
+	 */
+	static std::vector<BatchJob> ReadManifest(const std::string &manifest);
+
+	/**
+	 * Runs all \p jobs, returning their results in the same order.
+	 * A job that fails doesn't stop the others.
+	 */
+	std::vector<BatchJobResult> Run(const std::vector<BatchJob> &jobs);
+
+	/**
+	 * Writes a report of \p results to \p out in the CSV format, with one line per job.
+	 */
+	static void WriteReport(const std::vector<BatchJobResult> &results, std::ostream &out);
+
+	uint32_t GetWorkerCount() const;
+
+	/**
+	 * Returns the number of graph files that have been parsed.
+	 */
+	std::size_t GetLoadedGraphCount() const;
+
+private:
+	class Impl;
+	std::unique_ptr<Impl> m_implementation;
+};  // class BatchRunner
+}  // namespace pagoda
+
+#endif
@@ -0,0 +1,270 @@
+#include "compiled_graph_format.h"
+
+#include "graph.h"
+#include "node.h"
+#include "reader/ast_node_visitor.h"
+#include "reader/graph_definition_node.h"
+#include "reader/named_argument.h"
+#include "reader/node_definition_node.h"
+#include "reader/node_link_node.h"
+
+#include "common/binary_stream.h"
+#include "common/exception.h"
+#include "common/profiler.h"
+
+#include "dynamic_value/expression.h"
+#include "dynamic_value/float_value.h"
+#include "dynamic_value/integer_value.h"
+#include "dynamic_value/string_value.h"
+#include "pgscript/interpreter/bytecode_serializer.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace pagoda
+{
+constexpr char CompiledGraphFormat::s_magic[4];
+
+namespace
+{
+void CheckLittleEndian()
+{
+	if (!CompiledGraphFormat::IsLittleEndian())
+	{
+		throw Exception("The compiled graph format is only supported in little-endian platforms");
+	}
+}
+
+/**
+ * Writes each node and edge while visiting a \c GraphDefinitionNode.
+ */
+class CompiledGraphWriterVisitor : public AstNodeVisitor
+{
+public:
+	explicit CompiledGraphWriterVisitor(std::string &buffer) : m_writer(buffer), m_nodeCount(0) {}
+
+	void Visit(GraphDefinitionNode *graphDefinition) override
+	{
+		const auto headerOffset = m_writer.GetSize();
+		CompiledGraphFormat::Header header;
+		std::memcpy(header.m_magic, CompiledGraphFormat::s_magic, sizeof(header.m_magic));
+		header.m_version = CompiledGraphFormat::s_version;
+		header.m_nodeCount = 0;
+		header.m_edgeCount = 0;
+		m_writer.Write(header);
+
+		// Nodes are written as they are defined and edges after all nodes, so edges are created last
+		for (const auto &statement : *graphDefinition)
+		{
+			statement->AcceptVisitor(this);
+		}
+		for (const auto &e : m_edges)
+		{
+			m_writer.Write(e.first);
+			m_writer.Write(e.second);
+		}
+
+		header.m_nodeCount = m_nodeCount;
+		header.m_edgeCount = static_cast<uint32_t>(m_edges.size());
+		m_writer.Overwrite(headerOffset, header);
+	}
+
+	void Visit(NamedArgument *namedArgument) override
+	{
+		m_writer.WriteString(namedArgument->GetName());
+		m_writer.Write(static_cast<uint8_t>(namedArgument->GetArgumentType()));
+		const auto &value = namedArgument->GetArgumentValue();
+		switch (namedArgument->GetArgumentType())
+		{
+			case NamedArgument::ArgumentType::String:
+				m_writer.WriteString(value);
+				break;
+			case NamedArgument::ArgumentType::Float:
+				m_writer.Write(static_cast<float>(std::atof(value.c_str())));
+				break;
+			case NamedArgument::ArgumentType::Integer:
+				m_writer.Write(static_cast<int32_t>(std::atoi(value.c_str())));
+				break;
+			case NamedArgument::ArgumentType::Expression:
+				WriteExpression(value);
+				break;
+		}
+	}
+
+	void Visit(NodeDefinitionNode *nodeDefinition) override
+	{
+		m_writer.WriteString(nodeDefinition->GetNodeName());
+		m_writer.WriteString(nodeDefinition->GetNodeType());
+		WriteArguments(nodeDefinition->GetConstructionArguments());
+		WriteArguments(nodeDefinition->GetExecutionArguments());
+		m_nodeIndices[nodeDefinition->GetNodeName()] = m_nodeCount++;
+	}
+
+	void Visit(NodeLinkNode *nodeLink) override
+	{
+		auto end = nodeLink->end();
+		auto prevNodeName = nodeLink->begin();
+		auto currentNodeName = std::next(prevNodeName);
+
+		while (currentNodeName != end)
+		{
+			auto prevNode = m_nodeIndices.find(*prevNodeName);
+			auto currNode = m_nodeIndices.find(*currentNodeName);
+
+			if (prevNode == std::end(m_nodeIndices) || currNode == std::end(m_nodeIndices))
+			{
+				throw Exception("Node not found while linking '" + (*prevNodeName) + "' to '" + (*currentNodeName) +
+				                "'");
+			}
+			m_edges.emplace_back(prevNode->second, currNode->second);
+
+			++prevNodeName;
+			++currentNodeName;
+		}
+	}
+
+private:
+	void WriteArguments(const std::vector<NamedArgumentPtr> &arguments)
+	{
+		m_writer.Write(static_cast<uint32_t>(arguments.size()));
+		for (const auto &a : arguments)
+		{
+			a->AcceptVisitor(this);
+		}
+	}
+
+	void WriteExpression(const std::string &expressionString)
+	{
+		auto expression = Expression::CreateExpression(expressionString);
+		auto bytecode = expression->GetBytecode();
+
+		m_writer.WriteString(expressionString);
+		m_writer.Write(static_cast<uint8_t>(bytecode != nullptr));
+		if (bytecode == nullptr)
+		{
+			return;
+		}
+
+		const auto &variables = expression->GetVariables();
+		m_writer.Write(static_cast<uint32_t>(variables.size()));
+		for (const auto &v : variables)
+		{
+			const auto &identifiers = v.GetIdentifiers();
+			m_writer.Write(static_cast<uint32_t>(identifiers.size()));
+			for (const auto &i : identifiers)
+			{
+				m_writer.WriteString(i);
+			}
+		}
+		BytecodeSerializer::Write(*bytecode, m_writer);
+	}
+
+	BinaryWriter m_writer;
+	uint32_t m_nodeCount;
+	std::unordered_map<std::string, uint32_t> m_nodeIndices;
+	std::vector<std::pair<uint32_t, uint32_t>> m_edges;
+};
+
+ExpressionPtr ReadExpression(BinaryReader &reader)
+{
+	auto expressionString = reader.ReadString();
+	if (reader.Read<uint8_t>() == 0)
+	{
+		return Expression::CreateExpression(expressionString);
+	}
+
+	std::vector<Variable> variables;
+	const auto variableCount = reader.Read<uint32_t>();
+	for (auto v = 0u; v < variableCount; ++v)
+	{
+		std::list<std::string> identifiers;
+		const auto identifierCount = reader.Read<uint32_t>();
+		for (auto i = 0u; i < identifierCount; ++i)
+		{
+			identifiers.push_back(reader.ReadString());
+		}
+		variables.emplace_back(identifiers);
+	}
+	return Expression::CreateCompiledExpression(expressionString, variables, BytecodeSerializer::Read(reader));
+}
+
+std::unordered_map<std::string, DynamicValueBasePtr> ReadArguments(BinaryReader &reader)
+{
+	std::unordered_map<std::string, DynamicValueBasePtr> arguments;
+	const auto count = reader.Read<uint32_t>();
+	for (auto a = 0u; a < count; ++a)
+	{
+		auto name = reader.ReadString();
+		DynamicValueBasePtr value;
+		switch (static_cast<NamedArgument::ArgumentType>(reader.Read<uint8_t>()))
+		{
+			case NamedArgument::ArgumentType::String:
+				value = std::make_shared<String>(reader.ReadString());
+				break;
+			case NamedArgument::ArgumentType::Float:
+				value = std::make_shared<FloatValue>(reader.Read<float>());
+				break;
+			case NamedArgument::ArgumentType::Integer:
+				value = std::make_shared<Integer>(static_cast<int>(reader.Read<int32_t>()));
+				break;
+			case NamedArgument::ArgumentType::Expression:
+				value = ReadExpression(reader);
+				break;
+			default:
+				throw Exception("Invalid argument type in compiled graph");
+		}
+		arguments[name] = value;
+	}
+	return arguments;
+}
+}  // namespace
+
+void CompiledGraphWriter::Write(GraphDefinitionNode &graphDefinition, std::string &buffer)
+{
+	START_PROFILE;
+	CheckLittleEndian();
+
+	CompiledGraphWriterVisitor visitor(buffer);
+	visitor.Visit(&graphDefinition);
+}
+
+void CompiledGraphReader::Read(const char *data, std::size_t size, GraphPtr graph)
+{
+	START_PROFILE;
+	CheckLittleEndian();
+
+	if (!CompiledGraphFormat::HasMagic(data, size))
+	{
+		throw Exception("Not a compiled graph");
+	}
+	BinaryReader reader(data, size);
+	auto header = reader.Read<CompiledGraphFormat::Header>();
+	if (header.m_version != CompiledGraphFormat::s_version)
+	{
+		throw Exception("Unsupported compiled graph version " + std::to_string(header.m_version));
+	}
+
+	std::vector<NodePtr> nodes;
+	for (auto n = 0u; n < header.m_nodeCount; ++n)
+	{
+		auto name = reader.ReadString();
+		auto node = graph->CreateNode(reader.ReadString());
+		node->SetName(name);
+		node->SetConstructionArguments(ReadArguments(reader));
+		node->SetExecutionArguments(ReadArguments(reader));
+		graph->AddNode(node);
+		nodes.push_back(node);
+	}
+
+	for (auto e = 0u; e < header.m_edgeCount; ++e)
+	{
+		const auto source = reader.Read<uint32_t>();
+		const auto target = reader.Read<uint32_t>();
+		if (source >= nodes.size() || target >= nodes.size())
+		{
+			throw Exception("Invalid edge in compiled graph");
+		}
+		graph->CreateEdge(nodes[source], nodes[target]);
+	}
+}
+}  // namespace pagoda
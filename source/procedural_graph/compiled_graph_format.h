@@ -0,0 +1,87 @@
+#ifndef PAGODA_PROCEDURAL_GRAPH_COMPILED_GRAPH_FORMAT_H_
+#define PAGODA_PROCEDURAL_GRAPH_COMPILED_GRAPH_FORMAT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace pagoda
+{
+class Graph;
+using GraphPtr = std::shared_ptr<Graph>;
+class GraphDefinitionNode;
+
+/**
+ * Binary format for graphs that have already been parsed, meant to be loaded without the graph grammar
+ * nor the pgscript parser.
+ *
+ * All values are little-endian. The file starts with a \c Header followed by:
+ *  - each node: its name, type, construction arguments and execution arguments
+ *  - each edge: the indices of its source and target nodes
+ *
+ * Arguments are stored with their name, their type and their value. Floats and integers are stored
+ * converted, and expressions are stored with their source, their variables and their bytecode. Expressions
+ * that can't be compiled are stored only with their source and are parsed when loading.
+ */
+struct CompiledGraphFormat
+{
+	static constexpr char s_magic[4] = {'P', 'G', 'G', 'C'};
+	static constexpr uint32_t s_version = 1;
+	/// Extension for files in this format, distinct from the operation cache entries.
+	static constexpr const char *s_extension = ".pgb";
+
+	struct Header
+	{
+		char m_magic[4];
+		uint32_t m_version;
+		uint32_t m_nodeCount;
+		uint32_t m_edgeCount;
+	};
+	static_assert(sizeof(Header) == 16, "Header must not have padding");
+
+	/**
+	 * Returns true if the \p size bytes of \p data start with the magic of this format.
+	 */
+	static bool HasMagic(const char *data, std::size_t size)
+	{
+		return size >= sizeof(s_magic) && std::memcmp(data, s_magic, sizeof(s_magic)) == 0;
+	}
+
+	static bool IsLittleEndian()
+	{
+		const uint32_t one = 1;
+		char firstByte;
+		std::memcpy(&firstByte, &one, 1);
+		return firstByte == 1;
+	}
+};  // struct CompiledGraphFormat
+
+/**
+ * Writes graph definitions in the \c CompiledGraphFormat.
+ */
+class CompiledGraphWriter
+{
+public:
+	/**
+	 * Appends the graph in \p graphDefinition to \p buffer.
+	 * Throws an \c Exception if a link refers to a node that hasn't been defined before it.
+	 */
+	static void Write(GraphDefinitionNode &graphDefinition, std::string &buffer);
+};  // class CompiledGraphWriter
+
+/**
+ * Reads graphs in the \c CompiledGraphFormat.
+ */
+class CompiledGraphReader
+{
+public:
+	/**
+	 * Adds the nodes and edges in the \p size bytes of \p data to \p graph.
+	 * Throws an \c Exception if \p data isn't a valid compiled graph.
+	 */
+	static void Read(const char *data, std::size_t size, GraphPtr graph);
+};  // class CompiledGraphReader
+}  // namespace pagoda
+
+#endif
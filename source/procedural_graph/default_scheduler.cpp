@@ -8,7 +8,11 @@ namespace pagoda
 {
 DefaultScheduler::DefaultScheduler(Graph &graph) : m_graph(graph), m_executionQueue(m_graph) {}
 
-void DefaultScheduler::Initialize() {}
+void DefaultScheduler::Initialize()
+{
+	// The scheduler is kept by the graph and runs again on every incremental execution
+	m_executionQueue.Reset();
+}
 
 bool DefaultScheduler::Step()
 {
@@ -20,29 +24,37 @@ bool DefaultScheduler::Step()
 		return false;
 	}
 
-	auto inNodes = m_graph.GetNodeInputNodes(nextNode);
-	auto outNodes = m_graph.GetNodeOutputNodes(nextNode);
+	if (!SendPreviousResults(m_graph, nextNode))
+	{
+		ExecuteNode(m_graph, nextNode);
+	}
+
+	return true;
+}
 
-	nextNode->SetExpressionVariables();
+void DefaultScheduler::Finalize() {}
+
+void DefaultScheduler::ExecuteNode(Graph &graph, NodePtr node)
+{
+	auto inNodes = graph.GetNodeInputNodes(node);
+	auto outNodes = graph.GetNodeOutputNodes(node);
+
+	node->SetExpressionVariables();
 	try
 	{
-		LOG_INFO("Executing node '" << nextNode->GetName() << "'");
-		nextNode->Execute(inNodes, outNodes);
+		LOG_INFO("Executing node '" << node->GetName() << "'");
+		node->Execute(inNodes, outNodes);
 	}
 	catch (Exception &e)
 	{
-		LOG_ERROR("Exception caught while executing Node " << nextNode->GetName() << "(" << nextNode->GetId() << ")");
+		LOG_ERROR("Exception caught while executing Node " << node->GetName() << "(" << node->GetId() << ")");
 		LOG_ERROR(e.What());
 	}
 	catch (...)
 	{
-		LOG_FATAL("Unknown exception caught while executing Node " << nextNode->GetName() << "(" << nextNode->GetId()
+		LOG_FATAL("Unknown exception caught while executing Node " << node->GetName() << "(" << node->GetId()
 		                                                           << ")");
 		throw;
 	}
-
-	return true;
 }
-
-void DefaultScheduler::Finalize() {}
 }  // namespace pagoda
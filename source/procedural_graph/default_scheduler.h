@@ -21,6 +21,11 @@ public:
 	bool Step() override;
     void Finalize() override;
 
+	/**
+	 * Executes \p node with its input and output nodes in \p graph, logging any \c Exception thrown.
+	 */
+	static void ExecuteNode(Graph &graph, NodePtr node);
+
 private:
 	using NodeWeakPtrSet = std::unordered_set<NodeWeakPtr, NodeWeakPtrHasher, NodeWeakPtrEqual>;
 
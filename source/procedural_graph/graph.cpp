@@ -1,13 +1,18 @@
 #include "graph.h"
 
 #include "common/assertions.h"
+#include "common/async_file_writer.h"
 #include "common/profiler.h"
 #include "default_scheduler.h"
+#include "dynamic_value/expression.h"
 #include "node.h"
 #include "node_factory.h"
 #include "unknown_node_type.h"
 
+#include "procedural_objects/procedural_object_arena.h"
+
 #include <array>
+#include <vector>
 
 namespace pagoda
 {
@@ -24,7 +29,23 @@ private:
 	using AdjacencyContainer = std::unordered_map<NodeWeakPtr, Adjacency, NodeWeakPtrHasher, NodeWeakPtrEqual>;
 
 public:
-	Impl(NodeFactoryPtr nodeFactory, Graph *graph) : m_nextNodeId(0), m_graph(graph), m_nodeFactory(nodeFactory) {}
+	Impl(NodeFactoryPtr nodeFactory, Graph *graph)
+	    : m_nextNodeId(0), m_graph(graph), m_nodeFactory(nodeFactory), m_executed(false)
+	{
+	}
+
+	~Impl()
+	{
+		if (!m_executed)
+		{
+			return;
+		}
+		// Kills the objects created by the nodes so that the memory of their arenas is released in one shot
+		for (const auto &n : m_nodes)
+		{
+			n->ClearResults();
+		}
+	}
 
 	void AddNode(NodePtr node)
 	{
@@ -55,6 +76,7 @@ public:
 		m_outputNodes.erase(node);
 		m_adjacencies.erase(node);
 
+		m_dirtyNodes.erase(node);
 		m_nodes.erase(node);
 	}
 
@@ -158,16 +180,95 @@ public:
 
 	void Execute()
 	{
-		IScheduler *scheduler = GetScheduler();
-		scheduler->Initialize();
-		while (true)
+		RunScheduler({});
+		m_executed = true;
+		m_dirtyNodes.clear();
+	}
+
+	void SetNodeDirty(NodePtr node)
+	{
+		m_dirtyNodes.insert(node);
+
+		// Collect the expressions of node and, transitively, all the expressions that depend on them
+		std::unordered_set<Expression *> dirtyExpressions;
+		std::vector<ExpressionPtr> pending;
+		for (auto parIter = node->GetMembersBegin(); parIter != node->GetMembersEnd(); ++parIter)
+		{
+			if (auto e = std::dynamic_pointer_cast<Expression>(parIter->second.m_value.ToDynamicValue()))
+			{
+				e->SetDirty();
+				pending.push_back(e);
+			}
+		}
+		while (!pending.empty())
+		{
+			auto e = pending.back();
+			pending.pop_back();
+			if (!dirtyExpressions.insert(e.get()).second)
+			{
+				continue;
+			}
+			for (const auto &dependent : e->GetDependentExpressions())
+			{
+				if (auto d = dependent.lock())
+				{
+					pending.push_back(d);
+				}
+			}
+		}
+
+		for (const auto &n : m_nodes)
 		{
-			if (!scheduler->Step())
+			for (auto parIter = n->GetMembersBegin(); parIter != n->GetMembersEnd(); ++parIter)
 			{
-				break;
+				auto e = std::dynamic_pointer_cast<Expression>(parIter->second.m_value.ToDynamicValue());
+				if (e != nullptr && dirtyExpressions.count(e.get()) > 0)
+				{
+					m_dirtyNodes.insert(n);
+					break;
+				}
 			}
 		}
-		scheduler->Finalize();
+	}
+
+	std::size_t ExecuteIncremental()
+	{
+		START_PROFILE;
+
+		if (!m_executed)
+		{
+			Execute();
+			return 0;
+		}
+
+		// Every node downstream of a dirty node has to be executed again
+		NodeSet<Node> cone;
+		std::vector<NodePtr> pending;
+		for (const auto &n : m_dirtyNodes)
+		{
+			pending.push_back(n.lock());
+		}
+		while (!pending.empty())
+		{
+			auto node = pending.back();
+			pending.pop_back();
+			if (!cone.insert(node).second)
+			{
+				continue;
+			}
+			for (const auto &n : OutNodes(node))
+			{
+				pending.push_back(n.lock());
+			}
+		}
+
+		for (const auto &n : cone)
+		{
+			n->ClearResults();
+		}
+		RunScheduler(cone);
+		m_dirtyNodes.clear();
+		return m_nodes.size() - cone.size();
 	}
 
 	NodePtr CreateNode(const std::string &nodeType)
@@ -182,6 +283,62 @@ public:
 	}
 
 private:
+	/**
+	 * Executes \p executedNodes, or all nodes if empty, with the \c IScheduler of the \c Graph.
+	 */
+	void RunScheduler(const NodeSet<Node> &executedNodes)
+	{
+		// The files written in this execution are flushed on their own, so that neither the writes nor the
+		// errors of other executions, possibly of other graphs in other threads, are waited for or reported
+		auto writeGroup = std::make_shared<FileWriteGroup>();
+		// The objects created in this execution are allocated in their own arena, which is released once they
+		// are all killed instead of being kept with the Graph
+		SetExecutionState(ProceduralObjectArena::Create(), writeGroup);
+
+		IScheduler *scheduler = GetScheduler();
+		try
+		{
+			scheduler->SetExecutedNodes(executedNodes);
+			scheduler->Initialize();
+			while (true)
+			{
+				if (!scheduler->Step())
+				{
+					break;
+				}
+			}
+			scheduler->Finalize();
+		}
+		catch (...)
+		{
+			SetExecutionState(nullptr, nullptr);
+			// Still wait for the files already scheduled, but report the error that stopped the execution
+			try
+			{
+				writeGroup->Flush();
+			}
+			catch (...)
+			{
+			}
+			throw;
+		}
+		SetExecutionState(nullptr, nullptr);
+		// Make sure every file written by the nodes is on disk by the time the execution finishes
+		writeGroup->Flush();
+	}
+
+	/**
+	 * Sets the arena in which the nodes allocate their objects and the group in which they write their files.
+	 */
+	void SetExecutionState(ProceduralObjectArenaPtr arena, FileWriteGroupPtr writeGroup)
+	{
+		for (const auto &n : m_nodes)
+		{
+			n->SetProceduralObjectArena(arena);
+			n->SetFileWriteGroup(writeGroup);
+		}
+	}
+
 	IScheduler *GetScheduler()
 	{
 		if (m_scheduler == nullptr)
@@ -211,6 +368,10 @@ private:
 	Graph *m_graph;
 	std::unique_ptr<IScheduler> m_scheduler;
 	NodeFactoryPtr m_nodeFactory;
+	/// Whether the whole \c Graph has been executed.
+	bool m_executed;
+	/// Nodes that need to be executed in the next call to ExecuteIncremental().
+	NodeWeakPtrSet m_dirtyNodes;
 };
 
 Graph::Graph(NodeFactoryPtr nodeFactory) : m_implementation(std::make_unique<Graph::Impl>(nodeFactory, this)) {}
@@ -254,6 +415,10 @@ NodePtr Graph::CreateNode(const std::string &nodeType) { return m_implementation
 
 void Graph::Execute() { m_implementation->Execute(); }
 
+void Graph::SetNodeDirty(NodePtr node) { m_implementation->SetNodeDirty(node); }
+
+std::size_t Graph::ExecuteIncremental() { return m_implementation->ExecuteIncremental(); }
+
 void Graph::SetSchedulerFactory(const SchedulerFactoryFunction_t &factoryFunction)
 {
 	s_schedulerFactoryFunction = factoryFunction;
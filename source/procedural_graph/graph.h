@@ -176,9 +176,25 @@ public:
 
     /**
      * Executes the \c Graph using the defined \c IScheduler.
+     * Returns once all the files written during the execution are on disk.
      */
     void Execute();
 
+	/**
+	 * Marks \p node as dirty so that it is executed again in the next call to ExecuteIncremental(),
+	 * together with every \c Node whose values depend on the expressions of \p node.
+	 * Must be called after changing the values of \p node.
+	 */
+	void SetNodeDirty(NodePtr node);
+
+	/**
+	 * Executes only the dirty \c Node and the \c Node downstream of them with the defined \c IScheduler,
+	 * reusing the results of the previous execution for all others. The first call executes the whole \c Graph.
+	 *
+	 * @return The number of \c Node that were skipped.
+	 */
+	std::size_t ExecuteIncremental();
+
 private:
 	class Impl;
 	std::unique_ptr<Impl> m_implementation;
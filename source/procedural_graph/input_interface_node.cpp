@@ -35,7 +35,12 @@ void InputInterfaceNode::SetConstructionArguments(
 void InputInterfaceNode::SetInterfaceName(const std::string& interfaceName) { m_interfaceName = interfaceName; }
 const std::string& InputInterfaceNode::GetInterfaceName() const { return m_interfaceName; }
 
-void InputInterfaceNode::AddProceduralObject(ProceduralObjectPtr object) { m_proceduralObjects.push_back(object); }
+void InputInterfaceNode::AddProceduralObjects(SharedProceduralObjectBatch objects)
+{
+	m_proceduralObjects.push_back(std::move(objects));
+}
+
+void InputInterfaceNode::ClearResults() { m_proceduralObjects.clear(); }
 
 void InputInterfaceNode::AcceptNodeVisitor(NodeVisitor* visitor)
 {
@@ -47,7 +52,7 @@ namespace
 class out_visitor : public NodeVisitor
 {
 public:
-	out_visitor(const std::string& name, std::list<ProceduralObjectPtr>& objects)
+	out_visitor(const std::string& name, const SharedProceduralObjectBatches& objects)
 	    : m_interfaceName(name), m_proceduralObjects(objects)
 	{
 	}
@@ -55,9 +60,9 @@ public:
 	void Visit(std::shared_ptr<OperationNode> n) override
 	{
 		ProceduralOperationPtr op = n->GetOperation();
-		for (auto object : m_proceduralObjects)
+		for (const auto& objects : m_proceduralObjects)
 		{
-			op->PushProceduralObject(m_interfaceName, object);
+			op->PushProceduralObjects(m_interfaceName, objects);
 		}
 	}
 
@@ -76,7 +81,7 @@ public:
 	void Visit(std::shared_ptr<RouterNode> n) override { throw UnsupportedNodeLink("input", "RouterNode"); }
 
 	const std::string& m_interfaceName;
-	std::list<ProceduralObjectPtr>& m_proceduralObjects;
+	const SharedProceduralObjectBatches& m_proceduralObjects;
 };
 }  // namespace
 
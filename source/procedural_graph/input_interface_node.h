@@ -4,14 +4,12 @@
 
 #include "node.h"
 
-#include <list>
+#include "procedural_objects/procedural_object_batch.h"
 
 namespace pagoda
 {
 class ProceduralOperation;
 using ProceduralOperationPtr = std::shared_ptr<ProceduralOperation>;
-class ProceduralObject;
-using ProceduralObjectPtr = std::shared_ptr<ProceduralObject>;
 
 class InputInterfaceNode : public Node
 {
@@ -24,16 +22,20 @@ public:
 	void SetConstructionArguments(const std::unordered_map<std::string, DynamicValueBasePtr>&) override;
 
 	void Execute(const NodeSet<Node>& inNodes, const NodeSet<Node>& outNodes) override;
+	void ClearResults() override;
 	void SetInterfaceName(const std::string& interfaceName);
 	const std::string& GetInterfaceName() const;
-	void AddProceduralObject(ProceduralObjectPtr object);
+	/**
+	 * Adds the \p objects sent by the previous node, without copying them.
+	 */
+	void AddProceduralObjects(SharedProceduralObjectBatch objects);
 	void AcceptNodeVisitor(NodeVisitor* visitor) override;
 
-	const std::list<ProceduralObjectPtr>& GetProceduralObjects() const { return m_proceduralObjects; }
+	ProceduralObjectBatch GetProceduralObjects() const { return FlattenProceduralObjectBatches(m_proceduralObjects); }
 
 private:
 	std::string m_interfaceName;
-	std::list<ProceduralObjectPtr> m_proceduralObjects;
+	SharedProceduralObjectBatches m_proceduralObjects;
 };  // class OperationExecution
 }  // namespace pagoda
 
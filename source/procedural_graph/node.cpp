@@ -30,7 +30,7 @@ void Node::SetExpressionVariables()
 {
 	for (auto parIter = GetMembersBegin(); parIter != GetMembersEnd(); ++parIter)
 	{
-		ExpressionPtr e = std::dynamic_pointer_cast<Expression>(parIter->second.m_value);
+		ExpressionPtr e = std::dynamic_pointer_cast<Expression>(parIter->second.m_value.ToDynamicValue());
 		if (e != nullptr)
 		{
 			for (const auto &var : e->GetVariables())
@@ -51,6 +51,8 @@ void Node::SetExpressionVariables()
 	}
 }
 
+void Node::SendResults(const NodeSet<Node> &outNodes) { Execute(NodeSet<Node>(), outNodes); }
+
 std::string Node::ToString() const { return "<Node>"; }
 
 void Node::AcceptVisitor(ValueVisitorBase &visitor) { throw Exception("Unimplemented"); }
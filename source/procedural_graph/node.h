@@ -83,6 +83,29 @@ public:
 	 */
 	virtual void Execute(const NodeSet<Node> &inNodes, const NodeSet<Node> &outNodes) = 0;
 
+	/**
+	 * Discards the objects received and created during the last execution, so that this \c Node
+	 * can be executed again.
+	 */
+	virtual void ClearResults() {}
+
+	/**
+	 * Sends the results of the last execution to \p outNodes again, without executing.
+	 *
+	 * The default implementation calls Execute(), which is right for nodes that only forward
+	 * what they received.
+	 */
+	virtual void SendResults(const NodeSet<Node> &outNodes);
+
+	/**
+	 * Sets the \c ProceduralObjectArena in which the objects created by this \c Node are allocated.
+	 */
+	virtual void SetProceduralObjectArena(ProceduralObjectArenaPtr arena) {}
+	/**
+	 * Sets the \c FileWriteGroup in which the files written by this \c Node are scheduled.
+	 */
+	virtual void SetFileWriteGroup(FileWriteGroupPtr group) {}
+
 	std::string ToString() const override;
 
 	void AcceptVisitor(ValueVisitorBase &visitor) override;
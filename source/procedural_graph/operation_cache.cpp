@@ -0,0 +1,673 @@
+#include "operation_cache.h"
+
+#include "common/exception.h"
+#include "common/file_util.h"
+#include "common/logger.h"
+#include "common/mapped_file.h"
+#include "common/profiler.h"
+#include "common/sha256.h"
+#include "dynamic_value/get_value_as.h"
+#include "dynamic_value/value_visitor.h"
+#include "geometry_core/geometry_binary_format.h"
+#include "procedural_objects/geometry_component.h"
+#include "procedural_objects/geometry_system.h"
+#include "procedural_objects/hierarchical_component.h"
+#include "procedural_objects/hierarchical_system.h"
+#include "procedural_objects/procedural_object.h"
+#include "procedural_objects/procedural_object_system.h"
+#include "procedural_objects/procedural_operation.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace pagoda
+{
+namespace
+{
+constexpr char s_magic[4] = {'P', 'G', 'O', 'C'};
+/// Increment whenever the way keys are computed or results are stored changes.
+constexpr uint32_t s_version = 3;
+constexpr const char *s_extension = ".pgc";
+
+/**
+ * Appends the fields that identify the results of an operation to a key.
+ */
+class KeyWriter
+{
+public:
+	explicit KeyWriter(std::string &key) : m_key(key) {}
+
+	void Add(const void *data, std::size_t size) { m_key.append(static_cast<const char *>(data), size); }
+
+	template<class T>
+	void AddValue(const T &value)
+	{
+		Add(&value, sizeof(T));
+	}
+
+	void AddString(const std::string &s)
+	{
+		AddValue<uint64_t>(s.size());
+		Add(s.data(), s.size());
+	}
+
+private:
+	std::string &m_key;
+};
+
+/**
+ * 64 bit FNV-1a hash of \p key, which names its entry.
+ */
+uint64_t HashKey(const std::string &key)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (const auto c : key)
+	{
+		hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+	}
+	return hash;
+}
+
+/**
+ * Adds the contents of a value to a key.
+ * Values whose contents can't be added, such as functions, make the whole key unusable.
+ */
+class ValueKeyWriter : public ValueVisitorBase
+{
+public:
+	explicit ValueKeyWriter(KeyWriter &writer) : m_writer(writer), m_usable(true) {}
+
+	void Visit(Boolean &v) override
+	{
+		m_writer.AddValue('b');
+		m_writer.AddValue(get_value_as<bool>(v));
+	}
+	void Visit(FloatValue &v) override
+	{
+		m_writer.AddValue('f');
+		m_writer.AddValue(get_value_as<float>(v));
+	}
+	void Visit(Integer &v) override
+	{
+		m_writer.AddValue('i');
+		m_writer.AddValue(get_value_as<int>(v));
+	}
+	void Visit(String &v) override
+	{
+		m_writer.AddValue('s');
+		m_writer.AddString(get_value_as<std::string>(v));
+	}
+	void Visit(NullObject &) override { m_writer.AddValue('n'); }
+	void Visit(TypeInfo &) override { m_usable = false; }
+	void Visit(Vector3 &v) override
+	{
+		const auto vector = static_cast<Vec3F>(v);
+		m_writer.AddValue('v');
+		for (auto c : {boost::qvm::X(vector), boost::qvm::Y(vector), boost::qvm::Z(vector)})
+		{
+			m_writer.AddValue(c);
+		}
+	}
+	void Visit(DynamicPlane &v) override
+	{
+		m_writer.AddValue('p');
+		m_writer.AddString(v.ToString());
+	}
+	void Visit(Function &) override { m_usable = false; }
+	void Visit(DynamicClass &) override { m_usable = false; }
+	void Visit(DynamicInstance &) override { m_usable = false; }
+	void Visit(Expression &e) override
+	{
+		// The expression is identified by its source and the values given to its variables
+		m_writer.AddValue('e');
+		m_writer.AddString(e.GetExpressionString());
+		std::vector<std::string> variables;
+		for (const auto &v : e.GetVariables())
+		{
+			variables.push_back(v.GetIdentifiers().front());
+		}
+		std::sort(variables.begin(), variables.end());
+		variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+		for (const auto &v : variables)
+		{
+			m_writer.AddString(v);
+			auto value = e.GetVariableValue(v);
+			if (value == nullptr)
+			{
+				m_writer.AddValue('u');
+			}
+			else
+			{
+				value->AcceptVisitor(*this);
+			}
+		}
+	}
+	void Visit(ProceduralOperation &) override
+	{
+		// Values read from the operation are its own values and input objects, which are hashed separately
+		m_writer.AddValue('o');
+	}
+
+	bool IsUsable() const { return m_usable; }
+
+private:
+	KeyWriter &m_writer;
+	bool m_usable;
+};
+
+/**
+ * Adds the members of \p object sorted by name to a key, skipping procedural objects.
+ */
+bool AddMembers(ClassBase &object, KeyWriter &writer)
+{
+	std::vector<std::pair<std::string, DynamicValueBasePtr>> members;
+	for (auto iter = object.GetMembersBegin(); iter != object.GetMembersEnd(); ++iter)
+	{
+		if (std::dynamic_pointer_cast<ProceduralObject>(iter->second.m_value.ToDynamicValue()) == nullptr)
+		{
+			members.emplace_back(iter->first, iter->second.m_value.ToDynamicValue());
+		}
+	}
+	std::sort(members.begin(), members.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+	ValueKeyWriter valueWriter(writer);
+	for (const auto &m : members)
+	{
+		writer.AddString(m.first);
+		m.second->AcceptVisitor(valueWriter);
+	}
+	return valueWriter.IsUsable();
+}
+
+/**
+ * Adds the faces of \p geometry, with the positions and normals of their points, its pending transform and
+ * \p scope to \p sha, reading them in place.
+ */
+void DigestGeometry(Geometry &geometry, const Mat3x4F &pendingTransform, bool hasPendingTransform,
+                    const Scope &scope, Sha256 &sha)
+{
+	START_PROFILE;
+
+	sha.UpdateValue(hasPendingTransform);
+	if (hasPendingTransform)
+	{
+		sha.UpdateValue(pendingTransform);
+	}
+	sha.UpdateValue(scope.GetPosition());
+	sha.UpdateValue(scope.GetSize());
+	sha.UpdateValue(scope.GetRotation());
+
+	for (auto f = geometry.FacesBegin(); f != geometry.FacesEnd(); ++f)
+	{
+		const Geometry::Index_t face = *f;
+		sha.UpdateValue(face);
+		sha.UpdateValue(geometry.GetFaceAttributes(face).m_normal);
+		uint32_t faceSize = 0;
+		for (auto fp = geometry.FacePointCirculatorBegin(face); fp; ++fp)
+		{
+			const Geometry::Index_t point = *fp;
+			sha.UpdateValue(point);
+			sha.UpdateValue(geometry.GetPosition(point));
+			sha.UpdateValue(geometry.GetVertexAttributes(point).m_normal);
+			++faceSize;
+		}
+		sha.UpdateValue(faceSize);
+	}
+	sha.UpdateValue(static_cast<uint64_t>(geometry.GetFaceCount()));
+}
+
+enum class ValueType : uint32_t
+{
+	Boolean,
+	Float,
+	Integer,
+	String,
+	Vector3
+};
+
+/**
+ * Appends 4 byte aligned fields to a buffer.
+ */
+class EntryWriter
+{
+public:
+	explicit EntryWriter(std::string &buffer) : m_buffer(buffer) {}
+
+	void Write(uint32_t v) { m_buffer.append(reinterpret_cast<const char *>(&v), sizeof(v)); }
+	void Write(int32_t v) { m_buffer.append(reinterpret_cast<const char *>(&v), sizeof(v)); }
+	void Write(float v) { m_buffer.append(reinterpret_cast<const char *>(&v), sizeof(v)); }
+	void Write(const std::string &s)
+	{
+		Write(static_cast<uint32_t>(s.size()));
+		m_buffer.append(s);
+		Pad();
+	}
+	void Pad() { m_buffer.append((4 - m_buffer.size() % 4) % 4, '\0'); }
+
+private:
+	std::string &m_buffer;
+};
+
+/**
+ * Reads the fields written by \c EntryWriter, throwing an \c Exception if the data is too short.
+ */
+class EntryReader
+{
+public:
+	EntryReader(const char *data, std::size_t size) : m_data(data), m_size(size), m_offset(0) {}
+
+	template<class T>
+	T Read()
+	{
+		T v;
+		std::memcpy(&v, Advance(sizeof(T)), sizeof(T));
+		return v;
+	}
+
+	std::string ReadString()
+	{
+		const auto size = Read<uint32_t>();
+		std::string s(Advance(size), size);
+		Pad();
+		return s;
+	}
+
+	const char *Advance(std::size_t size)
+	{
+		if (size > m_size - m_offset)
+		{
+			throw Exception("Truncated operation cache entry");
+		}
+		const char *data = m_data + m_offset;
+		m_offset += size;
+		return data;
+	}
+
+	void Pad() { Advance((4 - m_offset % 4) % 4); }
+
+private:
+	const char *m_data;
+	std::size_t m_size;
+	std::size_t m_offset;
+};
+
+/**
+ * Writes the members of \p object. Returns false if any of them can't be stored.
+ */
+bool WriteMembers(ProceduralObject &object, EntryWriter &writer)
+{
+	std::vector<std::pair<std::string, DynamicValueBasePtr>> members;
+	for (auto iter = object.GetMembersBegin(); iter != object.GetMembersEnd(); ++iter)
+	{
+		members.emplace_back(iter->first, iter->second.m_value.ToDynamicValue());
+	}
+	writer.Write(static_cast<uint32_t>(members.size()));
+	for (const auto &m : members)
+	{
+		writer.Write(m.first);
+		if (auto b = std::dynamic_pointer_cast<Boolean>(m.second))
+		{
+			writer.Write(static_cast<uint32_t>(ValueType::Boolean));
+			writer.Write(static_cast<uint32_t>(get_value_as<bool>(*b)));
+		}
+		else if (auto f = std::dynamic_pointer_cast<FloatValue>(m.second))
+		{
+			writer.Write(static_cast<uint32_t>(ValueType::Float));
+			writer.Write(get_value_as<float>(*f));
+		}
+		else if (auto i = std::dynamic_pointer_cast<Integer>(m.second))
+		{
+			writer.Write(static_cast<uint32_t>(ValueType::Integer));
+			writer.Write(static_cast<int32_t>(get_value_as<int>(*i)));
+		}
+		else if (auto s = std::dynamic_pointer_cast<String>(m.second))
+		{
+			writer.Write(static_cast<uint32_t>(ValueType::String));
+			writer.Write(get_value_as<std::string>(*s));
+		}
+		else if (auto v = std::dynamic_pointer_cast<Vector3>(m.second))
+		{
+			const auto vector = static_cast<Vec3F>(*v);
+			writer.Write(static_cast<uint32_t>(ValueType::Vector3));
+			writer.Write(boost::qvm::X(vector));
+			writer.Write(boost::qvm::Y(vector));
+			writer.Write(boost::qvm::Z(vector));
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void ReadMembers(ProceduralObject &object, EntryReader &reader)
+{
+	const auto memberCount = reader.Read<uint32_t>();
+	for (auto m = 0u; m < memberCount; ++m)
+	{
+		const auto name = reader.ReadString();
+		DynamicValueBasePtr value;
+		switch (static_cast<ValueType>(reader.Read<uint32_t>()))
+		{
+			case ValueType::Boolean:
+				value = std::make_shared<Boolean>(reader.Read<uint32_t>() != 0);
+				break;
+			case ValueType::Float:
+				value = std::make_shared<FloatValue>(reader.Read<float>());
+				break;
+			case ValueType::Integer:
+				value = std::make_shared<Integer>(static_cast<int>(reader.Read<int32_t>()));
+				break;
+			case ValueType::String:
+				value = std::make_shared<String>(reader.ReadString());
+				break;
+			case ValueType::Vector3:
+			{
+				const auto x = reader.Read<float>();
+				const auto y = reader.Read<float>();
+				const auto z = reader.Read<float>();
+				value = std::make_shared<Vector3>(Vec3F{x, y, z});
+				break;
+			}
+			default:
+				throw Exception("Invalid value in operation cache entry");
+		}
+		object.RegisterOrSetMember(name, value);
+	}
+}
+
+/// Written instead of an input index for objects without a \c HierarchicalComponent.
+constexpr int32_t s_noHierarchy = -2;
+/// Written instead of an input index for objects not linked to any input object.
+constexpr int32_t s_noLinkedInput = -1;
+}  // namespace
+
+class OperationCache::Impl
+{
+public:
+	explicit Impl(const std::string &directory) : m_directory(directory), m_hits(0), m_misses(0)
+	{
+		file_util::CreateDirectories(directory);
+	}
+
+	bool GetKey(const std::string &operationName, ProceduralOperation &operation, std::string &key) const
+	{
+		START_PROFILE;
+
+		if (!operation.IsCacheable())
+		{
+			return false;
+		}
+
+		key.clear();
+		KeyWriter writer(key);
+		writer.Add(s_magic, sizeof(s_magic));
+		writer.AddValue(s_version);
+		writer.AddString(operationName);
+		if (!AddMembers(operation, writer))
+		{
+			return false;
+		}
+
+		// The input objects are only added as a digest, which keeps keys and entries small however big they are
+		auto geometrySystem = operation.GetProceduralObjectSystem()->GetComponentSystem<GeometrySystem>();
+		Sha256 inputs;
+		std::string objectKey;
+		for (const auto &interface : operation.GetInputInterfaces())
+		{
+			inputs.UpdateValue<uint64_t>(interface.size());
+			inputs.Update(interface.data(), interface.size());
+			const auto &objects = operation.GetPendingInputObjects(interface);
+			inputs.UpdateValue<uint64_t>(objects.size());
+			for (const auto &object : objects)
+			{
+				objectKey.clear();
+				KeyWriter objectWriter(objectKey);
+				if (!AddMembers(*object, objectWriter))
+				{
+					return false;
+				}
+				inputs.UpdateValue<uint64_t>(objectKey.size());
+				inputs.Update(objectKey.data(), objectKey.size());
+
+				auto geometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(object);
+				Mat3x4F pendingTransform;
+				bool hasPendingTransform = false;
+				auto geometry =
+				    geometryComponent != nullptr
+				        ? geometrySystem->GetUntransformedGeometry(geometryComponent, pendingTransform, hasPendingTransform)
+				        : nullptr;
+				inputs.UpdateValue(geometry != nullptr);
+				if (geometry != nullptr)
+				{
+					DigestGeometry(*geometry, pendingTransform, hasPendingTransform, geometryComponent->GetScope(),
+					               inputs);
+				}
+			}
+		}
+		const auto digest = inputs.Finish();
+		writer.Add(digest.data(), digest.size());
+		return true;
+	}
+
+	bool Load(const std::string &key, const std::vector<ProceduralObjectPtr> &inputs,
+	          ProceduralObjectSystemPtr objectSystem, Outputs_t &outputs)
+	{
+		START_PROFILE;
+
+		const auto path = GetEntryPath(key);
+		if (!boost::filesystem::exists(path))
+		{
+			++m_misses;
+			return false;
+		}
+
+		Outputs_t loaded;
+		try
+		{
+			MappedFile file(path.string());
+			EntryReader reader(file.GetData(), file.GetSize());
+			if (std::memcmp(reader.Advance(sizeof(s_magic)), s_magic, sizeof(s_magic)) != 0 ||
+			    reader.Read<uint32_t>() != s_version)
+			{
+				throw Exception("Not an operation cache entry");
+			}
+			if (reader.ReadString() != key)
+			{
+				// Another key with the same hash
+				LOG_TRACE(ProceduralGraph, "Operation cache entry '" << path.string() << "' has a different key");
+				++m_misses;
+				return false;
+			}
+
+			auto geometrySystem = objectSystem->GetComponentSystem<GeometrySystem>();
+			auto hierarchicalSystem = objectSystem->GetComponentSystem<HierarchicalSystem>();
+			const auto objectCount = reader.Read<uint32_t>();
+			for (auto o = 0u; o < objectCount; ++o)
+			{
+				auto interface = reader.ReadString();
+				auto object = objectSystem->CreateProceduralObject();
+				loaded.emplace_back(interface, object);
+
+				const auto linkedInput = reader.Read<int32_t>();
+				if (linkedInput >= static_cast<int32_t>(inputs.size()))
+				{
+					throw Exception("Invalid input object in operation cache entry");
+				}
+				if (linkedInput != s_noHierarchy)
+				{
+					auto hierarchicalComponent = hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(object);
+					if (linkedInput != s_noLinkedInput)
+					{
+						// Same link as the one created by the operations
+						hierarchicalSystem->SetParent(
+						    hierarchicalComponent,
+						    hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inputs[linkedInput]));
+					}
+				}
+
+				ReadMembers(*object, reader);
+
+				const auto geometrySize = reader.Read<uint32_t>();
+				if (geometrySize > 0)
+				{
+					Scope scope;
+					auto geometry = GeometryBinaryReader<Geometry>::Read(reader.Advance(geometrySize), geometrySize, scope);
+					reader.Pad();
+					auto geometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(object);
+					geometryComponent->SetGeometry(geometry);
+					geometryComponent->SetScope(scope);
+				}
+			}
+			outputs.insert(outputs.end(), loaded.begin(), loaded.end());
+		}
+		catch (const Exception &e)
+		{
+			LOG_WARNING("Ignoring operation cache entry '" << path.string() << "': " << e.What());
+			for (auto &object : loaded)
+			{
+				objectSystem->KillProceduralObject(object.second);
+			}
+			++m_misses;
+			return false;
+		}
+
+		++m_hits;
+		return true;
+	}
+
+	void Store(const std::string &key, const std::vector<ProceduralObjectPtr> &inputs,
+	           ProceduralObjectSystemPtr objectSystem, const Outputs_t &outputs)
+	{
+		START_PROFILE;
+
+		auto geometrySystem = objectSystem->GetComponentSystem<GeometrySystem>();
+		auto hierarchicalSystem = objectSystem->GetComponentSystem<HierarchicalSystem>();
+
+		std::unordered_map<std::shared_ptr<HierarchicalComponent>, int32_t> inputIndices;
+		for (auto i = 0u; i < inputs.size(); ++i)
+		{
+			if (auto component = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inputs[i]))
+			{
+				inputIndices.emplace(component, static_cast<int32_t>(i));
+			}
+		}
+
+		std::string buffer;
+		EntryWriter writer(buffer);
+		buffer.append(s_magic, sizeof(s_magic));
+		writer.Write(s_version);
+		writer.Write(key);
+		writer.Write(static_cast<uint32_t>(outputs.size()));
+		for (const auto &output : outputs)
+		{
+			writer.Write(output.first);
+
+			auto linkedInput = s_noHierarchy;
+			if (auto component = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(output.second))
+			{
+				linkedInput = s_noLinkedInput;
+				for (const auto &input : inputIndices)
+				{
+					if (component->GetParent() == input.first || input.first->GetParent() == component)
+					{
+						linkedInput = input.second;
+						break;
+					}
+				}
+			}
+			writer.Write(linkedInput);
+
+			if (!WriteMembers(*output.second, writer))
+			{
+				LOG_TRACE(ProceduralGraph, "Not caching outputs with values that can't be stored");
+				return;
+			}
+
+			auto geometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(output.second);
+			auto geometry = geometryComponent != nullptr ? geometrySystem->GetGeometry(geometryComponent) : nullptr;
+			if (geometry == nullptr)
+			{
+				writer.Write(uint32_t{0});
+				continue;
+			}
+			const auto sizeOffset = buffer.size();
+			writer.Write(uint32_t{0});
+			GeometryBinaryWriter<Geometry>(geometry).Write(buffer, geometryComponent->GetScope());
+			const auto geometrySize = static_cast<uint32_t>(buffer.size() - sizeOffset - sizeof(uint32_t));
+			std::memcpy(&buffer[sizeOffset], &geometrySize, sizeof(geometrySize));
+			writer.Pad();
+		}
+
+		// Written to a temporary file first so that entries are never seen half written
+		const auto path = GetEntryPath(key);
+		auto temporaryPath = path;
+		temporaryPath += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+		std::FILE *file = std::fopen(temporaryPath.string().c_str(), "wb");
+		if (file == nullptr)
+		{
+			LOG_WARNING("Unable to write operation cache entry '" << temporaryPath.string() << "'");
+			return;
+		}
+		const auto written = std::fwrite(buffer.data(), 1, buffer.size(), file);
+		const auto closed = std::fclose(file);
+		boost::system::error_code error;
+		if (written == buffer.size() && closed == 0)
+		{
+			boost::filesystem::rename(temporaryPath, path, error);
+		}
+		if (written != buffer.size() || closed != 0 || error)
+		{
+			LOG_WARNING("Unable to write operation cache entry '" << path.string() << "'");
+			boost::filesystem::remove(temporaryPath, error);
+		}
+	}
+
+	boost::filesystem::path GetEntryPath(const std::string &key) const
+	{
+		std::stringstream name;
+		name << std::hex << std::setw(16) << std::setfill('0') << HashKey(key) << s_extension;
+		return boost::filesystem::path(m_directory) / name.str();
+	}
+
+	std::string m_directory;
+	std::atomic<std::size_t> m_hits;
+	std::atomic<std::size_t> m_misses;
+};  // class OperationCache::Impl
+
+OperationCache::OperationCache(const std::string &directory) : m_implementation(std::make_unique<Impl>(directory)) {}
+
+OperationCache::~OperationCache() {}
+
+bool OperationCache::GetKey(const std::string &operationName, ProceduralOperation &operation, std::string &key) const
+{
+	return m_implementation->GetKey(operationName, operation, key);
+}
+
+bool OperationCache::Load(const std::string &key, const std::vector<ProceduralObjectPtr> &inputs,
+                          ProceduralObjectSystemPtr objectSystem, Outputs_t &outputs)
+{
+	return m_implementation->Load(key, inputs, objectSystem, outputs);
+}
+
+void OperationCache::Store(const std::string &key, const std::vector<ProceduralObjectPtr> &inputs,
+                           ProceduralObjectSystemPtr objectSystem, const Outputs_t &outputs)
+{
+	m_implementation->Store(key, inputs, objectSystem, outputs);
+}
+
+const std::string &OperationCache::GetDirectory() const { return m_implementation->m_directory; }
+
+std::size_t OperationCache::GetHitCount() const { return m_implementation->m_hits; }
+
+std::size_t OperationCache::GetMissCount() const { return m_implementation->m_misses; }
+}  // namespace pagoda
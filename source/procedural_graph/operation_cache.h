@@ -0,0 +1,80 @@
+#ifndef PAGODA_PROCEDURAL_GRAPH_OPERATION_CACHE_H_
+#define PAGODA_PROCEDURAL_GRAPH_OPERATION_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pagoda
+{
+class ProceduralOperation;
+class ProceduralObject;
+using ProceduralObjectPtr = std::shared_ptr<ProceduralObject>;
+class ProceduralObjectSystem;
+using ProceduralObjectSystemPtr = std::shared_ptr<ProceduralObjectSystem>;
+
+/**
+ * Persistent cache for the output objects of \c ProceduralOperation, stored in a directory.
+ *
+ * Results are addressed by a key made of the registered name of the operation, its values and
+ * a SHA-256 digest of its pending input objects (their values, geometry, pending transform and scope),
+ * so that executing an operation with the same values on the same inputs can be replaced by loading
+ * its outputs. Entries are named after a hash of the key and store the key, which is compared when
+ * loading them.
+ *
+ * The geometry, scope and values of the output objects are stored, as well as the links in the
+ * hierarchy between each output object and the input objects.
+ */
+class OperationCache
+{
+public:
+	/// Output objects, each with the name of the output interface it was created in.
+	using Outputs_t = std::vector<std::pair<std::string, ProceduralObjectPtr>>;
+
+	/**
+	 * Creates an \c OperationCache that stores results in \p directory, creating it if needed.
+	 */
+	explicit OperationCache(const std::string &directory);
+	~OperationCache();
+
+	/**
+	 * Computes the key for the current values and pending input objects of \p operation, registered
+	 * as \p operationName in the \c OperationFactory.
+	 * Returns false if the results of \p operation can't be cached.
+	 */
+	bool GetKey(const std::string &operationName, ProceduralOperation &operation, std::string &key) const;
+
+	/**
+	 * Creates the output objects stored for \p key in \p outputs, linking them in the hierarchy
+	 * to the same objects in \p inputs as when they were stored.
+	 * Returns true on a hit and false on a miss.
+	 */
+	bool Load(const std::string &key, const std::vector<ProceduralObjectPtr> &inputs,
+	          ProceduralObjectSystemPtr objectSystem, Outputs_t &outputs);
+
+	/**
+	 * Stores the \p outputs created from \p inputs for \p key.
+	 * Outputs that can't be stored are ignored.
+	 */
+	void Store(const std::string &key, const std::vector<ProceduralObjectPtr> &inputs,
+	           ProceduralObjectSystemPtr objectSystem, const Outputs_t &outputs);
+
+	const std::string &GetDirectory() const;
+	/**
+	 * Returns the number of calls to \c Load() that found stored results.
+	 */
+	std::size_t GetHitCount() const;
+	/**
+	 * Returns the number of calls to \c Load() that didn't find stored results.
+	 */
+	std::size_t GetMissCount() const;
+
+private:
+	class Impl;
+	std::unique_ptr<Impl> m_implementation;
+};  // class OperationCache
+using OperationCachePtr = std::shared_ptr<OperationCache>;
+}  // namespace pagoda
+
+#endif
@@ -8,16 +8,22 @@
 #include "node.h"
 #include "node_set_visitor.h"
 #include "node_visitor.h"
+#include "operation_cache.h"
 #include "output_interface_node.h"
 #include "unsupported_node_link.h"
 
 #include "procedural_objects/operation_factory.h"
+#include "procedural_objects/procedural_object_system.h"
 #include "procedural_objects/procedural_operation.h"
 #include "procedural_objects/unknown_operation.h"
 
+#include <unordered_map>
+#include <vector>
+
 namespace pagoda
 {
 const char *OperationNode::name = "Operation";
+OperationCachePtr OperationNode::s_operationCache = nullptr;
 
 OperationNode::OperationNode(OperationFactoryPtr operationFactory) : m_operationFactory(operationFactory) {}
 OperationNode::~OperationNode() {}
@@ -31,18 +37,20 @@ void OperationNode::SetConstructionArguments(
 		throw ConstructionArgumentNotFound(GetName(), GetId(), "operation");
 	}
 
-	auto operation = m_operationFactory->Create(get_value_as<std::string>(*operationIter->second));
+	const auto operationName = get_value_as<std::string>(*operationIter->second);
+	auto operation = m_operationFactory->Create(operationName);
 	if (operation == nullptr)
 	{
-		throw UnknownOperation(get_value_as<std::string>(*operationIter->second));
+		throw UnknownOperation(operationName);
 	}
 
-	SetOperation(operation);
+	SetOperation(operation, operationName);
 }
 
-void OperationNode::SetOperation(ProceduralOperationPtr operation)
+void OperationNode::SetOperation(ProceduralOperationPtr operation, const std::string &operationName)
 {
 	m_operation = operation;
+	m_operationName = operationName;
 	RegisterOrSetMember("op", m_operation);
 }
 
@@ -56,7 +64,11 @@ namespace
 class out_visitor : public NodeVisitor
 {
 public:
-	out_visitor(ProceduralOperationPtr operation) : m_operation(operation) {}
+	out_visitor(const OperationNode::OutputObjects_t &outputs, std::unordered_map<std::string, uint32_t> &receivers,
+	            uint32_t nodeId)
+	    : m_outputs(outputs), m_receivers(receivers), m_nodeId(nodeId)
+	{
+	}
 
 	void Visit(std::shared_ptr<OperationNode> n) override { throw UnsupportedNodeLink("output", "OperationNode"); }
 
@@ -67,19 +79,27 @@ public:
 
 	void Visit(std::shared_ptr<OutputInterfaceNode> n) override
 	{
-		auto interface = n->GetInterfaceName();
-		ProceduralObjectPtr object = nullptr;
-		while ((object = m_operation->PopProceduralObject(interface)) != nullptr)
+		auto objects = m_outputs.find(n->GetInterfaceName());
+		if (objects == m_outputs.end() || objects->second == nullptr)
+		{
+			return;
+		}
+		// Each interface is only delivered to the first OutputInterfaceNode that receives it
+		auto receiver = m_receivers.emplace(n->GetInterfaceName(), n->GetId()).first;
+		if (receiver->second != n->GetId())
 		{
-			n->AddProceduralObject(object);
+			return;
 		}
+		n->AddProceduralObjects(objects->second);
 	}
 
 	void Visit(std::shared_ptr<ParameterNode> n) override { throw UnsupportedNodeLink("output", "ParameterNode"); }
 
 	void Visit(std::shared_ptr<RouterNode> n) override { throw UnsupportedNodeLink("input", "RouterNode"); }
 
-	ProceduralOperationPtr m_operation;
+	const OperationNode::OutputObjects_t &m_outputs;
+	std::unordered_map<std::string, uint32_t> &m_receivers;
+	uint32_t m_nodeId;
 };
 }  // namespace
 
@@ -99,13 +119,107 @@ void OperationNode::Execute(const NodeSet<Node> &inNodes, const NodeSet<Node> &o
 		}
 	}
 
-	m_operation->Execute();
+	auto cache = s_operationCache;
+	std::string key;
+	if (cache != nullptr && !m_operationName.empty() && cache->GetKey(m_operationName, *m_operation, key))
+	{
+		ProceduralObjectBatch inputs;
+		for (const auto &interface : m_operation->GetInputInterfaces())
+		{
+			const auto objects = m_operation->GetPendingInputObjects(interface);
+			inputs.insert(inputs.end(), objects.begin(), objects.end());
+		}
 
-	out_visitor v(m_operation);
+		auto objectSystem = m_operation->GetProceduralObjectSystem();
+		OperationCache::Outputs_t outputs;
+		if (cache->Load(key, inputs, objectSystem, outputs))
+		{
+			LOG_TRACE(ProceduralGraph, "Loaded the results of OperationNode " << GetName() << " from the cache");
+			m_operation->ClearInputs();
+
+			std::unordered_map<std::string, ProceduralObjectBatch> loaded;
+			for (auto &o : outputs)
+			{
+				loaded[o.first].push_back(o.second);
+			}
+			for (const auto &interface : m_operation->GetOutputInterfaces())
+			{
+				auto objects = loaded.find(interface);
+				m_outputs[interface] = objects == loaded.end()
+				                           ? nullptr
+				                           : std::make_shared<const ProceduralObjectBatch>(std::move(objects->second));
+			}
+		}
+		else
+		{
+			m_operation->Execute();
+			TakeOutputs();
+			for (const auto &interface : m_operation->GetOutputInterfaces())
+			{
+				if (const auto &objects = m_outputs[interface])
+				{
+					for (const auto &object : *objects)
+					{
+						outputs.emplace_back(interface, object);
+					}
+				}
+			}
+			cache->Store(key, inputs, objectSystem, outputs);
+		}
+	}
+	else
+	{
+		m_operation->Execute();
+		TakeOutputs();
+	}
+
+	m_receivers.clear();
+	SendResults(outNodes);
+}
+
+void OperationNode::SendResults(const NodeSet<Node> &outNodes)
+{
+	out_visitor v(m_outputs, m_receivers, GetId());
 	for (auto n : outNodes)
 	{
 		n->AcceptNodeVisitor(&v);
 	}
 }
 
+void OperationNode::ClearResults()
+{
+	m_operation->ClearInputs();
+	auto objectSystem = m_operation->GetProceduralObjectSystem();
+	for (auto &interfaceObjects : m_outputs)
+	{
+		if (interfaceObjects.second == nullptr)
+		{
+			continue;
+		}
+		for (auto object : *interfaceObjects.second)
+		{
+			objectSystem->KillProceduralObject(object);
+		}
+		interfaceObjects.second = nullptr;
+	}
+	m_receivers.clear();
+}
+
+void OperationNode::SetProceduralObjectArena(ProceduralObjectArenaPtr arena) { m_operation->SetArena(arena); }
+
+void OperationNode::SetFileWriteGroup(FileWriteGroupPtr group) { m_operation->SetFileWriteGroup(group); }
+
+void OperationNode::TakeOutputs()
+{
+	// The output interfaces of an operation don't change, so the entries in m_outputs are reused
+	for (const auto &interface : m_operation->GetOutputInterfaces())
+	{
+		m_outputs[interface] = m_operation->TakeOutputObjects(interface);
+	}
+}
+
+void OperationNode::SetOperationCache(OperationCachePtr cache) { s_operationCache = cache; }
+
+OperationCachePtr OperationNode::GetOperationCache() { return s_operationCache; }
+
 }  // namespace pagoda
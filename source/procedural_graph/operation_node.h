@@ -4,17 +4,23 @@
 
 #include "node.h"
 
+#include "procedural_objects/procedural_object_batch.h"
+
 namespace pagoda
 {
 class ProceduralOperation;
 using ProceduralOperationPtr = std::shared_ptr<ProceduralOperation>;
 class OperationFactory;
 using OperationFactoryPtr = std::shared_ptr<OperationFactory>;
+class OperationCache;
+using OperationCachePtr = std::shared_ptr<OperationCache>;
 
 class OperationNode : public Node
 {
 public:
 	static const char *name;
+	/// Output objects of the operation for each output interface.
+	using OutputObjects_t = std::unordered_map<std::string, SharedProceduralObjectBatch>;
 
 	OperationNode(OperationFactoryPtr operationFactory);
 	~OperationNode();
@@ -22,13 +28,50 @@ public:
 	void SetConstructionArguments(const std::unordered_map<std::string, DynamicValueBasePtr> &) override;
 
 	void Execute(const NodeSet<Node> &inNodes, const NodeSet<Node> &outNodes) override;
-	void SetOperation(ProceduralOperationPtr operation);
+	/**
+	 * Sends the output objects of the last execution to \p outNodes again.
+	 */
+	void SendResults(const NodeSet<Node> &outNodes) override;
+	/**
+	 * Clears the pending inputs of the operation and kills the output objects of the last execution.
+	 */
+	void ClearResults() override;
+	void SetProceduralObjectArena(ProceduralObjectArenaPtr arena) override;
+	void SetFileWriteGroup(FileWriteGroupPtr group) override;
+	/**
+	 * Sets the operation executed by this node. Its results are only cached if \p operationName, the name it
+	 * is registered with in the \c OperationFactory, is given.
+	 */
+	void SetOperation(ProceduralOperationPtr operation, const std::string &operationName = "");
 	ProceduralOperationPtr GetOperation() const { return m_operation; }
 	void AcceptNodeVisitor(NodeVisitor *visitor) override;
 
+	/**
+	 * Sets the \c OperationCache used by all \c OperationNode to skip executing operations whose
+	 * results are already cached. Caching is disabled with a nullptr (the default).
+	 */
+	static void SetOperationCache(OperationCachePtr cache);
+	/**
+	 * Returns the \c OperationCache used by all \c OperationNode.
+	 */
+	static OperationCachePtr GetOperationCache();
+
 private:
+	/**
+	 * Takes the objects in the output interfaces of the operation to m_outputs.
+	 */
+	void TakeOutputs();
+
 	ProceduralOperationPtr m_operation;
+	/// Name of the operation in the \c OperationFactory, which identifies it in the \c OperationCache.
+	std::string m_operationName;
 	OperationFactoryPtr m_operationFactory;
+	/// The output objects of the last execution.
+	OutputObjects_t m_outputs;
+	/// The id of the \c OutputInterfaceNode that received each output interface.
+	std::unordered_map<std::string, uint32_t> m_receivers;
+
+	static OperationCachePtr s_operationCache;
 };  // class OperationNode
 }  // namespace pagoda
 
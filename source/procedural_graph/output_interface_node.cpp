@@ -41,22 +41,27 @@ void OutputInterfaceNode::AcceptNodeVisitor(NodeVisitor* visitor)
 	visitor->Visit(std::dynamic_pointer_cast<OutputInterfaceNode>(shared_from_this()));
 }
 
-void OutputInterfaceNode::AddProceduralObject(ProceduralObjectPtr object) { m_proceduralObjects.push_back(object); }
+void OutputInterfaceNode::AddProceduralObjects(SharedProceduralObjectBatch objects)
+{
+	m_proceduralObjects.push_back(std::move(objects));
+}
+
+void OutputInterfaceNode::ClearResults() { m_proceduralObjects.clear(); }
 
 namespace
 {
 class out_visitor : public NodeVisitor
 {
 public:
-	out_visitor(std::list<ProceduralObjectPtr>& objects) : m_proceduralObjects(objects) {}
+	out_visitor(const SharedProceduralObjectBatches& objects) : m_proceduralObjects(objects) {}
 
 	void Visit(std::shared_ptr<OperationNode> n) override { throw UnsupportedNodeLink("input", "OperationNode"); }
 
 	void Visit(std::shared_ptr<InputInterfaceNode> n) override
 	{
-		for (auto o : m_proceduralObjects)
+		for (const auto& objects : m_proceduralObjects)
 		{
-			n->AddProceduralObject(o);
+			n->AddProceduralObjects(objects);
 		}
 	}
 
@@ -69,13 +74,13 @@ public:
 
 	void Visit(std::shared_ptr<RouterNode> n) override
 	{
-		for (auto o : m_proceduralObjects)
+		for (const auto& objects : m_proceduralObjects)
 		{
-			n->AddProceduralObject(o);
+			n->AddProceduralObjects(objects);
 		}
 	}
 
-	std::list<ProceduralObjectPtr>& m_proceduralObjects;
+	const SharedProceduralObjectBatches& m_proceduralObjects;
 };
 }  // namespace
 
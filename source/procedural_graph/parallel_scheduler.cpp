@@ -0,0 +1,336 @@
+#include "parallel_scheduler.h"
+
+#include "execution_queue.h"
+#include "graph.h"
+#include "node.h"
+#include "parameter_node.h"
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "common/profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace pagoda
+{
+class ParallelScheduler::Impl
+{
+public:
+	Impl(ParallelScheduler &scheduler, Graph &graph, uint32_t workerCount)
+	    : m_scheduler(scheduler), m_graph(graph), m_workerCount(workerCount), m_executed(false)
+	{
+		if (m_workerCount == 0)
+		{
+			m_workerCount = std::max(1u, std::thread::hardware_concurrency());
+		}
+	}
+
+	void Initialize()
+	{
+		START_PROFILE;
+
+		m_tasks.clear();
+		m_executed = false;
+
+		// The execution order of the DefaultScheduler is used to serialize nodes that share state
+		ExecutionQueue queue(m_graph);
+		std::unordered_map<NodePtr, std::size_t> nodeIndices;
+		NodePtr node = nullptr;
+		while ((node = queue.GetNextNode()) != nullptr)
+		{
+			nodeIndices.emplace(node, m_tasks.size());
+			m_tasks.push_back(Task{node, m_graph.GetNodeInputNodes(node), m_graph.GetNodeOutputNodes(node), {}});
+		}
+
+		std::vector<std::set<std::size_t>> dependencies(m_tasks.size());
+		for (auto i = 0u; i < m_tasks.size(); ++i)
+		{
+			std::vector<std::size_t> writers;
+			for (const auto &in : m_tasks[i].m_inNodes)
+			{
+				writers.push_back(nodeIndices[in]);
+				dependencies[i].insert(nodeIndices[in]);
+			}
+			// Nodes writing into the same node must keep the sequential order
+			AddOrderingDependencies(writers, dependencies);
+
+			if (std::dynamic_pointer_cast<ParameterNode>(m_tasks[i].m_node) != nullptr)
+			{
+				// Nodes receiving parameters from the same ParameterNode share their values
+				std::vector<std::size_t> consumers;
+				CollectParameterConsumers(i, nodeIndices, consumers);
+				AddOrderingDependencies(consumers, dependencies);
+			}
+		}
+
+		m_pendingDependencies = std::vector<std::atomic<std::size_t>>(m_tasks.size());
+		for (auto i = 0u; i < m_tasks.size(); ++i)
+		{
+			m_pendingDependencies[i] = dependencies[i].size();
+			for (auto d : dependencies[i])
+			{
+				m_tasks[d].m_dependents.push_back(i);
+			}
+		}
+	}
+
+	bool Step()
+	{
+		START_PROFILE;
+
+		if (m_executed || m_tasks.empty())
+		{
+			return false;
+		}
+		m_executed = true;
+
+		m_completedTasks = 0;
+		m_queuedTasks = 0;
+		m_finished = false;
+		m_exception = nullptr;
+		m_queues.clear();
+		for (auto i = 0u; i < m_workerCount; ++i)
+		{
+			m_queues.push_back(std::make_unique<WorkQueue>());
+		}
+
+		uint32_t nextQueue = 0;
+		for (auto i = 0u; i < m_tasks.size(); ++i)
+		{
+			if (m_pendingDependencies[i] == 0)
+			{
+				Push(nextQueue, i);
+				nextQueue = (nextQueue + 1) % m_workerCount;
+			}
+		}
+
+		std::vector<std::thread> workers;
+		for (auto i = 1u; i < m_workerCount; ++i)
+		{
+			workers.emplace_back(&Impl::Work, this, i);
+		}
+		Work(0);
+		for (auto &w : workers)
+		{
+			w.join();
+		}
+
+		if (m_exception != nullptr)
+		{
+			std::rethrow_exception(m_exception);
+		}
+
+		return false;
+	}
+
+	uint32_t GetWorkerCount() const { return m_workerCount; }
+
+private:
+	struct Task
+	{
+		NodePtr m_node;
+		NodeSet<Node> m_inNodes;
+		NodeSet<Node> m_outNodes;
+		std::vector<std::size_t> m_dependents;
+	};
+
+	struct WorkQueue
+	{
+		std::mutex m_mutex;
+		std::deque<std::size_t> m_tasks;
+	};
+
+	void AddOrderingDependencies(std::vector<std::size_t> &tasks, std::vector<std::set<std::size_t>> &dependencies)
+	{
+		std::sort(tasks.begin(), tasks.end());
+		for (auto i = 1u; i < tasks.size(); ++i)
+		{
+			dependencies[tasks[i]].insert(tasks[i - 1]);
+		}
+	}
+
+	void CollectParameterConsumers(std::size_t parameterTask,
+	                               std::unordered_map<NodePtr, std::size_t> &nodeIndices,
+	                               std::vector<std::size_t> &consumers)
+	{
+		for (const auto &out : m_tasks[parameterTask].m_outNodes)
+		{
+			auto outIndex = nodeIndices[out];
+			if (std::find(consumers.begin(), consumers.end(), outIndex) != consumers.end())
+			{
+				continue;
+			}
+			consumers.push_back(outIndex);
+			if (std::dynamic_pointer_cast<ParameterNode>(out) != nullptr)
+			{
+				CollectParameterConsumers(outIndex, nodeIndices, consumers);
+			}
+		}
+	}
+
+	void Push(uint32_t queue, std::size_t task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			++m_queuedTasks;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_queues[queue]->m_mutex);
+			m_queues[queue]->m_tasks.push_back(task);
+		}
+		m_wakeUp.notify_one();
+	}
+
+	bool Pop(uint32_t worker, std::size_t &task)
+	{
+		// Own queue is consumed LIFO to keep following a branch of the graph
+		{
+			auto &queue = *m_queues[worker];
+			std::lock_guard<std::mutex> lock(queue.m_mutex);
+			if (!queue.m_tasks.empty())
+			{
+				task = queue.m_tasks.back();
+				queue.m_tasks.pop_back();
+				--m_queuedTasks;
+				return true;
+			}
+		}
+
+		// Steal the oldest task from the other workers
+		for (auto i = 1u; i < m_workerCount; ++i)
+		{
+			auto &queue = *m_queues[(worker + i) % m_workerCount];
+			std::lock_guard<std::mutex> lock(queue.m_mutex);
+			if (!queue.m_tasks.empty())
+			{
+				task = queue.m_tasks.front();
+				queue.m_tasks.pop_front();
+				--m_queuedTasks;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Work(uint32_t worker)
+	{
+		while (!m_finished)
+		{
+			std::size_t task;
+			if (!Pop(worker, task))
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wakeUp.wait(lock, [this]() { return m_finished || m_queuedTasks > 0; });
+				if (m_finished)
+				{
+					return;
+				}
+				continue;
+			}
+
+			if (!Execute(task))
+			{
+				Finish();
+				return;
+			}
+
+			for (auto d : m_tasks[task].m_dependents)
+			{
+				if (--m_pendingDependencies[d] == 0)
+				{
+					Push(worker, d);
+				}
+			}
+
+			if (++m_completedTasks == m_tasks.size())
+			{
+				Finish();
+				return;
+			}
+		}
+	}
+
+	bool Execute(std::size_t taskIndex)
+	{
+		auto &task = m_tasks[taskIndex];
+		if (m_scheduler.SendPreviousResults(m_graph, task.m_node))
+		{
+			return true;
+		}
+
+		task.m_node->SetExpressionVariables();
+		try
+		{
+			LOG_INFO("Executing node '" << task.m_node->GetName() << "'");
+			task.m_node->Execute(task.m_inNodes, task.m_outNodes);
+		}
+		catch (Exception &e)
+		{
+			LOG_ERROR("Exception caught while executing Node " << task.m_node->GetName() << "("
+			                                                   << task.m_node->GetId() << ")");
+			LOG_ERROR(e.What());
+		}
+		catch (...)
+		{
+			LOG_FATAL("Unknown exception caught while executing Node " << task.m_node->GetName() << "("
+			                                                           << task.m_node->GetId() << ")");
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_exception == nullptr)
+			{
+				m_exception = std::current_exception();
+			}
+			return false;
+		}
+		return true;
+	}
+
+	void Finish()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_finished = true;
+		}
+		m_wakeUp.notify_all();
+	}
+
+	ParallelScheduler &m_scheduler;
+	Graph &m_graph;
+	uint32_t m_workerCount;
+	bool m_executed;
+
+	std::vector<Task> m_tasks;
+	std::vector<std::atomic<std::size_t>> m_pendingDependencies;
+	std::vector<std::unique_ptr<WorkQueue>> m_queues;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wakeUp;
+	std::atomic<std::size_t> m_queuedTasks;
+	std::atomic<std::size_t> m_completedTasks;
+	std::atomic<bool> m_finished;
+	std::exception_ptr m_exception;
+};
+
+ParallelScheduler::ParallelScheduler(Graph &graph, uint32_t workerCount)
+    : m_implementation(std::make_unique<ParallelScheduler::Impl>(*this, graph, workerCount))
+{
+}
+
+ParallelScheduler::~ParallelScheduler() {}
+
+void ParallelScheduler::Initialize() { m_implementation->Initialize(); }
+
+bool ParallelScheduler::Step() { return m_implementation->Step(); }
+
+void ParallelScheduler::Finalize() {}
+
+uint32_t ParallelScheduler::GetWorkerCount() const { return m_implementation->GetWorkerCount(); }
+}  // namespace pagoda
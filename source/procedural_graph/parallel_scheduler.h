@@ -0,0 +1,51 @@
+#ifndef PAGODA_PROCEDURAL_GRAPH_PARALLEL_SCHEDULER_H_
+#define PAGODA_PROCEDURAL_GRAPH_PARALLEL_SCHEDULER_H_
+
+#include "scheduler.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace pagoda
+{
+class Graph;
+
+/**
+ * An \c IScheduler that executes independent \c Node objects concurrently.
+ *
+ * A \c Node becomes ready as soon as all of its input nodes have finished. Ready nodes are
+ * distributed amongst a pool of workers, each owning a queue, and idle workers steal nodes
+ * from the other queues.
+ *
+ * Output is deterministic. Whenever several nodes write into the same \c Node (e.g. the
+ * \c OutputInterfaceNode objects feeding an \c InputInterfaceNode) or share the parameters of
+ * a \c ParameterNode, they are executed in the same relative order as in the \c DefaultScheduler.
+ *
+ * Since the whole graph is executed concurrently, the first call to \c Step() executes all
+ * nodes and returns false.
+ */
+class ParallelScheduler : public IScheduler
+{
+public:
+	/**
+	 * Constructs a \c ParallelScheduler for \p graph with \p workerCount workers.
+	 * If \p workerCount is 0, the number of hardware threads is used.
+	 */
+	ParallelScheduler(Graph &graph, uint32_t workerCount = 0);
+	~ParallelScheduler() override;
+
+	void Initialize() override;
+	bool Step() override;
+	void Finalize() override;
+
+	/**
+	 * Returns the number of workers used to execute the \c Graph.
+	 */
+	uint32_t GetWorkerCount() const;
+
+private:
+	class Impl;
+	std::unique_ptr<Impl> m_implementation;
+};  // class ParallelScheduler
+}  // namespace pagoda
+#endif
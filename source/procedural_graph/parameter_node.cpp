@@ -33,7 +33,7 @@ void ParameterNode::Execute(const NodeSet<Node> &inNodes, const NodeSet<Node> &o
 	{
 		for (const auto &outNode : outNodes)
 		{
-			outNode->RegisterOrSetMember(parIter->first, parIter->second.m_value);
+			outNode->RegisterOrSetMember(parIter->first, parIter->second.m_value.ToDynamicValue());
 		}
 	}
 }
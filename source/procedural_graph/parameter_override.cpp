@@ -0,0 +1,71 @@
+#include "parameter_override.h"
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "dynamic_value/set_value_from.h"
+#include "dynamic_value/value_visitor.h"
+
+#include <regex>
+
+namespace pagoda
+{
+namespace
+{
+struct ParamSetter : ValueVisitorBase
+{
+	ParamSetter(const std::string &v) : m_value(v) {}
+
+	void Visit(Boolean &v) override
+	{
+		if (m_value != "true" && m_value != "false")
+		{
+			throw Exception("Unable to set Boolean parameter from " + m_value + " value.");
+		}
+		set_value_from<bool>(v, m_value == "true");
+	}
+	void Visit(FloatValue &v) override { set_value_from<float>(v, std::atof(m_value.c_str())); }
+	void Visit(Integer &v) override { set_value_from<float>(v, std::atof(m_value.c_str())); }
+	void Visit(String &v) override { set_value_from<std::string>(v, m_value); }
+	void Visit(NullObject &v) override { throw Exception("Cannot set a NullObject."); }
+	void Visit(TypeInfo &v) override { throw Exception("Cannot set a TypeInfo."); }
+	void Visit(Vector3 &v) override { throw Exception("Cannot set a Vector3."); }
+	void Visit(DynamicPlane &v) override { throw Exception("Cannot set a DynamicPlane."); }
+	void Visit(Function &v) override { throw Exception("Cannot set a Function."); }
+	void Visit(DynamicClass &v) override { throw Exception("Cannot set a DynamicClass."); }
+	void Visit(DynamicInstance &v) override { throw Exception("Cannot set a DynamicInstance."); }
+	void Visit(Expression &v) override { throw Exception("Cannot set an Expression."); }
+	void Visit(ProceduralOperation &v) override { throw Exception("Cannot set a ProceduralOperation."); }
+
+	std::string m_value;
+};
+}  // namespace
+
+NodeSet<Node> OverrideParameter(const NodeSet<Node> &nodes, const std::string &parameterOverride)
+{
+	NodeSet<Node> changedNodes;
+	static const std::regex paramRegex("^(.+)\\.(.+)=(.+)$");
+	std::smatch matches;
+	if (std::regex_search(parameterOverride, matches, paramRegex) && matches.size() > 3)
+	{
+		std::string nodeName = matches.str(1);
+		std::string paramName = matches.str(2);
+		std::string value = matches.str(3);
+		ParamSetter setter(value);
+		for (auto &n : nodes)
+		{
+			if (n->GetName() == nodeName)
+			{
+				LOG_INFO("Overriding parameter '" << paramName << "' in node '" << n->GetName() << "' with value '"
+				                                  << value << "'");
+				n->GetMember(paramName)->AcceptVisitor(setter);
+				changedNodes.insert(n);
+			}
+		}
+	}
+	else
+	{
+		throw Exception("Invalid parameter definition: '" + parameterOverride + "'");
+	}
+	return changedNodes;
+}
+}  // namespace pagoda
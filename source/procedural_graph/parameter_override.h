@@ -0,0 +1,21 @@
+#ifndef PAGODA_PROCEDURAL_GRAPH_PARAMETER_OVERRIDE_H_
+#define PAGODA_PROCEDURAL_GRAPH_PARAMETER_OVERRIDE_H_
+
+#include "node.h"
+#include "node_set.h"
+
+#include <string>
+
+namespace pagoda
+{
+/**
+ * Overrides a parameter in the \c Node in \p nodes with the name given in \p parameterOverride.
+ *
+ * The format of \p parameterOverride is '<node name>.<param name>=<value>' and \p value is converted
+ * to the type of the parameter. Returns the nodes whose parameter was changed.
+ * Throws an \c Exception if \p parameterOverride is invalid or the parameter can't be set.
+ */
+NodeSet<Node> OverrideParameter(const NodeSet<Node> &nodes, const std::string &parameterOverride);
+}  // namespace pagoda
+
+#endif
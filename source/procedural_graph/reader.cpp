@@ -1,5 +1,6 @@
 #include "reader.h"
 
+#include "compiled_graph_format.h"
 #include "reader/ast_interpreter.h"
 #include "reader/graph_definition_node.h"
 #include "reader/graph_reader_grammar.h"
@@ -26,25 +27,45 @@ struct GraphReader::Impl
 	{
 		GraphPtr graph = std::make_shared<Graph>(m_nodeFactory);
 
+		GraphDefinitionNodePtr graph_def = Parse(str);
+
+		AstInterpreter interpreter(graph);
+		interpreter.Visit(graph_def.get());
+
+		return graph;
+	}
+
+	std::string Compile(const std::string &str)
+	{
+		std::string compiled;
+		CompiledGraphWriter::Write(*Parse(str), compiled);
+		return compiled;
+	}
+
+	GraphPtr ReadCompiled(const char *data, std::size_t size)
+	{
+		GraphPtr graph = std::make_shared<Graph>(m_nodeFactory);
+		CompiledGraphReader::Read(data, size, graph);
+		return graph;
+	}
+
+	GraphDefinitionNodePtr Parse(const std::string &str)
+	{
 		std::string::const_iterator begin = std::begin(str);
 		std::string::const_iterator end = std::end(str);
 
-		GraphReaderGrammar<std::string::const_iterator> grammar;
+		// The grammar's rules are expensive to build and hold no state between parses
+		static thread_local GraphReaderGrammar<std::string::const_iterator> grammar;
 		GraphDefinitionNodePtr graph_def;
 
 		bool result = boost::spirit::qi::phrase_parse(begin, end, grammar, boost::spirit::qi::space, graph_def);
 
 		if (!result || begin != end)
 		{
-			throw Exception("Syntax error while reading graph file. Starting in\n " + std::string(begin, end));
 			m_currentParseResult.status = ParseResult::Status::UnknownError;
-			return nullptr;
+			throw Exception("Syntax error while reading graph file. Starting in\n " + std::string(begin, end));
 		}
-
-		AstInterpreter interpreter(graph);
-		interpreter.Visit(graph_def.get());
-
-		return graph;
+		return graph_def;
 	}
 	const ParseResult &GetParseResult() const { return m_currentParseResult; }
 
@@ -59,6 +80,11 @@ GraphReader::GraphReader(NodeFactoryPtr nodeFactory)
 }
 GraphReader::~GraphReader() {}
 GraphPtr GraphReader::Read(const std::string &str) { return m_implementation->Read(str); }
+std::string GraphReader::Compile(const std::string &str) { return m_implementation->Compile(str); }
+GraphPtr GraphReader::ReadCompiled(const char *data, std::size_t size)
+{
+	return m_implementation->ReadCompiled(data, size);
+}
 const ParseResult &GraphReader::GetParseResult() const { return m_implementation->GetParseResult(); }
 
 }  // namespace pagoda
@@ -20,6 +20,18 @@ public:
 	~GraphReader();
 
 	GraphPtr Read(const std::string &str);
+
+	/**
+	 * Parses the graph in \p str and returns it in the \c CompiledGraphFormat.
+	 */
+	std::string Compile(const std::string &str);
+
+	/**
+	 * Reads a graph in the \c CompiledGraphFormat from the \p size bytes in \p data,
+	 * without parsing the graph nor its expressions.
+	 */
+	GraphPtr ReadCompiled(const char *data, std::size_t size);
+
 	const ParseResult &GetParseResult() const;
 
 private:
@@ -30,14 +30,19 @@ void RouterNode::AcceptNodeVisitor(NodeVisitor *visitor)
 	visitor->Visit(std::dynamic_pointer_cast<RouterNode>(shared_from_this()));
 }
 
-void RouterNode::AddProceduralObject(ProceduralObjectPtr object) { m_proceduralObjects.push_back(object); }
+void RouterNode::AddProceduralObjects(SharedProceduralObjectBatch objects)
+{
+	m_proceduralObjects.push_back(std::move(objects));
+}
+
+void RouterNode::ClearResults() { m_proceduralObjects.clear(); }
 
 namespace
 {
 class out_visitor : public NodeVisitor
 {
 public:
-	out_visitor(ProceduralObjectPredicateRegistryPtr predicateRegistry, std::list<ProceduralObjectPtr> &objects,
+	out_visitor(ProceduralObjectPredicateRegistryPtr predicateRegistry, const SharedProceduralObjectBatches &objects,
 	            std::shared_ptr<DynamicValueTable> &table)
 	    : m_predicateRegistry(predicateRegistry), m_proceduralObjects(objects), m_nodeMemberTable(table)
 	{
@@ -62,11 +67,24 @@ public:
 					return;
 				}
 
-				for (auto o : m_proceduralObjects)
+				for (const auto &objects : m_proceduralObjects)
 				{
-					if ((*pred)(o))
+					ProceduralObjectBatch accepted;
+					for (const auto &o : *objects)
+					{
+						if ((*pred)(o))
+						{
+							accepted.push_back(o);
+						}
+					}
+					// Batches whose objects are all accepted are handed over as they are
+					if (accepted.size() == objects->size())
+					{
+						n->AddProceduralObjects(objects);
+					}
+					else if (!accepted.empty())
 					{
-						n->AddProceduralObject(o);
+						n->AddProceduralObjects(std::make_shared<const ProceduralObjectBatch>(std::move(accepted)));
 					}
 				}
 			}
@@ -88,7 +106,7 @@ public:
 	void Visit(std::shared_ptr<RouterNode> n) override { throw UnsupportedNodeLink("input", "RouterNode"); }
 
 	ProceduralObjectPredicateRegistryPtr m_predicateRegistry;
-	std::list<ProceduralObjectPtr> &m_proceduralObjects;
+	const SharedProceduralObjectBatches &m_proceduralObjects;
 	std::shared_ptr<DynamicValueTable> m_nodeMemberTable;
 };
 }  // namespace
@@ -2,12 +2,10 @@
 
 #include "node.h"
 
-#include <list>
+#include "procedural_objects/procedural_object_batch.h"
 
 namespace pagoda
 {
-class ProceduralObject;
-using ProceduralObjectPtr = std::shared_ptr<ProceduralObject>;
 class ProceduralObjectPredicateRegistry;
 using ProceduralObjectPredicateRegistryPtr = std::shared_ptr<ProceduralObjectPredicateRegistry>;
 
@@ -21,12 +19,16 @@ public:
 
 	void SetConstructionArguments(const std::unordered_map<std::string, DynamicValueBasePtr> &) override;
 	void AcceptNodeVisitor(NodeVisitor *visitor) override;
-	void AddProceduralObject(ProceduralObjectPtr object);
+	/**
+	 * Adds the \p objects sent by the previous node, without copying them.
+	 */
+	void AddProceduralObjects(SharedProceduralObjectBatch objects);
 
 	void Execute(const NodeSet<Node> &inNodes, const NodeSet<Node> &outNodes) override;
+	void ClearResults() override;
 
 private:
-	std::list<ProceduralObjectPtr> m_proceduralObjects;
+	SharedProceduralObjectBatches m_proceduralObjects;
 	ProceduralObjectPredicateRegistryPtr m_predicateRegistry;
 };
 }  // namespace pagoda
@@ -0,0 +1,29 @@
+#include "scheduler.h"
+
+#include "graph.h"
+#include "node.h"
+
+namespace pagoda
+{
+bool IScheduler::SendPreviousResults(Graph &graph, const NodePtr &node) const
+{
+	if (m_executedNodes.empty() || m_executedNodes.count(node) > 0)
+	{
+		return false;
+	}
+
+	NodeSet<Node> outNodes;
+	for (const auto &n : graph.GetNodeOutputNodes(node))
+	{
+		if (m_executedNodes.count(n) > 0)
+		{
+			outNodes.insert(n);
+		}
+	}
+	if (!outNodes.empty())
+	{
+		node->SendResults(outNodes);
+	}
+	return true;
+}
+}  // namespace pagoda
@@ -1,8 +1,12 @@
 #ifndef PAGODA_PROCEDURAL_GRAPH_SCHEDULER_H_
 #define PAGODA_PROCEDURAL_GRAPH_SCHEDULER_H_
 
+#include "node_set.h"
+
 namespace pagoda
 {
+class Graph;
+
 class IScheduler
 {
 public:
@@ -11,6 +15,23 @@ public:
 	virtual void Initialize() = 0;
 	virtual bool Step() = 0;
 	virtual void Finalize() = 0;
+
+	/**
+	 * Restricts the following executions to \p nodes. Any other \c Node is not executed again and only
+	 * sends the results of its previous execution to the restricted nodes it is connected to.
+	 * An empty set executes every \c Node.
+	 */
+	void SetExecutedNodes(const NodeSet<Node> &nodes) { m_executedNodes = nodes; }
+
+protected:
+	/**
+	 * If \p node is not to be executed, sends the results of its previous execution to its output
+	 * nodes in \p graph that are executed and returns true.
+	 */
+	bool SendPreviousResults(Graph &graph, const NodePtr &node) const;
+
+private:
+	NodeSet<Node> m_executedNodes;
 };  // class IScheduler
 }  // namespace pagoda
 #endif
@@ -37,40 +37,41 @@ void ClipGeometry::DoWork()
 	auto geometrySystem = m_proceduralObjectSystem->GetComponentSystem<GeometrySystem>();
 	auto hierarchicalSystem = m_proceduralObjectSystem->GetComponentSystem<HierarchicalSystem>();
 
-	while (HasInput(inputGeometry))
-	{
-		ProceduralObjectPtr inObject = GetInputProceduralObject(inputGeometry);
+	ForEachInputObject(inputGeometry, [&](ProceduralObjectPtr inObject) -> ObjectWork_t {
 		UpdateValue("plane");
-
-		Clip<Geometry> clip(get_value_as<Plane<float>>(*GetValue("plane")));
-
-		// Geometry
-		auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
-		GeometryPtr inGeometry = inGeometryComponent->GetGeometry();
-
-		auto frontProceduralObject = CreateOutputProceduralObject(frontGeometry);
-		auto frontGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(frontProceduralObject);
-		auto front = std::make_shared<Geometry>();
-		frontGeometryComponent->SetGeometry(front);
-
-		auto backProceduralObject = CreateOutputProceduralObject(backGeometry);
-		auto backGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(backProceduralObject);
-		auto back = std::make_shared<Geometry>();
-		backGeometryComponent->SetGeometry(back);
-
-		clip.Execute(inGeometry, front, back);
-
-		frontGeometryComponent->SetScope(
-		    Scope::FromGeometryAndConstrainedRotation(front, inGeometryComponent->GetScope().GetRotation()));
-		backGeometryComponent->SetScope(
-		    Scope::FromGeometryAndConstrainedRotation(back, inGeometryComponent->GetScope().GetRotation()));
-
-		auto parentHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
-		for (const auto& object : {frontProceduralObject, backProceduralObject})
-		{
-			auto hierarchicalComponent = hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(object);
-			hierarchicalSystem->SetParent(hierarchicalComponent, parentHierarchicalComponent);
-		}
-	}
+		auto plane = get_value_as<Plane<float>>(*GetValue("plane"));
+
+		return [=](ObjectOutputs& outputs) {
+			Clip<Geometry> clip(plane);
+
+			// Geometry
+			auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
+			GeometryPtr inGeometry = geometrySystem->GetGeometry(inGeometryComponent);
+
+			auto frontProceduralObject = outputs.CreateOutputProceduralObject(frontGeometry);
+			auto frontGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(frontProceduralObject);
+			auto front = std::make_shared<Geometry>();
+			frontGeometryComponent->SetGeometry(front);
+
+			auto backProceduralObject = outputs.CreateOutputProceduralObject(backGeometry);
+			auto backGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(backProceduralObject);
+			auto back = std::make_shared<Geometry>();
+			backGeometryComponent->SetGeometry(back);
+
+			clip.Execute(inGeometry, front, back);
+
+			frontGeometryComponent->SetScope(
+			    Scope::FromGeometryAndConstrainedRotation(front, inGeometryComponent->GetScope().GetRotation()));
+			backGeometryComponent->SetScope(
+			    Scope::FromGeometryAndConstrainedRotation(back, inGeometryComponent->GetScope().GetRotation()));
+
+			auto parentHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
+			for (const auto& object : {frontProceduralObject, backProceduralObject})
+			{
+				auto hierarchicalComponent = hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(object);
+				hierarchicalSystem->SetParent(hierarchicalComponent, parentHierarchicalComponent);
+			}
+		};
+	});
 }
 }  // namespace pagoda
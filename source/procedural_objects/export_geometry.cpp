@@ -2,59 +2,76 @@
 
 #include "dynamic_value/get_value_as.h"
 #include "dynamic_value/set_value_from.h"
+#include "geometry_core/geometry_binary_format.h"
 #include "geometry_core/geometry_exporter.h"
 
 #include "geometry_component.h"
 #include "hierarchical_component.h"
 #include "procedural_object_system.h"
 
-#include "common/file_util.h"
+#include "common/async_file_writer.h"
 
 #include <boost/filesystem/path.hpp>
 
-#include <fstream>
-
 namespace pagoda
 {
 const char* ExportGeometry::name = "ExportGeometry";
 const std::string ExportGeometry::inputGeometry("in");
+std::atomic<bool> ExportGeometry::s_writeBinaryCache(false);
 
 ExportGeometry::ExportGeometry(ProceduralObjectSystemPtr objectSystem) : ProceduralOperation(objectSystem)
 {
 	CreateInputInterface(inputGeometry);
 
-	RegisterValues({{"path", std::make_shared<String>("geometry.obj")}, {"count", std::make_shared<Integer>(0)}});
+	RegisterValues({{"path", std::make_shared<String>("geometry.obj")},
+	                {"output_directory", std::make_shared<String>("")},
+	                {"count", std::make_shared<Integer>(0)}});
 }
 
 ExportGeometry::~ExportGeometry() {}
 
+void ExportGeometry::SetWriteBinaryCache(bool write) { s_writeBinaryCache = write; }
+
 void ExportGeometry::DoWork()
 {
 	START_PROFILE;
 
 	int objectCount = 0;
 	auto geometrySystem = m_proceduralObjectSystem->GetComponentSystem<GeometrySystem>();
+	const boost::filesystem::path outputDirectory = get_value_as<std::string>(*GetValue("output_directory"));
+	auto writeGroup = GetFileWriteGroup();
 
-	while (HasInput(inputGeometry))
-	{
-		set_value_from<int>(*GetValue("count"), objectCount);
+	ForEachInputObject(inputGeometry, [&](ProceduralObjectPtr inObject) -> ObjectWork_t {
+		set_value_from<int>(*GetValue("count"), objectCount++);
 		UpdateValue("path");
-
-		ProceduralObjectPtr inObject = GetInputProceduralObject(inputGeometry);
-
-		auto geometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
-		auto geometry = geometryComponent->GetGeometry();
-		pagoda::ObjExporter<Geometry> exporter(geometry);
-
 		std::string outputPath = get_value_as<std::string>(*GetValue("path"));
-		file_util::CreateDirectories(boost::filesystem::path(outputPath).parent_path());
-
-		std::ofstream out_file(outputPath.c_str());
-		exporter.Export(out_file);
-		out_file.close();
-
-		++objectCount;
-	}
+		if (!outputDirectory.empty() && boost::filesystem::path(outputPath).is_relative())
+		{
+			outputPath = (outputDirectory / outputPath).string();
+		}
+
+		return [=](ObjectOutputs&) {
+			auto geometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
+			auto geometry = geometrySystem->GetGeometry(geometryComponent);
+			const auto binaryPath =
+			    boost::filesystem::path(outputPath).replace_extension(GeometryBinaryFormat::s_extension).string();
+			const bool writeBinary = (binaryPath == outputPath);
+
+			// Files are written in the background so that the graph execution doesn't wait on the disk.
+			if (writeBinary || s_writeBinaryCache)
+			{
+				std::string buffer;
+				GeometryBinaryWriter<Geometry>(geometry).Write(buffer, geometryComponent->GetScope());
+				AsyncFileWriter::Instance().Write(binaryPath, std::move(buffer), writeGroup);
+			}
+			if (!writeBinary)
+			{
+				std::string buffer;
+				pagoda::ObjExporter<Geometry>(geometry).Export(buffer);
+				AsyncFileWriter::Instance().Write(outputPath, std::move(buffer), writeGroup);
+			}
+		};
+	});
 }
 
 }  // namespace pagoda
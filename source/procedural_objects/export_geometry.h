@@ -3,8 +3,17 @@
 
 #include "procedural_operation.h"
 
+#include <atomic>
+
 namespace pagoda
 {
+/**
+ * Exports the geometry of each input object to the file in the "path" parameter.
+ *
+ * Paths with the \c GeometryBinaryFormat extension (.pgg) are written in that format,
+ * all others in the Obj format. Relative paths are written inside the "output_directory"
+ * parameter, if it isn't empty.
+ */
 class ExportGeometry : public ProceduralOperation
 {
 public:
@@ -15,6 +24,18 @@ public:
 	~ExportGeometry();
 
 	void DoWork() override;
+
+	/// Exporting writes files, so it must always execute.
+	bool IsCacheable() const override { return false; }
+
+	/**
+	 * If \p write is true, a file in the \c GeometryBinaryFormat is also written next to
+	 * every Obj file, so that tools can load the geometry without parsing it.
+	 */
+	static void SetWriteBinaryCache(bool write);
+
+private:
+	static std::atomic<bool> s_writeBinaryCache;
 };
 }  // namespace pagoda
 
@@ -39,7 +39,7 @@ void ExtractFaces::DoWork()
 		auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
 		auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
 
-		auto inGeometry = inGeometryComponent->GetGeometry();
+		auto inGeometry = geometrySystem->GetGeometry(inGeometryComponent);
 		std::vector<GeometryPtr> explodedFaces;
 		explodeToFaces.Execute(inGeometry, explodedFaces);
 
@@ -42,7 +42,7 @@ void ExtractScope::DoWork()
 		std::shared_ptr<GeometryComponent> outGeometryComponent =
 		    geometrySystem->CreateComponentAs<GeometryComponent>(outObject);
 
-		GeometryPtr inGeometry = inGeometryComponent->GetGeometry();
+		// The box only depends on the scope, so the input geometry doesn't need to be read
 		auto outGeometry = std::make_shared<Geometry>();
 
 		CreateBox<Geometry> createBox(inGeometryComponent->GetScope());
@@ -36,36 +36,35 @@ void ExtrudeGeometry::DoWork()
 	auto geometrySystem = m_proceduralObjectSystem->GetComponentSystem<GeometrySystem>();
 	auto hierarchicalSystem = m_proceduralObjectSystem->GetComponentSystem<HierarchicalSystem>();
 
-	while (HasInput(input_geometry))
-	{
-		ProceduralObjectPtr in_object = GetInputProceduralObject(input_geometry);
+	ForEachInputObject(input_geometry, [&](ProceduralObjectPtr in_object) -> ObjectWork_t {
 		UpdateValue("extrusion_amount");
-
 		float extrusion_amount = get_value_as<float>(*GetValue("extrusion_amount"));
-		Extrusion<Geometry> extrude(extrusion_amount);
-
-		// Geometry
-		ProceduralObjectPtr out_object = CreateOutputProceduralObject(output_geometry);
-		std::shared_ptr<GeometryComponent> geometry_component =
-		    geometrySystem->CreateComponentAs<GeometryComponent>(out_object);
-		std::shared_ptr<GeometryComponent> in_geometry_component =
-		    geometrySystem->GetComponentAs<GeometryComponent>(in_object);
-		GeometryPtr in_geometry = in_geometry_component->GetGeometry();
-
-		auto out_geometry = std::make_shared<Geometry>();
-		extrude.Execute(in_geometry, out_geometry);
-
-		geometry_component->SetGeometry(out_geometry);
-		geometry_component->SetScope(
-		    Scope::FromGeometryAndConstrainedRotation(out_geometry, in_geometry_component->GetScope().GetRotation()));
-
-		// Hierarchy
-		std::shared_ptr<HierarchicalComponent> in_hierarchical_component =
-		    hierarchicalSystem->GetComponentAs<HierarchicalComponent>(in_object);
-		std::shared_ptr<HierarchicalComponent> out_hierarchical_component =
-		    hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(out_object);
 
-		hierarchicalSystem->SetParent(out_hierarchical_component, in_hierarchical_component);
-	}
+		return [=](ObjectOutputs& outputs) {
+			Extrusion<Geometry> extrude(extrusion_amount);
+
+			// Geometry
+			ProceduralObjectPtr out_object = outputs.CreateOutputProceduralObject(output_geometry);
+			std::shared_ptr<GeometryComponent> geometry_component =
+			    geometrySystem->CreateComponentAs<GeometryComponent>(out_object);
+			std::shared_ptr<GeometryComponent> in_geometry_component =
+			    geometrySystem->GetComponentAs<GeometryComponent>(in_object);
+			GeometryPtr in_geometry = geometrySystem->GetGeometry(in_geometry_component);
+			auto out_geometry = std::make_shared<Geometry>();
+
+			extrude.Execute(in_geometry, out_geometry);
+
+			geometry_component->SetGeometry(out_geometry);
+			geometry_component->SetScope(
+			    Scope::FromGeometryAndConstrainedRotation(out_geometry, in_geometry_component->GetScope().GetRotation()));
+
+			// Hierarchy
+			std::shared_ptr<HierarchicalComponent> in_hierarchical_component =
+			    hierarchicalSystem->GetComponentAs<HierarchicalComponent>(in_object);
+			std::shared_ptr<HierarchicalComponent> out_hierarchical_component =
+			    hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(out_object);
+			hierarchicalSystem->SetParent(out_hierarchical_component, in_hierarchical_component);
+		};
+	});
 }
 }  // namespace pagoda
@@ -55,7 +55,7 @@ void FaceOffsetOperation::DoWork()
 		    geometrySystem->GetComponentAs<GeometryComponent>(inObject);
 		std::shared_ptr<HierarchicalComponent> inHierarchicalComponent =
 		    hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
-		GeometryPtr inGeometry = inGeometryComponent->GetGeometry();
+		GeometryPtr inGeometry = geometrySystem->GetGeometry(inGeometryComponent);
 
 		offset.Execute(inGeometry, std::back_inserter(innerGeometries), std::back_inserter(outerGeometries));
 
@@ -1,9 +1,54 @@
 #include "geometry_component.h"
 
+#include "common/assertions.h"
+
 namespace pagoda
 {
 std::string GeometryComponent::GetComponentSystemName() { return GeometrySystem::GetComponentSystemName(); }
 
+GeometryComponent::GeometryComponent() : m_hasPendingTransform(false) {}
+
+void GeometryComponent::SetGeometry(GeometryPtr geom)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	geometry = geom;
+	m_hasPendingTransform = false;
+}
+
+GeometryPtr GeometryComponent::GetGeometry() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	DBG_ASSERT_MSG(!m_hasPendingTransform, "The geometry has a pending transform, use GeometrySystem::GetGeometry()");
+	return geometry;
+}
+
+bool GeometryComponent::HasPendingTransform() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_hasPendingTransform;
+}
+
+std::size_t GeometryComponent::BakeTransform(bool makeUnique)
+{
+	if (!m_hasPendingTransform && !makeUnique)
+	{
+		return 0;
+	}
+
+	std::size_t copiedBytes = 0;
+	if (geometry.use_count() > 1)
+	{
+		copiedBytes = geometry->GetMemoryBytes();
+		geometry = std::make_shared<Geometry>(*geometry);
+	}
+	if (m_hasPendingTransform)
+	{
+		geometry->TransformPositions(m_pendingTransform);
+		m_hasPendingTransform = false;
+	}
+	return copiedBytes;
+}
+
 const Scope& GeometryComponent::GetScope() const { return m_scope; }
 
 void GeometryComponent::SetScope(const Scope& scope) { m_scope = scope; }
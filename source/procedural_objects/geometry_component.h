@@ -7,23 +7,59 @@
 #include "geometry_core/geometry_builder.h"
 #include "geometry_core/scope.h"
 
+#include <mutex>
+
 namespace pagoda
 {
+/**
+ * Holds the geometry of a procedural object and its scope.
+ *
+ * Affine transformations given to \c GeometrySystem::TransformGeometry() are composed into a pending
+ * transform instead of being applied to the positions, which only happens once the geometry is needed.
+ */
 class GeometryComponent : public ProceduralComponent
 {
 public:
 	static std::string GetComponentSystemName();
 
+	GeometryComponent();
 	virtual ~GeometryComponent(){};
 
 	std::string GetType() const override { return GetComponentSystemName(); }
-	void SetGeometry(GeometryPtr geom) { geometry = geom; }
-	GeometryPtr GetGeometry() const { return geometry; }
+	/**
+	 * Sets the geometry, discarding any pending transform.
+	 */
+	void SetGeometry(GeometryPtr geom);
+	/**
+	 * Returns the geometry, which may be shared with other components and must not be modified.
+	 * Use \c GeometrySystem::GetMutableGeometry() to modify it.
+	 *
+	 * There must be no pending transform. \c GeometrySystem::GetGeometry() applies it before returning the geometry.
+	 */
+	GeometryPtr GetGeometry() const;
+	/**
+	 * Returns whether there is a transform that hasn't been applied to the geometry yet.
+	 */
+	bool HasPendingTransform() const;
 	const Scope& GetScope() const;
 	void SetScope(const Scope& scope);
 
 private:
+	friend class GeometrySystem;
+
+	/**
+	 * Applies the pending transform to the geometry, replacing it by a copy if anything else holds it.
+	 * If \p makeUnique is true the geometry is also replaced by a copy when there is no pending transform.
+	 * Returns the estimated bytes copied. Must be called with m_mutex locked.
+	 */
+	std::size_t BakeTransform(bool makeUnique);
+
+	/// Guards the geometry and the pending transform, which are updated when the geometry is first needed.
+	mutable std::mutex m_mutex;
 	GeometryPtr geometry;
+	/// Transform to apply to the positions of the geometry.
+	Mat3x4F m_pendingTransform;
+	bool m_hasPendingTransform;
 	Scope m_scope;
 };  // class GeometryComponent
 
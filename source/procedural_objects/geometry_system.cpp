@@ -3,13 +3,104 @@
 #include "common/assertions.h"
 #include "common/profiler.h"
 #include "geometry_component.h"
+#include "geometry_operations/matrix_transform.h"
 #include "procedural_object.h"
 
+#include <unordered_map>
+
 namespace pagoda
 {
 const std::string GeometrySystem::GetComponentSystemName() { return "GeometrySystem"; }
 
-GeometrySystem::GeometrySystem() : ProceduralComponentSystem(GetComponentSystemName()) {}
+GeometrySystem::GeometrySystem() : ProceduralComponentSystem(GetComponentSystemName()), m_copiedBytes(0) {}
 GeometrySystem::~GeometrySystem() {}
 
+void GeometrySystem::ShareGeometry(std::shared_ptr<GeometryComponent> from, std::shared_ptr<GeometryComponent> to)
+{
+	START_PROFILE;
+
+	GeometryPtr geometry;
+	Mat3x4F pendingTransform;
+	bool hasPendingTransform;
+	{
+		std::lock_guard<std::mutex> lock(from->m_mutex);
+		geometry = from->geometry;
+		pendingTransform = from->m_pendingTransform;
+		hasPendingTransform = from->m_hasPendingTransform;
+	}
+	DBG_ASSERT_MSG(geometry != nullptr, "Can't share a null geometry");
+
+	std::lock_guard<std::mutex> lock(to->m_mutex);
+	to->geometry = std::move(geometry);
+	to->m_pendingTransform = pendingTransform;
+	to->m_hasPendingTransform = hasPendingTransform;
+}
+
+GeometryPtr GeometrySystem::GetGeometry(std::shared_ptr<GeometryComponent> component)
+{
+	START_PROFILE;
+
+	std::lock_guard<std::mutex> lock(component->m_mutex);
+	m_copiedBytes += component->BakeTransform(false);
+	return component->geometry;
+}
+
+GeometryPtr GeometrySystem::GetMutableGeometry(std::shared_ptr<GeometryComponent> component)
+{
+	START_PROFILE;
+
+	std::lock_guard<std::mutex> lock(component->m_mutex);
+	DBG_ASSERT_MSG(component->geometry != nullptr, "Component has no geometry");
+	m_copiedBytes += component->BakeTransform(true);
+	return component->geometry;
+}
+
+GeometryPtr GeometrySystem::GetUntransformedGeometry(std::shared_ptr<GeometryComponent> component,
+                                                     Mat3x4F &pendingTransform, bool &hasPendingTransform) const
+{
+	std::lock_guard<std::mutex> lock(component->m_mutex);
+	pendingTransform = component->m_pendingTransform;
+	hasPendingTransform = component->m_hasPendingTransform;
+	return component->geometry;
+}
+
+void GeometrySystem::TransformGeometry(std::shared_ptr<GeometryComponent> component, const Mat4x4F &matrix)
+{
+	START_PROFILE;
+
+	if (!IsAffine(matrix))
+	{
+		MatrixTransform<Geometry>(matrix).Execute(GetMutableGeometry(component));
+		return;
+	}
+
+	const auto transform = AffineRows(matrix);
+	std::lock_guard<std::mutex> lock(component->m_mutex);
+	component->m_pendingTransform =
+	    component->m_hasPendingTransform ? ComposeAffine(transform, component->m_pendingTransform) : transform;
+	component->m_hasPendingTransform = true;
+}
+
+std::size_t GeometrySystem::GetSharedGeometryBytes()
+{
+	START_PROFILE;
+
+	std::unordered_map<const Geometry *, std::size_t> holders;
+	ForEachComponent([&](const std::shared_ptr<GeometryComponent> &component) {
+		std::lock_guard<std::mutex> lock(component->m_mutex);
+		if (component->geometry != nullptr)
+		{
+			++holders[component->geometry.get()];
+		}
+	});
+
+	std::size_t sharedBytes = 0;
+	for (const auto &h : holders)
+	{
+		sharedBytes += (h.second - 1) * h.first->GetMemoryBytes();
+	}
+	return sharedBytes;
+}
+std::size_t GeometrySystem::GetCopiedGeometryBytes() const { return m_copiedBytes; }
+
 }  // namespace pagoda
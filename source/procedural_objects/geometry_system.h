@@ -10,10 +10,13 @@
 #include <geometry_operations/create_rect.h>
 #include <geometry_operations/extrusion.h>
 
+#include <atomic>
+
 namespace pagoda
 {
 // TODO: Maybe move these type defs to geometry core
-using Geometry = GeometryBase<>;
+using Geometry = GeometryBase<CompactSplitPointTopology, DefaultFaceAttributes, DefaultEdgeAttributes,
+                              DefaultVertexAttributes, DenseAttributeStorage>;
 using GeometryPtr = std::shared_ptr<Geometry>;
 using GeometryBuilder = GeometryBuilderT<Geometry>;
 using GeometryBuilderPtr = std::shared_ptr<GeometryBuilder>;
@@ -24,6 +27,10 @@ class GeometryComponent;
  * @brief Manages \c GeometryComponent.
  *
  * All instances of \c GeometryComponent should be created and destroyed (killed) through this system.
+ *
+ * Components can share their geometry, which is then copied when one of them modifies it through
+ * GetMutableGeometry(). Affine transformations given to TransformGeometry() are only applied to the
+ * positions when the geometry is needed, so that chains of transformations don't rewrite them each time.
  */
 class GeometrySystem : public ProceduralComponentSystem<GeometryComponent>
 {
@@ -33,6 +40,45 @@ public:
 	GeometrySystem();
 	virtual ~GeometrySystem();
 
+	/**
+	 * Sets the geometry of \p from in \p to without copying it, along with its pending transform.
+	 */
+	void ShareGeometry(std::shared_ptr<GeometryComponent> from, std::shared_ptr<GeometryComponent> to);
+	/**
+	 * Returns the geometry of \p component to be read, which must not be modified.
+	 * Any pending transform is applied to it first, in a copy if anything else holds the geometry.
+	 */
+	GeometryPtr GetGeometry(std::shared_ptr<GeometryComponent> component);
+	/**
+	 * Returns the geometry of \p component so that it can be modified. If anything else holds the geometry it
+	 * is first replaced by a copy. Any pending transform is applied to it.
+	 */
+	GeometryPtr GetMutableGeometry(std::shared_ptr<GeometryComponent> component);
+	/**
+	 * Returns the geometry of \p component without applying its pending transform, which is returned in
+	 * \p pendingTransform if \p hasPendingTransform is set. The geometry must not be modified.
+	 */
+	GeometryPtr GetUntransformedGeometry(std::shared_ptr<GeometryComponent> component, Mat3x4F &pendingTransform,
+	                                     bool &hasPendingTransform) const;
+	/**
+	 * Transforms the geometry of \p component with \p matrix.
+	 * Affine matrices are composed with the pending transform of \p component, without touching the
+	 * geometry. Otherwise the geometry is transformed right away.
+	 */
+	void TransformGeometry(std::shared_ptr<GeometryComponent> component, const Mat4x4F &matrix);
+
+	/**
+	 * Returns the estimated bytes that components currently sharing their geometry don't hold in copies.
+	 * A geometry held by n components counts n - 1 times. Sharing stops counting once it is copied.
+	 */
+	std::size_t GetSharedGeometryBytes();
+	/**
+	 * Returns the estimated bytes of the geometries copied by GetGeometry() and GetMutableGeometry().
+	 */
+	std::size_t GetCopiedGeometryBytes() const;
+
+private:
+	std::atomic<std::size_t> m_copiedBytes;
 };  // class GeometrySystem
 using GeometrySystemPtr = std::shared_ptr<GeometrySystem>;
 using GeometrySystemWeakPtr = std::weak_ptr<GeometrySystem>;
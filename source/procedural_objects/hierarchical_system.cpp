@@ -13,6 +13,7 @@ void HierarchicalSystem::SetParent(std::shared_ptr<HierarchicalComponent> parent
                                    std::shared_ptr<HierarchicalComponent> child)
 {
 	DBG_ASSERT_MSG(child != nullptr, "Child component must not be null");
+	std::lock_guard<std::mutex> lock(m_hierarchyMutex);
 
 	child->SetParent(parent);
 
@@ -42,6 +42,8 @@ private:
 	std::unordered_set<std::weak_ptr<HierarchicalComponent>, HierarchicalComponentWeakPtrHasher,
 	                   HierarchicalComponentEqual>
 	    root_components;
+	/// Guards the hierarchy since several children of the same parent may be created concurrently.
+	std::mutex m_hierarchyMutex;
 };  // class GeometrySystem
 using HierarchicalSystemPtr = std::shared_ptr<HierarchicalSystem>;
 using HierarchicalSystemWeakPtr = std::weak_ptr<HierarchicalSystem>;
@@ -5,21 +5,27 @@
 #include "common/logger.h"
 
 #include "procedural_component_system_base.h"
+#include "procedural_object.h"
+#include "procedural_object_arena.h"
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
+#include <vector>
 
 namespace pagoda
 {
-class ProceduralObject;
-using ProceduralObjectPtr = std::shared_ptr<ProceduralObject>;
-
 class ProceduralComponent;
 using ProceduralComponentPtr = std::shared_ptr<ProceduralComponent>;
 
 /**
  * Base template class for a \c ProceduralComponentSytem that holds \c ProceduralComponent
  * of type C.
+ *
+ * The components are stored contiguously in a sparse set indexed by the \c ProceduralObjectId of
+ * their objects, so that looking up the component of an object doesn't need hashing.
  */
 template<class C>
 class ProceduralComponentSystem : public ProceduralComponentSystemBase
@@ -38,40 +44,197 @@ public:
 
     /**
      * Creates a \c ProceduralComponent of type \c Component_t for the \c ProceduralObject give in \p object.
+     * The component is allocated in the \c ProceduralObjectArena of \p object, if it has one.
      */
-	std::shared_ptr<ProceduralComponent> CreateComponent(ProceduralObjectPtr object) override
+	std::shared_ptr<ProceduralComponent> CreateComponent(const ProceduralObjectPtr &object) override
+	{
+		return CreateComponentAs<Component_t>(object);
+	}
+
+    /**
+     * Returns the \c ProceduralComponent for the \c ProceduralObject \p object.
+     */
+	std::shared_ptr<ProceduralComponent> GetComponent(const ProceduralObjectPtr &object) override
+	{
+		return GetComponentAs<Component_t>(object);
+	}
+
+    /**
+     * Creates the component for \p object as in CreateComponent(), casting it to \c T.
+     * No dynamic cast is needed when \c T is \c Component_t or one of its bases.
+     */
+	template<typename T>
+	std::shared_ptr<T> CreateComponentAs(const ProceduralObjectPtr &object)
 	{
         DBG_ASSERT_MSG(object != nullptr, "Can't create a component (%s) for a null ProceduralObject", GetComponentSystemTypeName().c_str());
-		DBG_ASSERT_MSG(m_components.find(object) == std::end(m_components),
-		               "Procedural object already has a component for %s", GetComponentSystemTypeName().c_str());
+		auto arena = object->GetArena();
+		auto component = arena != nullptr ? arena->MakeShared<Component_t>() : std::make_shared<Component_t>();
 
-		auto component = std::make_shared<Component_t>();
-		m_components[object] = component;
-		return component;
+		const auto &id = object->GetId();
+		std::lock_guard<std::shared_mutex> lock(m_mutex);
+		if (id.m_index >= m_sparse.size())
+		{
+			m_sparse.resize(id.m_index + 1, s_invalidPosition);
+		}
+		auto &position = m_sparse[id.m_index];
+		if (position != s_invalidPosition)
+		{
+			DBG_ASSERT_MSG(m_ids[position] != id, "Procedural object already has a component for %s",
+			               GetComponentSystemTypeName().c_str());
+			// The component of a destroyed object that wasn't killed and hasn't been removed yet
+			m_ids[position] = id;
+			m_components[position] = component;
+		}
+		else
+		{
+			position = static_cast<uint32_t>(m_components.size());
+			m_ids.push_back(id);
+			m_components.push_back(component);
+		}
+		return CastComponent<T>(component);
 	}
 
     /**
-     * Returns the \c ProceduralComponent for the \c ProceduralObject \p object.
+     * Returns the component for \p object as in GetComponent(), casting it to \c T.
+     * No dynamic cast is needed when \c T is \c Component_t or one of its bases.
      */
-	std::shared_ptr<ProceduralComponent> GetComponent(ProceduralObjectPtr object) override
+	template<typename T>
+	std::shared_ptr<T> GetComponentAs(const ProceduralObjectPtr &object)
 	{
         DBG_ASSERT_MSG(object != nullptr, "Can't get a component (%s) for a null ProceduralObject", GetComponentSystemTypeName().c_str());
-		auto component = m_components.find(object);
-		if (component == std::end(m_components))
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		const auto position = FindPosition(object->GetId());
+		if (position == s_invalidPosition)
 		{
 			return nullptr;
 		}
-		return component->second;
+		return CastComponent<T>(m_components[position]);
 	}
 
     /**
      * Deletes the \c ProceduralComponent for the \c ProceduralObject \p object.
      */
-	void KillProceduralComponent(ProceduralObjectPtr object) override { m_components.erase(object); }
+	void KillProceduralComponent(const ProceduralObjectPtr &object) override
+	{
+		std::lock_guard<std::shared_mutex> lock(m_mutex);
+		const auto &id = object->GetId();
+		const auto position = FindPosition(id);
+		if (position == s_invalidPosition)
+		{
+			return;
+		}
+
+		Remove(position);
+	}
+
+    /**
+     * Calls \p f with each \c ProceduralComponent in this system, in no particular order.
+     * Components can't be created or killed from \p f.
+     */
+	template<class F>
+	void ForEachComponent(F &&f)
+	{
+		RemoveDestroyedObjects();
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		for (const auto &c : m_components)
+		{
+			f(c);
+		}
+	}
+
+	std::size_t GetComponentCount()
+	{
+		RemoveDestroyedObjects();
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return m_components.size();
+	}
 
 private:
-    /// Stores the \c ProceduralComponent for each \c ProceduralObject.
-	std::unordered_map<ProceduralObjectPtr, std::shared_ptr<Component_t>> m_components;
+	static constexpr uint32_t s_invalidPosition = ~uint32_t(0);
+
+    /**
+     * Removes the component at \p position. Must be called with m_mutex locked exclusively.
+     */
+	void Remove(uint32_t position)
+	{
+		// Keeps the components contiguous by moving the last one to the position of the removed one
+		const auto index = m_ids[position].m_index;
+		const auto last = static_cast<uint32_t>(m_components.size() - 1);
+		if (position != last)
+		{
+			m_ids[position] = m_ids[last];
+			m_components[position] = std::move(m_components[last]);
+			m_sparse[m_ids[position].m_index] = position;
+		}
+		m_ids.pop_back();
+		m_components.pop_back();
+		m_sparse[index] = s_invalidPosition;
+	}
+
+    /**
+     * Removes the components of the objects that were destroyed without being killed.
+     * Only scans the components when some object has been destroyed since the last scan.
+     */
+	void RemoveDestroyedObjects()
+	{
+		const auto destroyedCount = ProceduralObject::GetDestroyedCount();
+		if (destroyedCount == m_sweptDestroyedCount.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		std::lock_guard<std::shared_mutex> lock(m_mutex);
+		// Objects destroyed after destroyedCount was read are swept on the next call
+		m_sweptDestroyedCount.store(destroyedCount, std::memory_order_release);
+		for (auto position = static_cast<uint32_t>(m_components.size()); position > 0; --position)
+		{
+			if (!ProceduralObject::IsAlive(m_ids[position - 1]))
+			{
+				Remove(position - 1);
+			}
+		}
+	}
+
+    /**
+     * Returns the position of the component for the object with \p id, or s_invalidPosition.
+     */
+	uint32_t FindPosition(const ProceduralObjectId &id) const
+	{
+		if (id.m_index >= m_sparse.size())
+		{
+			return s_invalidPosition;
+		}
+		const auto position = m_sparse[id.m_index];
+		if (position == s_invalidPosition || m_ids[position] != id)
+		{
+			return s_invalidPosition;
+		}
+		return position;
+	}
+
+	template<typename T>
+	static std::shared_ptr<T> CastComponent(const std::shared_ptr<Component_t> &component)
+	{
+		if constexpr (std::is_base_of<T, Component_t>::value)
+		{
+			return component;
+		}
+		else
+		{
+			return std::dynamic_pointer_cast<T>(component);
+		}
+	}
+
+    /// Guards the components so that they can be created and queried concurrently.
+	std::shared_mutex m_mutex;
+    /// Position in m_components of the component for each object index, or s_invalidPosition.
+	std::vector<uint32_t> m_sparse;
+    /// The objects owning the components in m_components.
+	std::vector<ProceduralObjectId> m_ids;
+    /// The \c ProceduralComponent of all objects, contiguous.
+	std::vector<std::shared_ptr<Component_t>> m_components;
+    /// Value of ProceduralObject::GetDestroyedCount() when the components of destroyed objects were last removed.
+	std::atomic<uint64_t> m_sweptDestroyedCount{0};
 };  // class ProceduralComponentSystem
 
 }  // namespace pagoda
@@ -22,18 +22,18 @@ public:
 	virtual ~ProceduralComponentSystemBase();
 
 	std::string GetComponentSystemTypeName() const;
-	virtual std::shared_ptr<ProceduralComponent> CreateComponent(ProceduralObjectPtr) = 0;
-	virtual std::shared_ptr<ProceduralComponent> GetComponent(ProceduralObjectPtr object) = 0;
-	virtual void KillProceduralComponent(ProceduralObjectPtr) = 0;
+	virtual std::shared_ptr<ProceduralComponent> CreateComponent(const ProceduralObjectPtr &object) = 0;
+	virtual std::shared_ptr<ProceduralComponent> GetComponent(const ProceduralObjectPtr &object) = 0;
+	virtual void KillProceduralComponent(const ProceduralObjectPtr &object) = 0;
 
 	template<typename C>
-	std::shared_ptr<C> GetComponentAs(ProceduralObjectPtr object)
+	std::shared_ptr<C> GetComponentAs(const ProceduralObjectPtr &object)
 	{
 		return std::dynamic_pointer_cast<C>(GetComponent(object));
 	}
 
 	template<typename C>
-	std::shared_ptr<C> CreateComponentAs(ProceduralObjectPtr object)
+	std::shared_ptr<C> CreateComponentAs(const ProceduralObjectPtr &object)
 	{
 		return std::dynamic_pointer_cast<C>(CreateComponent(object));
 	}
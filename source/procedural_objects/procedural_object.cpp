@@ -1,14 +1,88 @@
 #include "procedural_object.h"
 
+#include "procedural_object_arena.h"
+
 #include "dynamic_value/type_info.h"
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 namespace pagoda
 {
+namespace
+{
+/**
+ * Hands out the \c ProceduralObjectId of all \c ProceduralObject, reusing the indices of the destroyed ones.
+ */
+class ProceduralObjectIds
+{
+public:
+	ProceduralObjectId Acquire()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_freeIndices.empty())
+		{
+			m_generations.push_back(0);
+			return {static_cast<uint32_t>(m_generations.size() - 1), 0};
+		}
+		const auto index = m_freeIndices.back();
+		m_freeIndices.pop_back();
+		return {index, m_generations[index]};
+	}
+
+	void Release(const ProceduralObjectId& id)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_generations[id.m_index];
+		m_freeIndices.push_back(id.m_index);
+		m_destroyedCount.fetch_add(1, std::memory_order_release);
+	}
+
+	bool IsAlive(const ProceduralObjectId& id)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return id.m_index < m_generations.size() && m_generations[id.m_index] == id.m_generation;
+	}
+
+	uint64_t GetDestroyedCount() const { return m_destroyedCount.load(std::memory_order_acquire); }
+
+private:
+	std::mutex m_mutex;
+	/// Generation of the next object to hold each index.
+	std::vector<uint32_t> m_generations;
+	std::vector<uint32_t> m_freeIndices;
+	/// Number of objects destroyed so far, readable without locking m_mutex.
+	std::atomic<uint64_t> m_destroyedCount{0};
+};
+
+ProceduralObjectIds& GetProceduralObjectIds()
+{
+	// Never destroyed, since objects may outlive the static variables
+	static auto ids = new ProceduralObjectIds();
+	return *ids;
+}
+}  // namespace
+
 const TypeInfoPtr ProceduralObject::s_typeInfo = std::make_shared<TypeInfo>("ProceduralObject");
 
-ProceduralObject::ProceduralObject() : BuiltinClass(s_typeInfo) {}
+ProceduralObject::ProceduralObject()
+    : BuiltinClass(s_typeInfo), m_arena(nullptr), m_id(GetProceduralObjectIds().Acquire())
+{
+}
+
+ProceduralObject::ProceduralObject(ProceduralObjectArena* arena)
+    : BuiltinClass(s_typeInfo, arena->MakeShared<DynamicValueTable>(s_typeInfo->GetTypeName())),
+      m_arena(arena),
+      m_id(GetProceduralObjectIds().Acquire())
+{
+}
+
+ProceduralObject::~ProceduralObject() { GetProceduralObjectIds().Release(m_id); }
+
+bool ProceduralObject::IsAlive(const ProceduralObjectId& id) { return GetProceduralObjectIds().IsAlive(id); }
 
-ProceduralObject::~ProceduralObject() {}
+uint64_t ProceduralObject::GetDestroyedCount() { return GetProceduralObjectIds().GetDestroyedCount(); }
 
 std::string ProceduralObject::ToString() const { return "<ProceduralObject>"; }
 
@@ -6,6 +6,7 @@
 #include "procedural_component.h"
 
 #include <bitset>
+#include <cstdint>
 #include <list>
 #include <unordered_map>
 #include <unordered_set>
@@ -19,18 +20,68 @@ using ContextPtr = std::shared_ptr<Context>;
 class TypeInfo;
 using TypeInfoPtr = std::shared_ptr<TypeInfo>;
 
+class ProceduralObjectArena;
+
+/**
+ * Identifies a \c ProceduralObject while it is alive.
+ *
+ * Indices are small and reused by the objects created after the ones holding them are destroyed,
+ * so that they can index dense arrays. The generation tells apart the objects that held the same index.
+ */
+struct ProceduralObjectId
+{
+	uint32_t m_index;
+	uint32_t m_generation;
+
+	bool operator==(const ProceduralObjectId& other) const
+	{
+		return m_index == other.m_index && m_generation == other.m_generation;
+	}
+	bool operator!=(const ProceduralObjectId& other) const { return !(*this == other); }
+};  // struct ProceduralObjectId
+
 class ProceduralObject : public std::enable_shared_from_this<ProceduralObject>, public BuiltinClass
 {
 public:
 	static const TypeInfoPtr s_typeInfo;
 
 	ProceduralObject();
+	/**
+	 * Creates a \c ProceduralObject whose member table is allocated in \p arena.
+	 * The object must also be allocated in \p arena, which it doesn't keep alive by itself.
+	 */
+	explicit ProceduralObject(ProceduralObjectArena* arena);
 	virtual ~ProceduralObject();
 
+	/**
+	 * Returns the \c ProceduralObjectArena this object was allocated in, or nullptr.
+	 * Its \c ProceduralComponent are allocated in the same arena.
+	 */
+	ProceduralObjectArena* GetArena() const { return m_arena; }
+
+	/**
+	 * Returns the \c ProceduralObjectId of this object, which doesn't change during its lifetime.
+	 */
+	const ProceduralObjectId& GetId() const { return m_id; }
+
+	/**
+	 * Returns true if the \c ProceduralObject identified by \p id hasn't been destroyed.
+	 */
+	static bool IsAlive(const ProceduralObjectId& id);
+
+	/**
+	 * Returns how many \c ProceduralObject have been destroyed so far.
+	 * Doesn't lock, so it can cheaply tell whether any object was destroyed since it was last called.
+	 */
+	static uint64_t GetDestroyedCount();
+
 	std::string ToString() const override;
 
 	void AcceptVisitor(ValueVisitorBase& visitor) override;
 
+private:
+	ProceduralObjectArena* m_arena;
+	ProceduralObjectId m_id;
 };  // class ProceduralObject
 
 using ProceduralObjectPtr = std::shared_ptr<ProceduralObject>;
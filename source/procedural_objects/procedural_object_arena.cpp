@@ -0,0 +1,124 @@
+#include "procedural_object_arena.h"
+
+#include <cstddef>
+
+namespace pagoda
+{
+namespace
+{
+/// Allocations are rounded up to this size, which keeps them aligned for any type.
+const std::size_t s_granularity = alignof(std::max_align_t);
+/// Allocations larger than this aren't done in the blocks.
+const std::size_t s_maxPooledSize = 1024;
+const std::size_t s_blockSize = 64 * 1024;
+
+std::size_t GetSizeClass(std::size_t size) { return (size + s_granularity - 1) / s_granularity; }
+
+std::atomic<uint64_t> s_nextArenaId(0);
+}  // namespace
+
+void ProceduralObjectArenaDeleter::operator()(ProceduralObjectArena *arena) const { arena->Release(); }
+
+ProceduralObjectArenaPtr ProceduralObjectArena::Create()
+{
+	return ProceduralObjectArenaPtr(new ProceduralObjectArena(), ProceduralObjectArenaDeleter());
+}
+
+ProceduralObjectArena::ProceduralObjectArena() : m_id(s_nextArenaId++), m_references(1) {}
+
+ProceduralObjectArena::~ProceduralObjectArena() {}
+
+std::size_t ProceduralObjectArena::GetReservedBytes() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_blocks.size() * s_blockSize;
+}
+
+void *ProceduralObjectArena::Allocate(std::size_t size)
+{
+	// The caller holds a reference already, so the arena can't be destroyed concurrently
+	m_references.fetch_add(1, std::memory_order_relaxed);
+	if (size > s_maxPooledSize)
+	{
+		return ::operator new(size);
+	}
+
+	// Freed memory keeps the next free pointer in its first bytes
+	auto &cache = GetThreadCache();
+	const auto sizeClass = GetSizeClass(size);
+	if (auto p = cache.m_freeLists[sizeClass])
+	{
+		cache.m_freeLists[sizeClass] = *static_cast<void **>(p);
+		return p;
+	}
+
+	const auto alignedSize = sizeClass * s_granularity;
+	if (static_cast<std::size_t>(cache.m_end - cache.m_current) < alignedSize)
+	{
+		Refill(cache);
+	}
+	auto p = cache.m_current;
+	cache.m_current += alignedSize;
+	return p;
+}
+
+void ProceduralObjectArena::Deallocate(void *p, std::size_t size)
+{
+	if (size > s_maxPooledSize)
+	{
+		::operator delete(p);
+	}
+	else
+	{
+		// The memory goes to the thread that returns it, which is fine as all blocks live as long as the arena
+		auto &freeList = GetThreadCache().m_freeLists[GetSizeClass(size)];
+		*static_cast<void **>(p) = freeList;
+		freeList = p;
+	}
+	RemoveReference();
+}
+
+void ProceduralObjectArena::Release() { RemoveReference(); }
+
+void ProceduralObjectArena::RemoveReference()
+{
+	if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		delete this;
+	}
+}
+
+auto ProceduralObjectArena::GetThreadCache() -> ThreadCache &
+{
+	// Threads usually allocate from a single arena at a time, so only the last one used is remembered
+	struct LastCache
+	{
+		uint64_t m_arenaId;
+		ThreadCache *m_cache = nullptr;
+	};
+	thread_local LastCache s_lastCache;
+	if (s_lastCache.m_cache != nullptr && s_lastCache.m_arenaId == m_id)
+	{
+		return *s_lastCache.m_cache;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto &cache = m_threadCaches[std::this_thread::get_id()];
+	if (cache == nullptr)
+	{
+		cache = std::make_unique<ThreadCache>();
+		cache->m_freeLists.resize(GetSizeClass(s_maxPooledSize) + 1, nullptr);
+	}
+	s_lastCache.m_arenaId = m_id;
+	s_lastCache.m_cache = cache.get();
+	return *cache;
+}
+
+void ProceduralObjectArena::Refill(ThreadCache &cache)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_blocks.emplace_back(new char[s_blockSize]);
+	cache.m_current = m_blocks.back().get();
+	cache.m_end = cache.m_current + s_blockSize;
+}
+}  // namespace pagoda
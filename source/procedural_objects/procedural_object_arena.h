@@ -0,0 +1,153 @@
+#ifndef PAGODA_PROCEDURAL_OBJECTS_PROCEDURAL_OBJECT_ARENA_H_
+#define PAGODA_PROCEDURAL_OBJECTS_PROCEDURAL_OBJECT_ARENA_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace pagoda
+{
+class ProceduralObjectArena;
+
+/**
+ * Releases the reference of the owner of a \c ProceduralObjectArena.
+ */
+struct ProceduralObjectArenaDeleter
+{
+	void operator()(ProceduralObjectArena *arena) const;
+};
+
+using ProceduralObjectArenaPtr = std::shared_ptr<ProceduralObjectArena>;
+
+/**
+ * Pool from which \c ProceduralObject, their member tables and their \c ProceduralComponent are allocated.
+ *
+ * Everything created with MakeShared() keeps the arena alive, so the arena can be dropped by its owners
+ * at any time and its memory is released in one shot once the last of them is destroyed. Memory of
+ * destroyed values is reused for the ones created afterwards.
+ *
+ * Values can be created from multiple threads. Each thread allocates from its own free lists and its own
+ * part of a block, so the arena is only locked to give a thread a new block.
+ */
+class ProceduralObjectArena
+{
+public:
+	/**
+	 * Allocator that allocates from a \c ProceduralObjectArena.
+	 */
+	template<class T>
+	class Allocator
+	{
+	public:
+		using value_type = T;
+
+		explicit Allocator(ProceduralObjectArena *arena) : m_arena(arena) {}
+		template<class U>
+		Allocator(const Allocator<U> &other) : m_arena(other.m_arena)
+		{
+		}
+
+		T *allocate(std::size_t n) { return static_cast<T *>(m_arena->Allocate(n * sizeof(T))); }
+		void deallocate(T *p, std::size_t n) { m_arena->Deallocate(p, n * sizeof(T)); }
+
+		template<class U>
+		bool operator==(const Allocator<U> &other) const
+		{
+			return m_arena == other.m_arena;
+		}
+		template<class U>
+		bool operator!=(const Allocator<U> &other) const
+		{
+			return m_arena != other.m_arena;
+		}
+
+	private:
+		template<class U>
+		friend class Allocator;
+
+		ProceduralObjectArena *m_arena;
+	};
+
+	/**
+	 * Creates a \c ProceduralObjectArena. It is destroyed once it is no longer owned and everything
+	 * created in it is destroyed.
+	 */
+	static ProceduralObjectArenaPtr Create();
+
+	ProceduralObjectArena(const ProceduralObjectArena &) = delete;
+	ProceduralObjectArena &operator=(const ProceduralObjectArena &) = delete;
+
+	/**
+	 * Creates a \c T with \p args in this arena. The \c T and its reference count share a single allocation.
+	 */
+	template<class T, class... Args>
+	std::shared_ptr<T> MakeShared(Args &&... args)
+	{
+		return std::allocate_shared<T>(Allocator<T>(this), std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Returns the number of bytes of the blocks allocated by this arena.
+	 */
+	std::size_t GetReservedBytes() const;
+
+private:
+	friend struct ProceduralObjectArenaDeleter;
+
+	ProceduralObjectArena();
+	~ProceduralObjectArena();
+
+	/**
+	 * Returns memory for \p size bytes, aligned for any type.
+	 */
+	void *Allocate(std::size_t size);
+	/**
+	 * Returns the memory at \p p, allocated with Allocate(\p size), so that it can be reused.
+	 */
+	void Deallocate(void *p, std::size_t size);
+	/**
+	 * Releases the reference of the owners, destroying the arena if nothing allocated in it is alive.
+	 */
+	void Release();
+	/**
+	 * Drops a reference of the owners or of an allocation, destroying the arena with the last one.
+	 */
+	void RemoveReference();
+
+	/**
+	 * The memory of the arena used by a single thread.
+	 */
+	struct ThreadCache
+	{
+		/// Memory returned to the arena in this thread, by size class.
+		std::vector<void *> m_freeLists;
+		/// Position of the unused memory in the block of this thread.
+		char *m_current = nullptr;
+		char *m_end = nullptr;
+	};
+	/**
+	 * Returns the \c ThreadCache of the calling thread, creating it the first time the thread uses the arena.
+	 */
+	ThreadCache &GetThreadCache();
+	/**
+	 * Gives \p cache a new block to allocate from.
+	 */
+	void Refill(ThreadCache &cache);
+
+	/// Identifies the arena in the caches of the threads, as addresses can be reused by later arenas.
+	const uint64_t m_id;
+	/// References of the owners, which count as one, and of each allocation that hasn't been returned.
+	std::atomic<std::size_t> m_references;
+	/// Guards the blocks and the thread caches.
+	mutable std::mutex m_mutex;
+	/// Blocks from which the memory is allocated, all released with the arena.
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	std::unordered_map<std::thread::id, std::unique_ptr<ThreadCache>> m_threadCaches;
+};  // class ProceduralObjectArena
+}  // namespace pagoda
+
+#endif
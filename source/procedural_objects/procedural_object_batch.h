@@ -0,0 +1,40 @@
+#ifndef PAGODA_PROCEDURAL_OBJECTS_PROCEDURAL_OBJECT_BATCH_H_
+#define PAGODA_PROCEDURAL_OBJECTS_PROCEDURAL_OBJECT_BATCH_H_
+
+#include "procedural_component.h"
+
+#include <memory>
+#include <vector>
+
+namespace pagoda
+{
+/// Procedural objects passed together between operations and graph nodes, in order.
+using ProceduralObjectBatch = std::vector<ProceduralObjectPtr>;
+
+/**
+ * A \c ProceduralObjectBatch that is no longer modified once created.
+ *
+ * Graph nodes hand these to each other instead of copying the objects, so that a batch created
+ * by an operation reaches the operations downstream with a single reference count per hop, and
+ * can be sent again without copies.
+ */
+using SharedProceduralObjectBatch = std::shared_ptr<const ProceduralObjectBatch>;
+
+/// The batches received by a graph node, in the order they were received.
+using SharedProceduralObjectBatches = std::vector<SharedProceduralObjectBatch>;
+
+/**
+ * Returns the objects in all the \p batches, in order.
+ */
+inline ProceduralObjectBatch FlattenProceduralObjectBatches(const SharedProceduralObjectBatches& batches)
+{
+	ProceduralObjectBatch objects;
+	for (const auto& b : batches)
+	{
+		objects.insert(objects.end(), b->begin(), b->end());
+	}
+	return objects;
+}
+}  // namespace pagoda
+
+#endif
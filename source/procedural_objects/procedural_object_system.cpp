@@ -6,6 +6,7 @@
 
 #include "procedural_component_system.h"
 #include "procedural_object.h"
+#include "procedural_object_arena.h"
 
 namespace pagoda
 {
@@ -13,11 +14,12 @@ ProceduralObjectSystem::ProceduralObjectSystem() { LOG_TRACE(Core, "Creating Pro
 
 ProceduralObjectSystem::~ProceduralObjectSystem() { LOG_TRACE(Core, "Destroying ProceduralObjectSystem"); }
 
-std::shared_ptr<ProceduralObject> ProceduralObjectSystem::CreateProceduralObject()
+std::shared_ptr<ProceduralObject> ProceduralObjectSystem::CreateProceduralObject(ProceduralObjectArena* arena)
 {
 	START_PROFILE;
 
-	auto object = std::make_shared<ProceduralObject>();
+	auto object = arena != nullptr ? arena->MakeShared<ProceduralObject>(arena) : std::make_shared<ProceduralObject>();
+	std::lock_guard<std::shared_mutex> lock(m_mutex);
 	m_proceduralObjects.insert(object);
 
 	return object;
@@ -29,6 +31,7 @@ bool ProceduralObjectSystem::RegisterProceduralComponentSystem(std::shared_ptr<P
 
 	LOG_TRACE(Core, "Registering ProceduralComponentSystem with name " << system->GetComponentSystemTypeName().c_str());
 	auto system_type = system->GetComponentSystemTypeName();
+	std::lock_guard<std::shared_mutex> lock(m_mutex);
 
 	if (m_proceduralComponentSystems.find(system_type) != std::end(m_proceduralComponentSystems))
 	{
@@ -44,6 +47,7 @@ bool ProceduralObjectSystem::UnregisterProceduralComponentSystem(std::shared_ptr
 	START_PROFILE;
 
 	auto system_type = system->GetComponentSystemTypeName();
+	std::lock_guard<std::shared_mutex> lock(m_mutex);
 
 	DBG_ASSERT_MSG(m_proceduralObjects.size() == 0,
 	               "Unregistering a ComponentSystem while there are procedural objects may cause incorrect behaviour.");
@@ -61,6 +65,7 @@ bool ProceduralObjectSystem::UnregisterProceduralComponentSystem(std::shared_ptr
 std::shared_ptr<ProceduralComponentSystemBase> ProceduralObjectSystem::GetComponentSystem(const std::string& systemName)
 {
 	START_PROFILE;
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
 
 	auto iteratorToSystems = m_proceduralComponentSystems.find(systemName);
 
@@ -81,6 +86,7 @@ void ProceduralObjectSystem::KillProceduralObject(std::shared_ptr<ProceduralObje
 		return;
 	}
 
+	std::lock_guard<std::shared_mutex> lock(m_mutex);
 	for (auto& system : m_proceduralComponentSystems)
 	{
 		system.second->KillProceduralComponent(proceduralObject);
@@ -4,18 +4,22 @@
 #include "common/profiler.h"
 
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace pagoda
 {
 class ProceduralObject;
+class ProceduralObjectArena;
 class ProceduralComponentSystemBase;
 
 /**
  * Manages all \c ProceduralObject.
  *
  * All \c ProceduralObject should be created and killed through a \c ProceduralObjectSystem.
+ * Objects can be created and killed, and component systems queried, from multiple threads.
  */
 class ProceduralObjectSystem
 {
@@ -23,7 +27,10 @@ public:
 	ProceduralObjectSystem();
 	~ProceduralObjectSystem();
 
-	std::shared_ptr<ProceduralObject> CreateProceduralObject();
+	/**
+	 * Creates a \c ProceduralObject, allocated in \p arena if not null.
+	 */
+	std::shared_ptr<ProceduralObject> CreateProceduralObject(ProceduralObjectArena* arena = nullptr);
 	void KillProceduralObject(std::shared_ptr<ProceduralObject>& proceduralObject);
 
 	bool RegisterProceduralComponentSystem(std::shared_ptr<ProceduralComponentSystemBase> system);
@@ -36,6 +43,7 @@ public:
 		    m_proceduralObjects.size() == 0,
 		    "Unregistering a ComponentSystem while there are procedural objects may cause incorrect behaviour.");
 		START_PROFILE;
+		std::lock_guard<std::shared_mutex> lock(m_mutex);
 
 		std::string type = System::GetComponentSystem();
 
@@ -63,6 +71,8 @@ public:
 	}
 
 private:
+	/// Guards the objects and systems so that nodes can be executed concurrently.
+	std::shared_mutex m_mutex;
 	std::unordered_set<std::shared_ptr<ProceduralObject>> m_proceduralObjects;
 	std::unordered_map<std::string, std::shared_ptr<ProceduralComponentSystemBase>> m_proceduralComponentSystems;
 };  // class ProceduralObjectSystem
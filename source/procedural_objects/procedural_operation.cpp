@@ -6,10 +6,18 @@
 #include "dynamic_value/value_visitor.h"
 #include "procedural_object.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 namespace pagoda
 {
 const TypeInfoPtr ProceduralOperation::s_typeInfo = std::make_shared<TypeInfo>("ProceduralOperation");
 
+uint32_t ProceduralOperation::s_objectWorkerCount = 1;
+
 ProceduralOperation::ProceduralOperation(ProceduralObjectSystemPtr proceduralObjectSystem)
     : BuiltinClass(s_typeInfo), m_proceduralObjectSystem(proceduralObjectSystem)
 {
@@ -36,6 +44,20 @@ bool ProceduralOperation::PushProceduralObject(const std::string& interface, Pro
 	return true;
 }
 
+bool ProceduralOperation::PushProceduralObjects(const std::string& interface, SharedProceduralObjectBatch objects)
+{
+	START_PROFILE;
+
+	auto input_interface = input_interfaces.find(interface);
+	if (input_interface == input_interfaces.end())
+	{
+		return false;
+	}
+
+	input_interface->second->AddProceduralObjects(std::move(objects));
+	return true;
+}
+
 ProceduralObjectPtr ProceduralOperation::PopProceduralObject(const std::string& interface) const
 {
 	START_PROFILE;
@@ -50,6 +72,19 @@ ProceduralObjectPtr ProceduralOperation::PopProceduralObject(const std::string&
 	return output_interface->second->GetAndPopProceduralObject();
 }
 
+SharedProceduralObjectBatch ProceduralOperation::TakeOutputObjects(const std::string& interface) const
+{
+	START_PROFILE;
+
+	auto output_interface = output_interfaces.find(interface);
+	if (output_interface == output_interfaces.end())
+	{
+		return nullptr;
+	}
+
+	return output_interface->second->TakeProceduralObjects();
+}
+
 void ProceduralOperation::CreateInputInterface(const std::string& interfaceName)
 {
 	START_PROFILE;
@@ -89,12 +124,49 @@ std::shared_ptr<ProceduralObject> ProceduralOperation::CreateOutputProceduralObj
 {
 	START_PROFILE;
 
-	auto procedural_object = m_proceduralObjectSystem->CreateProceduralObject();
+	auto procedural_object = m_proceduralObjectSystem->CreateProceduralObject(m_arena.get());
 	output_interfaces[interfaceName]->AddProceduralObject(procedural_object);
 
 	return procedural_object;
 }
 
+std::vector<std::string> ProceduralOperation::GetInputInterfaces() const
+{
+	std::vector<std::string> names;
+	for (const auto& i : input_interfaces)
+	{
+		names.push_back(i.first);
+	}
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+std::vector<std::string> ProceduralOperation::GetOutputInterfaces() const
+{
+	std::vector<std::string> names;
+	for (const auto& i : output_interfaces)
+	{
+		names.push_back(i.first);
+	}
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+ProceduralObjectBatch ProceduralOperation::GetPendingInputObjects(const std::string& interface) const
+{
+	auto inputInterface = input_interfaces.find(interface);
+	DBG_ASSERT_MSG(inputInterface != input_interfaces.end(), "Could not find operation interface");
+	return inputInterface->second->GetProceduralObjects();
+}
+
+void ProceduralOperation::ClearInputs()
+{
+	for (auto& i : input_interfaces)
+	{
+		i.second->Clear();
+	}
+}
+
 std::string ProceduralOperation::ToString() const { return "<ProceduralOperation>"; }
 
 void ProceduralOperation::AcceptVisitor(ValueVisitorBase& visitor) { visitor.Visit(*this); }
@@ -118,4 +190,107 @@ void ProceduralOperation::UpdateValue(const std::string& valueName)
 
 DynamicValueBasePtr ProceduralOperation::GetValue(const std::string& valueName) { return GetMember(valueName); }
 
+void ProceduralOperation::SetObjectWorkerCount(uint32_t workerCount) { s_objectWorkerCount = workerCount; }
+
+uint32_t ProceduralOperation::GetObjectWorkerCount()
+{
+	if (s_objectWorkerCount == 0)
+	{
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+	return s_objectWorkerCount;
+}
+
+ProceduralOperation::ObjectOutputs::ObjectOutputs(ProceduralObjectSystemPtr proceduralObjectSystem,
+                                                  ProceduralObjectArena* arena)
+    : m_proceduralObjectSystem(proceduralObjectSystem), m_arena(arena)
+{
+}
+
+std::shared_ptr<ProceduralObject> ProceduralOperation::ObjectOutputs::CreateOutputProceduralObject(
+    const std::string& interfaceName)
+{
+	auto proceduralObject = m_proceduralObjectSystem->CreateProceduralObject(m_arena);
+	m_outputs.emplace_back(interfaceName, proceduralObject);
+	return proceduralObject;
+}
+
+void ProceduralOperation::ForEachInputObject(const std::string& interfaceName,
+                                             const std::function<ObjectWork_t(ProceduralObjectPtr)>& prepare)
+{
+	START_PROFILE;
+
+	std::vector<ObjectWork_t> work;
+	while (HasInput(interfaceName))
+	{
+		work.push_back(prepare(GetInputProceduralObject(interfaceName)));
+	}
+
+	std::vector<ObjectOutputs> outputs(work.size(), ObjectOutputs(m_proceduralObjectSystem, m_arena.get()));
+	const uint32_t workerCount = std::min<std::size_t>(GetObjectWorkerCount(), work.size());
+	if (workerCount <= 1)
+	{
+		for (auto i = 0u; i < work.size(); ++i)
+		{
+			work[i](outputs[i]);
+		}
+	}
+	else
+	{
+		// Objects are processed in contiguous batches, several per worker to balance uneven work
+		const std::size_t batchSize = std::max<std::size_t>(1, work.size() / (4 * workerCount));
+		std::atomic<std::size_t> nextBatch(0);
+		std::mutex exceptionMutex;
+		std::exception_ptr exception = nullptr;
+
+		auto worker = [&]() {
+			std::size_t begin;
+			while ((begin = batchSize * nextBatch++) < work.size())
+			{
+				try
+				{
+					for (auto i = begin; i < std::min(begin + batchSize, work.size()); ++i)
+					{
+						work[i](outputs[i]);
+					}
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(exceptionMutex);
+					if (exception == nullptr)
+					{
+						exception = std::current_exception();
+					}
+				}
+			}
+		};
+
+		std::vector<std::thread> workers;
+		for (auto i = 1u; i < workerCount; ++i)
+		{
+			workers.emplace_back(worker);
+		}
+		worker();
+		for (auto& w : workers)
+		{
+			w.join();
+		}
+
+		if (exception != nullptr)
+		{
+			std::rethrow_exception(exception);
+		}
+	}
+
+	for (auto& objectOutputs : outputs)
+	{
+		for (auto& output : objectOutputs.m_outputs)
+		{
+			auto outputInterface = output_interfaces.find(output.first);
+			DBG_ASSERT_MSG(outputInterface != output_interfaces.end(), "Could not find operation interface");
+			outputInterface->second->AddProceduralObject(output.second);
+		}
+	}
+}
+
 }  // namespace pagoda
@@ -7,14 +7,20 @@
 #include "procedural_operation_object_interface.h"
 
 #include <bitset>
+#include <functional>
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace pagoda
 {
 class ProceduralObjectSystem;
 using ProceduralObjectSystemPtr = std::shared_ptr<ProceduralObjectSystem>;
+class ProceduralObjectArena;
+using ProceduralObjectArenaPtr = std::shared_ptr<ProceduralObjectArena>;
+class FileWriteGroup;
+using FileWriteGroupPtr = std::shared_ptr<FileWriteGroup>;
 
 class TypeInfo;
 using TypeInfoPtr = std::shared_ptr<TypeInfo>;
@@ -45,16 +51,115 @@ public:
 	 * Pushes the given \p procedural_object to the input interface with the given \p interface.
 	 */
 	bool PushProceduralObject(const std::string& interface, ProceduralObjectPtr procedural_object);
+	/**
+	 * Pushes all the \p objects to the input interface with the given \p interface without copying them.
+	 */
+	bool PushProceduralObjects(const std::string& interface, SharedProceduralObjectBatch objects);
 	/**
 	 * Pops a \c ProceduralObject from the output interface with the given \p interface
 	 */
 	ProceduralObjectPtr PopProceduralObject(const std::string& interface) const;
+	/**
+	 * Removes all the objects from the output interface with the given \p interface and returns them,
+	 * or nullptr if there are none.
+	 */
+	SharedProceduralObjectBatch TakeOutputObjects(const std::string& interface) const;
+
+	/**
+	 * Returns the names of the input interfaces, sorted by name.
+	 */
+	std::vector<std::string> GetInputInterfaces() const;
+	/**
+	 * Returns the names of the output interfaces, sorted by name.
+	 */
+	std::vector<std::string> GetOutputInterfaces() const;
+	/**
+	 * Returns the objects waiting in the input interface \p interface without removing them.
+	 */
+	ProceduralObjectBatch GetPendingInputObjects(const std::string& interface) const;
+	/**
+	 * Discards the objects waiting in all input interfaces.
+	 */
+	void ClearInputs();
+
+	/**
+	 * Returns true if the outputs of this operation only depend on its values and input objects
+	 * and executing it has no other effects, so that its results can be cached.
+	 */
+	virtual bool IsCacheable() const { return true; }
+
+	ProceduralObjectSystemPtr GetProceduralObjectSystem() const { return m_proceduralObjectSystem; }
+
+	/**
+	 * Sets the \c ProceduralObjectArena in which the output objects are allocated.
+	 * With a nullptr (the default) they are allocated individually.
+	 */
+	void SetArena(ProceduralObjectArenaPtr arena) { m_arena = arena; }
+	ProceduralObjectArenaPtr GetArena() const { return m_arena; }
+
+	/**
+	 * Sets the \c FileWriteGroup in which the files written by the operation are scheduled.
+	 * With a nullptr (the default) they are flushed with the \c AsyncFileWriter.
+	 */
+	void SetFileWriteGroup(FileWriteGroupPtr group) { m_fileWriteGroup = group; }
+	FileWriteGroupPtr GetFileWriteGroup() const { return m_fileWriteGroup; }
 
 	std::string ToString() const override;
 
 	void AcceptVisitor(ValueVisitorBase& visitor) override;
 
+	/**
+	 * Sets the number of threads used to process the input objects of per-object pure operations.
+	 * A value of 1 (the default) processes them on the calling thread. A value of 0 uses one
+	 * thread per hardware thread.
+	 */
+	static void SetObjectWorkerCount(uint32_t workerCount);
+	/**
+	 * Returns the number of threads used to process the input objects of per-object pure operations.
+	 */
+	static uint32_t GetObjectWorkerCount();
+
 protected:
+	/**
+	 * Collects the output \c ProceduralObject created while processing a single input object in
+	 * ForEachInputObject(). They are added to the output interfaces in the order of the input objects.
+	 */
+	class ObjectOutputs
+	{
+	public:
+		ObjectOutputs(ProceduralObjectSystemPtr proceduralObjectSystem, ProceduralObjectArena* arena);
+
+		/**
+		 * Creates a \c ProceduralObject that will be added to the output interface \p interfaceName.
+		 */
+		std::shared_ptr<ProceduralObject> CreateOutputProceduralObject(const std::string& interfaceName);
+
+	private:
+		friend class ProceduralOperation;
+
+		ProceduralObjectSystemPtr m_proceduralObjectSystem;
+		ProceduralObjectArena* m_arena;
+		std::vector<std::pair<std::string, ProceduralObjectPtr>> m_outputs;
+	};
+
+	/**
+	 * The work done for a single input object by a per-object pure operation.
+	 */
+	using ObjectWork_t = std::function<void(ObjectOutputs&)>;
+
+	/**
+	 * Processes every input object in the input interface \p interfaceName.
+	 *
+	 * Operations whose work on each input object only depends on that object and on the values
+	 * read for it are per-object pure and should use this method instead of looping with HasInput().
+	 *
+	 * \p prepare is called on the calling thread for each input object, in order, and is where
+	 * values must be updated and read. It returns the \c ObjectWork_t for that object, which may run
+	 * on another thread and must not access this operation's values or interfaces.
+	 */
+	void ForEachInputObject(const std::string& interfaceName,
+	                        const std::function<ObjectWork_t(ProceduralObjectPtr)>& prepare);
+
 	/**
 	 * Performs the operation work.
 	 */
@@ -85,6 +190,10 @@ private:
 
 	InterfaceContainer_t input_interfaces;
 	InterfaceContainer_t output_interfaces;
+	ProceduralObjectArenaPtr m_arena;
+	FileWriteGroupPtr m_fileWriteGroup;
+
+	static uint32_t s_objectWorkerCount;
 
 };  // class ProceduralOperation
 }  // namespace pagoda
@@ -4,7 +4,8 @@
 
 namespace pagoda
 {
-ProceduralOperationObjectInterface::ProceduralOperationObjectInterface(const std::string& name) : interface_name(name)
+ProceduralOperationObjectInterface::ProceduralOperationObjectInterface(const std::string& name)
+    : interface_name(name), m_batch(0), m_index(0)
 {
 }
 
@@ -16,42 +17,132 @@ bool ProceduralOperationObjectInterface::AddProceduralObject(ProceduralObjectPtr
 
 	if (Accepts(procedural_object))
 	{
-		procedural_objects.push_back(procedural_object);
+		m_objects.push_back(std::move(procedural_object));
 
 		return true;
 	}
 	return false;
 }
 
-ProceduralObjectPtr ProceduralOperationObjectInterface::GetFrontProceduralObject()
+void ProceduralOperationObjectInterface::AddProceduralObjects(SharedProceduralObjectBatch objects)
 {
 	START_PROFILE;
 
-	if (procedural_objects.size() > 0)
+	if (objects == nullptr || objects->empty())
 	{
-		auto object = procedural_objects.front();
-		return object;
+		return;
 	}
-	else
+	FlushObjects();
+	m_batches.push_back(std::move(objects));
+}
+
+ProceduralObjectPtr ProceduralOperationObjectInterface::GetFrontProceduralObject()
+{
+	START_PROFILE;
+
+	auto next = GetNext();
+	return next != nullptr ? *next : nullptr;
+}
+
+ProceduralObjectPtr ProceduralOperationObjectInterface::GetAndPopProceduralObject()
+{
+	START_PROFILE;
+
+	SkipReadBatches();
+	auto next = GetNext();
+	if (next == nullptr)
 	{
 		return nullptr;
 	}
+
+	auto object = *next;
+	++m_index;
+	if (GetNext() == nullptr)
+	{
+		// Releases the objects that were read, keeping the buffer for the next ones
+		Clear();
+	}
+	return object;
 }
 
-ProceduralObjectPtr ProceduralOperationObjectInterface::GetAndPopProceduralObject()
+SharedProceduralObjectBatch ProceduralOperationObjectInterface::TakeProceduralObjects()
 {
 	START_PROFILE;
 
-	if (procedural_objects.size() > 0)
+	SkipReadBatches();
+	if (GetNext() == nullptr)
+	{
+		Clear();
+		return nullptr;
+	}
+
+	SharedProceduralObjectBatch objects;
+	if (m_batch == m_batches.size() && m_index == 0)
+	{
+		objects = std::make_shared<const ProceduralObjectBatch>(std::move(m_objects));
+	}
+	else if (m_batch + 1 == m_batches.size() && m_index == 0 && m_objects.empty())
 	{
-		auto object = procedural_objects.front();
-		procedural_objects.pop_front();
-		return object;
+		objects = m_batches.back();
 	}
 	else
 	{
-		return nullptr;
+		objects = std::make_shared<const ProceduralObjectBatch>(GetProceduralObjects());
+	}
+	Clear();
+	return objects;
+}
+
+ProceduralObjectBatch ProceduralOperationObjectInterface::GetProceduralObjects() const
+{
+	ProceduralObjectBatch objects;
+	auto index = m_index;
+	for (auto batch = m_batch; batch < m_batches.size(); ++batch, index = 0)
+	{
+		objects.insert(objects.end(), m_batches[batch]->begin() + index, m_batches[batch]->end());
+	}
+	objects.insert(objects.end(), m_objects.begin() + index, m_objects.end());
+	return objects;
+}
+
+void ProceduralOperationObjectInterface::Clear()
+{
+	m_batches.clear();
+	m_objects.clear();
+	m_batch = 0;
+	m_index = 0;
+}
+
+const ProceduralObjectPtr* ProceduralOperationObjectInterface::GetNext() const
+{
+	auto index = m_index;
+	for (auto batch = m_batch; batch < m_batches.size(); ++batch, index = 0)
+	{
+		if (index < m_batches[batch]->size())
+		{
+			return &(*m_batches[batch])[index];
+		}
+	}
+	return index < m_objects.size() ? &m_objects[index] : nullptr;
+}
+
+void ProceduralOperationObjectInterface::SkipReadBatches()
+{
+	while (m_batch < m_batches.size() && m_index >= m_batches[m_batch]->size())
+	{
+		++m_batch;
+		m_index = 0;
+	}
+}
+
+void ProceduralOperationObjectInterface::FlushObjects()
+{
+	if (m_objects.empty())
+	{
+		return;
 	}
+	m_batches.push_back(std::make_shared<const ProceduralObjectBatch>(std::move(m_objects)));
+	m_objects.clear();
 }
 
 }  // namespace pagoda
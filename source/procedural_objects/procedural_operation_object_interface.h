@@ -1,13 +1,19 @@
 #ifndef PAGODA_PROCEDURAL_OPERATION_OBJECT_INTERFACE_H_
 #define PAGODA_PROCEDURAL_OPERATION_OBJECT_INTERFACE_H_
 
+#include "procedural_object_batch.h"
 #include "procedural_object_mask.h"
 
-#include <list>
 #include <string>
 
 namespace pagoda
 {
+/**
+ * Holds the procedural objects that go in or out of a \c ProceduralOperation through one of its interfaces.
+ *
+ * Objects are stored contiguously. Whole \c SharedProceduralObjectBatch are added and taken without
+ * copying their objects and reading the objects only advances a cursor.
+ */
 class ProceduralOperationObjectInterface
 {
 public:
@@ -17,13 +23,46 @@ public:
 
 	bool Accepts(ProceduralObjectPtr procedural_object);
 	bool AddProceduralObject(ProceduralObjectPtr procedural_object);
-	bool HasProceduralObjects() const { return !procedural_objects.empty(); }
+	/**
+	 * Adds all the objects in \p objects after the ones already in the interface.
+	 */
+	void AddProceduralObjects(SharedProceduralObjectBatch objects);
+	bool HasProceduralObjects() const { return GetNext() != nullptr; }
 	ProceduralObjectPtr GetFrontProceduralObject();
 	ProceduralObjectPtr GetAndPopProceduralObject();
+	/**
+	 * Removes all the objects from the interface and returns them in a single batch, or nullptr if
+	 * there are none. Doesn't copy the objects if they were added one by one or in a single batch.
+	 */
+	SharedProceduralObjectBatch TakeProceduralObjects();
+	/**
+	 * Returns a copy of the objects in the interface.
+	 */
+	ProceduralObjectBatch GetProceduralObjects() const;
+	void Clear();
 
 private:
+	/**
+	 * Returns the next object in the interface or nullptr if there is none.
+	 */
+	const ProceduralObjectPtr* GetNext() const;
+	/**
+	 * Moves the cursor past the batches that were completely read.
+	 */
+	void SkipReadBatches();
+	/**
+	 * Moves the objects added one by one to m_batches.
+	 */
+	void FlushObjects();
+
 	std::string interface_name;
-	std::list<ProceduralObjectPtr> procedural_objects;
+	/// Batches added to the interface, read before m_objects.
+	SharedProceduralObjectBatches m_batches;
+	/// Objects added one by one since the last batch.
+	ProceduralObjectBatch m_objects;
+	/// Cursor of the next object, in m_batches[m_batch] or, past the batches, in m_objects.
+	std::size_t m_batch;
+	std::size_t m_index;
 };  // class ProceduralOperationObjectInterface
 }  // namespace pagoda
 
@@ -40,42 +40,42 @@ void RepeatSplit::DoWork()
 	auto geometrySystem = m_proceduralObjectSystem->GetComponentSystem<GeometrySystem>();
 	auto hierarchicalSystem = m_proceduralObjectSystem->GetComponentSystem<HierarchicalSystem>();
 
-	while (HasInput(inputGeometry))
-	{
-		ProceduralObjectPtr inObject = GetInputProceduralObject(inputGeometry);
-
+	ForEachInputObject(inputGeometry, [&](ProceduralObjectPtr inObject) -> ObjectWork_t {
 		UpdateValue("size");
 		UpdateValue("axis");
 		UpdateValue("adjust");
 
-		auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
-		GeometryPtr inGeometry = inGeometryComponent->GetGeometry();
-		auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
-		auto inScope = inGeometryComponent->GetScope();
-
 		auto size = get_value_as<float>(*GetValue("size"));
 		auto axis = get_value_as<std::string>(*GetValue("axis"));
 		auto adjust = get_value_as<std::string>(*GetValue("adjust"));
-		PlaneSplits<Geometry> planeSplit(CreatePlanes(inScope, size, axis, adjust == "true"));
-
-		std::vector<GeometryPtr> splitGeometries;
 
-		planeSplit.Execute(inGeometry, splitGeometries);
-
-		int32_t createdObjectCount = 1;
-		for (auto& g : splitGeometries)
-		{
-			auto outProceduralObject = CreateOutputProceduralObject(outputGeometry);
-			outProceduralObject->RegisterOrSetMember("index", std::make_shared<Integer>(createdObjectCount++));
-			auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outProceduralObject);
-			auto outHierarchicalComponent =
-			    hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outProceduralObject);
-
-			outGeometryComponent->SetGeometry(g);
-			outGeometryComponent->SetScope(Scope::FromGeometryAndConstrainedRotation(g, inScope.GetRotation()));
-			hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
-		}
-	}
+		return [=](ObjectOutputs& outputs) {
+			auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
+			GeometryPtr inGeometry = geometrySystem->GetGeometry(inGeometryComponent);
+			auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
+			auto inScope = inGeometryComponent->GetScope();
+
+			PlaneSplits<Geometry> planeSplit(CreatePlanes(inScope, size, axis, adjust == "true"));
+
+			std::vector<GeometryPtr> splitGeometries;
+
+			planeSplit.Execute(inGeometry, splitGeometries);
+
+			int32_t createdObjectCount = 1;
+			for (auto& g : splitGeometries)
+			{
+				auto outProceduralObject = outputs.CreateOutputProceduralObject(outputGeometry);
+				outProceduralObject->RegisterOrSetMember("index", std::make_shared<Integer>(createdObjectCount++));
+				auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outProceduralObject);
+				auto outHierarchicalComponent =
+				    hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outProceduralObject);
+
+				outGeometryComponent->SetGeometry(g);
+				outGeometryComponent->SetScope(Scope::FromGeometryAndConstrainedRotation(g, inScope.GetRotation()));
+				hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
+			}
+		};
+	});
 }
 
 std::vector<Plane<float>> RepeatSplit::CreatePlanes(const Scope& scope, const float& size, const std::string& axis,
@@ -13,8 +13,6 @@
 #include "math_lib/matrix_base.h"
 #include "procedural_object_system.h"
 
-#include "geometry_operations/matrix_transform.h"
-
 #include <boost/qvm/map_vec_mat.hpp>
 #include <boost/qvm/mat_operations.hpp>
 
@@ -44,18 +42,7 @@ void Rotate::DoWork()
 	auto geometrySystem = m_proceduralObjectSystem->GetComponentSystem<GeometrySystem>();
 	auto hierarchicalSystem = m_proceduralObjectSystem->GetComponentSystem<HierarchicalSystem>();
 
-	while (HasInput(s_inputGeometry))
-	{
-		ProceduralObjectPtr inObject = GetInputProceduralObject(s_inputGeometry);
-		ProceduralObjectPtr outObject = CreateOutputProceduralObject(s_outputGeometry);
-
-		auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
-		GeometryPtr inGeometry = inGeometryComponent->GetGeometry();
-		auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outObject);
-		auto outGeometry = std::make_shared<Geometry>();
-		outGeometryComponent->SetGeometry(outGeometry);
-
-		auto inScope = inGeometryComponent->GetScope();
+	ForEachInputObject(s_inputGeometry, [&](ProceduralObjectPtr inObject) -> ObjectWork_t {
 		UpdateValue("x");
 		UpdateValue("y");
 		UpdateValue("z");
@@ -68,58 +55,50 @@ void Rotate::DoWork()
 		auto rotationOrder = get_value_as<std::string>(*GetValue("rotation_order"));
 		auto world = get_value_as<std::string>(*GetValue("world")) == "true";
 
-		Mat4x4F matrix(boost::qvm::diag_mat(Vec4F{1.0f, 1.0f, 1.0f, 1.0f}));
-		if (world)
-		{
-			auto rot = inScope.GetRotation();
-			boost::qvm::col<0>(matrix) = XYZ0(boost::qvm::col<0>(rot));
-			boost::qvm::col<1>(matrix) = XYZ0(boost::qvm::col<1>(rot));
-			boost::qvm::col<2>(matrix) = XYZ0(boost::qvm::col<2>(rot));
-			boost::qvm::col<3>(matrix) = Vec4F{0, 0, 0, 1};
-		}
+		return [=](ObjectOutputs& outputs) {
+			ProceduralObjectPtr outObject = outputs.CreateOutputProceduralObject(s_outputGeometry);
+
+			auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
+			auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outObject);
+			geometrySystem->ShareGeometry(inGeometryComponent, outGeometryComponent);
 
-		for (std::size_t i = rotationOrder.size(); i > 0; --i)
-		{
-			char order = rotationOrder[i - 1];
-			switch (order)
+			auto inScope = inGeometryComponent->GetScope();
+			// The rotations are composed as 3x3 matrices and the result applied as an affine transformation
+			Mat3x3F rot = world ? inScope.GetRotation() : Mat3x3F(boost::qvm::diag_mat(Vec3F{1.0f, 1.0f, 1.0f}));
+			for (std::size_t i = rotationOrder.size(); i > 0; --i)
 			{
-				case 'x':
-					matrix = matrix * boost::qvm::rotx_mat<4>(static_cast<float>(Radians(x)));
-					break;
-				case 'y':
-					matrix = matrix * boost::qvm::roty_mat<4>(static_cast<float>(Radians(y)));
-					break;
-				case 'z':
-					matrix = matrix * boost::qvm::rotz_mat<4>(static_cast<float>(Radians(z)));
-					break;
-				default:
-					throw Exception("Invalid rotation order " + std::string(1, order));
+				char order = rotationOrder[i - 1];
+				switch (order)
+				{
+					case 'x':
+						rot = rot * boost::qvm::rotx_mat<3>(static_cast<float>(Radians(x)));
+						break;
+					case 'y':
+						rot = rot * boost::qvm::roty_mat<3>(static_cast<float>(Radians(y)));
+						break;
+					case 'z':
+						rot = rot * boost::qvm::rotz_mat<3>(static_cast<float>(Radians(z)));
+						break;
+					default:
+						throw Exception("Invalid rotation order " + std::string(1, order));
+				}
 			}
-		}
-
-		if (world)
-		{
-			auto rot = inScope.GetInverseRotation();
-			Mat4x4F invRot;
-			boost::qvm::col<0>(invRot) = XYZ0(boost::qvm::col<0>(rot));
-			boost::qvm::col<1>(invRot) = XYZ0(boost::qvm::col<1>(rot));
-			boost::qvm::col<2>(invRot) = XYZ0(boost::qvm::col<2>(rot));
-			boost::qvm::col<3>(invRot) = Vec4F{0, 0, 0, 1};
-			matrix = matrix * invRot;
-		}
-
-		MatrixTransform<Geometry> transform(matrix);
-		transform.Execute(inGeometry, outGeometry);
-		Mat3x3F rot;
-		boost::qvm::col<0>(rot) = XYZ(boost::qvm::col<0>(matrix));
-		boost::qvm::col<1>(rot) = XYZ(boost::qvm::col<1>(matrix));
-		boost::qvm::col<2>(rot) = XYZ(boost::qvm::col<2>(matrix));
-		outGeometryComponent->SetScope(
-		    Scope::FromGeometryAndConstrainedRotation(outGeometry, rot * inScope.GetRotation()));
-
-		auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
-		auto outHierarchicalComponent = hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outObject);
-		hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
-	}
+			if (world)
+			{
+				rot = rot * inScope.GetInverseRotation();
+			}
+
+			Mat4x4F matrix(boost::qvm::diag_mat(Vec4F{1.0f, 1.0f, 1.0f, 1.0f}));
+			boost::qvm::col<0>(matrix) = XYZ0(boost::qvm::col<0>(rot));
+			boost::qvm::col<1>(matrix) = XYZ0(boost::qvm::col<1>(rot));
+			boost::qvm::col<2>(matrix) = XYZ0(boost::qvm::col<2>(rot));
+			geometrySystem->TransformGeometry(outGeometryComponent, matrix);
+			outGeometryComponent->SetScope(inScope.Transformed(AffineRows(matrix), rot * inScope.GetRotation()));
+
+			auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
+			auto outHierarchicalComponent = hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outObject);
+			hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
+		};
+	});
 }  // namespace pagoda
 }  // namespace pagoda
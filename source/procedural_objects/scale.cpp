@@ -10,13 +10,50 @@
 #include "math_lib/matrix_base.h"
 #include "procedural_object_system.h"
 
-#include "geometry_operations/matrix_transform.h"
-
 #include <boost/qvm/map_vec_mat.hpp>
 #include <boost/qvm/mat_operations.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace pagoda
 {
+namespace
+{
+/*
+ * Returns whether the scale in \p matrix only scales along the axes of \p scope, which then remains a box.
+ */
+bool ScalesAlongScopeAxes(const Mat4x4F &matrix, const Scope &scope)
+{
+	Mat3x3F linear;
+	for (auto r = 0u; r < 3; ++r)
+	{
+		for (auto c = 0u; c < 3; ++c)
+		{
+			linear.a[r][c] = matrix.a[r][c];
+		}
+	}
+	const Mat3x3F inScope = scope.GetInverseRotation() * linear * scope.GetRotation();
+	float maxDiagonal = 0.0f;
+	float maxOffDiagonal = 0.0f;
+	for (auto r = 0u; r < 3; ++r)
+	{
+		for (auto c = 0u; c < 3; ++c)
+		{
+			if (r == c)
+			{
+				maxDiagonal = std::max(maxDiagonal, std::abs(inScope.a[r][c]));
+			}
+			else
+			{
+				maxOffDiagonal = std::max(maxOffDiagonal, std::abs(inScope.a[r][c]));
+			}
+		}
+	}
+	return maxOffDiagonal <= 1e-5f * maxDiagonal;
+}
+}  // namespace
+
 const std::string Scale::s_inputGeometry("in");
 const std::string Scale::s_outputGeometry("out");
 
@@ -39,18 +76,7 @@ void Scale::DoWork()
 	auto geometrySystem = m_proceduralObjectSystem->GetComponentSystem<GeometrySystem>();
 	auto hierarchicalSystem = m_proceduralObjectSystem->GetComponentSystem<HierarchicalSystem>();
 
-	while (HasInput(s_inputGeometry))
-	{
-		ProceduralObjectPtr inObject = GetInputProceduralObject(s_inputGeometry);
-		ProceduralObjectPtr outObject = CreateOutputProceduralObject(s_outputGeometry);
-
-		auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
-		GeometryPtr inGeometry = inGeometryComponent->GetGeometry();
-		auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outObject);
-		auto outGeometry = std::make_shared<Geometry>();
-		outGeometryComponent->SetGeometry(outGeometry);
-
-		auto inScope = inGeometryComponent->GetScope();
+	ForEachInputObject(s_inputGeometry, [&](ProceduralObjectPtr inObject) -> ObjectWork_t {
 		UpdateValue("x");
 		UpdateValue("y");
 		UpdateValue("z");
@@ -61,36 +87,51 @@ void Scale::DoWork()
 		auto z = get_value_as<float>(*GetValue("z"));
 		auto pivotalPointName = get_value_as<std::string>(*GetValue("pivotal_point"));
 
-		Mat4x4F matrix;
-		if (pivotalPointName == "scope_center")
-		{
-			Vec3F pivotalPoint = inScope.GetCenterPointInWorld();
-			Mat4x4F translation = boost::qvm::translation_mat(XYZ(pivotalPoint));
-			Mat4x4F scale = boost::qvm::diag_mat(XYZ1(Vec3F{x, y, z}));
-			Mat4x4F invTranslation = boost::qvm::translation_mat(XYZ(-pivotalPoint));
-			matrix = translation * scale * invTranslation;
-		}
-		else if (pivotalPointName == "scope_origin")
-		{
-			Vec3F pivotalPoint = inScope.GetWorldPoint(Scope::BoxPoints::LowerBottomLeft);
-			matrix = boost::qvm::translation_mat(pivotalPoint) * boost::qvm::diag_mat(XYZ1(Vec3F{x, y, z})) *
-			         boost::qvm::translation_mat(-pivotalPoint);
-		}
-		else if (pivotalPointName == "world_origin")
-		{
-			matrix = boost::qvm::diag_mat(XYZ1(Vec3F{x, y, z}));
-		}
-
-		MatrixTransform<Geometry> transform(matrix);
-
-		transform.Execute(inGeometry, outGeometry);
-
-		outGeometryComponent->SetScope(Scope::FromGeometryAndConstrainedRotation(outGeometry, inScope.GetRotation()));
-
-		auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
-		auto outHierarchicalComponent = hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outObject);
-		hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
-	}
+		return [=](ObjectOutputs& outputs) {
+			ProceduralObjectPtr outObject = outputs.CreateOutputProceduralObject(s_outputGeometry);
+
+			auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
+			auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outObject);
+			geometrySystem->ShareGeometry(inGeometryComponent, outGeometryComponent);
+
+			auto inScope = inGeometryComponent->GetScope();
+			Mat4x4F matrix;
+			if (pivotalPointName == "scope_center")
+			{
+				Vec3F pivotalPoint = inScope.GetCenterPointInWorld();
+				Mat4x4F translation = boost::qvm::translation_mat(XYZ(pivotalPoint));
+				Mat4x4F scale = boost::qvm::diag_mat(XYZ1(Vec3F{x, y, z}));
+				Mat4x4F invTranslation = boost::qvm::translation_mat(XYZ(-pivotalPoint));
+				matrix = translation * scale * invTranslation;
+			}
+			else if (pivotalPointName == "scope_origin")
+			{
+				Vec3F pivotalPoint = inScope.GetWorldPoint(Scope::BoxPoints::LowerBottomLeft);
+				matrix = boost::qvm::translation_mat(pivotalPoint) * boost::qvm::diag_mat(XYZ1(Vec3F{x, y, z})) *
+				         boost::qvm::translation_mat(-pivotalPoint);
+			}
+			else if (pivotalPointName == "world_origin")
+			{
+				matrix = boost::qvm::diag_mat(XYZ1(Vec3F{x, y, z}));
+			}
+
+			geometrySystem->TransformGeometry(outGeometryComponent, matrix);
+			if (ScalesAlongScopeAxes(matrix, inScope))
+			{
+				outGeometryComponent->SetScope(inScope.Transformed(AffineRows(matrix), inScope.GetRotation()));
+			}
+			else
+			{
+				// The scope's box is sheared, so the scope is fit to the transformed geometry
+				outGeometryComponent->SetScope(Scope::FromGeometryAndConstrainedRotation(
+				    geometrySystem->GetGeometry(outGeometryComponent), inScope.GetRotation()));
+			}
+
+			auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
+			auto outHierarchicalComponent = hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outObject);
+			hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
+		};
+	});
 }
 }  // namespace pagoda
 
@@ -99,14 +99,7 @@ void Split::DoWork()
 		outInterfaces.push_back(outInterface);
 	}
 
-	while (HasInput(s_inputGeometry))
-	{
-		ProceduralObjectPtr inObject = GetInputProceduralObject(s_inputGeometry);
-		auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
-		GeometryPtr inGeometry = inGeometryComponent->GetGeometry();
-		auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
-		auto inScope = inGeometryComponent->GetScope();
-
+	ForEachInputObject(s_inputGeometry, [&](ProceduralObjectPtr inObject) -> ObjectWork_t {
 		std::vector<float> sizes;
 		sizes.reserve(splitCount);
 		for (auto i = 1; i <= splitCount; ++i)
@@ -116,22 +109,29 @@ void Split::DoWork()
 			sizes.push_back(get_value_as<float>(*GetValue(splitSizeName)));
 		}
 
-		PlaneSplits<Geometry> planeSplit(createPlanes(inScope, sizes, axis));
-		std::vector<GeometryPtr> splitGeometries;
-		planeSplit.Execute(inGeometry, splitGeometries);
-
-		for (auto i = 0u; i < static_cast<uint32_t>(splitCount) && i < splitGeometries.size(); ++i)
-		{
-			auto outProceduralObject = CreateOutputProceduralObject(outInterfaces[i]);
-			auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outProceduralObject);
-			auto outHierarchicalComponent =
-			    hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outProceduralObject);
-
-			outGeometryComponent->SetGeometry(splitGeometries[i]);
-			outGeometryComponent->SetScope(
-			    Scope::FromGeometryAndConstrainedRotation(splitGeometries[i], inScope.GetRotation()));
-			hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
-		}
-	}
+		return [=](ObjectOutputs& outputs) {
+			auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
+			GeometryPtr inGeometry = geometrySystem->GetGeometry(inGeometryComponent);
+			auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
+			auto inScope = inGeometryComponent->GetScope();
+
+			PlaneSplits<Geometry> planeSplit(createPlanes(inScope, sizes, axis));
+			std::vector<GeometryPtr> splitGeometries;
+			planeSplit.Execute(inGeometry, splitGeometries);
+
+			for (auto i = 0u; i < static_cast<uint32_t>(splitCount) && i < splitGeometries.size(); ++i)
+			{
+				auto outProceduralObject = outputs.CreateOutputProceduralObject(outInterfaces[i]);
+				auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outProceduralObject);
+				auto outHierarchicalComponent =
+				    hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outProceduralObject);
+
+				outGeometryComponent->SetGeometry(splitGeometries[i]);
+				outGeometryComponent->SetScope(
+				    Scope::FromGeometryAndConstrainedRotation(splitGeometries[i], inScope.GetRotation()));
+				hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
+			}
+		};
+	});
 }
 }  // namespace pagoda
@@ -10,8 +10,6 @@
 #include "math_lib/matrix_base.h"
 #include "procedural_object_system.h"
 
-#include "geometry_operations/matrix_transform.h"
-
 #include <boost/qvm/map_mat_vec.hpp>
 #include <boost/qvm/map_vec_mat.hpp>
 
@@ -39,18 +37,7 @@ void Translate::DoWork()
 	auto geometrySystem = m_proceduralObjectSystem->GetComponentSystem<GeometrySystem>();
 	auto hierarchicalSystem = m_proceduralObjectSystem->GetComponentSystem<HierarchicalSystem>();
 
-	while (HasInput(s_inputGeometry))
-	{
-		ProceduralObjectPtr inObject = GetInputProceduralObject(s_inputGeometry);
-		ProceduralObjectPtr outObject = CreateOutputProceduralObject(s_outputGeometry);
-
-		auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
-		GeometryPtr inGeometry = inGeometryComponent->GetGeometry();
-		auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outObject);
-		auto outGeometry = std::make_shared<Geometry>();
-		outGeometryComponent->SetGeometry(outGeometry);
-
-		auto inScope = inGeometryComponent->GetScope();
+	ForEachInputObject(s_inputGeometry, [&](ProceduralObjectPtr inObject) -> ObjectWork_t {
 		UpdateValue("x");
 		UpdateValue("y");
 		UpdateValue("z");
@@ -60,24 +47,31 @@ void Translate::DoWork()
 		auto y = get_value_as<float>(*GetValue("y"));
 		auto z = get_value_as<float>(*GetValue("z"));
 		auto inWorldCoordinates = get_value_as<std::string>(*GetValue("world")) == "true";
-		Mat4x4F matrix;
-		if (inWorldCoordinates)
-		{
-			matrix = boost::qvm::translation_mat(Vec3F{x, y, z});
-		}
-		else
-		{
-			matrix = boost::qvm::translation_mat(inScope.GetLocalVector(Vec3F{x, y, z}));
-		}
-		MatrixTransform<Geometry> transform(matrix);
 
-		transform.Execute(inGeometry, outGeometry);
+		return [=](ObjectOutputs& outputs) {
+			ProceduralObjectPtr outObject = outputs.CreateOutputProceduralObject(s_outputGeometry);
+
+			auto inGeometryComponent = geometrySystem->GetComponentAs<GeometryComponent>(inObject);
+			auto outGeometryComponent = geometrySystem->CreateComponentAs<GeometryComponent>(outObject);
+			geometrySystem->ShareGeometry(inGeometryComponent, outGeometryComponent);
 
-		outGeometryComponent->SetScope(Scope::FromGeometryAndConstrainedRotation(outGeometry, inScope.GetRotation()));
+			auto inScope = inGeometryComponent->GetScope();
+			Mat4x4F matrix;
+			if (inWorldCoordinates)
+			{
+				matrix = boost::qvm::translation_mat(Vec3F{x, y, z});
+			}
+			else
+			{
+				matrix = boost::qvm::translation_mat(inScope.GetLocalVector(Vec3F{x, y, z}));
+			}
+			geometrySystem->TransformGeometry(outGeometryComponent, matrix);
+			outGeometryComponent->SetScope(inScope.Transformed(AffineRows(matrix), inScope.GetRotation()));
 
-		auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
-		auto outHierarchicalComponent = hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outObject);
-		hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
-	}
+			auto inHierarchicalComponent = hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
+			auto outHierarchicalComponent = hierarchicalSystem->CreateComponentAs<HierarchicalComponent>(outObject);
+			hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
+		};
+	});
 }
 }  // namespace pagoda
@@ -34,34 +34,34 @@ void TriangulateGeometry::DoWork()
 	auto geometrySystem = m_proceduralObjectSystem->GetComponentSystem<GeometrySystem>();
 	auto hierarchicalSystem = m_proceduralObjectSystem->GetComponentSystem<HierarchicalSystem>();
 
-	EarClipping<Geometry> earClipping;
-
-	while (HasInput(sInputGeometry))
-	{
-		// Geometry
-		ProceduralObjectPtr inObject = GetInputProceduralObject(sInputGeometry);
-		ProceduralObjectPtr outObject = CreateOutputProceduralObject(sOutputGeometry);
-
-		std::shared_ptr<GeometryComponent> inGeometryComponent =
-		    geometrySystem->GetComponentAs<GeometryComponent>(inObject);
-		std::shared_ptr<GeometryComponent> outGeometryComponent =
-		    geometrySystem->CreateComponentAs<GeometryComponent>(outObject);
-
-		GeometryPtr inGeometry = inGeometryComponent->GetGeometry();
-		auto outGeometry = std::make_shared<Geometry>();
-
-		earClipping.Execute(inGeometry, outGeometry);
-		outGeometryComponent->SetGeometry(outGeometry);
-		outGeometryComponent->SetScope(inGeometryComponent->GetScope());
-
-		// Hierarchy
-		std::shared_ptr<HierarchicalComponent> inHierarchicalComponent =
-		    hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
-		std::shared_ptr<HierarchicalComponent> outHierarchicalComponent =
-		    hierarchicalSystem->GetComponentAs<HierarchicalComponent>(outObject);
-
-		hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
-	}
+	ForEachInputObject(sInputGeometry, [&](ProceduralObjectPtr inObject) -> ObjectWork_t {
+		return [=](ObjectOutputs& outputs) {
+			EarClipping<Geometry> earClipping;
+
+			// Geometry
+			ProceduralObjectPtr outObject = outputs.CreateOutputProceduralObject(sOutputGeometry);
+
+			std::shared_ptr<GeometryComponent> inGeometryComponent =
+			    geometrySystem->GetComponentAs<GeometryComponent>(inObject);
+			std::shared_ptr<GeometryComponent> outGeometryComponent =
+			    geometrySystem->CreateComponentAs<GeometryComponent>(outObject);
+
+			GeometryPtr inGeometry = geometrySystem->GetGeometry(inGeometryComponent);
+			auto outGeometry = std::make_shared<Geometry>();
+
+			earClipping.Execute(inGeometry, outGeometry);
+			outGeometryComponent->SetGeometry(outGeometry);
+			outGeometryComponent->SetScope(inGeometryComponent->GetScope());
+
+			// Hierarchy
+			std::shared_ptr<HierarchicalComponent> inHierarchicalComponent =
+			    hierarchicalSystem->GetComponentAs<HierarchicalComponent>(inObject);
+			std::shared_ptr<HierarchicalComponent> outHierarchicalComponent =
+			    hierarchicalSystem->GetComponentAs<HierarchicalComponent>(outObject);
+
+			hierarchicalSystem->SetParent(outHierarchicalComponent, inHierarchicalComponent);
+		};
+	});
 }
 
 }  // namespace pagoda
@@ -0,0 +1,26 @@
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<std::size_t> s_allocationCount{0};
+}  // namespace
+
+// Counts the allocations made by the benchmarks in this binary
+void *operator new(std::size_t size)
+{
+	++s_allocationCount;
+	if (void *p = std::malloc(size == 0 ? 1 : size))
+	{
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+std::size_t GetAllocationCount() { return s_allocationCount.load(); }
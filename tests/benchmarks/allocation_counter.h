@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Returns the number of calls to operator new made so far by the benchmarks.
+ */
+std::size_t GetAllocationCount();
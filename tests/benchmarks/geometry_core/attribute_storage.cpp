@@ -0,0 +1,68 @@
+#include <geometry_core/geometry.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace pagoda;
+
+namespace
+{
+template<class Storage>
+using Geometry_t =
+    GeometryBase<SplitPointTopology, DefaultFaceAttributes, DefaultEdgeAttributes, DefaultVertexAttributes, Storage>;
+
+/**
+ * Creates a geometry with (at least) \p pointCount points, all with a position.
+ */
+template<class Storage>
+std::shared_ptr<Geometry_t<Storage>> CreateGeometry(std::size_t pointCount)
+{
+	auto geometry = std::make_shared<Geometry_t<Storage>>();
+	for (auto i = 0u; i < pointCount; i += 3)
+	{
+		geometry->CreateFace();
+	}
+	float i = 0;
+	for (auto p = geometry->PointsBegin(); p != geometry->PointsEnd(); ++p, ++i)
+	{
+		geometry->SetPosition(*p, Vec3F{i, 2 * i, 3 * i});
+	}
+	return geometry;
+}
+
+template<class Storage>
+void BM_ReadPositions(benchmark::State &state)
+{
+	auto geometry = CreateGeometry<Storage>(state.range(0));
+	for (auto _ : state)
+	{
+		Vec3F sum{0, 0, 0};
+		for (auto p = geometry->PointsBegin(); p != geometry->PointsEnd(); ++p)
+		{
+			sum += geometry->GetPosition(*p);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * geometry->GetPointCount());
+}
+
+template<class Storage>
+void BM_TranslatePositions(benchmark::State &state)
+{
+	auto geometry = CreateGeometry<Storage>(state.range(0));
+	const Vec3F translation{1, 0, 0};
+	for (auto _ : state)
+	{
+		for (auto p = geometry->PointsBegin(); p != geometry->PointsEnd(); ++p)
+		{
+			geometry->SetPosition(*p, geometry->GetPosition(*p) + translation);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * geometry->GetPointCount());
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ReadPositions, AssociativeAttributeStorage)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_ReadPositions, DenseAttributeStorage)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_TranslatePositions, AssociativeAttributeStorage)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_TranslatePositions, DenseAttributeStorage)->Range(1 << 12, 1 << 18);
@@ -0,0 +1,49 @@
+#include <geometry_core/geometry_exporter.h>
+#include <geometry_operations/create_sphere.h>
+#include <procedural_objects/geometry_system.h>
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+using namespace pagoda;
+
+namespace
+{
+std::shared_ptr<Geometry> CreateSphereGeometry(uint32_t size)
+{
+	auto geometry = std::make_shared<Geometry>();
+	CreateSphere<Geometry> sphere(1.0f, size, size);
+	sphere.Execute(geometry);
+	return geometry;
+}
+
+void BM_ExportObjToStream(benchmark::State &state)
+{
+	auto geometry = CreateSphereGeometry(state.range(0));
+	ObjExporter<Geometry> exporter(geometry);
+	for (auto _ : state)
+	{
+		std::stringstream ss;
+		exporter.Export(ss);
+		benchmark::DoNotOptimize(ss.str().size());
+	}
+	state.SetItemsProcessed(state.iterations() * geometry->GetPointCount());
+}
+
+void BM_ExportObjToBuffer(benchmark::State &state)
+{
+	auto geometry = CreateSphereGeometry(state.range(0));
+	ObjExporter<Geometry> exporter(geometry);
+	for (auto _ : state)
+	{
+		std::string buffer;
+		exporter.Export(buffer);
+		benchmark::DoNotOptimize(buffer.size());
+	}
+	state.SetItemsProcessed(state.iterations() * geometry->GetPointCount());
+}
+}  // namespace
+
+BENCHMARK(BM_ExportObjToStream)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ExportObjToBuffer)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,81 @@
+#include <geometry_core/indexed_container.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace pagoda;
+
+namespace
+{
+using Container_t = IndexedContainer<uint32_t, uint32_t>;
+
+/**
+ * Creates a container with \p size values and deletes all but one in every \p keepEvery.
+ */
+Container_t CreateChurnedContainer(uint32_t size, uint32_t keepEvery)
+{
+	Container_t container;
+	for (auto i = 0u; i < size; ++i)
+	{
+		container.Create(i);
+	}
+	for (auto i = 0u; i < size; ++i)
+	{
+		if (i % keepEvery != 0)
+		{
+			container.Delete(i);
+		}
+	}
+	return container;
+}
+
+void BM_IterateAfterDeletes(benchmark::State &state)
+{
+	auto container = CreateChurnedContainer(1 << 18, state.range(0));
+	for (auto _ : state)
+	{
+		uint64_t sum = 0;
+		for (const auto &v : container)
+		{
+			sum += v.m_value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * container.Count());
+}
+
+void BM_IterateAfterCompact(benchmark::State &state)
+{
+	auto container = CreateChurnedContainer(1 << 18, state.range(0));
+	container.Compact();
+	for (auto _ : state)
+	{
+		uint64_t sum = 0;
+		for (const auto &v : container)
+		{
+			sum += v.m_value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * container.Count());
+}
+
+void BM_CreateAfterDeletes(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto container = CreateChurnedContainer(1 << 16, state.range(0));
+		state.ResumeTiming();
+		for (auto i = 0u; i < (1 << 16); ++i)
+		{
+			container.Create(i);
+		}
+		benchmark::DoNotOptimize(container.Count());
+	}
+	state.SetItemsProcessed(state.iterations() * (1 << 16));
+}
+}  // namespace
+
+BENCHMARK(BM_IterateAfterDeletes)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_IterateAfterCompact)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_CreateAfterDeletes)->Arg(1)->Arg(10)->Arg(100);
@@ -0,0 +1,93 @@
+#include <geometry_core/split_point_topology.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace pagoda;
+
+namespace
+{
+/**
+ * Creates a triangulated grid with \p size x \p size cells where the points are shared between adjacent faces.
+ */
+template<class Topology>
+void CreateGrid(Topology &topology, uint32_t size)
+{
+	std::vector<typename Topology::PointHandle> points((size + 1) * (size + 1), Topology::s_invalidIndex);
+	auto createFace = [&topology, &points](uint32_t a, uint32_t b, uint32_t c) {
+		auto face = topology.CreateFace(points[a], points[b], points[c]);
+		points[a] = topology.GetPoint(face.m_splitPoints[0]);
+		points[b] = topology.GetPoint(face.m_splitPoints[1]);
+		points[c] = topology.GetPoint(face.m_splitPoints[2]);
+	};
+
+	for (auto y = 0u; y < size; ++y)
+	{
+		for (auto x = 0u; x < size; ++x)
+		{
+			const uint32_t p = y * (size + 1) + x;
+			createFace(p, p + 1, p + size + 2);
+			createFace(p, p + size + 2, p + size + 1);
+		}
+	}
+}
+
+template<class Topology>
+void BM_CreateGrid(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		Topology topology;
+		CreateGrid(topology, state.range(0));
+		benchmark::DoNotOptimize(topology.GetFaceCount());
+	}
+	state.SetItemsProcessed(state.iterations() * 2 * state.range(0) * state.range(0));
+}
+
+template<class Topology>
+void BM_PointAdjacentFaces(benchmark::State &state)
+{
+	Topology topology;
+	CreateGrid(topology, state.range(0));
+	for (auto _ : state)
+	{
+		std::size_t faceCount = 0;
+		for (auto p = topology.PointsBegin(); p != topology.PointsEnd(); ++p)
+		{
+			for (auto f = topology.PointFaceBegin(*p); f != topology.PointFaceEnd(*p); ++f)
+			{
+				++faceCount;
+			}
+		}
+		benchmark::DoNotOptimize(faceCount);
+	}
+	state.SetItemsProcessed(state.iterations() * topology.GetPointCount());
+}
+
+template<class Topology>
+void BM_SharedEdges(benchmark::State &state)
+{
+	Topology topology;
+	CreateGrid(topology, state.range(0));
+	for (auto _ : state)
+	{
+		std::size_t edgeCount = 0;
+		for (auto e = topology.EdgesBegin(); e != topology.EdgesEnd(); ++e)
+		{
+			auto source = topology.GetPoint(topology.GetSource(*e));
+			auto destination = topology.GetPoint(topology.GetDestination(*e));
+			edgeCount += topology.GetEdges(source, destination).size();
+		}
+		benchmark::DoNotOptimize(edgeCount);
+	}
+	state.SetItemsProcessed(state.iterations() * topology.GetEdgeCount());
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_CreateGrid, SplitPointTopology)->Range(32, 256);
+BENCHMARK_TEMPLATE(BM_CreateGrid, CompactSplitPointTopology)->Range(32, 256);
+BENCHMARK_TEMPLATE(BM_PointAdjacentFaces, SplitPointTopology)->Range(32, 256);
+BENCHMARK_TEMPLATE(BM_PointAdjacentFaces, CompactSplitPointTopology)->Range(32, 256);
+BENCHMARK_TEMPLATE(BM_SharedEdges, SplitPointTopology)->Range(32, 256);
+BENCHMARK_TEMPLATE(BM_SharedEdges, CompactSplitPointTopology)->Range(32, 256);
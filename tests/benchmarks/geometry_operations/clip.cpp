@@ -0,0 +1,32 @@
+#include <geometry_operations/clip.h>
+#include <geometry_operations/create_sphere.h>
+#include <procedural_objects/geometry_system.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace pagoda;
+
+namespace
+{
+/*
+ * Clips a sphere of state.range(0) x state.range(0) faces with a plane that crosses it off the poles.
+ */
+void BM_ClipSphere(benchmark::State &state)
+{
+	auto sphere = std::make_shared<Geometry>();
+	CreateSphere<Geometry>(1.0f, state.range(0), state.range(0) - 1).Execute(sphere);
+	const auto plane = Plane<float>::FromPointAndNormal({0, 0, 0.1f}, {0.3f, 0.2f, 1.0f});
+
+	for (auto _ : state)
+	{
+		auto front = std::make_shared<Geometry>();
+		auto back = std::make_shared<Geometry>();
+		Clip<Geometry>(plane).Execute(sphere, front, back);
+		benchmark::DoNotOptimize(back->GetFaceCount());
+	}
+	state.SetItemsProcessed(state.iterations() * sphere->GetFaceCount());
+	state.counters["faces"] = sphere->GetFaceCount();
+}
+}  // namespace
+
+BENCHMARK(BM_ClipSphere)->Arg(64)->Arg(316)->Unit(benchmark::kMillisecond);
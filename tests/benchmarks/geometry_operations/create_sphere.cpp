@@ -0,0 +1,109 @@
+#include <geometry_core/geometry_builder.h>
+#include <geometry_operations/create_sphere.h>
+#include <procedural_objects/geometry_system.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace pagoda;
+
+namespace
+{
+/**
+ * Creates the points and quad faces of a \p slices x \p stacks sphere grid in flat arrays.
+ */
+void CreateSphereArrays(uint32_t slices, uint32_t stacks, std::vector<Vec3F> &positions,
+                        std::vector<Geometry::Index_t> &indices, std::vector<uint32_t> &faceSizes)
+{
+	const float sliceAngle = MathUtils<float>::two_pi / slices;
+	const float stackAngle = MathUtils<float>::pi / (stacks + 1);
+	for (auto st = 0u; st < stacks; ++st)
+	{
+		for (auto sl = 0u; sl < slices; ++sl)
+		{
+			const float theta = (st + 1) * stackAngle;
+			const float omega = sl * sliceAngle;
+			positions.push_back(
+			    Vec3F{std::sin(theta) * std::cos(omega), std::sin(theta) * std::sin(omega), std::cos(theta)});
+		}
+	}
+	for (auto st = 0u; st < stacks - 1; ++st)
+	{
+		for (auto sl = 0u; sl < slices; ++sl)
+		{
+			indices.push_back(sl + st * slices);
+			indices.push_back(sl + (st + 1) * slices);
+			indices.push_back((sl + 1) % slices + (st + 1) * slices);
+			indices.push_back((sl + 1) % slices + st * slices);
+			faceSizes.push_back(4);
+		}
+	}
+}
+
+void BM_FaceBuilderSphere(benchmark::State &state)
+{
+	std::vector<Vec3F> positions;
+	std::vector<Geometry::Index_t> indices;
+	std::vector<uint32_t> faceSizes;
+	CreateSphereArrays(state.range(0), state.range(0), positions, indices, faceSizes);
+
+	for (auto _ : state)
+	{
+		auto geometry = std::make_shared<Geometry>();
+		GeometryBuilderT<Geometry> builder(geometry);
+		std::vector<Geometry::Index_t> points;
+		points.reserve(positions.size());
+		for (const auto &p : positions)
+		{
+			points.push_back(builder.AddPoint(p));
+		}
+		std::size_t faceStart = 0;
+		for (const auto &size : faceSizes)
+		{
+			auto face = builder.StartFace(size);
+			for (auto i = 0u; i < size; ++i)
+			{
+				face.AddIndex(points[indices[faceStart + i]]);
+			}
+			face.CloseFace();
+			faceStart += size;
+		}
+		benchmark::DoNotOptimize(geometry->GetFaceCount());
+	}
+	state.SetItemsProcessed(state.iterations() * faceSizes.size());
+}
+
+void BM_BulkBuilderSphere(benchmark::State &state)
+{
+	std::vector<Vec3F> positions;
+	std::vector<Geometry::Index_t> indices;
+	std::vector<uint32_t> faceSizes;
+	CreateSphereArrays(state.range(0), state.range(0), positions, indices, faceSizes);
+
+	for (auto _ : state)
+	{
+		auto geometry = std::make_shared<Geometry>();
+		BulkGeometryBuilderT<Geometry> builder(geometry);
+		builder.Build(positions, indices, faceSizes);
+		benchmark::DoNotOptimize(geometry->GetFaceCount());
+	}
+	state.SetItemsProcessed(state.iterations() * faceSizes.size());
+}
+
+void BM_CreateSphere(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		auto geometry = std::make_shared<Geometry>();
+		CreateSphere<Geometry> sphere(1.0f, state.range(0), state.range(0));
+		sphere.Execute(geometry);
+		benchmark::DoNotOptimize(geometry->GetFaceCount());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * (state.range(0) + 1));
+}
+}  // namespace
+
+BENCHMARK(BM_FaceBuilderSphere)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BulkBuilderSphere)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CreateSphere)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,77 @@
+#include <geometry_core/geometry_builder.h>
+#include <geometry_operations/ear_clipping.h>
+#include <math_lib/math_utils.h>
+#include <procedural_objects/geometry_system.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+using namespace pagoda;
+
+namespace
+{
+GeometryPtr CreatePolygon(const std::vector<Vec3F> &points)
+{
+	auto geometry = std::make_shared<Geometry>();
+	GeometryBuilderT<Geometry> builder(geometry);
+	auto face = builder.StartFace(points.size());
+	for (const auto &p : points)
+	{
+		face.AddIndex(builder.AddPoint(p));
+	}
+	face.CloseFace();
+	geometry->GetFaceAttributes(*geometry->FacesBegin()).m_normal = Vec3F{0, 0, 1};
+	return geometry;
+}
+
+/*
+ * A star with state.range(0) points, half of them reflex.
+ */
+GeometryPtr CreateStar(uint32_t pointCount)
+{
+	std::vector<Vec3F> points;
+	for (auto i = 0u; i < pointCount; ++i)
+	{
+		const float angle = i * MathUtils<float>::two_pi / pointCount;
+		const float radius = i % 2 == 0 ? 10.0f : 5.0f;
+		points.push_back(radius * Vec3F{std::cos(angle), std::sin(angle), 0});
+	}
+	return CreatePolygon(points);
+}
+
+/*
+ * A comb with state.range(0) points, like the outline of a facade with its windows cut out from the bottom.
+ */
+GeometryPtr CreateComb(uint32_t pointCount)
+{
+	const auto teeth = (pointCount - 2) / 4;
+	std::vector<Vec3F> points{Vec3F{0, 0, 0}, Vec3F{static_cast<float>(teeth), 0, 0}};
+	for (auto t = teeth; t > 0; --t)
+	{
+		points.push_back(Vec3F{static_cast<float>(t), 10, 0});
+		points.push_back(Vec3F{t - 0.5f, 10, 0});
+		points.push_back(Vec3F{t - 0.5f, 1, 0});
+		points.push_back(Vec3F{t - 1.0f, 1, 0});
+	}
+	return CreatePolygon(points);
+}
+
+void TriangulatePolygon(benchmark::State &state, GeometryPtr polygon)
+{
+	for (auto _ : state)
+	{
+		auto out = std::make_shared<Geometry>();
+		EarClipping<Geometry>().Execute(polygon, out);
+		benchmark::DoNotOptimize(out->GetFaceCount());
+	}
+	state.SetItemsProcessed(state.iterations() * polygon->GetPointCount());
+}
+
+void BM_EarClippingStar(benchmark::State &state) { TriangulatePolygon(state, CreateStar(state.range(0))); }
+
+void BM_EarClippingComb(benchmark::State &state) { TriangulatePolygon(state, CreateComb(state.range(0))); }
+}  // namespace
+
+BENCHMARK(BM_EarClippingStar)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EarClippingComb)->Arg(102)->Arg(1002)->Arg(10002)->Unit(benchmark::kMillisecond);
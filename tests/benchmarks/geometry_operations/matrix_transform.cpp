@@ -0,0 +1,52 @@
+#include <geometry_operations/create_sphere.h>
+#include <geometry_operations/matrix_transform.h>
+#include <procedural_objects/geometry_system.h>
+
+#include <benchmark/benchmark.h>
+
+#include <boost/qvm/map_vec_mat.hpp>
+#include <boost/qvm/mat_operations.hpp>
+
+using namespace pagoda;
+
+namespace
+{
+/*
+ * Rotates and translates a sphere of state.range(0) x state.range(0) faces into a new geometry,
+ * as Translate, Scale and Rotate do.
+ */
+void BM_MatrixTransformSphere(benchmark::State &state)
+{
+	auto sphere = std::make_shared<Geometry>();
+	CreateSphere<Geometry>(1.0f, state.range(0), state.range(0) - 1).Execute(sphere);
+	const Mat4x4F matrix = boost::qvm::translation_mat(Vec3F{1, 2, 3}) * boost::qvm::rotz_mat<4>(0.3f);
+
+	for (auto _ : state)
+	{
+		auto out = std::make_shared<Geometry>();
+		MatrixTransform<Geometry>(matrix).Execute(sphere, out);
+		benchmark::DoNotOptimize(out->GetPointCount());
+	}
+	state.SetItemsProcessed(state.iterations() * sphere->GetPointCount());
+}
+
+/*
+ * Rotates and translates a sphere of state.range(0) x state.range(0) faces in place.
+ */
+void BM_MatrixTransformSphereInPlace(benchmark::State &state)
+{
+	auto sphere = std::make_shared<Geometry>();
+	CreateSphere<Geometry>(1.0f, state.range(0), state.range(0) - 1).Execute(sphere);
+	const Mat4x4F matrix = boost::qvm::translation_mat(Vec3F{1, 2, 3}) * boost::qvm::rotz_mat<4>(0.3f);
+
+	for (auto _ : state)
+	{
+		MatrixTransform<Geometry>(matrix).Execute(sphere);
+		benchmark::DoNotOptimize(sphere->GetPosition(0));
+	}
+	state.SetItemsProcessed(state.iterations() * sphere->GetPointCount());
+}
+}  // namespace
+
+BENCHMARK(BM_MatrixTransformSphere)->Arg(64)->Arg(316)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MatrixTransformSphereInPlace)->Arg(64)->Arg(316)->Unit(benchmark::kMillisecond);
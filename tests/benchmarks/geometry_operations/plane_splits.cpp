@@ -0,0 +1,68 @@
+#include <geometry_core/geometry_builder.h>
+#include <geometry_operations/plane_splits.h>
+#include <procedural_objects/geometry_system.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace pagoda;
+
+namespace
+{
+/*
+ * Creates a facade of state.range(0) x state.range(0) unit quads on the xy plane.
+ */
+GeometryPtr CreateFacade(uint32_t size)
+{
+	std::vector<Vec3F> positions;
+	for (auto y = 0u; y <= size; ++y)
+	{
+		for (auto x = 0u; x <= size; ++x)
+		{
+			positions.push_back(Vec3F{static_cast<float>(x), static_cast<float>(y), 0});
+		}
+	}
+	std::vector<Geometry::Index_t> indices;
+	std::vector<uint32_t> faceSizes;
+	for (auto y = 0u; y < size; ++y)
+	{
+		for (auto x = 0u; x < size; ++x)
+		{
+			const auto corner = y * (size + 1) + x;
+			indices.insert(indices.end(), {corner, corner + 1, corner + size + 2, corner + size + 1});
+			faceSizes.push_back(4);
+		}
+	}
+
+	auto facade = std::make_shared<Geometry>();
+	BulkGeometryBuilderT<Geometry>(facade).Build(positions, indices, faceSizes);
+	return facade;
+}
+
+/*
+ * Splits a facade of state.range(0) x state.range(0) faces into 50 slabs along x, as RepeatSplit does.
+ */
+void BM_RepeatSplitFacade(benchmark::State &state)
+{
+	const auto size = static_cast<uint32_t>(state.range(0));
+	auto facade = CreateFacade(size);
+
+	const uint32_t slabs = 50;
+	const Vec3F normal{-1, 0, 0};
+	std::vector<Plane<float>> planes;
+	for (auto i = 1u; i < slabs; ++i)
+	{
+		planes.push_back(Plane<float>::FromPointAndNormal(Vec3F{0.37f + i * size / float(slabs), 0, 0}, normal));
+	}
+
+	for (auto _ : state)
+	{
+		std::vector<GeometryPtr> slices;
+		PlaneSplits<Geometry>(planes).Execute(facade, slices);
+		benchmark::DoNotOptimize(slices.size());
+	}
+	state.SetItemsProcessed(state.iterations() * facade->GetFaceCount());
+	state.counters["faces"] = facade->GetFaceCount();
+}
+}  // namespace
+
+BENCHMARK(BM_RepeatSplitFacade)->Arg(50)->Arg(200)->Unit(benchmark::kMillisecond);
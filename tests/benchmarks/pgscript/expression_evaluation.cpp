@@ -0,0 +1,102 @@
+#include <dynamic_value/binding/tagged_ops.h>
+#include <dynamic_value/float_value.h>
+#include <dynamic_value/integer_value.h>
+#include <pgscript/interpreter/interpreter.h>
+#include <pgscript/parser/parser.h>
+
+#include <benchmark/benchmark.h>
+
+#include "../allocation_counter.h"
+
+using namespace pagoda;
+
+namespace
+{
+const char *s_script = R"(
+var sum = 0;
+var i = 0;
+while (i < 10) {
+    if (i > 2 and i != 5) {
+        sum = sum + i * 2.5;
+    } else {
+        sum = sum - 1;
+    }
+    i = i + 1;
+}
+sum;
+)";
+
+// Number of arithmetic and comparison operations in s_script
+const std::size_t s_operationsPerRun = 54;
+
+void SetAllocationCounters(benchmark::State &state, std::size_t allocations, std::size_t operationsPerIteration)
+{
+	const auto iterations = static_cast<double>(state.iterations());
+	state.counters["allocs_per_iteration"] = static_cast<double>(allocations) / iterations;
+	state.counters["allocs_per_operation"] = static_cast<double>(allocations) / (iterations * operationsPerIteration);
+}
+
+/*
+ * index * 2 + offset > 10 evaluated with boxed values, as each operation was done before TaggedValue.
+ */
+void BM_EvaluateBoxedExpression(benchmark::State &state)
+{
+	DynamicValueBasePtr index = std::make_shared<Integer>(3);
+	DynamicValueBasePtr offset = std::make_shared<FloatValue>(0.5f);
+	DynamicValueBasePtr two = std::make_shared<Integer>(2);
+	DynamicValueBasePtr ten = std::make_shared<Integer>(10);
+
+	const auto startCount = GetAllocationCount();
+	for (auto _ : state)
+	{
+		binary_op_dispatcher<mul> mulOp(index, two);
+		auto product = apply_visitor(mulOp, *index);
+		binary_op_dispatcher<add> addOp(product, offset);
+		auto sum = apply_visitor(addOp, *product);
+		binary_op_dispatcher<gt> gtOp(sum, ten);
+		benchmark::DoNotOptimize(apply_visitor(gtOp, *sum));
+	}
+	SetAllocationCounters(state, GetAllocationCount() - startCount, 3);
+}
+
+/*
+ * index * 2 + offset > 10 evaluated with TaggedValue.
+ */
+void BM_EvaluateTaggedExpression(benchmark::State &state)
+{
+	auto index = TaggedValue::FromInteger(3);
+	auto offset = TaggedValue::FromFloat(0.5f);
+	auto two = TaggedValue::FromInteger(2);
+	auto ten = TaggedValue::FromInteger(10);
+
+	const auto startCount = GetAllocationCount();
+	for (auto _ : state)
+	{
+		auto result = apply_binary_op<gt>(apply_binary_op<add>(apply_binary_op<mul>(index, two), offset), ten);
+		benchmark::DoNotOptimize(result.m_boolean);
+	}
+	SetAllocationCounters(state, GetAllocationCount() - startCount, 3);
+}
+
+void BM_InterpretScript(benchmark::State &state, Interpreter::Engine engine)
+{
+	auto program = Parser().Parse(s_script);
+	Interpreter interpreter;
+	interpreter.SetEngine(engine);
+	// Compiles the program before measuring
+	interpreter.Interpret(program);
+
+	const auto startCount = GetAllocationCount();
+	for (auto _ : state)
+	{
+		interpreter.Interpret(program);
+		benchmark::DoNotOptimize(interpreter.GetLastEvaluatedExpression());
+	}
+	SetAllocationCounters(state, GetAllocationCount() - startCount, s_operationsPerRun);
+}
+}  // namespace
+
+BENCHMARK(BM_EvaluateBoxedExpression);
+BENCHMARK(BM_EvaluateTaggedExpression);
+BENCHMARK_CAPTURE(BM_InterpretScript, ast, Interpreter::Engine::Ast);
+BENCHMARK_CAPTURE(BM_InterpretScript, bytecode, Interpreter::Engine::Bytecode);
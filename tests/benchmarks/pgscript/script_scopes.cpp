@@ -0,0 +1,54 @@
+#include <pgscript/interpreter/interpreter.h>
+#include <pgscript/parser/parser.h>
+
+#include <benchmark/benchmark.h>
+
+#include "../allocation_counter.h"
+
+using namespace pagoda;
+
+namespace
+{
+/*
+ * Nested loops whose blocks declare variables, and if blocks that declare nothing.
+ */
+const char *s_script = R"(
+var total = 0;
+var i = 0;
+while (i < 20) {
+    var j = 0;
+    while (j < 20) {
+        var product = i * j;
+        if (product > 100) {
+            total = total + product;
+        } else {
+            total = total - 1;
+        }
+        j = j + 1;
+    }
+    i = i + 1;
+}
+total;
+)";
+
+const std::size_t s_innerIterations = 20 * 20;
+
+void BM_InterpretNestedScopes(benchmark::State &state)
+{
+	auto program = Parser().Parse(s_script);
+	Interpreter interpreter;
+	interpreter.Interpret(program);
+
+	const auto startCount = GetAllocationCount();
+	for (auto _ : state)
+	{
+		interpreter.Interpret(program);
+		benchmark::DoNotOptimize(interpreter.GetLastEvaluatedExpression());
+	}
+	const auto iterations = static_cast<double>(state.iterations());
+	state.counters["allocs_per_run"] = static_cast<double>(GetAllocationCount() - startCount) / iterations;
+	state.SetItemsProcessed(state.iterations() * s_innerIterations);
+}
+}  // namespace
+
+BENCHMARK(BM_InterpretNestedScopes)->Unit(benchmark::kMicrosecond);
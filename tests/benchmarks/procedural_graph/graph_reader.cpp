@@ -0,0 +1,63 @@
+#include <pagoda.h>
+#include <procedural_graph/graph.h>
+#include <procedural_graph/reader.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace pagoda;
+
+namespace
+{
+/*
+ * A chain of operationCount extrusions, each with an expression argument.
+ */
+std::string CreateGraphSource(int64_t operationCount)
+{
+	std::string source = "parameter = Parameter() { amount: 2.5, count: 3 }\n"
+	                     "create_rect = Operation(operation: \"CreateRectGeometry\") { width: 10, height: 5 }\n";
+	std::string links = "create_rect -> out_0";
+	for (int64_t i = 0; i < operationCount; ++i)
+	{
+		const auto index = std::to_string(i);
+		source += "out_" + index + " = OutputInterface(interface: \"out\")\n";
+		source += "in_" + index + " = InputInterface(interface: \"in\")\n";
+		source += "extrude_" + index +
+		          " = Operation(operation: \"ExtrudeGeometry\") { extrusion_amount: $< amount * count + " + index +
+		          " / 10.0; >$ }\n";
+		source += "parameter -> extrude_" + index + ";\n";
+		if (i > 0)
+		{
+			links += " -> out_" + index;
+		}
+		links += " -> in_" + index + " -> extrude_" + index;
+	}
+	return source + links + ";\n";
+}
+
+void BM_ReadGraph(benchmark::State &state)
+{
+	Pagoda pagoda;
+	GraphReader reader(pagoda.GetNodeFactory());
+	const auto source = CreateGraphSource(state.range(0));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(reader.Read(source)->GetNodeCount());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ReadCompiledGraph(benchmark::State &state)
+{
+	Pagoda pagoda;
+	GraphReader reader(pagoda.GetNodeFactory());
+	const auto compiled = reader.Compile(CreateGraphSource(state.range(0)));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(reader.ReadCompiled(compiled.data(), compiled.size())->GetNodeCount());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_ReadGraph)->Arg(10)->Arg(100);
+BENCHMARK(BM_ReadCompiledGraph)->Arg(10)->Arg(100);
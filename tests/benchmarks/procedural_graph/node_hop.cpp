@@ -0,0 +1,165 @@
+#include <pagoda.h>
+#include <procedural_graph/graph.h>
+#include <procedural_graph/input_interface_node.h>
+#include <procedural_graph/operation_node.h>
+#include <procedural_graph/output_interface_node.h>
+#include <procedural_graph/reader.h>
+#include <procedural_objects/procedural_object_system.h>
+#include <procedural_objects/procedural_operation.h>
+
+#include <benchmark/benchmark.h>
+
+#include "../allocation_counter.h"
+
+using namespace pagoda;
+
+namespace
+{
+/*
+ * The banner regression graph without its ExportGeometry node, so that no files are written.
+ */
+const char *s_bannerGraph = R"(
+facade = Operation(operation: "CreateRectGeometry") { width: 30, height: 20 }
+facade_out = OutputInterface(interface: "out")
+facade -> facade_out;
+
+facade_extrusion_in = InputInterface(interface: "in")
+facade_extrusion = Operation(operation: "ExtrudeGeometry") { extrusion_amount: -5 }
+facade_extrusion_out = OutputInterface(interface: "out")
+facade_extrusion_in -> facade_extrusion -> facade_extrusion_out;
+facade_out -> facade_extrusion_in;
+
+first_floor_in = InputInterface(interface: "in")
+first_floor = Operation(operation: "Split") { axis: "y", split_count: 3, split_1: 3, split_2: 15, split_3: 2 }
+first_floor_1 = OutputInterface(interface: "split_1")
+first_floor_2 = OutputInterface(interface: "split_2")
+first_floor_3 = OutputInterface(interface: "split_3")
+first_floor_in -> first_floor;
+first_floor -> first_floor_1;
+first_floor -> first_floor_2;
+first_floor -> first_floor_3;
+
+first_floor_split_in = InputInterface(interface: "in")
+first_floor_split = Operation(operation: "Split") { axis: "x", split_count: 3, split_1: 13, split_2: 4, split_3: 13 }
+first_floor_split_1 = OutputInterface(interface: "split_1")
+first_floor_split_2 = OutputInterface(interface: "split_2")
+first_floor_split_3 = OutputInterface(interface: "split_3")
+first_floor_split_in -> first_floor_split;
+first_floor_split -> first_floor_split_1;
+first_floor_split -> first_floor_split_2;
+first_floor_split -> first_floor_split_3;
+
+door_in = InputInterface(interface: "in")
+door = Operation(operation: "ExtrudeGeometry") { extrusion_amount: 0.5 }
+door_out = OutputInterface(interface: "out")
+door_in -> door -> door_out;
+
+middle_floors_in = InputInterface(interface: "in")
+middle_floors = Operation(operation: "RepeatSplit") { size: 2, axis: "y", adjust: "true" }
+middle_floors_out = OutputInterface(interface: "out")
+middle_floors_in -> middle_floors -> middle_floors_out;
+
+middle_floors_tiles_in = InputInterface(interface: "in")
+middle_floors_tiles = Operation(operation: "RepeatSplit") { size: 2, axis: "x", adjust: "true" }
+middle_floors_tiles_out = OutputInterface(interface: "out")
+middle_floors_tiles_in -> middle_floors_tiles -> middle_floors_tiles_out;
+
+top_floor_extrude_in = InputInterface(interface: "in")
+top_floor_extrude = Operation(operation: "ExtrudeGeometry") { extrusion_amount: 0.5 }
+top_floor_extrude_out = OutputInterface(interface: "out")
+top_floor_extrude_in -> top_floor_extrude -> top_floor_extrude_out;
+
+facade_out -> first_floor_in;
+first_floor_1 -> first_floor_split_in;
+first_floor_2 -> middle_floors_in;
+middle_floors_out -> middle_floors_tiles_in;
+first_floor_3 -> top_floor_extrude_in;
+first_floor_split_2 -> door_in;
+)";
+
+/*
+ * Consumes every object in its input interface.
+ */
+class SinkOperation : public ProceduralOperation
+{
+public:
+	SinkOperation(ProceduralObjectSystemPtr objectSystem) : ProceduralOperation(objectSystem)
+	{
+		CreateInputInterface("in");
+	}
+
+	void DoWork() override
+	{
+		while (HasInput("in"))
+		{
+			benchmark::DoNotOptimize(GetInputProceduralObject("in"));
+		}
+	}
+};
+
+void SetAllocationCounters(benchmark::State &state, std::size_t allocations)
+{
+	state.counters["allocs_per_iteration"] = static_cast<double>(allocations) / state.iterations();
+}
+
+/*
+ * Sends state.range(0) objects from an OutputInterfaceNode through an InputInterfaceNode to the
+ * operation of an OperationNode, which consumes them.
+ */
+void BM_NodeHop(benchmark::State &state)
+{
+	Pagoda pagoda;
+	auto objectSystem = pagoda.GetProceduralObjectSystem();
+	ProceduralObjectBatch objects;
+	for (auto i = 0; i < state.range(0); ++i)
+	{
+		objects.push_back(objectSystem->CreateProceduralObject());
+	}
+	auto batch = std::make_shared<const ProceduralObjectBatch>(std::move(objects));
+
+	auto out = std::make_shared<OutputInterfaceNode>();
+	auto in = std::make_shared<InputInterfaceNode>();
+	in->SetInterfaceName("in");
+	auto operationNode = std::make_shared<OperationNode>(pagoda.GetOperationFactory());
+	operationNode->SetOperation(std::make_shared<SinkOperation>(objectSystem));
+	const NodeSet<Node> inNodes{in};
+	const NodeSet<Node> operationNodes{operationNode};
+
+	const auto startCount = GetAllocationCount();
+	for (auto _ : state)
+	{
+		out->AddProceduralObjects(batch);
+		out->Execute({}, inNodes);
+		in->Execute({}, operationNodes);
+		operationNode->GetOperation()->Execute();
+		out->ClearResults();
+		in->ClearResults();
+	}
+	SetAllocationCounters(state, GetAllocationCount() - startCount);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/*
+ * Executes the banner graph again from its first node, as done after changing its parameters.
+ */
+void BM_ExecuteBannerGraph(benchmark::State &state)
+{
+	Pagoda pagoda;
+	auto graph = GraphReader(pagoda.GetNodeFactory()).Read(s_bannerGraph);
+	graph->Execute();
+
+	const auto startCount = GetAllocationCount();
+	for (auto _ : state)
+	{
+		for (const auto &n : graph->GetGraphInputNodes())
+		{
+			graph->SetNodeDirty(n);
+		}
+		graph->ExecuteIncremental();
+	}
+	SetAllocationCounters(state, GetAllocationCount() - startCount);
+}
+}  // namespace
+
+BENCHMARK(BM_NodeHop)->Arg(16)->Arg(1024);
+BENCHMARK(BM_ExecuteBannerGraph);
@@ -0,0 +1,45 @@
+#include <procedural_objects/geometry_component.h>
+#include <procedural_objects/geometry_system.h>
+#include <procedural_objects/procedural_object.h>
+#include <procedural_objects/procedural_object_system.h>
+
+#include <pagoda.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace pagoda;
+
+namespace
+{
+/*
+ * Looks up the GeometryComponent of state.range(0) objects, as every operation does for its inputs.
+ */
+void BM_GetGeometryComponent(benchmark::State &state)
+{
+	Pagoda pagoda;
+	auto objectSystem = pagoda.GetProceduralObjectSystem();
+	auto geometrySystem = objectSystem->GetComponentSystem<GeometrySystem>();
+	std::vector<ProceduralObjectPtr> objects;
+	for (auto i = 0; i < state.range(0); ++i)
+	{
+		objects.push_back(objectSystem->CreateProceduralObject());
+		geometrySystem->CreateComponent(objects.back());
+	}
+
+	for (auto _ : state)
+	{
+		for (const auto &o : objects)
+		{
+			benchmark::DoNotOptimize(geometrySystem->GetComponentAs<GeometryComponent>(o));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+
+	for (auto &o : objects)
+	{
+		objectSystem->KillProceduralObject(o);
+	}
+}
+}  // namespace
+
+BENCHMARK(BM_GetGeometryComponent)->Arg(1024)->Arg(65536);
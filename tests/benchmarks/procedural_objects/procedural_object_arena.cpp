@@ -0,0 +1,88 @@
+#include <dynamic_value/integer_value.h>
+#include <procedural_objects/geometry_component.h>
+#include <procedural_objects/geometry_system.h>
+#include <procedural_objects/procedural_object.h>
+#include <procedural_objects/procedural_object_arena.h>
+#include <procedural_objects/procedural_object_system.h>
+
+#include <pagoda.h>
+
+#include <benchmark/benchmark.h>
+
+#include "../allocation_counter.h"
+
+using namespace pagoda;
+
+namespace
+{
+const int64_t s_objectCount = 1024;
+
+/*
+ * Creates s_objectCount objects with a geometry component and a member, as a facade tile would
+ * have, and kills them. With an arena, the memory of the killed objects is reused in the next
+ * iteration, as in the repeated executions of a graph.
+ */
+void BM_CreateProceduralObjects(benchmark::State &state, bool useArena)
+{
+	Pagoda pagoda;
+	auto objectSystem = pagoda.GetProceduralObjectSystem();
+	auto geometrySystem = objectSystem->GetComponentSystem<GeometrySystem>();
+	auto count = std::make_shared<Integer>(1);
+	std::vector<ProceduralObjectPtr> objects;
+	objects.reserve(s_objectCount);
+
+	auto arena = useArena ? ProceduralObjectArena::Create() : nullptr;
+	const auto startCount = GetAllocationCount();
+	for (auto _ : state)
+	{
+		for (auto i = 0; i < s_objectCount; ++i)
+		{
+			auto object = objectSystem->CreateProceduralObject(arena.get());
+			geometrySystem->CreateComponent(object);
+			object->RegisterMember("count", count);
+			objects.push_back(object);
+		}
+		for (auto &o : objects)
+		{
+			objectSystem->KillProceduralObject(o);
+		}
+		objects.clear();
+	}
+	state.counters["allocs_per_object"] =
+	    static_cast<double>(GetAllocationCount() - startCount) / (state.iterations() * s_objectCount);
+	state.SetItemsProcessed(state.iterations() * s_objectCount);
+}
+
+ProceduralObjectArenaPtr s_sharedArena;
+
+/*
+ * Creates and destroys s_objectCount values in an arena shared by all the benchmark threads, as the workers
+ * of a parallel execution do.
+ */
+void BM_CreateValuesInSharedArena(benchmark::State &state)
+{
+	if (state.thread_index() == 0)
+	{
+		s_sharedArena = ProceduralObjectArena::Create();
+	}
+	std::vector<std::shared_ptr<int64_t>> values;
+	values.reserve(s_objectCount);
+	for (auto _ : state)
+	{
+		for (auto i = 0; i < s_objectCount; ++i)
+		{
+			values.push_back(s_sharedArena->MakeShared<int64_t>(i));
+		}
+		values.clear();
+	}
+	state.SetItemsProcessed(state.iterations() * s_objectCount);
+	if (state.thread_index() == 0)
+	{
+		s_sharedArena = nullptr;
+	}
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_CreateProceduralObjects, individual, false);
+BENCHMARK_CAPTURE(BM_CreateProceduralObjects, arena, true);
+BENCHMARK(BM_CreateValuesInSharedArena)->Threads(1)->Threads(4);
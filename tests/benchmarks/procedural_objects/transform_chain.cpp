@@ -0,0 +1,68 @@
+#include <pagoda.h>
+#include <procedural_graph/graph.h>
+#include <procedural_graph/reader.h>
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+using namespace pagoda;
+
+namespace
+{
+/*
+ * Returns a graph that creates a sphere with the given number of slices and stacks and sends it through
+ * \p stages chains of Translate, Rotate and Scale nodes.
+ */
+std::string TransformChainGraph(int64_t slices, int64_t stages)
+{
+	std::stringstream graph;
+	graph << "sphere = Operation(operation: \"CreateSphereGeometry\") { radius: 1, slices: " << slices
+	      << ", stacks: " << slices << " }\n";
+	graph << "sphere_out = OutputInterface(interface: \"out\")\n";
+	graph << "sphere -> sphere_out;\n";
+
+	std::string previous = "sphere_out";
+	auto addNode = [&](const std::string &name, const std::string &operation, const std::string &parameters) {
+		graph << name << "_in = InputInterface(interface: \"in\")\n";
+		graph << name << " = Operation(operation: \"" << operation << "\") { " << parameters << " }\n";
+		graph << name << "_out = OutputInterface(interface: \"out\")\n";
+		graph << name << "_in -> " << name << " -> " << name << "_out;\n";
+		graph << previous << " -> " << name << "_in;\n";
+		previous = name + "_out";
+	};
+	for (auto i = 0; i < stages; ++i)
+	{
+		const auto stage = std::to_string(i);
+		addNode("translate" + stage, "Translate", "x: 1, y: 2, z: 3, world: \"false\"");
+		addNode("rotate" + stage, "Rotate", "x: 10, y: 20, z: 30, rotation_order: \"xyz\", world: \"false\"");
+		addNode("scale" + stage, "Scale", "x: 1.1, y: 1.1, z: 1.1");
+	}
+	return graph.str();
+}
+
+/*
+ * Executes again the transforms of a sphere with state.range(0) slices and stacks through state.range(1)
+ * Translate, Rotate and Scale stages.
+ */
+void BM_TransformChain(benchmark::State &state)
+{
+	Pagoda pagoda;
+	auto graph = GraphReader(pagoda.GetNodeFactory()).Read(TransformChainGraph(state.range(0), state.range(1)));
+	graph->Execute();
+
+	for (auto _ : state)
+	{
+		for (const auto &n : graph->GetGraphInputNodes())
+		{
+			for (const auto &out : graph->GetNodeOutputNodes(n))
+			{
+				graph->SetNodeDirty(out);
+			}
+		}
+		graph->ExecuteIncremental();
+	}
+}
+}  // namespace
+
+BENCHMARK(BM_TransformChain)->Args({64, 4})->Args({256, 4})->Unit(benchmark::kMillisecond);
@@ -33,8 +33,9 @@ public:
 
 	static void SetWriteOutput(bool write) { s_write = write; }
 
-	RegressionTest(const std::string& name) : m_regressionTestName(name)
+	RegressionTest(const std::string& name, Interpreter::Engine engine) : m_regressionTestName(name), m_engine(engine)
 	{
+		m_interpreter.SetEngine(engine);
 		m_testDir = GetTestFilesDirectory() / "test_files" / name;
 		std::string code = file_util::LoadFileToString(GetScriptFile().string());
 		m_program = Parser().Parse(code);
@@ -45,8 +46,8 @@ public:
 	{
 		std::stringstream myStdout;
 		std::stringstream myStderr;
-		Interpreter::SetStdOutStream(&myStdout);
-		Interpreter::SetStdErrStream(&myStderr);
+		m_interpreter.SetStdOutStream(&myStdout);
+		m_interpreter.SetStdErrStream(&myStderr);
 
 		m_interpreter.Interpret(m_program);
 		auto last = std::dynamic_pointer_cast<T>(m_interpreter.GetLastEvaluatedExpression());
@@ -56,7 +57,8 @@ public:
 		std::stringstream ss;
 		AstPrinter printer(ss);
 		m_program->AcceptVisitor(&printer);
-		if (s_write)
+		// Only the interpreter writes the expected output, which the other engines must match
+		if (s_write && m_engine == Interpreter::Engine::Ast)
 		{
 			file_util::WriteStringToFile(GetASTFile().string(), ss.str());
 			file_util::WriteStringToFile(GetStdOutFile().string(), myStdout.str());
@@ -83,6 +85,7 @@ private:
 	static boost::filesystem::path s_testFilesDirectory;
 	static bool s_write;
 	std::string m_regressionTestName;
+	Interpreter::Engine m_engine;
 	boost::filesystem::path m_testDir;
 
 	ast::ProgramPtr m_program;
@@ -91,25 +94,31 @@ private:
 boost::filesystem::path RegressionTest::s_testFilesDirectory = "";
 bool RegressionTest::s_write = false;
 
-#define REGRESSION_TEST(NAME, EXPECTED)                        \
-	TEST(RegressionTestCase, NAME)                             \
-	{                                                          \
-		try                                                    \
-		{                                                      \
-			RegressionTest r(#NAME);                           \
-			r.Match(EXPECTED);                                 \
-		}                                                      \
-		catch (Exception & e)                                  \
-		{                                                      \
-			LOG_ERROR("Exception caught while running test:"); \
-			LOG_ERROR(e.What());                               \
-			throw;                                             \
-		}                                                      \
+#define ENGINE_REGRESSION_TEST(TEST_CASE, NAME, ENGINE, EXPECTED) \
+	TEST(TEST_CASE, NAME)                                          \
+	{                                                              \
+		try                                                        \
+		{                                                          \
+			RegressionTest r(#NAME, ENGINE);                       \
+			r.Match(EXPECTED);                                     \
+		}                                                          \
+		catch (Exception & e)                                      \
+		{                                                          \
+			LOG_ERROR("Exception caught while running test:");     \
+			LOG_ERROR(e.What());                                   \
+			throw;                                                 \
+		}                                                          \
 	}
 
+// Every script runs both in the tree-walking interpreter and in the bytecode virtual machine
+#define REGRESSION_TEST(NAME, EXPECTED)                                                        \
+	ENGINE_REGRESSION_TEST(RegressionTestCase, NAME, Interpreter::Engine::Ast, EXPECTED)       \
+	ENGINE_REGRESSION_TEST(BytecodeRegressionTestCase, NAME, Interpreter::Engine::Bytecode, EXPECTED)
+
 REGRESSION_TEST(float_operations, std::make_shared<FloatValue>(2.5f))
 REGRESSION_TEST(integer_operations, std::make_shared<Integer>(2))
 REGRESSION_TEST(string_operations, std::make_shared<String>("abc123123"))
+REGRESSION_TEST(control_flow, std::make_shared<Integer>(33))
 
 REGRESSION_TEST(vector, std::make_shared<Vector3>(Vec3F{1, 2, 3}))
 REGRESSION_TEST(plane, std::make_shared<DynamicPlane>(Plane<float>::FromPointAndNormal({0, 0, 0}, {1, 0, 0})))
@@ -0,0 +1,83 @@
+#include <common/async_file_writer.h>
+#include <common/exception.h>
+#include <common/file_util.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+using namespace pagoda;
+
+class AsyncFileWriterTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		m_directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+	}
+
+	void TearDown() override { boost::filesystem::remove_all(m_directory); }
+
+	boost::filesystem::path m_directory;
+};
+
+TEST_F(AsyncFileWriterTest, when_flushing_should_have_written_all_files)
+{
+	AsyncFileWriter writer(3, 4);
+	for (auto i = 0u; i < 20; ++i)
+	{
+		writer.Write((m_directory / "sub" / (std::to_string(i) + ".txt")).string(), std::string(i * 100, 'a' + i));
+	}
+	writer.Flush();
+
+	EXPECT_EQ(writer.GetWrittenFileCount(), 20);
+	for (auto i = 0u; i < 20; ++i)
+	{
+		EXPECT_EQ(file_util::LoadFileToString(m_directory / "sub" / (std::to_string(i) + ".txt")),
+		          std::string(i * 100, 'a' + i));
+	}
+}
+
+TEST_F(AsyncFileWriterTest, when_rewriting_a_file_should_keep_the_last_contents)
+{
+	AsyncFileWriter writer(1, 1);
+	auto path = (m_directory / "file.txt").string();
+	writer.Write(path, "first");
+	writer.Flush();
+	writer.Write(path, "second");
+	writer.Flush();
+
+	EXPECT_EQ(file_util::LoadFileToString(path), "second");
+}
+
+TEST_F(AsyncFileWriterTest, when_a_write_fails_should_throw_on_flush)
+{
+	AsyncFileWriter writer;
+	boost::filesystem::create_directories(m_directory);
+	file_util::WriteStringToFile((m_directory / "file.txt").string(), "");
+
+	writer.Write((m_directory / "file.txt" / "nested.txt").string(), "contents");
+	EXPECT_THROW(writer.Flush(), Exception);
+
+	// The error is reported only once
+	EXPECT_NO_THROW(writer.Flush());
+}
+
+TEST_F(AsyncFileWriterTest, when_a_write_in_a_group_fails_should_only_throw_when_flushing_that_group)
+{
+	AsyncFileWriter writer;
+	boost::filesystem::create_directories(m_directory);
+	file_util::WriteStringToFile((m_directory / "file.txt").string(), "");
+	auto failingGroup = std::make_shared<FileWriteGroup>();
+	auto group = std::make_shared<FileWriteGroup>();
+
+	writer.Write((m_directory / "file.txt" / "nested.txt").string(), "contents", failingGroup);
+	writer.Write((m_directory / "other.txt").string(), "contents", group);
+	EXPECT_NO_THROW(group->Flush());
+	EXPECT_NO_THROW(writer.Flush());
+	EXPECT_THROW(failingGroup->Flush(), Exception);
+
+	// The error is reported only once
+	EXPECT_NO_THROW(failingGroup->Flush());
+	EXPECT_EQ(file_util::LoadFileToString(m_directory / "other.txt"), "contents");
+}
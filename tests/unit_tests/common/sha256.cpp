@@ -0,0 +1,43 @@
+#include <common/sha256.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace pagoda;
+
+namespace
+{
+std::string Digest(const std::string &data)
+{
+	Sha256 sha;
+	sha.Update(data.data(), data.size());
+	return Sha256::ToHex(sha.Finish());
+}
+}  // namespace
+
+TEST(Sha256Test, when_digesting_should_match_the_reference_digests)
+{
+	EXPECT_EQ(Digest(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+	EXPECT_EQ(Digest("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+	EXPECT_EQ(Digest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+	          "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+	EXPECT_EQ(Digest(std::string(1000000, 'a')), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(Sha256Test, when_digesting_in_pieces_should_match_digesting_at_once)
+{
+	std::string data;
+	for (auto i = 0u; i < 1000; ++i)
+	{
+		data.push_back(static_cast<char>(i * 7));
+	}
+
+	Sha256 sha;
+	for (std::size_t offset = 0, size = 1; offset < data.size(); offset += size, size = size * 2 + 1)
+	{
+		sha.Update(data.data() + offset, std::min(size, data.size() - offset));
+	}
+
+	EXPECT_EQ(Sha256::ToHex(sha.Finish()), Digest(data));
+}
@@ -1,6 +1,7 @@
 #include <dynamic_value/binding/cast_to.h>
 #include <dynamic_value/boolean_value.h>
 #include <dynamic_value/dynamic_value_table.h>
+#include <dynamic_value/get_value_as.h>
 #include <dynamic_value/value_not_found.h>
 
 #include <gtest/gtest.h>
@@ -78,3 +79,27 @@ TEST_F(DynamicValueTableTest, when_getting_a_value_should_search_in_parent_table
 	ASSERT_TRUE(static_cast<bool>(*b));
 }
 
+TEST_F(DynamicValueTableTest, when_declaring_a_value_with_a_pointer_should_keep_the_same_object)
+{
+	m_table->Declare("b", m_bool);
+	ASSERT_EQ(m_table->Get("b"), m_bool);
+	ASSERT_EQ(m_table->GetValue("b").m_type, TaggedValue::Type::Boolean);
+}
+
+TEST_F(DynamicValueTableTest, when_declaring_a_tagged_value_should_store_it_unboxed)
+{
+	m_table->DeclareValue("i", TaggedValue::FromInteger(3));
+	auto i = m_table->GetValue("i");
+	ASSERT_EQ(i.m_type, TaggedValue::Type::Integer);
+	ASSERT_EQ(i.m_integer, 3);
+	ASSERT_EQ(get_value_as<int>(*m_table->Get("i")), 3);
+}
+
+TEST_F(DynamicValueTableTest, when_assigning_a_tagged_value_should_update_its_value)
+{
+	m_table->SetParent(m_parentTable);
+	m_parentTable->Declare("b", m_bool);
+	m_table->AssignValue("b", TaggedValue::FromFloat(1.5f));
+	ASSERT_EQ(m_parentTable->GetValue("b").m_type, TaggedValue::Type::Float);
+	ASSERT_EQ(get_value_as<float>(*m_parentTable->Get("b")), 1.5f);
+}
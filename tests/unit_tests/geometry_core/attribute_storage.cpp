@@ -0,0 +1,119 @@
+#include <geometry_core/geometry.h>
+#include <math_lib/vec_base.h>
+
+#include <gtest/gtest.h>
+
+using namespace pagoda;
+
+template<class Storage>
+class AttributeStorageTest : public ::testing::Test
+{
+protected:
+	using Geometry_t =
+	    GeometryBase<SplitPointTopology, DefaultFaceAttributes, DefaultEdgeAttributes, DefaultVertexAttributes, Storage>;
+
+	virtual void SetUp() { m_geometry = std::make_shared<Geometry_t>(); }
+
+	std::shared_ptr<Geometry_t> m_geometry;
+};
+
+using StoragePolicies = ::testing::Types<AssociativeAttributeStorage, DenseAttributeStorage>;
+TYPED_TEST_SUITE(AttributeStorageTest, StoragePolicies);
+
+TYPED_TEST(AttributeStorageTest, when_setting_positions_should_be_able_to_get_them)
+{
+	auto face = this->m_geometry->CreateFace();
+	for (auto i = 0u; i < 3; ++i)
+	{
+		auto p = this->m_geometry->GetPoint(face.m_splitPoints[i]);
+		this->m_geometry->SetPosition(p, Vec3F{static_cast<float>(i), 2.0f * i, 3.0f * i});
+	}
+
+	for (auto i = 0u; i < 3; ++i)
+	{
+		auto p = this->m_geometry->GetPoint(face.m_splitPoints[i]);
+		EXPECT_EQ(this->m_geometry->GetPosition(p), (Vec3F{static_cast<float>(i), 2.0f * i, 3.0f * i}));
+	}
+}
+
+TYPED_TEST(AttributeStorageTest, when_getting_an_unset_position_should_return_the_origin)
+{
+	EXPECT_EQ(this->m_geometry->GetPosition(10), (Vec3F{0, 0, 0}));
+}
+
+TYPED_TEST(AttributeStorageTest, when_overwriting_a_position_should_keep_the_last_one)
+{
+	this->m_geometry->SetPosition(5, Vec3F{1, 2, 3});
+	this->m_geometry->SetPosition(5, Vec3F{4, 5, 6});
+	this->m_geometry->SetPosition(0, Vec3F{7, 8, 9});
+
+	EXPECT_EQ(this->m_geometry->GetPosition(5), (Vec3F{4, 5, 6}));
+	EXPECT_EQ(this->m_geometry->GetPosition(0), (Vec3F{7, 8, 9}));
+}
+
+TYPED_TEST(AttributeStorageTest, when_modifying_attributes_should_keep_the_modifications)
+{
+	this->m_geometry->GetFaceAttributes(3).m_normal = Vec3F{0, 0, 1};
+	this->m_geometry->GetVertexAttributes(7).m_normal = Vec3F{0, 1, 0};
+
+	EXPECT_EQ(this->m_geometry->GetFaceAttributes(3).m_normal, (Vec3F{0, 0, 1}));
+	EXPECT_EQ(this->m_geometry->GetVertexAttributes(7).m_normal, (Vec3F{0, 1, 0}));
+}
+
+TYPED_TEST(AttributeStorageTest, when_copying_a_geometry_should_copy_the_attributes)
+{
+	this->m_geometry->SetPosition(2, Vec3F{1, 2, 3});
+	this->m_geometry->GetFaceAttributes(1).m_normal = Vec3F{0, 0, 1};
+
+	typename TestFixture::Geometry_t copy;
+	copy = *this->m_geometry;
+	this->m_geometry->SetPosition(2, Vec3F{4, 5, 6});
+
+	EXPECT_EQ(copy.GetPosition(2), (Vec3F{1, 2, 3}));
+	EXPECT_EQ(copy.GetFaceAttributes(1).m_normal, (Vec3F{0, 0, 1}));
+}
+
+TYPED_TEST(AttributeStorageTest, when_compacting_should_move_the_attributes_with_the_topology)
+{
+	std::vector<typename TestFixture::Geometry_t::FaceHandle> faces;
+	for (auto i = 0u; i < 3; ++i)
+	{
+		auto face = this->m_geometry->CreateFace();
+		faces.push_back(face.m_face);
+		this->m_geometry->GetFaceAttributes(face.m_face).m_normal = Vec3F{0, 0, static_cast<float>(i)};
+		for (auto s : face.m_splitPoints)
+		{
+			auto p = this->m_geometry->GetPoint(s);
+			this->m_geometry->SetPosition(p, Vec3F{static_cast<float>(i), static_cast<float>(p.GetIndex()), 0});
+		}
+	}
+	this->m_geometry->DeleteFace(faces[0]);
+
+	this->m_geometry->Compact();
+
+	ASSERT_EQ(this->m_geometry->GetFaceCount(), 2);
+	auto i = 1.0f;
+	for (auto f = this->m_geometry->FacesBegin(); f != this->m_geometry->FacesEnd(); ++f, ++i)
+	{
+		EXPECT_EQ(this->m_geometry->GetFaceAttributes(*f).m_normal, (Vec3F{0, 0, i}));
+		for (auto p = this->m_geometry->FacePointCirculatorBegin(*f); p; ++p)
+		{
+			EXPECT_EQ(boost::qvm::X(this->m_geometry->GetPosition(*p)), i);
+		}
+	}
+}
+
+TYPED_TEST(AttributeStorageTest, when_transforming_positions_should_apply_the_affine_matrix)
+{
+	this->m_geometry->SetPosition(0, Vec3F{1, 2, 3});
+	this->m_geometry->SetPosition(3, Vec3F{-1, 0, 2});
+
+	Mat3x4F matrix;
+	matrix.a[0][0] = 0, matrix.a[0][1] = -1, matrix.a[0][2] = 0, matrix.a[0][3] = 10;
+	matrix.a[1][0] = 1, matrix.a[1][1] = 0, matrix.a[1][2] = 0, matrix.a[1][3] = 20;
+	matrix.a[2][0] = 0, matrix.a[2][1] = 0, matrix.a[2][2] = 2, matrix.a[2][3] = 30;
+	this->m_geometry->TransformPositions(matrix);
+
+	EXPECT_EQ(this->m_geometry->GetPosition(0), (Vec3F{8, 21, 36}));
+	EXPECT_EQ(this->m_geometry->GetPosition(3), (Vec3F{10, 19, 34}));
+}
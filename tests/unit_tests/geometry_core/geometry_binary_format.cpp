@@ -0,0 +1,118 @@
+#include <geometry_core/geometry.h>
+#include <geometry_core/geometry_binary_format.h>
+#include <geometry_core/geometry_exporter.h>
+#include <geometry_operations/create_sphere.h>
+#include <math_lib/vec_base.h>
+
+#include <common/exception.h>
+#include <common/file_util.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/qvm/map_mat_mat.hpp>
+#include <boost/qvm/mat_operations.hpp>
+
+using namespace pagoda;
+
+using GeometryType =
+    GeometryBase<CompactSplitPointTopology, DefaultFaceAttributes, DefaultEdgeAttributes, DefaultVertexAttributes,
+                 DenseAttributeStorage>;
+
+class GeometryBinaryFormatTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		m_geometry = std::make_shared<GeometryType>();
+		CreateSphere<GeometryType> sphere(2.0f, 10, 6);
+		sphere.Execute(m_geometry);
+		m_scope = Scope(Vec3F{1, 2, 3}, Vec3F{4, 5, 6}, boost::qvm::rotz_mat<3>(0.5f));
+	}
+
+	std::string ExportObj(std::shared_ptr<GeometryType> geometry)
+	{
+		std::string buffer;
+		ObjExporter<GeometryType>(geometry).Export(buffer);
+		return buffer;
+	}
+
+	std::shared_ptr<GeometryType> m_geometry;
+	Scope m_scope;
+};
+
+TEST_F(GeometryBinaryFormatTest, when_reading_a_written_geometry_should_export_the_same_obj)
+{
+	std::string buffer;
+	GeometryBinaryWriter<GeometryType>(m_geometry).Write(buffer, m_scope);
+
+	Scope scope;
+	auto geometry = GeometryBinaryReader<GeometryType>::Read(buffer.data(), buffer.size(), scope);
+
+	EXPECT_EQ(geometry->GetPointCount(), m_geometry->GetPointCount());
+	EXPECT_EQ(geometry->GetFaceCount(), m_geometry->GetFaceCount());
+	EXPECT_TRUE(geometry->IsValid());
+	EXPECT_EQ(ExportObj(geometry), ExportObj(m_geometry));
+}
+
+TEST_F(GeometryBinaryFormatTest, when_reading_a_written_geometry_should_restore_the_scope)
+{
+	std::string buffer;
+	GeometryBinaryWriter<GeometryType>(m_geometry).Write(buffer, m_scope);
+
+	Scope scope;
+	GeometryBinaryReader<GeometryType>::Read(buffer.data(), buffer.size(), scope);
+
+	EXPECT_EQ(scope.GetPosition(), m_scope.GetPosition());
+	EXPECT_EQ(scope.GetSize(), m_scope.GetSize());
+	EXPECT_TRUE(scope.GetRotation() == m_scope.GetRotation());
+}
+
+TEST_F(GeometryBinaryFormatTest, when_writing_should_use_flat_arrays)
+{
+	std::string buffer;
+	GeometryBinaryWriter<GeometryType>(m_geometry).Write(buffer, m_scope);
+
+	GeometryBinaryFormat::Header header;
+	std::memcpy(&header, buffer.data(), sizeof(header));
+	EXPECT_EQ(header.m_pointCount, m_geometry->GetPointCount());
+	EXPECT_EQ(header.m_faceCount, m_geometry->GetFaceCount());
+	EXPECT_EQ(header.m_indexCount, m_geometry->GetSplitPointCount());
+	EXPECT_EQ(buffer.size(), GeometryBinaryFormat::GetFileSize(header));
+}
+
+TEST_F(GeometryBinaryFormatTest, when_reading_from_a_file_should_map_it)
+{
+	auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.pgg");
+	std::string buffer;
+	GeometryBinaryWriter<GeometryType>(m_geometry).Write(buffer, m_scope);
+	file_util::WriteStringToFile(path, buffer);
+
+	Scope scope;
+	auto geometry = GeometryBinaryReader<GeometryType>::ReadFile(path.string(), scope);
+	boost::filesystem::remove(path);
+
+	EXPECT_EQ(ExportObj(geometry), ExportObj(m_geometry));
+}
+
+TEST_F(GeometryBinaryFormatTest, when_reading_invalid_data_should_throw)
+{
+	std::string buffer;
+	GeometryBinaryWriter<GeometryType>(m_geometry).Write(buffer, m_scope);
+	Scope scope;
+
+	EXPECT_THROW(GeometryBinaryReader<GeometryType>::Read(buffer.data(), 10, scope), Exception);
+	EXPECT_THROW(GeometryBinaryReader<GeometryType>::Read(buffer.data(), buffer.size() - 4, scope), Exception);
+
+	auto wrongMagic = buffer;
+	wrongMagic[0] = 'X';
+	EXPECT_THROW(GeometryBinaryReader<GeometryType>::Read(wrongMagic.data(), wrongMagic.size(), scope), Exception);
+
+	auto wrongIndex = buffer;
+	GeometryBinaryFormat::Header header;
+	std::memcpy(&header, buffer.data(), sizeof(header));
+	const uint32_t invalidIndex = header.m_pointCount;
+	const auto indicesOffset = sizeof(header) + sizeof(float) * 6 * header.m_pointCount + 4 * header.m_faceCount;
+	std::memcpy(&wrongIndex[indicesOffset], &invalidIndex, sizeof(invalidIndex));
+	EXPECT_THROW(GeometryBinaryReader<GeometryType>::Read(wrongIndex.data(), wrongIndex.size(), scope), Exception);
+}
@@ -94,3 +94,55 @@ TEST_F(GeometryBuilderTest, when_creating_a_face_should_be_able_to_reuse_points)
 	EXPECT_EQ(m_geometry->GetEdgeCount(), 8);
 	EXPECT_TRUE(m_geometry->IsValid());
 }
+
+TEST_F(GeometryBuilderTest, when_building_in_bulk_should_create_the_same_geometry_as_the_face_builder)
+{
+	std::vector<Vec3F> positions = {Vec3F{0, 0, 0}, Vec3F{0, 0, 1}, Vec3F{0, 1, 1}, Vec3F{0, 1, 0},
+	                                Vec3F{1, 1, 1}, Vec3F{1, 0, 1}, Vec3F{5, 5, 5}};
+	std::vector<GeometryType::Index_t> indices = {0, 1, 2, 3, 2, 1, 5, 4};
+	std::vector<uint32_t> faceSizes = {4, 4};
+
+	auto expected = std::make_shared<GeometryType>();
+	GeometryBuilderT<GeometryType> builder(expected);
+	std::vector<GeometryType::Index_t> points;
+	for (const auto &p : positions)
+	{
+		points.push_back(builder.AddPoint(p));
+	}
+	std::size_t faceStart = 0;
+	for (const auto &size : faceSizes)
+	{
+		auto faceBuilder = builder.StartFace(size);
+		for (auto i = 0u; i < size; ++i)
+		{
+			faceBuilder.AddIndex(points[indices[faceStart + i]]);
+		}
+		faceBuilder.CloseFace();
+		faceStart += size;
+	}
+
+	BulkGeometryBuilderT<GeometryType> bulkBuilder(m_geometry);
+	bulkBuilder.Build(positions, indices, faceSizes);
+
+	EXPECT_EQ(m_geometry->GetFaceCount(), 2);
+	EXPECT_EQ(m_geometry->GetPointCount(), 6);
+	EXPECT_EQ(m_geometry->GetSplitPointCount(), 8);
+	EXPECT_EQ(m_geometry->GetEdgeCount(), 8);
+	EXPECT_TRUE(m_geometry->IsValid());
+
+	std::stringstream expectedTopology;
+	expected->DumpToStream(expectedTopology);
+	std::stringstream topology;
+	m_geometry->DumpToStream(topology);
+	EXPECT_EQ(topology.str(), expectedTopology.str());
+
+	for (auto p = expected->PointsBegin(); p != expected->PointsEnd(); ++p)
+	{
+		EXPECT_EQ(m_geometry->GetPosition(*p), expected->GetPosition(*p));
+		EXPECT_EQ(m_geometry->GetVertexAttributes(*p).m_normal, expected->GetVertexAttributes(*p).m_normal);
+	}
+	for (auto f = expected->FacesBegin(); f != expected->FacesEnd(); ++f)
+	{
+		EXPECT_EQ(m_geometry->GetFaceAttributes(*f).m_normal, expected->GetFaceAttributes(*f).m_normal);
+	}
+}
@@ -3,6 +3,7 @@
 #include <geometry_core/geometry.h>
 #include <geometry_core/geometry_builder.h>
 #include <geometry_core/geometry_exporter.h>
+#include <geometry_operations/create_sphere.h>
 #include <math_lib/vec_base.h>
 
 #include <common/file_util.h>
@@ -107,3 +108,32 @@ TEST_F(GeometryExporterTest, geometry_exporter_export_cube)
 	MatchFile match(GetCurrentTestFileResultsDirectory() /= "geometry.obj", GetShouldWriteFiles());
 	match.Match(ss.str());
 }
+
+TEST_F(GeometryExporterTest, when_exporting_to_a_buffer_should_match_exporting_to_a_stream)
+{
+	CreateSphere<GeometryType> sphere(1.3f, 12, 7);
+	sphere.Execute(m_geometry);
+
+	ObjExporter<GeometryType> exporter(m_geometry);
+	std::stringstream ss;
+	exporter.Export(ss);
+	std::string buffer;
+	exporter.Export(buffer);
+
+	EXPECT_EQ(buffer, ss.str());
+}
+
+TEST_F(GeometryExporterTest, when_formatting_numbers_should_match_the_stream_formatting)
+{
+	for (float f : {0.0f, -0.0f, 1.0f, -1.5f, 0.1f, 1e-7f, 123456.0f, 1234567.0f, 3.14159265f, 1e20f, -2.5e-12f})
+	{
+		std::stringstream ss;
+		ss << f;
+		std::string formatted;
+		AppendNumber(formatted, f);
+		EXPECT_EQ(formatted, ss.str());
+	}
+	std::string formatted;
+	AppendNumber(formatted, std::size_t(1234));
+	EXPECT_EQ(formatted, "1234");
+}
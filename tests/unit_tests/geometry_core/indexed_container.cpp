@@ -189,6 +189,122 @@ TEST(IndexedContainerTest, when_changing_values_through_an_iterator_should_chang
     EXPECT_EQ(c.Get(1).m_value, 0);
 }
 
+TEST(IndexedContainerTest, when_creating_after_deleting_should_keep_the_creation_order)
+{
+	IndexedContainer<std::size_t, Value> c;
+	c.Create(1);
+	c.Create(2);
+	c.Create(3);
+	c.Delete(1);
+
+	EXPECT_EQ(c.Create(4), 3);
+	EXPECT_EQ(c.Get(3).m_value, 4);
+	EXPECT_FALSE(c.HasIndex(1));
+	EXPECT_EQ(c.Count(), 3);
+
+	std::vector<std::size_t> values;
+	for (const auto &el : c)
+	{
+		values.push_back(el.m_value.m_value);
+	}
+	EXPECT_EQ(values, (std::vector<std::size_t>{1, 3, 4}));
+}
+
+TEST(IndexedContainerTest, when_deleting_an_index_twice_should_only_count_it_once)
+{
+	IndexedContainer<std::size_t, Value> c;
+	c.Create(1);
+	c.Create(2);
+	c.Delete(0);
+	c.Delete(0);
+
+	EXPECT_EQ(c.Count(), 1);
+	EXPECT_EQ(c.Create(3), 2);
+	EXPECT_EQ(c.Count(), 2);
+}
+
+TEST(IndexedContainerTest, when_reserving_should_keep_the_existing_values_and_not_create_new_ones)
+{
+	IndexedContainer<std::size_t, Value> c;
+	c.Create(1);
+	c.Create(2);
+	c.Reserve(100);
+
+	EXPECT_EQ(c.Count(), 2);
+	EXPECT_FALSE(c.HasIndex(2));
+	EXPECT_EQ(c.Create(3), 2);
+
+	std::vector<std::size_t> values;
+	for (const auto &el : c)
+	{
+		values.push_back(el.m_value.m_value);
+	}
+	EXPECT_EQ(values, (std::vector<std::size_t>{1, 2, 3}));
+}
+
+TEST(IndexedContainerTest, when_iterating_over_many_deleted_indices_should_visit_only_the_valid_ones)
+{
+	IndexedContainer<std::size_t, Value> c;
+	for (auto i = 0u; i < 300; ++i)
+	{
+		c.Create(i);
+	}
+	for (auto i = 0u; i < 300; ++i)
+	{
+		if (i != 0 && i != 63 && i != 64 && i != 200 && i != 299)
+		{
+			c.Delete(i);
+		}
+	}
+
+	std::vector<std::size_t> visited;
+	for (const auto &el : c)
+	{
+		EXPECT_EQ(el.m_index, el.m_value.m_value);
+		visited.push_back(el.m_index);
+	}
+	EXPECT_EQ(visited, (std::vector<std::size_t>{0, 63, 64, 200, 299}));
+}
+
+TEST(IndexedContainerTest, when_compacting_should_keep_the_order_and_return_the_remap_table)
+{
+	IndexedContainer<std::size_t, Value> c;
+	for (auto i = 0u; i < 5; ++i)
+	{
+		c.Create(i);
+	}
+	c.Delete(1);
+	c.Delete(3);
+
+	auto remap = c.Compact();
+
+	using Container_t = IndexedContainer<std::size_t, Value>;
+	ASSERT_GE(remap.size(), 5u);
+	remap.resize(5);
+	EXPECT_EQ(remap, (Container_t::RemapTable_t{0, Container_t::s_invalidIndex, 1, Container_t::s_invalidIndex, 2}));
+	EXPECT_EQ(c.Count(), 3);
+	EXPECT_EQ(c.Get(0).m_value, 0);
+	EXPECT_EQ(c.Get(1).m_value, 2);
+	EXPECT_EQ(c.Get(2).m_value, 4);
+	EXPECT_FALSE(c.HasIndex(3));
+	EXPECT_EQ(c.Create(5), 3);
+}
+
+TEST(AssociativeIndexedContainersTest, when_remapping_should_move_the_values_and_remove_the_unmapped)
+{
+	AssociativeIndexedContainer<uint32_t, uint32_t> c;
+	c.GetOrCreate(0, 10);
+	c.GetOrCreate(1, 11);
+	c.GetOrCreate(2, 12);
+
+	c.Remap({1, std::numeric_limits<uint32_t>::max(), 0});
+
+	EXPECT_EQ(c.Count(), 2);
+	EXPECT_EQ(c.Get(0), 12);
+	EXPECT_EQ(c.Get(1), 10);
+	EXPECT_EQ(c.Create(13), 2);
+}
+
 TEST(AssociativeIndexedContainersTest, when_iterating_should_visit_all_values)
 {
 	AssociativeIndexedContainer<uint32_t, uint32_t> c;
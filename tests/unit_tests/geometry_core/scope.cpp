@@ -5,9 +5,12 @@
 #include <gtest/gtest.h>
 
 #include <boost/qvm/map_vec_mat.hpp>
+#include <boost/qvm/mat_operations.hpp>
 #include <boost/qvm/vec.hpp>
 #include <boost/qvm/vec_operations.hpp>
 
+#include <cmath>
+
 using namespace pagoda;
 using GeometryType = GeometryBase<>;
 
@@ -99,3 +102,27 @@ TEST(Scope, when_constructing_from_geometry_and_constrained_rotation_should_crea
 	EXPECT_TRUE(boost::qvm::col<1>(s.GetRotation()) == (Vec3F{0, 1, 0}));
 	EXPECT_TRUE(boost::qvm::col<2>(s.GetRotation()) == (Vec3F{0, 0, 1}));
 }
+
+TEST(Scope, when_transforming_a_scope_should_bound_its_transformed_box)
+{
+	Scope scope(Vec3F{1, 2, 3}, Vec3F{4, 5, 6}, boost::qvm::diag_mat(XYZ(Vec3F{1, 1, 1})));
+	const Mat3x3F rotation = boost::qvm::rotz_mat<3>(static_cast<float>(M_PI) / 2.0f);
+	Mat3x4F matrix;
+	for (auto r = 0u; r < 3; ++r)
+	{
+		for (auto c = 0u; c < 3; ++c)
+		{
+			matrix.a[r][c] = rotation.a[r][c];
+		}
+		matrix.a[r][3] = (r == 0 ? 10.0f : 0.0f);
+	}
+
+	auto s = scope.Transformed(matrix, rotation);
+	EXPECT_NEAR(X(s.GetPosition()), 8.0f, 1e-5f);
+	EXPECT_NEAR(Y(s.GetPosition()), 1.0f, 1e-5f);
+	EXPECT_NEAR(Z(s.GetPosition()), 3.0f, 1e-5f);
+	EXPECT_NEAR(X(s.GetSize()), 4.0f, 1e-5f);
+	EXPECT_NEAR(Y(s.GetSize()), 5.0f, 1e-5f);
+	EXPECT_NEAR(Z(s.GetSize()), 6.0f, 1e-5f);
+	EXPECT_TRUE(s.GetRotation() == rotation);
+}
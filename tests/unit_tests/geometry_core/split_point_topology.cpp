@@ -31,6 +31,9 @@ TEST(HandleImplicitCastTest, test_implicit_casts)
 	EXPECT_EQ(i, 4);
 }
 
+using Topologies = ::testing::Types<SplitPointTopology, CompactSplitPointTopology>;
+
+template<class Topology>
 class SplitPointTopologyCreateFaceTest : public PagodaTestFixture<::testing::Test>
 {
 protected:
@@ -38,27 +41,28 @@ protected:
 
 	void TearDown() {}
 
-	SplitPointTopology m_topology;
+	Topology m_topology;
 };
+TYPED_TEST_SUITE(SplitPointTopologyCreateFaceTest, Topologies);
 
-TEST_F(SplitPointTopologyCreateFaceTest, when_creating_a_face_should_return_a_face_with_three_points)
+TYPED_TEST(SplitPointTopologyCreateFaceTest, when_creating_a_face_should_return_a_face_with_three_points)
 {
-	SplitPointTopology::CreateFaceResult result = m_topology.CreateFace();
+	typename TypeParam::CreateFaceResult result = this->m_topology.CreateFace();
 	EXPECT_EQ(result.m_face.GetIndex(), 0);
 	EXPECT_EQ(result.m_splitPoints[0].GetIndex(), 0);
 	EXPECT_EQ(result.m_splitPoints[1].GetIndex(), 1);
 	EXPECT_EQ(result.m_splitPoints[2].GetIndex(), 2);
-	EXPECT_TRUE(m_topology.IsValid());
+	EXPECT_TRUE(this->m_topology.IsValid());
 
     std::stringstream ss;
-    m_topology.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_topology.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyCreateFaceTest, when_creating_two_faces_should_return_different_indices)
+TYPED_TEST(SplitPointTopologyCreateFaceTest, when_creating_two_faces_should_return_different_indices)
 {
-	SplitPointTopology::CreateFaceResult results[] = {m_topology.CreateFace(), m_topology.CreateFace()};
+	typename TypeParam::CreateFaceResult results[] = {this->m_topology.CreateFace(), this->m_topology.CreateFace()};
 
 	for (auto i = 0u; i < 2; ++i)
 	{
@@ -67,32 +71,99 @@ TEST_F(SplitPointTopologyCreateFaceTest, when_creating_two_faces_should_return_d
 		EXPECT_EQ(results[i].m_splitPoints[1].GetIndex(), i * 3 + 1);
 		EXPECT_EQ(results[i].m_splitPoints[2].GetIndex(), i * 3 + 2);
 	}
-	EXPECT_TRUE(m_topology.IsValid());
+	EXPECT_TRUE(this->m_topology.IsValid());
 
     std::stringstream ss;
-    m_topology.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_topology.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyCreateFaceTest, when_creating_faces_should_be_able_to_reuse_points)
+TYPED_TEST(SplitPointTopologyCreateFaceTest, when_creating_faces_should_be_able_to_reuse_points)
 {
-	auto results1 = m_topology.CreateFace();
-	auto results2 = m_topology.CreateFace(
-            m_topology.GetPoint(results1.m_splitPoints[0]),
-            m_topology.GetPoint(results1.m_splitPoints[1]));
+	auto results1 = this->m_topology.CreateFace();
+	auto results2 = this->m_topology.CreateFace(
+            this->m_topology.GetPoint(results1.m_splitPoints[0]),
+            this->m_topology.GetPoint(results1.m_splitPoints[1]));
 
-	EXPECT_EQ(m_topology.GetPoint(results2.m_splitPoints[0].GetIndex()), m_topology.GetPoint(results1.m_splitPoints[0].GetIndex()));
-	EXPECT_EQ(m_topology.GetPoint(results2.m_splitPoints[1].GetIndex()), m_topology.GetPoint(results1.m_splitPoints[1].GetIndex()));
-	EXPECT_EQ(m_topology.GetPoint(results2.m_splitPoints[2].GetIndex()).GetIndex(), 3);
-	EXPECT_TRUE(m_topology.IsValid());
+	EXPECT_EQ(this->m_topology.GetPoint(results2.m_splitPoints[0].GetIndex()), this->m_topology.GetPoint(results1.m_splitPoints[0].GetIndex()));
+	EXPECT_EQ(this->m_topology.GetPoint(results2.m_splitPoints[1].GetIndex()), this->m_topology.GetPoint(results1.m_splitPoints[1].GetIndex()));
+	EXPECT_EQ(this->m_topology.GetPoint(results2.m_splitPoints[2].GetIndex()).GetIndex(), 3);
+	EXPECT_TRUE(this->m_topology.IsValid());
 
     std::stringstream ss;
-    m_topology.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_topology.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
+TYPED_TEST(SplitPointTopologyCreateFaceTest, when_creating_a_polygon_should_create_all_points_in_order)
+{
+	std::vector<typename TypeParam::PointHandle> points(5, TypeParam::s_invalidIndex);
+	auto face = this->m_topology.CreatePolygon(points.data(), points.size());
+
+	EXPECT_EQ(this->m_topology.GetFaceCount(), 1);
+	EXPECT_EQ(this->m_topology.GetPointCount(), 5);
+	EXPECT_EQ(this->m_topology.GetSplitPointCount(), 5);
+	EXPECT_EQ(this->m_topology.GetEdgeCount(), 5);
+	EXPECT_TRUE(this->m_topology.IsValid());
+
+	auto splitPoint = this->m_topology.GetSplitPoint(face);
+	for (auto i = 0u; i < 5; ++i)
+	{
+		splitPoint = this->m_topology.GetNextSplitPoint(splitPoint);
+		EXPECT_EQ(this->m_topology.GetPoint(splitPoint), points[i]);
+		EXPECT_EQ(points[i].GetIndex(), i);
+	}
+}
+
+TYPED_TEST(SplitPointTopologyCreateFaceTest, when_creating_a_polygon_with_split_point_handles_should_use_them)
+{
+	std::vector<typename TypeParam::PointHandle> points(4, TypeParam::s_invalidIndex);
+	std::vector<typename TypeParam::SplitPointHandle> splitPoints = {3, 0, 2, 1};
+	auto face = this->m_topology.CreatePolygon(points.data(), points.size(), splitPoints.data());
+
+	EXPECT_EQ(this->m_topology.GetSplitPointCount(), 4);
+	EXPECT_TRUE(this->m_topology.IsValid());
+	EXPECT_EQ(this->m_topology.GetSplitPoint(face), splitPoints[3]);
+	for (auto i = 0u; i < 4; ++i)
+	{
+		EXPECT_EQ(this->m_topology.GetPoint(splitPoints[i]), points[i]);
+		EXPECT_EQ(this->m_topology.GetNextSplitPoint(splitPoints[i]), splitPoints[(i + 1) % 4]);
+	}
+}
+
+TYPED_TEST(SplitPointTopologyCreateFaceTest, when_creating_a_polygon_should_match_splitting_the_edges_of_a_triangle)
+{
+	TypeParam splitTopology;
+	auto triangle = splitTopology.CreateFace();
+	auto edge = splitTopology.GetOutEdge(triangle.m_splitPoints[2]);
+	for (auto i = 0u; i < 2; ++i)
+	{
+		splitTopology.SplitEdge(edge);
+		edge = splitTopology.GetNextEdge(edge);
+	}
+	std::array<typename TypeParam::PointHandle, 3> reused = {splitTopology.GetPoint(triangle.m_splitPoints[1]),
+	                                                         splitTopology.GetPoint(triangle.m_splitPoints[0]),
+	                                                         TypeParam::s_invalidIndex};
+	auto face = splitTopology.CreateFace(reused[0], reused[1], reused[2]);
+	splitTopology.SplitEdge(splitTopology.GetOutEdge(face.m_splitPoints[2]));
+
+	std::vector<typename TypeParam::PointHandle> points(5, TypeParam::s_invalidIndex);
+	this->m_topology.CreatePolygon(points.data(), points.size());
+	std::vector<typename TypeParam::PointHandle> reusedPoints = {points[1], points[0], TypeParam::s_invalidIndex,
+	                                                             TypeParam::s_invalidIndex};
+	this->m_topology.CreatePolygon(reusedPoints.data(), reusedPoints.size());
+	EXPECT_TRUE(this->m_topology.IsValid());
+
+	std::stringstream expected;
+	splitTopology.DumpToStream(expected);
+	std::stringstream actual;
+	this->m_topology.DumpToStream(actual);
+	EXPECT_EQ(actual.str(), expected.str());
+}
+
+template<class Topology>
 class SplitPointTopologyOperationsTest : public PagodaTestFixture<::testing::Test>
 {
 protected:
@@ -100,55 +171,57 @@ protected:
 
 	void TearDown() {}
 
-	SplitPointTopology m_topology;
+	Topology m_topology;
 };
+TYPED_TEST_SUITE(SplitPointTopologyOperationsTest, Topologies);
 
-TEST_F(SplitPointTopologyOperationsTest, when_getting_the_split_point_from_a_point_should_get_the_respective_split_point)
+TYPED_TEST(SplitPointTopologyOperationsTest, when_getting_the_split_point_from_a_point_should_get_the_respective_split_point)
 {
-	auto face = m_topology.CreateFace();
+	auto face = this->m_topology.CreateFace();
 
 	for (auto i = 0u; i < 3; ++i)
 	{
-        auto point = m_topology.GetPoint(face.m_splitPoints[i]);
-        auto edge = *(m_topology.GetOutEdges(point).begin());
-        EXPECT_EQ(point, m_topology.GetPoint(m_topology.GetSource(edge)));
+        auto point = this->m_topology.GetPoint(face.m_splitPoints[i]);
+        auto edge = *(this->m_topology.GetOutEdges(point).begin());
+        EXPECT_EQ(point, this->m_topology.GetPoint(this->m_topology.GetSource(edge)));
 	}
 }
 
-TEST_F(SplitPointTopologyOperationsTest, when_getting_the_split_point_from_a_face_should_get_the_respective_face)
+TYPED_TEST(SplitPointTopologyOperationsTest, when_getting_the_split_point_from_a_face_should_get_the_respective_face)
 {
-	auto face = m_topology.CreateFace();
-	auto splitPoint = m_topology.GetSplitPoint(face.m_face);
-	EXPECT_EQ(m_topology.GetFace(splitPoint), face.m_face);
+	auto face = this->m_topology.CreateFace();
+	auto splitPoint = this->m_topology.GetSplitPoint(face.m_face);
+	EXPECT_EQ(this->m_topology.GetFace(splitPoint), face.m_face);
 }
 
-TEST_F(SplitPointTopologyOperationsTest, when_getting_the_edges_from_a_split_point_should_return_the_respective_edge)
+TYPED_TEST(SplitPointTopologyOperationsTest, when_getting_the_edges_from_a_split_point_should_return_the_respective_edge)
 {
-	auto face = m_topology.CreateFace();
+	auto face = this->m_topology.CreateFace();
 	for (auto i = 0u; i < 3; ++i)
 	{
-        auto point = m_topology.GetPoint(face.m_splitPoints[i]);
-        auto edge = *(m_topology.GetOutEdges(point).begin());
-	    auto splitPoint = m_topology.GetSource(edge);
-	    auto outgoingEdge = m_topology.GetOutEdge(splitPoint);
-	    auto incomingEdge = m_topology.GetInEdge(splitPoint);
-
-	    EXPECT_EQ(m_topology.GetSource(outgoingEdge), splitPoint);
-	    EXPECT_EQ(m_topology.GetDestination(incomingEdge), splitPoint);
+        auto point = this->m_topology.GetPoint(face.m_splitPoints[i]);
+        auto edge = *(this->m_topology.GetOutEdges(point).begin());
+	    auto splitPoint = this->m_topology.GetSource(edge);
+	    auto outgoingEdge = this->m_topology.GetOutEdge(splitPoint);
+	    auto incomingEdge = this->m_topology.GetInEdge(splitPoint);
+
+	    EXPECT_EQ(this->m_topology.GetSource(outgoingEdge), splitPoint);
+	    EXPECT_EQ(this->m_topology.GetDestination(incomingEdge), splitPoint);
 	}
 }
 
-TEST_F(SplitPointTopologyOperationsTest, when_getting_the_face_from_an_edge_should_return_the_respective_face)
+TYPED_TEST(SplitPointTopologyOperationsTest, when_getting_the_face_from_an_edge_should_return_the_respective_face)
 {
-	auto face = m_topology.CreateFace();
+	auto face = this->m_topology.CreateFace();
 	for (auto i = 0u; i < 3; ++i)
 	{
-        auto point = m_topology.GetPoint(face.m_splitPoints[i]);
-        auto edge = *(m_topology.GetOutEdges(point).begin());
-	    EXPECT_EQ(m_topology.GetFace(edge), face.m_face);
+        auto point = this->m_topology.GetPoint(face.m_splitPoints[i]);
+        auto edge = *(this->m_topology.GetOutEdges(point).begin());
+	    EXPECT_EQ(this->m_topology.GetFace(edge), face.m_face);
 	}
 }
 
+template<class Topology>
 class SplitPointTopologyNavigationTest : public PagodaTestFixture<::testing::Test>
 {
 protected:
@@ -156,43 +229,45 @@ protected:
 
 	void TearDown() {}
 
-	SplitPointTopology m_topology;
+	Topology m_topology;
 };
+TYPED_TEST_SUITE(SplitPointTopologyNavigationTest, Topologies);
 
-TEST_F(SplitPointTopologyNavigationTest, when_navigating_the_split_points_should_be_able_to_circle_the_face)
+TYPED_TEST(SplitPointTopologyNavigationTest, when_navigating_the_split_points_should_be_able_to_circle_the_face)
 {
-	auto &topology = m_topology;
-	auto face = m_topology.CreateFace();
-	auto next = [&topology](SplitPointTopology::SplitPointHandle p) { return topology.GetNextSplitPoint(p); };
-	auto prev = [&topology](SplitPointTopology::SplitPointHandle p) { return topology.GetPrevSplitPoint(p); };
+	auto &topology = this->m_topology;
+	auto face = this->m_topology.CreateFace();
+	auto next = [&topology](typename TypeParam::SplitPointHandle p) { return topology.GetNextSplitPoint(p); };
+	auto prev = [&topology](typename TypeParam::SplitPointHandle p) { return topology.GetPrevSplitPoint(p); };
 
 	for (auto i = 0u; i < 3; ++i)
 	{
-        auto point = m_topology.GetPoint(face.m_splitPoints[i]);
-        auto edge = *(m_topology.GetOutEdges(point).begin());
-        SplitPointTopology::SplitPointHandle splitPoint = m_topology.GetSource(edge);
+        auto point = this->m_topology.GetPoint(face.m_splitPoints[i]);
+        auto edge = *(this->m_topology.GetOutEdges(point).begin());
+        typename TypeParam::SplitPointHandle splitPoint = this->m_topology.GetSource(edge);
 	    EXPECT_EQ(next(next(next(splitPoint))), splitPoint);
 	    EXPECT_EQ(prev(prev(prev(splitPoint))), splitPoint);
 	}
 }
 
-TEST_F(SplitPointTopologyNavigationTest, when_navigating_the_edges_should_be_able_to_circle_the_face)
+TYPED_TEST(SplitPointTopologyNavigationTest, when_navigating_the_edges_should_be_able_to_circle_the_face)
 {
-	auto &topology = m_topology;
-	auto face = m_topology.CreateFace();
-	auto next = [&topology](SplitPointTopology::EdgeHandle e) { return topology.GetNextEdge(e); };
-	auto prev = [&topology](SplitPointTopology::EdgeHandle e) { return topology.GetPrevEdge(e); };
+	auto &topology = this->m_topology;
+	auto face = this->m_topology.CreateFace();
+	auto next = [&topology](typename TypeParam::EdgeHandle e) { return topology.GetNextEdge(e); };
+	auto prev = [&topology](typename TypeParam::EdgeHandle e) { return topology.GetPrevEdge(e); };
 
 	for (auto i = 0u; i < 3; ++i)
 	{
-        auto point = m_topology.GetPoint(face.m_splitPoints[i]);
-        auto edge = *(m_topology.GetOutEdges(point).begin());
+        auto point = this->m_topology.GetPoint(face.m_splitPoints[i]);
+        auto edge = *(this->m_topology.GetOutEdges(point).begin());
 
 	    EXPECT_EQ(next(next(next(edge))), edge);
 	    EXPECT_EQ(prev(prev(prev(edge))), edge);
 	}
 }
 
+template<class Topology>
 class SplitPointTopologyIteratorsTest : public PagodaTestFixture<::testing::Test>
 {
 protected:
@@ -203,15 +278,16 @@ protected:
 
     void TearDown() {}
 
-    SplitPointTopology m_topology;
-    SplitPointTopology::CreateFaceResult m_face;
+    Topology m_topology;
+    typename Topology::CreateFaceResult m_face;
 };
+TYPED_TEST_SUITE(SplitPointTopologyIteratorsTest, Topologies);
 
-TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_points_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_iterating_over_points_should_go_through_all)
 {
-    auto iter = m_topology.PointsBegin();
-    auto endIter = m_topology.PointsEnd();
-    std::unordered_set<SplitPointTopology::Index_t> seenPoints;
+    auto iter = this->m_topology.PointsBegin();
+    auto endIter = this->m_topology.PointsEnd();
+    std::unordered_set<typename TypeParam::Index_t> seenPoints;
 
     for (/**/; iter != endIter; ++iter)
     {
@@ -221,11 +297,11 @@ TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_points_should_go_thr
     EXPECT_EQ(seenPoints.size(), 3);
 }
 
-TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_split_points_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_iterating_over_split_points_should_go_through_all)
 {
-    auto iter = m_topology.SplitPointsBegin();
-    auto endIter = m_topology.SplitPointsEnd();
-    std::unordered_set<SplitPointTopology::Index_t> seenSplitPoints;
+    auto iter = this->m_topology.SplitPointsBegin();
+    auto endIter = this->m_topology.SplitPointsEnd();
+    std::unordered_set<typename TypeParam::Index_t> seenSplitPoints;
 
     for (/**/; iter != endIter; ++iter)
     {
@@ -235,11 +311,11 @@ TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_split_points_should_
     EXPECT_EQ(seenSplitPoints.size(), 3);
 }
 
-TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_edges_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_iterating_over_edges_should_go_through_all)
 {
-    auto iter = m_topology.EdgesBegin();
-    auto endIter = m_topology.EdgesEnd();
-    std::unordered_set<SplitPointTopology::Index_t> seenEdges;
+    auto iter = this->m_topology.EdgesBegin();
+    auto endIter = this->m_topology.EdgesEnd();
+    std::unordered_set<typename TypeParam::Index_t> seenEdges;
 
     for (/**/; iter != endIter; ++iter)
     {
@@ -249,12 +325,12 @@ TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_edges_should_go_thro
     EXPECT_EQ(seenEdges.size(), 3);
 }
 
-TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_faces_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_iterating_over_faces_should_go_through_all)
 {
-    m_topology.CreateFace();
-    auto iter = m_topology.FacesBegin();
-    auto endIter = m_topology.FacesEnd();
-    std::unordered_set<SplitPointTopology::Index_t> seenFaces;
+    this->m_topology.CreateFace();
+    auto iter = this->m_topology.FacesBegin();
+    auto endIter = this->m_topology.FacesEnd();
+    std::unordered_set<typename TypeParam::Index_t> seenFaces;
 
     for (/**/; iter != endIter; ++iter)
     {
@@ -264,12 +340,12 @@ TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_faces_should_go_thro
     EXPECT_EQ(seenFaces.size(), 2);
 }
 
-TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_point_edges_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_iterating_over_point_edges_should_go_through_all)
 {
-    m_topology.CreateFace(m_topology.GetPoint(m_face.m_splitPoints[0]));
-    auto iter = m_topology.PointEdgesBegin(m_topology.GetPoint(m_face.m_splitPoints[0]));
-    auto endIter = m_topology.PointEdgesEnd(m_topology.GetPoint(m_face.m_splitPoints[0]));
-    std::unordered_set<SplitPointTopology::Index_t> seenEdges;
+    this->m_topology.CreateFace(this->m_topology.GetPoint(this->m_face.m_splitPoints[0]));
+    auto iter = this->m_topology.PointEdgesBegin(this->m_topology.GetPoint(this->m_face.m_splitPoints[0]));
+    auto endIter = this->m_topology.PointEdgesEnd(this->m_topology.GetPoint(this->m_face.m_splitPoints[0]));
+    std::unordered_set<typename TypeParam::Index_t> seenEdges;
 
     for (/**/; iter != endIter; ++iter)
     {
@@ -279,12 +355,12 @@ TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_point_edges_should_g
     EXPECT_EQ(seenEdges.size(), 2);
 }
 
-TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_point_split_points_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_iterating_over_point_split_points_should_go_through_all)
 {
-    m_topology.CreateFace(m_topology.GetPoint(m_face.m_splitPoints[0]));
-    auto iter = m_topology.PointSplitPointBegin(m_topology.GetPoint(m_face.m_splitPoints[0]));
-    auto endIter = m_topology.PointSplitPointEnd(m_topology.GetPoint(m_face.m_splitPoints[0]));
-    std::unordered_set<SplitPointTopology::Index_t> seenSplitPoints;
+    this->m_topology.CreateFace(this->m_topology.GetPoint(this->m_face.m_splitPoints[0]));
+    auto iter = this->m_topology.PointSplitPointBegin(this->m_topology.GetPoint(this->m_face.m_splitPoints[0]));
+    auto endIter = this->m_topology.PointSplitPointEnd(this->m_topology.GetPoint(this->m_face.m_splitPoints[0]));
+    std::unordered_set<typename TypeParam::Index_t> seenSplitPoints;
 
     for (/**/; iter != endIter; ++iter)
     {
@@ -294,12 +370,12 @@ TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_point_split_points_s
     EXPECT_EQ(seenSplitPoints.size(), 2);
 }
 
-TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_point_faces_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_iterating_over_point_faces_should_go_through_all)
 {
-    m_topology.CreateFace(m_topology.GetPoint(m_face.m_splitPoints[0]));
-    auto iter = m_topology.PointFaceBegin(m_topology.GetPoint(m_face.m_splitPoints[0]));
-    auto endIter = m_topology.PointFaceEnd(m_topology.GetPoint(m_face.m_splitPoints[0]));
-    std::unordered_set<SplitPointTopology::Index_t> seenFaces;
+    this->m_topology.CreateFace(this->m_topology.GetPoint(this->m_face.m_splitPoints[0]));
+    auto iter = this->m_topology.PointFaceBegin(this->m_topology.GetPoint(this->m_face.m_splitPoints[0]));
+    auto endIter = this->m_topology.PointFaceEnd(this->m_topology.GetPoint(this->m_face.m_splitPoints[0]));
+    std::unordered_set<typename TypeParam::Index_t> seenFaces;
 
     for (/**/; iter != endIter; ++iter)
     {
@@ -309,10 +385,10 @@ TEST_F(SplitPointTopologyIteratorsTest, when_iterating_over_point_faces_should_g
     EXPECT_EQ(seenFaces.size(), 2);
 }
 
-TEST_F(SplitPointTopologyIteratorsTest, when_circulating_over_face_edges_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_circulating_over_face_edges_should_go_through_all)
 {
-    auto iter = m_topology.FaceEdgeCirculatorBegin(m_face.m_face);
-    std::unordered_set<SplitPointTopology::Index_t> seenEdges;
+    auto iter = this->m_topology.FaceEdgeCirculatorBegin(this->m_face.m_face);
+    std::unordered_set<typename TypeParam::Index_t> seenEdges;
 
     while (iter)
     {
@@ -323,10 +399,10 @@ TEST_F(SplitPointTopologyIteratorsTest, when_circulating_over_face_edges_should_
     EXPECT_EQ(seenEdges.size(), 3);
 }
 
-TEST_F(SplitPointTopologyIteratorsTest, when_circulating_over_face_split_points_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_circulating_over_face_split_points_should_go_through_all)
 {
-    auto iter = m_topology.FaceSplitPointCirculatorBegin(m_face.m_face);
-    std::unordered_set<SplitPointTopology::Index_t> seenSplitPoints;
+    auto iter = this->m_topology.FaceSplitPointCirculatorBegin(this->m_face.m_face);
+    std::unordered_set<typename TypeParam::Index_t> seenSplitPoints;
 
     while (iter)
     {
@@ -337,10 +413,10 @@ TEST_F(SplitPointTopologyIteratorsTest, when_circulating_over_face_split_points_
     EXPECT_EQ(seenSplitPoints.size(), 3);
 }
 
-TEST_F(SplitPointTopologyIteratorsTest, when_circulating_over_face_points_should_go_through_all)
+TYPED_TEST(SplitPointTopologyIteratorsTest, when_circulating_over_face_points_should_go_through_all)
 {
-    auto iter = m_topology.FacePointCirculatorBegin(m_face.m_face);
-    std::unordered_set<SplitPointTopology::Index_t> seenPoints;
+    auto iter = this->m_topology.FacePointCirculatorBegin(this->m_face.m_face);
+    std::unordered_set<typename TypeParam::Index_t> seenPoints;
 
     while (iter)
     {
@@ -351,6 +427,7 @@ TEST_F(SplitPointTopologyIteratorsTest, when_circulating_over_face_points_should
     EXPECT_EQ(seenPoints.size(), 3);
 }
 
+template<class Topology>
 class SplitPointTopologySplitEdgeTest : public PagodaTestFixture<::testing::Test>
 {
 protected:
@@ -358,23 +435,25 @@ protected:
 
 	void TearDown() {}
 
-	SplitPointTopology m_topology;
+	Topology m_topology;
 };
+TYPED_TEST_SUITE(SplitPointTopologySplitEdgeTest, Topologies);
 
-TEST_F(SplitPointTopologySplitEdgeTest, when_splitting_an_edge_should_create_a_new_split_point_in_the_same_face)
+TYPED_TEST(SplitPointTopologySplitEdgeTest, when_splitting_an_edge_should_create_a_new_split_point_in_the_same_face)
 {
-	auto face = m_topology.CreateFace();
-	auto edge = m_topology.GetEdge(face.m_face);
-	SplitPointTopology::SplitPointHandle s = m_topology.SplitEdge(edge);
-	EXPECT_EQ(m_topology.GetFace(s), face.m_face);
-	EXPECT_TRUE(m_topology.IsValid());
+	auto face = this->m_topology.CreateFace();
+	auto edge = this->m_topology.GetEdge(face.m_face);
+	typename TypeParam::SplitPointHandle s = this->m_topology.SplitEdge(edge);
+	EXPECT_EQ(this->m_topology.GetFace(s), face.m_face);
+	EXPECT_TRUE(this->m_topology.IsValid());
 
     std::stringstream ss;
-    m_topology.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_topology.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
+template<class Topology>
 class SplitPointTopologyCollapseEdgeTest : public PagodaTestFixture<::testing::Test>
 {
 protected:
@@ -386,24 +465,26 @@ protected:
 
 	void TearDown() {}
 
-	SplitPointTopology m_triangle;
-	SplitPointTopology::CreateFaceResult m_face;
+	Topology m_triangle;
+	typename Topology::CreateFaceResult m_face;
 };
+TYPED_TEST_SUITE(SplitPointTopologyCollapseEdgeTest, Topologies);
 
-TEST_F(SplitPointTopologyCollapseEdgeTest, when_collapsing_an_edge_should_remove_the_destination_split_point)
+TYPED_TEST(SplitPointTopologyCollapseEdgeTest, when_collapsing_an_edge_should_remove_the_destination_split_point)
 {
-	auto edgeToCollapse = m_triangle.GetEdge(m_face.m_face);
-	m_triangle.CollapseEdge(edgeToCollapse);
-	EXPECT_TRUE(m_triangle.IsValid());
+	auto edgeToCollapse = this->m_triangle.GetEdge(this->m_face.m_face);
+	this->m_triangle.CollapseEdge(edgeToCollapse);
+	EXPECT_TRUE(this->m_triangle.IsValid());
 
     std::stringstream ss;
-    m_triangle.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_triangle.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyCollapseEdgeTest, when_face_is_a_triangle_should_not_allow_collapsing) {}
+TYPED_TEST(SplitPointTopologyCollapseEdgeTest, when_face_is_a_triangle_should_not_allow_collapsing) {}
 
+template<class Topology>
 class SplitPointTopologyDeleteTest : public PagodaTestFixture<::testing::Test>
 {
 protected:
@@ -414,134 +495,136 @@ protected:
 
 	void TearDown() {}
 
-	SplitPointTopology m_triangle;
-	SplitPointTopology::CreateFaceResult m_face;
+	Topology m_triangle;
+	typename Topology::CreateFaceResult m_face;
 };
+TYPED_TEST_SUITE(SplitPointTopologyDeleteTest, Topologies);
 
-TEST_F(SplitPointTopologyDeleteTest, when_deleting_a_face_should_cascade)
+TYPED_TEST(SplitPointTopologyDeleteTest, when_deleting_a_face_should_cascade)
 {
-    m_triangle.DeleteFace(m_face.m_face);
-    EXPECT_EQ(m_triangle.GetFaceCount(), 0);
-    EXPECT_EQ(m_triangle.GetPointCount(), 0);
-    EXPECT_EQ(m_triangle.GetSplitPointCount(), 0);
-    EXPECT_EQ(m_triangle.GetEdgeCount(), 0);
-    EXPECT_TRUE(m_triangle.IsValid());
+    this->m_triangle.DeleteFace(this->m_face.m_face);
+    EXPECT_EQ(this->m_triangle.GetFaceCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetPointCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetSplitPointCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetEdgeCount(), 0);
+    EXPECT_TRUE(this->m_triangle.IsValid());
 
     std::stringstream ss;
-    m_triangle.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_triangle.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyDeleteTest, when_deleting_a_face_should_not_affect_adjacent_faces)
+TYPED_TEST(SplitPointTopologyDeleteTest, when_deleting_a_face_should_not_affect_adjacent_faces)
 {
-    m_triangle.CreateFace(m_triangle.GetPoint(m_face.m_splitPoints[0]), m_triangle.GetPoint(m_face.m_splitPoints[1]));
-    m_triangle.DeleteFace(m_face.m_face);
-    EXPECT_EQ(m_triangle.GetFaceCount(), 1);
-    EXPECT_EQ(m_triangle.GetPointCount(), 3);
-    EXPECT_EQ(m_triangle.GetSplitPointCount(), 3);
-    EXPECT_EQ(m_triangle.GetEdgeCount(), 3);
-    EXPECT_TRUE(m_triangle.IsValid());
+    this->m_triangle.CreateFace(this->m_triangle.GetPoint(this->m_face.m_splitPoints[0]), this->m_triangle.GetPoint(this->m_face.m_splitPoints[1]));
+    this->m_triangle.DeleteFace(this->m_face.m_face);
+    EXPECT_EQ(this->m_triangle.GetFaceCount(), 1);
+    EXPECT_EQ(this->m_triangle.GetPointCount(), 3);
+    EXPECT_EQ(this->m_triangle.GetSplitPointCount(), 3);
+    EXPECT_EQ(this->m_triangle.GetEdgeCount(), 3);
+    EXPECT_TRUE(this->m_triangle.IsValid());
 
     std::stringstream ss;
-    m_triangle.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_triangle.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyDeleteTest, when_deleting_a_point_should_cascade)
+TYPED_TEST(SplitPointTopologyDeleteTest, when_deleting_a_point_should_cascade)
 {
-    m_triangle.DeletePoint(m_triangle.GetPoint(m_face.m_splitPoints[0]));
-    EXPECT_EQ(m_triangle.GetFaceCount(), 0);
-    EXPECT_EQ(m_triangle.GetPointCount(), 0);
-    EXPECT_EQ(m_triangle.GetSplitPointCount(), 0);
-    EXPECT_EQ(m_triangle.GetEdgeCount(), 0);
-    EXPECT_TRUE(m_triangle.IsValid());
+    this->m_triangle.DeletePoint(this->m_triangle.GetPoint(this->m_face.m_splitPoints[0]));
+    EXPECT_EQ(this->m_triangle.GetFaceCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetPointCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetSplitPointCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetEdgeCount(), 0);
+    EXPECT_TRUE(this->m_triangle.IsValid());
 
     std::stringstream ss;
-    m_triangle.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_triangle.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyDeleteTest, when_deleting_a_point_should_not_affect_unrelated_faces)
+TYPED_TEST(SplitPointTopologyDeleteTest, when_deleting_a_point_should_not_affect_unrelated_faces)
 {
-    m_triangle.CreateFace(m_triangle.GetPoint(m_face.m_splitPoints[0]), m_triangle.GetPoint(m_face.m_splitPoints[1]));
-    m_triangle.DeletePoint(m_triangle.GetPoint(m_face.m_splitPoints[2]));
-    EXPECT_EQ(m_triangle.GetFaceCount(), 1);
-    EXPECT_EQ(m_triangle.GetPointCount(), 3);
-    EXPECT_EQ(m_triangle.GetSplitPointCount(), 3);
-    EXPECT_EQ(m_triangle.GetEdgeCount(), 3);
-    EXPECT_TRUE(m_triangle.IsValid());
+    this->m_triangle.CreateFace(this->m_triangle.GetPoint(this->m_face.m_splitPoints[0]), this->m_triangle.GetPoint(this->m_face.m_splitPoints[1]));
+    this->m_triangle.DeletePoint(this->m_triangle.GetPoint(this->m_face.m_splitPoints[2]));
+    EXPECT_EQ(this->m_triangle.GetFaceCount(), 1);
+    EXPECT_EQ(this->m_triangle.GetPointCount(), 3);
+    EXPECT_EQ(this->m_triangle.GetSplitPointCount(), 3);
+    EXPECT_EQ(this->m_triangle.GetEdgeCount(), 3);
+    EXPECT_TRUE(this->m_triangle.IsValid());
 
     std::stringstream ss;
-    m_triangle.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_triangle.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyDeleteTest, when_deleting_a_split_point_should_cascade)
+TYPED_TEST(SplitPointTopologyDeleteTest, when_deleting_a_split_point_should_cascade)
 {
-    m_triangle.DeleteSplitPoint(m_triangle.GetSplitPoint(m_face.m_face));
-    EXPECT_EQ(m_triangle.GetFaceCount(), 0);
-    EXPECT_EQ(m_triangle.GetPointCount(), 0);
-    EXPECT_EQ(m_triangle.GetSplitPointCount(), 0);
-    EXPECT_EQ(m_triangle.GetEdgeCount(), 0);
-    EXPECT_TRUE(m_triangle.IsValid());
+    this->m_triangle.DeleteSplitPoint(this->m_triangle.GetSplitPoint(this->m_face.m_face));
+    EXPECT_EQ(this->m_triangle.GetFaceCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetPointCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetSplitPointCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetEdgeCount(), 0);
+    EXPECT_TRUE(this->m_triangle.IsValid());
 
     std::stringstream ss;
-    m_triangle.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_triangle.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyDeleteTest, when_deleting_a_split_point_should_not_affect_unrelated_faces)
+TYPED_TEST(SplitPointTopologyDeleteTest, when_deleting_a_split_point_should_not_affect_unrelated_faces)
 {
-    m_triangle.CreateFace(m_triangle.GetPoint(m_face.m_splitPoints[1]), m_triangle.GetPoint(m_face.m_splitPoints[2]));
-    m_triangle.DeleteSplitPoint(m_triangle.GetSplitPoint(m_face.m_face));
-    EXPECT_EQ(m_triangle.GetFaceCount(), 1);
-    EXPECT_EQ(m_triangle.GetPointCount(), 3);
-    EXPECT_EQ(m_triangle.GetSplitPointCount(), 3);
-    EXPECT_EQ(m_triangle.GetEdgeCount(), 3);
-    EXPECT_TRUE(m_triangle.IsValid());
+    this->m_triangle.CreateFace(this->m_triangle.GetPoint(this->m_face.m_splitPoints[1]), this->m_triangle.GetPoint(this->m_face.m_splitPoints[2]));
+    this->m_triangle.DeleteSplitPoint(this->m_triangle.GetSplitPoint(this->m_face.m_face));
+    EXPECT_EQ(this->m_triangle.GetFaceCount(), 1);
+    EXPECT_EQ(this->m_triangle.GetPointCount(), 3);
+    EXPECT_EQ(this->m_triangle.GetSplitPointCount(), 3);
+    EXPECT_EQ(this->m_triangle.GetEdgeCount(), 3);
+    EXPECT_TRUE(this->m_triangle.IsValid());
 
     std::stringstream ss;
-    m_triangle.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_triangle.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyDeleteTest, when_deleting_an_edge_should_cascade)
+TYPED_TEST(SplitPointTopologyDeleteTest, when_deleting_an_edge_should_cascade)
 {
-    m_triangle.DeleteEdge(m_triangle.GetEdge(m_face.m_face));
-    EXPECT_EQ(m_triangle.GetFaceCount(), 0);
-    EXPECT_EQ(m_triangle.GetPointCount(), 0);
-    EXPECT_EQ(m_triangle.GetSplitPointCount(), 0);
-    EXPECT_EQ(m_triangle.GetEdgeCount(), 0);
-    EXPECT_TRUE(m_triangle.IsValid());
+    this->m_triangle.DeleteEdge(this->m_triangle.GetEdge(this->m_face.m_face));
+    EXPECT_EQ(this->m_triangle.GetFaceCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetPointCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetSplitPointCount(), 0);
+    EXPECT_EQ(this->m_triangle.GetEdgeCount(), 0);
+    EXPECT_TRUE(this->m_triangle.IsValid());
 
     std::stringstream ss;
-    m_triangle.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_triangle.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
-TEST_F(SplitPointTopologyDeleteTest, when_deleting_an_edge_should_not_affect_unrelated_faces)
+TYPED_TEST(SplitPointTopologyDeleteTest, when_deleting_an_edge_should_not_affect_unrelated_faces)
 {
-    m_triangle.CreateFace(m_triangle.GetPoint(m_face.m_splitPoints[1]), m_triangle.GetPoint(m_face.m_splitPoints[2]));
-    m_triangle.DeleteEdge(m_triangle.GetEdge(m_face.m_face));
-    EXPECT_EQ(m_triangle.GetFaceCount(), 1);
-    EXPECT_EQ(m_triangle.GetPointCount(), 3);
-    EXPECT_EQ(m_triangle.GetSplitPointCount(), 3);
-    EXPECT_EQ(m_triangle.GetEdgeCount(), 3);
-    EXPECT_TRUE(m_triangle.IsValid());
+    this->m_triangle.CreateFace(this->m_triangle.GetPoint(this->m_face.m_splitPoints[1]), this->m_triangle.GetPoint(this->m_face.m_splitPoints[2]));
+    this->m_triangle.DeleteEdge(this->m_triangle.GetEdge(this->m_face.m_face));
+    EXPECT_EQ(this->m_triangle.GetFaceCount(), 1);
+    EXPECT_EQ(this->m_triangle.GetPointCount(), 3);
+    EXPECT_EQ(this->m_triangle.GetSplitPointCount(), 3);
+    EXPECT_EQ(this->m_triangle.GetEdgeCount(), 3);
+    EXPECT_TRUE(this->m_triangle.IsValid());
 
     std::stringstream ss;
-    m_triangle.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_triangle.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
 
+template<class Topology>
 class SplitPointTopologySplitFaceTest : public PagodaTestFixture<::testing::Test>
 {
 protected:
@@ -553,25 +636,78 @@ protected:
 
 	void TearDown() {}
 
-	SplitPointTopology m_topology;
-    SplitPointTopology::CreateFaceResult m_face;
+	Topology m_topology;
+    typename Topology::CreateFaceResult m_face;
 };
+TYPED_TEST_SUITE(SplitPointTopologySplitFaceTest, Topologies);
 
-TEST_F(SplitPointTopologySplitFaceTest, when_splitting_a_face_should_create_two_edges_between_the_points)
+TYPED_TEST(SplitPointTopologySplitFaceTest, when_splitting_a_face_should_create_two_edges_between_the_points)
 {
-    auto e0 = m_topology.GetEdge(m_face.m_face);
-    auto e1 = m_topology.GetNextEdge(e0);
+    auto e0 = this->m_topology.GetEdge(this->m_face.m_face);
+    auto e1 = this->m_topology.GetNextEdge(e0);
 
-    m_topology.SplitFace(m_face.m_face, e0, e1);
+    this->m_topology.SplitFace(this->m_face.m_face, e0, e1);
 
-    ASSERT_TRUE(m_topology.IsValid());
-    EXPECT_EQ(m_topology.GetFaceCount(), 2);
-    EXPECT_EQ(m_topology.GetPointCount(), 4);
-    EXPECT_EQ(m_topology.GetSplitPointCount(), 6);
-    EXPECT_EQ(m_topology.GetEdgeCount(), 6);
+    ASSERT_TRUE(this->m_topology.IsValid());
+    EXPECT_EQ(this->m_topology.GetFaceCount(), 2);
+    EXPECT_EQ(this->m_topology.GetPointCount(), 4);
+    EXPECT_EQ(this->m_topology.GetSplitPointCount(), 6);
+    EXPECT_EQ(this->m_topology.GetEdgeCount(), 6);
 
     std::stringstream ss;
-    m_topology.DumpToStream(ss);
-    MatchFile match(GetCurrentTestFileResultsDirectory() /= "topology.txt", GetShouldWriteFiles());
+    this->m_topology.DumpToStream(ss);
+    MatchFile match(this->GetCurrentTestFileResultsDirectory() /= "topology.txt", this->GetShouldWriteFiles());
     match.Match(ss.str());
 }
+
+template<class Topology>
+class SplitPointTopologyCompactTest : public PagodaTestFixture<::testing::Test>
+{
+protected:
+	void SetUp()
+	{
+		for (auto i = 0u; i < 3; ++i)
+		{
+			m_faces.push_back(m_topology.CreateFace().m_face);
+		}
+	}
+
+	void TearDown() {}
+
+	Topology m_topology;
+	std::vector<typename Topology::FaceHandle> m_faces;
+};
+TYPED_TEST_SUITE(SplitPointTopologyCompactTest, Topologies);
+
+TYPED_TEST(SplitPointTopologyCompactTest, when_compacting_should_renumber_the_remaining_elements)
+{
+	this->m_topology.DeleteFace(this->m_faces[1]);
+	auto result = this->m_topology.Compact();
+
+	ASSERT_TRUE(this->m_topology.IsValid());
+	EXPECT_EQ(this->m_topology.GetFaceCount(), 2);
+	EXPECT_EQ(this->m_topology.GetPointCount(), 6);
+	EXPECT_EQ(result.m_faces, (std::vector<typename TypeParam::Index_t>{0, TypeParam::s_invalidIndex, 1}));
+	EXPECT_EQ(result.m_points[3], TypeParam::s_invalidIndex);
+	EXPECT_EQ(result.m_points[6], 3);
+
+	std::vector<typename TypeParam::Index_t> points;
+	for (auto p = this->m_topology.PointsBegin(); p != this->m_topology.PointsEnd(); ++p)
+	{
+		points.push_back((*p).GetIndex());
+	}
+	EXPECT_EQ(points, (std::vector<typename TypeParam::Index_t>{0, 1, 2, 3, 4, 5}));
+}
+
+TYPED_TEST(SplitPointTopologyCompactTest, when_compacting_should_keep_the_faces_connectivity)
+{
+	auto shared = this->m_topology.GetPoint(this->m_topology.GetSplitPoint(this->m_faces[2]));
+	auto newFace = this->m_topology.CreateFace(shared).m_face;
+	this->m_topology.DeleteFace(this->m_faces[0]);
+	auto result = this->m_topology.Compact();
+
+	ASSERT_TRUE(this->m_topology.IsValid());
+	auto remappedPoint = result.m_points[shared];
+	EXPECT_EQ(this->m_topology.GetFaces(remappedPoint),
+	          (typename TypeParam::FaceHandleSet{result.m_faces[this->m_faces[2]], result.m_faces[newFace]}));
+}
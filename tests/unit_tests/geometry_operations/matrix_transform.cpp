@@ -0,0 +1,90 @@
+#include <geometry_core/geometry.h>
+#include <geometry_operations/create_box.h>
+#include <geometry_operations/matrix_transform.h>
+#include <math_lib/matrix_base.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/qvm/map_vec_mat.hpp>
+#include <boost/qvm/mat_operations.hpp>
+
+using namespace pagoda;
+
+using GeometryType = GeometryBase<SplitPointTopology, DefaultFaceAttributes, DefaultEdgeAttributes,
+                                  DefaultVertexAttributes, DenseAttributeStorage>;
+using GeometryPtr = std::shared_ptr<GeometryType>;
+
+class MatrixTransformTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		m_geometry = std::make_shared<GeometryType>();
+		CreateBox<GeometryType>(2, 4, 6).Execute(m_geometry);
+	}
+
+	/**
+	 * Returns the positions of the points of \p geometry after transforming them with the homogeneous divide.
+	 */
+	std::vector<Vec3F> ProjectPoints(GeometryPtr geometry, const Mat4x4F &matrix)
+	{
+		std::vector<Vec3F> positions;
+		for (auto p = geometry->PointsBegin(); p != geometry->PointsEnd(); ++p)
+		{
+			Vec4F position = matrix * XYZ1(geometry->GetPosition(*p));
+			positions.push_back(XYZ(position) / W(position));
+		}
+		return positions;
+	}
+
+	std::vector<Vec3F> GetPositions(GeometryPtr geometry)
+	{
+		std::vector<Vec3F> positions;
+		for (auto p = geometry->PointsBegin(); p != geometry->PointsEnd(); ++p)
+		{
+			positions.push_back(geometry->GetPosition(*p));
+		}
+		return positions;
+	}
+
+	GeometryPtr m_geometry;
+};
+
+TEST_F(MatrixTransformTest, when_transforming_with_an_affine_matrix_should_match_the_homogeneous_transformation)
+{
+	Mat4x4F matrix = boost::qvm::translation_mat(Vec3F{1, -2, 3}) * boost::qvm::rotz_mat<4>(0.3f) *
+	                 boost::qvm::diag_mat(Vec4F{2, 3, 4, 1});
+	auto expected = ProjectPoints(m_geometry, matrix);
+
+	auto out = std::make_shared<GeometryType>();
+	MatrixTransform<GeometryType>(matrix).Execute(m_geometry, out);
+
+	EXPECT_EQ(GetPositions(out), expected);
+}
+
+TEST_F(MatrixTransformTest, when_transforming_with_a_projective_matrix_should_divide_by_w)
+{
+	Mat4x4F matrix(boost::qvm::diag_mat(Vec4F{1, 1, 1, 1}));
+	matrix.a[3][2] = 0.5f;
+	matrix.a[3][3] = 10.0f;
+	auto expected = ProjectPoints(m_geometry, matrix);
+
+	auto out = std::make_shared<GeometryType>();
+	MatrixTransform<GeometryType>(matrix).Execute(m_geometry, out);
+
+	EXPECT_EQ(GetPositions(out), expected);
+}
+
+TEST_F(MatrixTransformTest, when_transforming_in_place_should_only_change_the_positions)
+{
+	const auto faceCount = m_geometry->GetFaceCount();
+	const auto pointCount = m_geometry->GetPointCount();
+	Mat4x4F matrix = boost::qvm::translation_mat(Vec3F{5, 0, 0});
+	auto expected = ProjectPoints(m_geometry, matrix);
+
+	MatrixTransform<GeometryType>(matrix).Execute(m_geometry);
+
+	EXPECT_EQ(GetPositions(m_geometry), expected);
+	EXPECT_EQ(m_geometry->GetFaceCount(), faceCount);
+	EXPECT_EQ(m_geometry->GetPointCount(), pointCount);
+}
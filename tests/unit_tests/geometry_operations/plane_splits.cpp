@@ -0,0 +1,173 @@
+#include <geometry_core/geometry.h>
+#include <geometry_operations/create_box.h>
+#include <geometry_operations/create_sphere.h>
+#include <geometry_operations/plane_splits.h>
+#include <math_lib/vec_base.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <sstream>
+
+using namespace pagoda;
+
+using GeometryType = GeometryBase<>;
+using GeometryPtr = std::shared_ptr<GeometryType>;
+
+namespace
+{
+/*
+ * Clips the geometry with each plane in turn, which PlaneSplits must be equivalent to.
+ */
+std::vector<GeometryPtr> ClipInTurn(GeometryPtr geometry, const std::vector<Plane<float>> &planes)
+{
+	std::vector<GeometryPtr> out;
+	auto current = std::make_shared<GeometryType>();
+	*current = *geometry;
+	for (const auto &plane : planes)
+	{
+		auto front = std::make_shared<GeometryType>();
+		auto back = std::make_shared<GeometryType>();
+		Clip<GeometryType>(plane).Execute(current, front, back);
+		if (front->GetFaceCount() > 0)
+		{
+			out.push_back(front);
+		}
+		current = back;
+	}
+	if (current->GetFaceCount() > 0)
+	{
+		out.push_back(current);
+	}
+	return out;
+}
+
+/*
+ * Describes the points, split points, edges and faces of the geometry with their indices and attributes.
+ * The indices are compacted first, as the geometries may have holes left by different deleted faces.
+ */
+std::string Describe(GeometryPtr geometryIn)
+{
+	auto geometry = std::make_shared<GeometryType>(*geometryIn);
+	geometry->Compact();
+
+	std::stringstream ss;
+	for (auto p = geometry->PointsBegin(); p != geometry->PointsEnd(); ++p)
+	{
+		ss << "p " << *p << " " << to_string(geometry->GetPosition(*p)) << " "
+		   << to_string(geometry->GetVertexAttributes(*p).m_normal) << "\n";
+	}
+	for (auto s = geometry->SplitPointsBegin(); s != geometry->SplitPointsEnd(); ++s)
+	{
+		ss << "s " << *s << " " << geometry->GetPoint(*s) << " " << geometry->GetFace(*s) << "\n";
+	}
+	for (auto e = geometry->EdgesBegin(); e != geometry->EdgesEnd(); ++e)
+	{
+		ss << "e " << *e << " " << geometry->GetSource(*e) << " " << geometry->GetDestination(*e) << "\n";
+	}
+	for (auto f = geometry->FacesBegin(); f != geometry->FacesEnd(); ++f)
+	{
+		ss << "f " << *f << " " << to_string(geometry->GetFaceAttributes(*f).m_normal);
+		for (auto fp = geometry->FacePointCirculatorBegin(*f); fp; ++fp)
+		{
+			ss << " " << *fp;
+		}
+		ss << "\n";
+	}
+	return ss.str();
+}
+
+void ExpectSameAsClipInTurn(GeometryPtr geometry, const std::vector<Plane<float>> &planes)
+{
+	const auto expected = ClipInTurn(geometry, planes);
+	std::vector<GeometryPtr> result;
+	PlaneSplits<GeometryType>(planes).Execute(geometry, result);
+
+	ASSERT_EQ(result.size(), expected.size());
+	for (auto i = 0u; i < result.size(); ++i)
+	{
+		EXPECT_EQ(Describe(result[i]), Describe(expected[i])) << "Geometry " << i;
+	}
+}
+
+std::vector<Plane<float>> ParallelPlanes(const Vec3F &normal, float start, float step, uint32_t count)
+{
+	std::vector<Plane<float>> planes;
+	for (auto i = 0u; i < count; ++i)
+	{
+		planes.push_back(Plane<float>::FromPointAndNormal(normal * (start + step * i), normal));
+	}
+	return planes;
+}
+
+GeometryPtr CreateSphereGeometry()
+{
+	auto geometry = std::make_shared<GeometryType>();
+	CreateSphere<GeometryType>(1, 16, 12).Execute(geometry);
+	return geometry;
+}
+}  // namespace
+
+TEST(PlaneSplitsTest, when_splitting_with_parallel_planes_should_match_clipping_in_turn)
+{
+	ExpectSameAsClipInTurn(CreateSphereGeometry(), ParallelPlanes(Vec3F{0, -1, 0}, 0.9f, -0.1f, 19));
+}
+
+TEST(PlaneSplitsTest, when_planes_go_through_points_should_match_clipping_in_turn)
+{
+	auto box = std::make_shared<GeometryType>();
+	CreateBox<GeometryType>(2, 2, 2).Execute(box);
+
+	ExpectSameAsClipInTurn(box, ParallelPlanes(Vec3F{-1, 0, 0}, 1.0f, 0.5f, 5));
+	ExpectSameAsClipInTurn(box, ParallelPlanes(Vec3F{0, 0, 1}, -1.0f, 0.5f, 5));
+}
+
+TEST(PlaneSplitsTest, when_splitting_with_planes_in_any_direction_should_match_clipping_in_turn)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(-1, 1);
+	auto sphere = CreateSphereGeometry();
+	for (auto i = 0u; i < 6; ++i)
+	{
+		std::vector<Plane<float>> planes;
+		for (auto p = 0u; p < 8; ++p)
+		{
+			const Vec3F point{distribution(generator), distribution(generator), distribution(generator)};
+			const Vec3F normal{distribution(generator), distribution(generator), distribution(generator)};
+			planes.push_back(Plane<float>::FromPointAndNormal(point * 0.5f, normal));
+		}
+		ExpectSameAsClipInTurn(sphere, planes);
+	}
+}
+
+TEST(PlaneSplitsTest, when_splitting_split_geometries_should_match_clipping_in_turn)
+{
+	std::vector<GeometryPtr> slices;
+	PlaneSplits<GeometryType>(ParallelPlanes(Vec3F{-1, 0, 0}, -0.5f, 0.25f, 5)).Execute(CreateSphereGeometry(), slices);
+
+	for (const auto &slice : slices)
+	{
+		ExpectSameAsClipInTurn(slice, ParallelPlanes(Vec3F{0, 0, -1}, -0.8f, 0.2f, 9));
+	}
+}
+
+TEST(PlaneSplitsTest, when_splitting_should_not_leave_holes_in_the_split_geometries)
+{
+	std::vector<GeometryPtr> slices;
+	PlaneSplits<GeometryType>(ParallelPlanes(Vec3F{0, -1, 0}, 0.9f, -0.1f, 19)).Execute(CreateSphereGeometry(), slices);
+
+	for (const auto &slice : slices)
+	{
+		uint32_t expectedIndex = 0;
+		for (auto f = slice->FacesBegin(); f != slice->FacesEnd(); ++f)
+		{
+			EXPECT_EQ((*f).GetIndex(), expectedIndex++);
+		}
+		expectedIndex = 0;
+		for (auto e = slice->EdgesBegin(); e != slice->EdgesEnd(); ++e)
+		{
+			EXPECT_EQ((*e).GetIndex(), expectedIndex++);
+		}
+	}
+}
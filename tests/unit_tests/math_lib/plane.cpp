@@ -3,6 +3,8 @@
 
 #include <boost/qvm/vec_operations.hpp>
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using namespace pagoda;
@@ -67,3 +69,28 @@ TEST(Plane, when_a_getting_the_side_of_the_plane_a_point_is_in_should_return_the
 	EXPECT_EQ(plane.GetPlaneSide((Vec3F{0, 0, 0})), Plane<float>::PlaneSide::Contained);
 	EXPECT_EQ(plane.GetPlaneSide((Vec3F{-1, 0, 0})), Plane<float>::PlaneSide::Back);
 }
+
+TEST(Plane, when_getting_the_sides_of_many_points_should_return_the_same_as_for_each_point)
+{
+	Plane<float> plane = Plane<float>::FromPointAndNormal(Vec3F{0, 0, 0.5f}, Vec3F{0.3f, 0.2f, 1});
+	std::vector<float> x, y, z;
+	for (auto i = 0; i < 37; ++i)
+	{
+		x.push_back(0.1f * i - 2);
+		y.push_back(0.3f * (i % 5) - 0.5f);
+		z.push_back(i % 3 == 0 ? 0.5f : 0.07f * i - 1);
+	}
+	const auto point = plane.GetPoint();
+	x.push_back(X(point));
+	y.push_back(Y(point));
+	z.push_back(Z(point));
+
+	std::vector<Plane<float>::PlaneSide> sides(x.size());
+	plane.GetPlaneSides(x.data(), y.data(), z.data(), x.size(), sides.data());
+
+	for (auto i = 0u; i < x.size(); ++i)
+	{
+		EXPECT_EQ(sides[i], plane.GetPlaneSide(Vec3F{x[i], y[i], z[i]})) << i;
+	}
+	EXPECT_EQ(sides.back(), Plane<float>::PlaneSide::Contained);
+}
@@ -1,8 +1,12 @@
 #include <dynamic_value/expression.h>
 #include <dynamic_value/get_value_as.h>
+#include <dynamic_value/integer_value.h>
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+
 using namespace pagoda;
 
 class ExpressionTest : public ::testing::Test
@@ -95,3 +99,49 @@ TEST_F(ExpressionTest, when_setting_an_expression_as_dirty_should_propagate_to_d
 	ASSERT_TRUE(expression->IsDirty());
 	ASSERT_TRUE(expression2->IsDirty());
 }
+
+TEST_F(ExpressionTest, when_evaluating_the_same_expressions_from_multiple_threads_should_evaluate_all_of_them)
+{
+	// Assigning to a variable can only be interpreted, the other expressions are compiled to bytecode
+	auto offset = Expression::CreateExpression("var x = 1; x + 0.5;");
+	auto compiled = Expression::CreateExpression("a * 2 + b;");
+	compiled->SetVariableValue("a", std::make_shared<Integer>(3));
+	compiled->SetVariableValue("b", offset);
+	auto interpreted = Expression::CreateExpression("a = a * 2; a;");
+	interpreted->SetVariableValue("a", std::make_shared<Integer>(4));
+
+	std::atomic<uint32_t> wrongValues{0};
+	std::atomic<uint32_t> exceptions{0};
+	std::vector<std::thread> threads;
+	for (auto t = 0u; t < 8; ++t)
+	{
+		threads.emplace_back([&, t]() {
+			for (auto i = 0u; i < 200; ++i)
+			{
+				try
+				{
+					if ((i + t) % 3 == 0)
+					{
+						offset->SetDirty();
+						interpreted->SetDirty();
+					}
+					if (get_value_as<float>(*compiled) != 7.5f || get_value_as<int>(*interpreted) != 8)
+					{
+						++wrongValues;
+					}
+				}
+				catch (...)
+				{
+					++exceptions;
+				}
+			}
+		});
+	}
+	for (auto &t : threads)
+	{
+		t.join();
+	}
+
+	EXPECT_EQ(wrongValues.load(), 0u);
+	EXPECT_EQ(exceptions.load(), 0u);
+}
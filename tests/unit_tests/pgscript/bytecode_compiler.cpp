@@ -0,0 +1,142 @@
+#include <pgscript/interpreter/bytecode_compiler.h>
+#include <pgscript/interpreter/bytecode_serializer.h>
+#include <pgscript/interpreter/interpreter.h>
+#include <pgscript/interpreter/virtual_machine.h>
+#include <pgscript/parser/parser.h>
+
+#include <common/binary_stream.h>
+#include <common/exception.h>
+
+#include <dynamic_value/dynamic_value_table.h>
+#include <dynamic_value/float_value.h>
+#include <dynamic_value/get_value_as.h>
+#include <dynamic_value/integer_value.h>
+#include <dynamic_value/string_value.h>
+
+#include <gtest/gtest.h>
+
+using namespace pagoda;
+
+class BytecodeCompilerTest : public ::testing::Test
+{
+protected:
+	BytecodeProgramPtr Compile(const std::string &code, const std::vector<std::string> &externals = {})
+	{
+		return BytecodeCompiler::Compile(Parser().Parse(code), externals);
+	}
+
+	bool HasOpCode(const BytecodeProgram &program, OpCode opCode)
+	{
+		for (const auto &i : program.m_instructions)
+		{
+			if (i.m_opCode == opCode)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	VirtualMachine m_vm;
+	std::shared_ptr<DynamicValueTable> m_globals = std::make_shared<DynamicValueTable>("globals");
+};
+
+TEST_F(BytecodeCompilerTest, when_compiling_operations_between_constants_should_fold_them)
+{
+	auto program = Compile("(1 + 2 * 2) / 2;");
+
+	ASSERT_NE(program, nullptr);
+	ASSERT_EQ(program->m_instructions.size(), 2u);
+	EXPECT_EQ(program->m_instructions[0].m_opCode, OpCode::PushConstant);
+	EXPECT_EQ(program->m_instructions[1].m_opCode, OpCode::Pop);
+	EXPECT_EQ(get_value_as<int>(*m_vm.Run(*program, {}, m_globals)), 2);
+}
+
+TEST_F(BytecodeCompilerTest, when_compiling_declared_variables_should_resolve_them_to_slots)
+{
+	auto program = Compile("var a = 1; { var a = 2.5; a = a * 2; } a + 1;");
+
+	ASSERT_NE(program, nullptr);
+	EXPECT_EQ(program->m_localCount, 2u);
+	EXPECT_FALSE(HasOpCode(*program, OpCode::LoadGlobal));
+	EXPECT_EQ(get_value_as<int>(*m_vm.Run(*program, {}, m_globals)), 2);
+}
+
+TEST_F(BytecodeCompilerTest, when_running_should_use_the_values_of_external_variables)
+{
+	auto program = Compile("index * 2 + offset;", {"index", "offset"});
+
+	ASSERT_NE(program, nullptr);
+	EXPECT_TRUE(HasOpCode(*program, OpCode::LoadExternal));
+	auto result = m_vm.Run(*program, {std::make_shared<Integer>(3), std::make_shared<FloatValue>(0.5f)}, m_globals);
+	EXPECT_EQ(get_value_as<float>(*result), 6.5f);
+}
+
+TEST_F(BytecodeCompilerTest, when_an_external_variable_has_no_value_should_look_it_up_in_the_globals)
+{
+	auto program = Compile("a + \"b\";", {"a"});
+	m_globals->Declare("a", std::make_shared<String>("a"));
+
+	EXPECT_EQ(get_value_as<std::string>(*m_vm.Run(*program, {nullptr}, m_globals)), "ab");
+}
+
+TEST_F(BytecodeCompilerTest, when_evaluating_logic_operators_should_short_circuit)
+{
+	// undefined_value would throw if it was evaluated
+	auto program = Compile("var a = false and undefined_value; var b = true or undefined_value; a == false and b;");
+
+	ASSERT_NE(program, nullptr);
+	EXPECT_TRUE(get_value_as<bool>(*m_vm.Run(*program, {}, m_globals)));
+}
+
+TEST_F(BytecodeCompilerTest, when_the_program_declares_functions_should_not_compile)
+{
+	EXPECT_EQ(Compile("function f() { return 1; }"), nullptr);
+}
+
+TEST_F(BytecodeCompilerTest, when_serializing_a_program_should_read_back_the_same_program)
+{
+	auto program = Compile("var s = \"a\" + name; if (n > 2.5 and true) { s = s + \"b\"; } s;", {"n"});
+	ASSERT_NE(program, nullptr);
+
+	std::string buffer;
+	BinaryWriter writer(buffer);
+	BytecodeSerializer::Write(*program, writer);
+	BinaryReader reader(buffer.data(), buffer.size());
+	auto read = BytecodeSerializer::Read(reader);
+
+	EXPECT_TRUE(reader.AtEnd());
+	ASSERT_EQ(read->m_instructions.size(), program->m_instructions.size());
+	EXPECT_EQ(read->m_constants.size(), program->m_constants.size());
+	EXPECT_EQ(read->m_names, program->m_names);
+	EXPECT_EQ(read->m_externals, program->m_externals);
+	EXPECT_EQ(read->m_localCount, program->m_localCount);
+	m_globals->Declare("name", std::make_shared<String>("c"));
+	EXPECT_EQ(get_value_as<std::string>(*m_vm.Run(*read, {std::make_shared<Integer>(3)}, m_globals)), "acb");
+}
+
+TEST_F(BytecodeCompilerTest, when_reading_a_truncated_program_should_throw)
+{
+	auto program = Compile("1 + a;", {"a"});
+	std::string buffer;
+	BinaryWriter writer(buffer);
+	BytecodeSerializer::Write(*program, writer);
+	buffer.pop_back();
+
+	BinaryReader reader(buffer.data(), buffer.size());
+	EXPECT_THROW(BytecodeSerializer::Read(reader), Exception);
+}
+
+TEST_F(BytecodeCompilerTest, when_interpreting_programs_should_keep_top_level_declarations_in_the_globals)
+{
+	auto interpretTwice = [](Interpreter::Engine engine) {
+		Interpreter interpreter;
+		interpreter.SetEngine(engine);
+		interpreter.Interpret(Parser().Parse("var a = 2; { var b = 3; a = a * b; }"));
+		interpreter.Interpret(Parser().Parse("a + 1;"));
+		return get_value_as<int>(*interpreter.GetLastEvaluatedExpression());
+	};
+
+	EXPECT_EQ(interpretTwice(Interpreter::Engine::Ast), 7);
+	EXPECT_EQ(interpretTwice(Interpreter::Engine::Bytecode), interpretTwice(Interpreter::Engine::Ast));
+}
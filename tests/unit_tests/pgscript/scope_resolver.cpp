@@ -0,0 +1,87 @@
+#include <pgscript/intermediate/ast.h>
+#include <pgscript/intermediate/get_expression.h>
+#include <pgscript/parser/parser.h>
+
+#include <gtest/gtest.h>
+
+using namespace pagoda;
+
+class ScopeResolverTest : public ::testing::Test
+{
+protected:
+	ast::ProgramPtr Parse(const std::string &code) { return Parser().Parse(code); }
+
+	template<class T>
+	std::shared_ptr<T> GetStatement(const std::vector<ast::StatementPtr> &statements, std::size_t index)
+	{
+		return std::dynamic_pointer_cast<T>(statements[index]);
+	}
+
+	ast::IdentifierPtr GetIdentifier(const ast::StatementPtr &statement)
+	{
+		auto e = std::dynamic_pointer_cast<ast::ExpressionStatement>(statement);
+		return std::dynamic_pointer_cast<ast::Identifier>(e->GetExpression());
+	}
+};
+
+TEST_F(ScopeResolverTest, when_parsing_identifiers_should_intern_them)
+{
+	auto program = Parse("a; b; a;");
+	const auto &statements = program->GetStatements();
+
+	EXPECT_EQ(GetIdentifier(statements[0])->GetSymbol(), GetIdentifier(statements[2])->GetSymbol());
+	EXPECT_NE(GetIdentifier(statements[0])->GetSymbol(), GetIdentifier(statements[1])->GetSymbol());
+	EXPECT_EQ(SymbolInterner::GetName(GetIdentifier(statements[1])->GetSymbol()), "b");
+}
+
+TEST_F(ScopeResolverTest, when_declaring_variables_in_the_program_should_not_resolve_them)
+{
+	auto program = Parse("var a = 1; a;");
+
+	EXPECT_FALSE(GetStatement<ast::VarDecl>(program->GetStatements(), 0)->GetIdentifier()->IsResolved());
+	EXPECT_FALSE(GetIdentifier(program->GetStatements()[1])->IsResolved());
+}
+
+TEST_F(ScopeResolverTest, when_declaring_variables_in_blocks_should_resolve_them_to_slots)
+{
+	auto program = Parse("{ var a = 1; var b = 2; { b; { var c; a; } } }");
+	auto outer = GetStatement<ast::StatementBlock>(program->GetStatements(), 0);
+	auto middle = GetStatement<ast::StatementBlock>(outer->GetStatements(), 2);
+	auto inner = GetStatement<ast::StatementBlock>(middle->GetStatements(), 1);
+
+	EXPECT_EQ(outer->GetSlotCount(), 2u);
+	EXPECT_EQ(middle->GetSlotCount(), 0u);
+	EXPECT_EQ(inner->GetSlotCount(), 1u);
+
+	// The middle block doesn't declare anything, so it doesn't count as a scope
+	auto b = GetIdentifier(middle->GetStatements()[0]);
+	ASSERT_TRUE(b->IsResolved());
+	EXPECT_EQ(b->GetScopeDepth(), 0u);
+	EXPECT_EQ(b->GetScopeSlot(), 1u);
+
+	auto a = GetIdentifier(inner->GetStatements()[1]);
+	ASSERT_TRUE(a->IsResolved());
+	EXPECT_EQ(a->GetScopeDepth(), 1u);
+	EXPECT_EQ(a->GetScopeSlot(), 0u);
+}
+
+TEST_F(ScopeResolverTest, when_an_identifier_is_used_before_its_declaration_should_not_resolve_it_to_the_declaration)
+{
+	auto program = Parse("{ a; var a = 1; }");
+	auto block = GetStatement<ast::StatementBlock>(program->GetStatements(), 0);
+
+	EXPECT_FALSE(GetIdentifier(block->GetStatements()[0])->IsResolved());
+	EXPECT_TRUE(GetStatement<ast::VarDecl>(block->GetStatements(), 1)->GetIdentifier()->IsResolved());
+}
+
+TEST_F(ScopeResolverTest, when_getting_members_should_not_resolve_the_member_name)
+{
+	auto program = Parse("{ var x = 1; var v = Vector3(1, 2, 3); v.x; }");
+	auto block = GetStatement<ast::StatementBlock>(program->GetStatements(), 0);
+	auto statement = GetStatement<ast::ExpressionStatement>(block->GetStatements(), 2);
+	auto get = std::dynamic_pointer_cast<ast::GetExpression>(statement->GetExpression());
+
+	ASSERT_NE(get, nullptr);
+	EXPECT_TRUE(std::dynamic_pointer_cast<ast::Identifier>(get->GetLhs())->IsResolved());
+	EXPECT_FALSE(get->GetIdentifier()->IsResolved());
+}
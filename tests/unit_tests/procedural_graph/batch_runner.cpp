@@ -0,0 +1,154 @@
+#include <procedural_graph/batch_runner.h>
+#include <procedural_graph/compiled_graph_format.h>
+
+#include <common/exception.h>
+#include <common/file_util.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <sstream>
+
+#include "graph_test_fixture.h"
+
+using namespace pagoda;
+
+class BatchRunnerTest : public GraphTestFixture
+{
+protected:
+	void SetUp() override
+	{
+		GraphTestFixture::SetUp();
+		file_util::WriteStringToFile(GetGraphFile(), GetExtrusionGraph("$< amount; >$", "geometry.obj", "amount: 10.0"));
+	}
+
+	std::string GetGraphFile() const { return (m_directory / "graph.pgd").string(); }
+
+	BatchJob CreateJob(const std::string &outputDirectory, const std::vector<std::string> &parameters = {})
+	{
+		return BatchJob{GetGraphFile(), (m_directory / outputDirectory).string(), parameters};
+	}
+
+	std::string GetOutput(const std::string &outputDirectory) const
+	{
+		return file_util::LoadFileToString(m_directory / outputDirectory / "geometry.obj");
+	}
+};
+
+TEST_F(BatchRunnerTest, when_reading_a_manifest_should_create_a_job_per_line)
+{
+	auto jobs = BatchRunner::ReadManifest(
+	    "# graph output parameters\n"
+	    "a.pgd out/a parameter.amount=2 parameter.label=x\n"
+	    "\n"
+	    "b.pgb out/b\n");
+
+	ASSERT_EQ(jobs.size(), 2u);
+	EXPECT_EQ(jobs[0].m_graphFile, "a.pgd");
+	EXPECT_EQ(jobs[0].m_outputDirectory, "out/a");
+	EXPECT_EQ(jobs[0].m_parameters, (std::vector<std::string>{"parameter.amount=2", "parameter.label=x"}));
+	EXPECT_EQ(jobs[1].m_graphFile, "b.pgb");
+	EXPECT_TRUE(jobs[1].m_parameters.empty());
+}
+
+TEST_F(BatchRunnerTest, when_a_manifest_line_has_no_output_directory_should_throw)
+{
+	EXPECT_THROW(BatchRunner::ReadManifest("a.pgd\n"), Exception);
+}
+
+TEST_F(BatchRunnerTest, when_running_jobs_should_write_each_job_to_its_output_directory)
+{
+	BatchRunner runner(m_pagoda.GetNodeFactory(), 4);
+	std::vector<BatchJob> jobs;
+	for (auto i = 0u; i < 8; ++i)
+	{
+		jobs.push_back(CreateJob("job_" + std::to_string(i), {"parameter.amount=" + std::to_string(i + 1)}));
+	}
+
+	auto results = runner.Run(jobs);
+
+	ASSERT_EQ(results.size(), jobs.size());
+	for (auto i = 0u; i < results.size(); ++i)
+	{
+		EXPECT_TRUE(results[i].m_succeeded) << results[i].m_error;
+		EXPECT_EQ(results[i].m_job.m_outputDirectory, jobs[i].m_outputDirectory);
+		EXPECT_FALSE(GetOutput("job_" + std::to_string(i)).empty());
+	}
+	EXPECT_NE(GetOutput("job_0"), GetOutput("job_1"));
+}
+
+TEST_F(BatchRunnerTest, when_running_jobs_with_the_same_graph_should_load_it_once)
+{
+	BatchRunner runner(m_pagoda.GetNodeFactory(), 4);
+
+	runner.Run({CreateJob("a"), CreateJob("b"), CreateJob("c"), CreateJob("d")});
+
+	EXPECT_EQ(runner.GetLoadedGraphCount(), 1u);
+}
+
+TEST_F(BatchRunnerTest, when_a_job_fails_should_report_it_and_run_the_others)
+{
+	BatchRunner runner(m_pagoda.GetNodeFactory(), 2);
+	BatchJob missingGraph = CreateJob("missing");
+	missingGraph.m_graphFile = (m_directory / "missing.pgd").string();
+	BatchJob notCompiled = CreateJob("not_compiled");
+	notCompiled.m_graphFile = (m_directory / (std::string("graph") + CompiledGraphFormat::s_extension)).string();
+	boost::filesystem::copy_file(GetGraphFile(), notCompiled.m_graphFile);
+
+	auto results = runner.Run({CreateJob("a", {"invalid_parameter"}), missingGraph, notCompiled, CreateJob("b")});
+
+	ASSERT_EQ(results.size(), 4u);
+	EXPECT_FALSE(results[0].m_succeeded);
+	EXPECT_FALSE(results[0].m_error.empty());
+	EXPECT_FALSE(results[1].m_succeeded);
+	EXPECT_FALSE(results[2].m_succeeded);
+	EXPECT_TRUE(results[3].m_succeeded);
+	EXPECT_FALSE(GetOutput("b").empty());
+}
+
+TEST_F(BatchRunnerTest, when_a_file_cant_be_written_should_only_fail_the_job_that_wrote_it)
+{
+	BatchRunner runner(m_pagoda.GetNodeFactory(), 2);
+	std::vector<BatchJob> jobs;
+	for (auto i = 0u; i < 32; ++i)
+	{
+		jobs.push_back(CreateJob("job_" + std::to_string(i)));
+	}
+	// The exported file can't be opened where there is a directory
+	boost::filesystem::create_directories(m_directory / "job_5" / "geometry.obj");
+
+	auto results = runner.Run(jobs);
+
+	ASSERT_EQ(results.size(), jobs.size());
+	for (auto i = 0u; i < results.size(); ++i)
+	{
+		if (i == 5)
+		{
+			EXPECT_FALSE(results[i].m_succeeded);
+			EXPECT_NE(results[i].m_error.find("job_5"), std::string::npos) << results[i].m_error;
+		}
+		else
+		{
+			EXPECT_TRUE(results[i].m_succeeded) << "Job " << i << ": " << results[i].m_error;
+		}
+	}
+}
+
+TEST_F(BatchRunnerTest, when_writing_a_report_should_write_a_line_per_job)
+{
+	BatchJobResult succeeded{CreateJob("a"), true, "", 0.5};
+	BatchJobResult failed{CreateJob("b"), false, "Invalid \"parameter\"", 0.25};
+
+	std::stringstream report;
+	BatchRunner::WriteReport({succeeded, failed}, report);
+
+	std::string line;
+	std::getline(report, line);
+	EXPECT_EQ(line, "job,graph,output_directory,status,seconds,error");
+	std::getline(report, line);
+	EXPECT_EQ(line, "0,\"" + GetGraphFile() + "\",\"" + (m_directory / "a").string() + "\",ok,0.5,\"\"");
+	std::getline(report, line);
+	EXPECT_EQ(line, "1,\"" + GetGraphFile() + "\",\"" + (m_directory / "b").string() +
+	                    "\",failed,0.25,\"Invalid \"\"parameter\"\"\"");
+}
@@ -0,0 +1,132 @@
+#include <procedural_graph/compiled_graph_format.h>
+#include <procedural_graph/graph.h>
+#include <procedural_graph/node.h>
+#include <procedural_graph/reader.h>
+
+#include <common/exception.h>
+#include <common/file_util.h>
+#include <dynamic_value/expression.h>
+#include <dynamic_value/float_value.h>
+#include <dynamic_value/get_value_as.h>
+#include <dynamic_value/integer_value.h>
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "graph_test_fixture.h"
+
+using namespace pagoda;
+
+class CompiledGraphTest : public GraphTestFixture
+{
+protected:
+	std::string GetGraphSource(const std::string &outputFile) const
+	{
+		return GetExtrusionGraph("$< amount * count; >$", (m_directory / outputFile).string(),
+		                         "amount: 2.5, count: 3, label: \"rect\"");
+	}
+
+	GraphPtr ReadCompiled(const std::string &compiled)
+	{
+		return m_reader.ReadCompiled(compiled.data(), compiled.size());
+	}
+
+	std::set<std::pair<std::string, std::string>> GetEdges(GraphPtr graph)
+	{
+		std::set<std::pair<std::string, std::string>> edges;
+		for (const auto &n : graph->GetGraphNodes())
+		{
+			for (const auto &o : graph->GetNodeOutputNodes(n))
+			{
+				edges.emplace(n->GetName(), o->GetName());
+			}
+		}
+		return edges;
+	}
+
+	GraphReader m_reader{m_pagoda.GetNodeFactory()};
+};
+
+TEST_F(CompiledGraphTest, when_reading_a_compiled_graph_should_create_the_same_nodes_and_edges)
+{
+	auto graph = m_reader.Read(GetGraphSource("geometry.obj"));
+	auto compiled = ReadCompiled(m_reader.Compile(GetGraphSource("geometry.obj")));
+
+	ASSERT_EQ(compiled->GetNodeCount(), graph->GetNodeCount());
+	for (const auto &n : graph->GetGraphNodes())
+	{
+		EXPECT_NE(GetNode(compiled, n->GetName()), nullptr);
+	}
+	EXPECT_EQ(GetEdges(compiled), GetEdges(graph));
+}
+
+TEST_F(CompiledGraphTest, when_reading_a_compiled_graph_should_set_the_arguments)
+{
+	auto graph = ReadCompiled(m_reader.Compile(GetGraphSource("geometry.obj")));
+	auto parameter = GetNode(graph, "parameter");
+
+	ASSERT_NE(parameter, nullptr);
+	EXPECT_EQ(get_value_as<float>(*parameter->GetMember("amount")), 2.5f);
+	EXPECT_EQ(get_value_as<int>(*parameter->GetMember("count")), 3);
+	EXPECT_EQ(get_value_as<std::string>(*parameter->GetMember("label")), "rect");
+}
+
+TEST_F(CompiledGraphTest, when_reading_a_compiled_graph_should_load_expressions_with_their_bytecode)
+{
+	auto graph = ReadCompiled(m_reader.Compile(GetGraphSource("geometry.obj")));
+	auto extrusion = GetNode(graph, "extrusion");
+
+	ASSERT_NE(extrusion, nullptr);
+	auto expression = std::dynamic_pointer_cast<Expression>(extrusion->GetMember("extrusion_amount"));
+	ASSERT_NE(expression, nullptr);
+	EXPECT_NE(expression->GetBytecode(), nullptr);
+	EXPECT_EQ(expression->GetExpressionString(), "amount * count; ");
+	ASSERT_EQ(expression->GetVariables().size(), 2u);
+
+	expression->SetVariableValue("amount", std::make_shared<FloatValue>(2.5f));
+	expression->SetVariableValue("count", std::make_shared<Integer>(3));
+	EXPECT_EQ(get_value_as<float>(*expression->Evaluate()), 7.5f);
+}
+
+TEST_F(CompiledGraphTest, when_executing_a_compiled_graph_should_produce_the_same_result)
+{
+	m_reader.Read(GetGraphSource("text.obj"))->Execute();
+	ReadCompiled(m_reader.Compile(GetGraphSource("compiled.obj")))->Execute();
+
+	auto text = file_util::LoadFileToString(m_directory / "text.obj");
+	EXPECT_FALSE(text.empty());
+	EXPECT_EQ(file_util::LoadFileToString(m_directory / "compiled.obj"), text);
+}
+
+TEST_F(CompiledGraphTest, when_the_file_has_the_compiled_extension_should_be_read_as_a_compiled_graph)
+{
+	const auto source = (m_directory / "graph.pgd").string();
+	const auto compiled = (m_directory / (std::string("graph") + CompiledGraphFormat::s_extension)).string();
+	file_util::WriteStringToFile(source, GetGraphSource("geometry.obj"));
+
+	m_pagoda.CompileGraphFile(source, compiled);
+
+	EXPECT_EQ(m_pagoda.CreateGraphFromFile(compiled)->GetNodeCount(), 8u);
+}
+
+TEST_F(CompiledGraphTest, when_a_file_with_the_compiled_extension_is_not_a_compiled_graph_should_throw)
+{
+	const auto compiled = (m_directory / (std::string("graph") + CompiledGraphFormat::s_extension)).string();
+	file_util::WriteStringToFile(compiled, GetGraphSource("geometry.obj"));
+
+	EXPECT_THROW(m_pagoda.CreateGraphFromFile(compiled), Exception);
+}
+
+TEST_F(CompiledGraphTest, when_the_data_is_not_a_compiled_graph_should_throw)
+{
+	EXPECT_THROW(ReadCompiled(GetGraphSource("geometry.obj")), Exception);
+}
+
+TEST_F(CompiledGraphTest, when_the_compiled_graph_is_truncated_should_throw)
+{
+	auto compiled = m_reader.Compile(GetGraphSource("geometry.obj"));
+	compiled.resize(compiled.size() / 2);
+
+	EXPECT_THROW(ReadCompiled(compiled), Exception);
+}
@@ -3,11 +3,15 @@
 #include <procedural_graph/node.h>
 #include <procedural_graph/operation_node.h>
 #include <procedural_graph/output_interface_node.h>
+#include <procedural_graph/reader.h>
 
+#include <common/exception.h>
+#include <common/file_util.h>
 #include <pagoda.h>
 
 #include <gtest/gtest.h>
 
+#include "graph_test_fixture.h"
 #include "mock_objects.h"
 
 using namespace pagoda;
@@ -189,3 +193,23 @@ TEST_F(GraphSimpleOperationsTest, when_unlinking_a_node_making_it_an_output_node
 
 	ASSERT_EQ(output_nodes.size(), 3);
 }
+
+class GraphExecutionTest : public GraphTestFixture
+{
+protected:
+	GraphPtr CreateGraph(const boost::filesystem::path &outputPath)
+	{
+		return GraphReader(m_pagoda.GetNodeFactory()).Read(GetExtrusionGraph("10.0", outputPath.string()));
+	}
+};
+
+TEST_F(GraphExecutionTest, when_a_file_cant_be_written_should_only_fail_the_execution_that_wrote_it)
+{
+	file_util::WriteStringToFile((m_directory / "file").string(), "");
+	auto failingGraph = CreateGraph(m_directory / "file" / "geometry.obj");
+	auto graph = CreateGraph(m_directory / "geometry.obj");
+
+	EXPECT_THROW(failingGraph->Execute(), Exception);
+	EXPECT_NO_THROW(graph->Execute());
+	EXPECT_FALSE(file_util::LoadFileToString(m_directory / "geometry.obj").empty());
+}
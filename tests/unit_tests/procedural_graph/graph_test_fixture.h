@@ -0,0 +1,74 @@
+#ifndef PAGODA_TESTS_PROCEDURAL_GRAPH_GRAPH_TEST_FIXTURE_H_
+#define PAGODA_TESTS_PROCEDURAL_GRAPH_GRAPH_TEST_FIXTURE_H_
+
+#include <procedural_graph/graph.h>
+#include <procedural_graph/node.h>
+
+#include <pagoda.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+/**
+ * Fixture for tests that execute graphs, with a temporary directory for the files they write.
+ */
+class GraphTestFixture : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		m_directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+		boost::filesystem::create_directories(m_directory);
+	}
+
+	void TearDown() override { boost::filesystem::remove_all(m_directory); }
+
+	/**
+	 * Returns the source of a graph that extrudes a rectangle by \p extrusionAmount and exports it to \p outputPath.
+	 * If \p parameters isn't empty, a 'parameter' node with them is connected to the extrusion.
+	 */
+	static std::string GetExtrusionGraph(const std::string &extrusionAmount, const std::string &outputPath,
+	                                     const std::string &parameters = "")
+	{
+		std::string source;
+		if (!parameters.empty())
+		{
+			source += "parameter = Parameter() { " + parameters + " }\n";
+		}
+		source +=
+		    "create_rect = Operation(operation: \"CreateRectGeometry\") { width: 10, height: 5 }\n"
+		    "create_rect_out = OutputInterface(interface: \"out\")\n"
+		    "extrusion_in = InputInterface(interface: \"in\")\n"
+		    "extrusion = Operation(operation: \"ExtrudeGeometry\") { extrusion_amount: " +
+		    extrusionAmount +
+		    " }\n"
+		    "extrusion_out = OutputInterface(interface: \"out\")\n"
+		    "export_in = InputInterface(interface: \"in\")\n"
+		    "export = Operation(operation: \"ExportGeometry\") { path: \"" +
+		    outputPath + "\" }\n";
+		if (!parameters.empty())
+		{
+			source += "parameter -> extrusion;\n";
+		}
+		source += "create_rect -> create_rect_out -> extrusion_in -> extrusion -> extrusion_out -> export_in -> export;\n";
+		return source;
+	}
+
+	static pagoda::NodePtr GetNode(pagoda::GraphPtr graph, const std::string &name)
+	{
+		for (const auto &n : graph->GetGraphNodes())
+		{
+			if (n->GetName() == name)
+			{
+				return n;
+			}
+		}
+		return nullptr;
+	}
+
+	pagoda::Pagoda m_pagoda;
+	boost::filesystem::path m_directory;
+};
+
+#endif
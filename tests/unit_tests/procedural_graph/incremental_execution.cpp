@@ -0,0 +1,108 @@
+#include <procedural_graph/graph.h>
+#include <procedural_graph/node.h>
+#include <procedural_graph/parallel_scheduler.h>
+#include <procedural_graph/reader.h>
+
+#include <common/file_util.h>
+#include <dynamic_value/float_value.h>
+
+#include <gtest/gtest.h>
+
+#include "graph_test_fixture.h"
+
+using namespace pagoda;
+
+class IncrementalExecutionTest : public GraphTestFixture
+{
+protected:
+	/**
+	 * Creates a graph that extrudes a rectangle by the amount in a parameter node and exports it.
+	 */
+	GraphPtr CreateGraph(const std::string &extrusionAmount)
+	{
+		return GraphReader(m_pagoda.GetNodeFactory())
+		    .Read(GetExtrusionGraph("$< amount; >$", GetOutputPath(), "amount: " + extrusionAmount));
+	}
+
+	std::string GetOutputPath() const { return (m_directory / "geometry.obj").string(); }
+
+	std::string GetOutput() const { return file_util::LoadFileToString(GetOutputPath()); }
+};
+
+TEST_F(IncrementalExecutionTest, when_executing_for_the_first_time_should_execute_every_node)
+{
+	auto graph = CreateGraph("10.0");
+
+	EXPECT_EQ(graph->ExecuteIncremental(), 0u);
+	EXPECT_FALSE(GetOutput().empty());
+}
+
+TEST_F(IncrementalExecutionTest, when_no_node_is_dirty_should_skip_every_node)
+{
+	auto graph = CreateGraph("10.0");
+	graph->ExecuteIncremental();
+	auto executed = GetOutput();
+
+	EXPECT_EQ(graph->ExecuteIncremental(), graph->GetNodeCount());
+	EXPECT_EQ(GetOutput(), executed);
+}
+
+TEST_F(IncrementalExecutionTest, when_a_node_is_dirty_should_only_execute_the_nodes_downstream)
+{
+	auto graph = CreateGraph("10.0");
+	graph->ExecuteIncremental();
+
+	graph->SetNodeDirty(GetNode(graph, "export"));
+
+	EXPECT_EQ(graph->ExecuteIncremental(), graph->GetNodeCount() - 1);
+}
+
+TEST_F(IncrementalExecutionTest, when_a_parameter_changes_should_produce_the_same_result_as_a_full_execution)
+{
+	CreateGraph("20.0")->Execute();
+	auto fullExecution = GetOutput();
+
+	auto graph = CreateGraph("10.0");
+	graph->ExecuteIncremental();
+	auto parameter = GetNode(graph, "parameter");
+	parameter->SetMember("amount", std::make_shared<FloatValue>(20.0f));
+	graph->SetNodeDirty(parameter);
+
+	// Only the parameter, the extrusion and everything after it are executed
+	EXPECT_EQ(graph->ExecuteIncremental(), 3u);
+	EXPECT_EQ(GetOutput(), fullExecution);
+}
+
+TEST_F(IncrementalExecutionTest, when_executing_incrementally_several_times_should_keep_producing_the_same_result)
+{
+	CreateGraph("10.0")->Execute();
+	auto fullExecution = GetOutput();
+
+	auto graph = CreateGraph("10.0");
+	graph->ExecuteIncremental();
+	auto parameter = GetNode(graph, "parameter");
+	parameter->SetMember("amount", std::make_shared<FloatValue>(20.0f));
+	graph->SetNodeDirty(parameter);
+	graph->ExecuteIncremental();
+	parameter->SetMember("amount", std::make_shared<FloatValue>(10.0f));
+	graph->SetNodeDirty(parameter);
+	graph->ExecuteIncremental();
+
+	EXPECT_EQ(GetOutput(), fullExecution);
+}
+
+TEST_F(IncrementalExecutionTest, when_the_graph_has_a_scheduler_should_execute_the_dirty_nodes_with_it)
+{
+	CreateGraph("20.0")->Execute();
+	auto fullExecution = GetOutput();
+
+	auto graph = CreateGraph("10.0");
+	graph->SetScheduler(std::make_unique<ParallelScheduler>(*graph, 4));
+	graph->ExecuteIncremental();
+	auto parameter = GetNode(graph, "parameter");
+	parameter->SetMember("amount", std::make_shared<FloatValue>(20.0f));
+	graph->SetNodeDirty(parameter);
+
+	EXPECT_EQ(graph->ExecuteIncremental(), 3u);
+	EXPECT_EQ(GetOutput(), fullExecution);
+}
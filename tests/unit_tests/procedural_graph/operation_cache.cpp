@@ -0,0 +1,173 @@
+#include <procedural_graph/operation_cache.h>
+#include <procedural_graph/operation_node.h>
+#include <procedural_graph/reader.h>
+#include <procedural_objects/export_geometry.h>
+#include <procedural_objects/extrude_geometry.h>
+#include <procedural_objects/geometry_component.h>
+#include <procedural_objects/geometry_system.h>
+#include <procedural_objects/procedural_object_system.h>
+
+#include <geometry_operations/create_rect.h>
+#include <geometry_operations/create_sphere.h>
+
+#include <common/file_util.h>
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/qvm/map_vec_mat.hpp>
+
+#include <algorithm>
+
+#include "graph_test_fixture.h"
+
+using namespace pagoda;
+
+class OperationCacheTest : public GraphTestFixture
+{
+protected:
+	void SetUp() override
+	{
+		GraphTestFixture::SetUp();
+		m_cache = std::make_shared<OperationCache>((m_directory / "cache").string());
+		OperationNode::SetOperationCache(m_cache);
+	}
+
+	void TearDown() override
+	{
+		OperationNode::SetOperationCache(nullptr);
+		GraphTestFixture::TearDown();
+	}
+
+	/**
+	 * Executes a graph that extrudes a rectangle by \p extrusionAmount and returns the exported geometry.
+	 */
+	std::string Execute(const std::string &extrusionAmount)
+	{
+		const auto outputPath = (m_directory / "geometry.obj").string();
+		GraphReader(m_pagoda.GetNodeFactory()).Read(GetExtrusionGraph(extrusionAmount, outputPath))->Execute();
+		return file_util::LoadFileToString(outputPath);
+	}
+
+	OperationCachePtr m_cache;
+};
+
+TEST_F(OperationCacheTest, when_executing_for_the_first_time_should_miss_every_cacheable_operation)
+{
+	Execute("10");
+
+	EXPECT_EQ(m_cache->GetHitCount(), 0u);
+	EXPECT_EQ(m_cache->GetMissCount(), 2u);
+}
+
+TEST_F(OperationCacheTest, when_executing_again_should_load_the_same_results_from_the_cache)
+{
+	auto executed = Execute("10");
+	auto cached = Execute("10");
+
+	EXPECT_EQ(m_cache->GetHitCount(), 2u);
+	EXPECT_EQ(m_cache->GetMissCount(), 2u);
+	EXPECT_EQ(cached, executed);
+}
+
+TEST_F(OperationCacheTest, when_a_value_changes_should_only_execute_the_operations_that_changed)
+{
+	auto first = Execute("10");
+	auto second = Execute("20");
+
+	EXPECT_EQ(m_cache->GetHitCount(), 1u);
+	EXPECT_EQ(m_cache->GetMissCount(), 3u);
+	EXPECT_NE(first, second);
+}
+
+TEST_F(OperationCacheTest, when_an_expression_changes_should_execute_again)
+{
+	Execute("$< 10 * 1.5; >$");
+	Execute("$< 10 * 1.5; >$");
+	Execute("$< 10 * 2; >$");
+
+	EXPECT_EQ(m_cache->GetHitCount(), 3u);
+	EXPECT_EQ(m_cache->GetMissCount(), 3u);
+}
+
+TEST_F(OperationCacheTest, when_an_entry_is_corrupted_should_execute_the_operation)
+{
+	auto executed = Execute("10");
+	std::vector<boost::filesystem::path> entries;
+	file_util::GetAllFilesWithExtension(m_directory / "cache", ".pgc", std::back_inserter(entries));
+	ASSERT_EQ(entries.size(), 2u);
+	for (const auto &e : entries)
+	{
+		file_util::WriteStringToFile(m_directory / "cache" / e, "PGOC");
+	}
+
+	auto reexecuted = Execute("10");
+
+	EXPECT_EQ(m_cache->GetHitCount(), 0u);
+	EXPECT_EQ(m_cache->GetMissCount(), 4u);
+	EXPECT_EQ(reexecuted, executed);
+}
+
+TEST_F(OperationCacheTest, when_an_entry_has_a_different_key_should_execute_the_operation)
+{
+	const auto cacheDirectory = m_directory / "cache";
+	Execute("10");
+	std::vector<boost::filesystem::path> firstEntries;
+	file_util::GetAllFilesWithExtension(cacheDirectory, ".pgc", std::back_inserter(firstEntries));
+	auto executed = Execute("20");
+	std::vector<boost::filesystem::path> entries;
+	file_util::GetAllFilesWithExtension(cacheDirectory, ".pgc", std::back_inserter(entries));
+	ASSERT_EQ(entries.size(), 3u);
+	// Replace the entry of the second extrusion with one of another operation, as if their keys had the same hash
+	const auto isFirstEntry = [&](const boost::filesystem::path &e) {
+		return std::find(firstEntries.begin(), firstEntries.end(), e) != firstEntries.end();
+	};
+	const auto secondExtrusion = *std::find_if_not(entries.begin(), entries.end(), isFirstEntry);
+	boost::filesystem::copy_file(cacheDirectory / firstEntries.front(), cacheDirectory / secondExtrusion,
+	                             boost::filesystem::copy_option::overwrite_if_exists);
+
+	auto reexecuted = Execute("20");
+
+	EXPECT_EQ(m_cache->GetHitCount(), 2u);
+	EXPECT_EQ(m_cache->GetMissCount(), 4u);
+	EXPECT_EQ(reexecuted, executed);
+}
+
+TEST_F(OperationCacheTest, when_getting_the_key_of_an_export_should_not_be_cacheable)
+{
+	ExportGeometry exportGeometry(m_pagoda.GetProceduralObjectSystem());
+	std::string key;
+
+	EXPECT_FALSE(m_cache->GetKey("ExportGeometry", exportGeometry, key));
+}
+
+TEST_F(OperationCacheTest, when_getting_the_key_should_digest_the_inputs_without_applying_their_pending_transform)
+{
+	auto objectSystem = m_pagoda.GetProceduralObjectSystem();
+	auto geometrySystem = objectSystem->GetComponentSystem<GeometrySystem>();
+	auto rect = std::make_shared<Geometry>();
+	CreateRect<Geometry>(10, 5).Execute(rect);
+	auto sphere = std::make_shared<Geometry>();
+	CreateSphere<Geometry>(1, 32, 32).Execute(sphere);
+	auto getKey = [&](const Vec3F &translation, GeometryPtr geometry) {
+		auto object = objectSystem->CreateProceduralObject();
+		auto component = geometrySystem->CreateComponentAs<GeometryComponent>(object);
+		component->SetGeometry(geometry);
+		geometrySystem->TransformGeometry(component, boost::qvm::translation_mat(translation));
+
+		ExtrudeGeometry extrusion(objectSystem);
+		extrusion.PushProceduralObject(ExtrudeGeometry::input_geometry, object);
+		std::string key;
+		EXPECT_TRUE(m_cache->GetKey("ExtrudeGeometry", extrusion, key));
+		EXPECT_TRUE(component->HasPendingTransform());
+		EXPECT_EQ(geometrySystem->GetCopiedGeometryBytes(), 0u);
+		return key;
+	};
+
+	const auto key = getKey(Vec3F{1, 0, 0}, rect);
+
+	EXPECT_EQ(getKey(Vec3F{1, 0, 0}, rect), key);
+	EXPECT_NE(getKey(Vec3F{2, 0, 0}, rect), key);
+	// Keys have the same size however big the inputs are
+	EXPECT_EQ(getKey(Vec3F{1, 0, 0}, sphere).size(), key.size());
+}
@@ -0,0 +1,178 @@
+#include <procedural_graph/graph.h>
+#include <procedural_graph/node.h>
+#include <procedural_graph/node_visitor.h>
+#include <procedural_graph/parallel_scheduler.h>
+
+#include <pagoda.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+using namespace pagoda;
+
+namespace
+{
+class ExecutionLog
+{
+public:
+	void Add(const std::string &name)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_executedNodes.push_back(name);
+	}
+
+	std::size_t IndexOf(const std::string &name) const
+	{
+		return std::distance(m_executedNodes.begin(),
+		                     std::find(m_executedNodes.begin(), m_executedNodes.end(), name));
+	}
+
+	std::mutex m_mutex;
+	std::vector<std::string> m_executedNodes;
+};
+
+class LoggingNode : public Node
+{
+public:
+	LoggingNode(ExecutionLog &log) : m_log(log) {}
+
+	void SetConstructionArguments(const std::unordered_map<std::string, DynamicValueBasePtr> &) override {}
+	void AcceptNodeVisitor(NodeVisitor *) override {}
+	void Execute(const NodeSet<Node> &, const NodeSet<Node> &) override { m_log.Add(GetName()); }
+
+private:
+	ExecutionLog &m_log;
+};
+}  // namespace
+
+class ParallelSchedulerTest : public ::testing::Test
+{
+protected:
+	void SetUp() { m_graph = std::make_shared<Graph>(m_pagoda.GetNodeFactory()); }
+
+	NodePtr CreateNode(const std::string &name)
+	{
+		auto node = std::make_shared<LoggingNode>(m_log);
+		m_graph->AddNode(node);
+		node->SetName(name);
+		return node;
+	}
+
+	void Execute(uint32_t workers)
+	{
+		m_graph->SetScheduler(std::make_unique<ParallelScheduler>(*m_graph, workers));
+		m_graph->Execute();
+	}
+
+	GraphPtr m_graph;
+	ExecutionLog m_log;
+	Pagoda m_pagoda;
+};
+
+TEST_F(ParallelSchedulerTest, when_created_with_zero_workers_should_use_at_least_one_worker)
+{
+	ParallelScheduler scheduler(*m_graph, 0);
+	EXPECT_GE(scheduler.GetWorkerCount(), 1u);
+}
+
+TEST_F(ParallelSchedulerTest, when_executing_should_execute_every_node_once)
+{
+	/*
+	 *      -> b1 -> c1
+	 * a -> -> b2 -> c2
+	 *      -> b3 -> c3
+	 */
+	auto a = CreateNode("a");
+	for (auto i = 0u; i < 3; ++i)
+	{
+		auto b = CreateNode("b" + std::to_string(i));
+		auto c = CreateNode("c" + std::to_string(i));
+		m_graph->CreateEdge(a, b);
+		m_graph->CreateEdge(b, c);
+	}
+
+	Execute(4);
+
+	ASSERT_EQ(m_log.m_executedNodes.size(), 7u);
+	for (auto i = 0u; i < 3; ++i)
+	{
+		EXPECT_EQ(std::count(m_log.m_executedNodes.begin(), m_log.m_executedNodes.end(), "b" + std::to_string(i)),
+		          1);
+	}
+}
+
+TEST_F(ParallelSchedulerTest, when_executing_should_execute_nodes_after_their_input_nodes)
+{
+	/*
+	 * a -> b -> d
+	 * a -> c -> d -> e
+	 */
+	auto a = CreateNode("a");
+	auto b = CreateNode("b");
+	auto c = CreateNode("c");
+	auto d = CreateNode("d");
+	auto e = CreateNode("e");
+	m_graph->CreateEdge(a, b);
+	m_graph->CreateEdge(a, c);
+	m_graph->CreateEdge(b, d);
+	m_graph->CreateEdge(c, d);
+	m_graph->CreateEdge(d, e);
+
+	Execute(4);
+
+	ASSERT_EQ(m_log.m_executedNodes.size(), 5u);
+	EXPECT_LT(m_log.IndexOf("a"), m_log.IndexOf("b"));
+	EXPECT_LT(m_log.IndexOf("a"), m_log.IndexOf("c"));
+	EXPECT_LT(m_log.IndexOf("b"), m_log.IndexOf("d"));
+	EXPECT_LT(m_log.IndexOf("c"), m_log.IndexOf("d"));
+	EXPECT_LT(m_log.IndexOf("d"), m_log.IndexOf("e"));
+}
+
+TEST_F(ParallelSchedulerTest, when_nodes_write_into_the_same_node_should_execute_them_in_sequential_order)
+{
+	/*
+	 * a -> a1 -> a2 -> d
+	 * b ----------> d
+	 * c ----> c1 -> d
+	 */
+	auto a = CreateNode("a");
+	auto b = CreateNode("b");
+	auto c = CreateNode("c");
+	auto a1 = CreateNode("a1");
+	auto a2 = CreateNode("a2");
+	auto c1 = CreateNode("c1");
+	auto d = CreateNode("d");
+	m_graph->CreateEdge(a, a1);
+	m_graph->CreateEdge(a1, a2);
+	m_graph->CreateEdge(a2, d);
+	m_graph->CreateEdge(b, d);
+	m_graph->CreateEdge(c, c1);
+	m_graph->CreateEdge(c1, d);
+
+	for (auto i = 0u; i < 20; ++i)
+	{
+		m_log.m_executedNodes.clear();
+		Execute(4);
+
+		ASSERT_EQ(m_log.m_executedNodes.size(), 7u);
+		EXPECT_LT(m_log.IndexOf("b"), m_log.IndexOf("c1"));
+		EXPECT_LT(m_log.IndexOf("c1"), m_log.IndexOf("a2"));
+		EXPECT_LT(m_log.IndexOf("a2"), m_log.IndexOf("d"));
+	}
+}
+
+TEST_F(ParallelSchedulerTest, when_executing_with_a_single_worker_should_execute_every_node)
+{
+	auto a = CreateNode("a");
+	auto b = CreateNode("b");
+	auto c = CreateNode("c");
+	m_graph->CreateEdge(a, b);
+
+	Execute(1);
+
+	EXPECT_EQ(m_log.m_executedNodes.size(), 3u);
+	EXPECT_LT(m_log.IndexOf("a"), m_log.IndexOf("b"));
+}
@@ -11,6 +11,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <boost/qvm/map_vec_mat.hpp>
+
 using namespace pagoda;
 
 class GeometrySystemTest : public ::testing::Test
@@ -57,3 +59,156 @@ TEST_F(GeometrySystemTest, test_kill_component)
 	auto returned_component = geometry_system->GetComponent(proceduralObject);
 	EXPECT_EQ(returned_component, nullptr);
 }
+
+TEST_F(GeometrySystemTest, when_killing_a_component_should_keep_the_others)
+{
+	std::vector<ProceduralObjectPtr> objects;
+	std::vector<std::shared_ptr<GeometryComponent>> components;
+	for (auto i = 0u; i < 3; ++i)
+	{
+		objects.push_back(std::make_shared<ProceduralObject>());
+		components.push_back(geometry_system->CreateComponentAs<GeometryComponent>(objects.back()));
+	}
+
+	geometry_system->KillProceduralComponent(objects[0]);
+
+	EXPECT_EQ(geometry_system->GetComponentAs<GeometryComponent>(objects[0]), nullptr);
+	EXPECT_EQ(geometry_system->GetComponentAs<GeometryComponent>(objects[1]), components[1]);
+	EXPECT_EQ(geometry_system->GetComponentAs<GeometryComponent>(objects[2]), components[2]);
+	EXPECT_EQ(geometry_system->GetComponentCount(), 2u);
+}
+
+TEST_F(GeometrySystemTest, when_an_object_is_destroyed_without_being_killed_its_component_shouldnt_be_returned)
+{
+	auto object = std::make_shared<ProceduralObject>();
+	geometry_system->CreateComponent(object);
+	const auto index = object->GetId().m_index;
+	object = nullptr;
+
+	auto newObject = std::make_shared<ProceduralObject>();
+	ASSERT_EQ(newObject->GetId().m_index, index);
+	EXPECT_EQ(geometry_system->GetComponent(newObject), nullptr);
+
+	auto component = geometry_system->CreateComponent(newObject);
+	EXPECT_EQ(geometry_system->GetComponent(newObject), component);
+	EXPECT_EQ(geometry_system->GetComponentCount(), 1u);
+}
+
+TEST_F(GeometrySystemTest, for_each_component_should_visit_all_components)
+{
+	auto first = std::make_shared<ProceduralObject>();
+	auto second = std::make_shared<ProceduralObject>();
+	auto firstComponent = geometry_system->CreateComponentAs<GeometryComponent>(first);
+	auto secondComponent = geometry_system->CreateComponentAs<GeometryComponent>(second);
+
+	std::vector<std::shared_ptr<GeometryComponent>> visited;
+	geometry_system->ForEachComponent([&](const std::shared_ptr<GeometryComponent> &c) { visited.push_back(c); });
+
+	EXPECT_EQ(visited, (std::vector<std::shared_ptr<GeometryComponent>>{firstComponent, secondComponent}));
+}
+
+TEST_F(GeometrySystemTest, for_each_component_should_skip_the_components_of_destroyed_objects)
+{
+	auto alive = std::make_shared<ProceduralObject>();
+	auto destroyed = std::make_shared<ProceduralObject>();
+	auto aliveComponent = geometry_system->CreateComponentAs<GeometryComponent>(alive);
+	geometry_system->CreateComponent(destroyed);
+	destroyed = nullptr;
+
+	std::vector<std::shared_ptr<GeometryComponent>> visited;
+	geometry_system->ForEachComponent([&](const std::shared_ptr<GeometryComponent> &c) { visited.push_back(c); });
+
+	EXPECT_EQ(visited, (std::vector<std::shared_ptr<GeometryComponent>>{aliveComponent}));
+	EXPECT_EQ(geometry_system->GetComponentCount(), 1u);
+	EXPECT_EQ(geometry_system->GetComponentAs<GeometryComponent>(alive), aliveComponent);
+}
+
+TEST_F(GeometrySystemTest, should_remove_the_components_of_objects_destroyed_after_a_previous_removal)
+{
+	auto first = std::make_shared<ProceduralObject>();
+	auto second = std::make_shared<ProceduralObject>();
+	geometry_system->CreateComponent(first);
+	geometry_system->CreateComponent(second);
+	first = nullptr;
+	EXPECT_EQ(geometry_system->GetComponentCount(), 1u);
+	EXPECT_EQ(geometry_system->GetComponentCount(), 1u);
+
+	second = nullptr;
+	EXPECT_EQ(geometry_system->GetComponentCount(), 0u);
+}
+
+TEST_F(GeometrySystemTest, when_sharing_a_geometry_should_copy_it_only_when_modified)
+{
+	CreateRect<Geometry>(2, 3).Execute(geometry);
+	const auto bytes = geometry->GetMemoryBytes();
+	auto fromObject = std::make_shared<ProceduralObject>();
+	auto toObject = std::make_shared<ProceduralObject>();
+	auto from = geometry_system->CreateComponentAs<GeometryComponent>(fromObject);
+	auto to = geometry_system->CreateComponentAs<GeometryComponent>(toObject);
+	from->SetGeometry(geometry);
+	geometry = nullptr;
+
+	geometry_system->ShareGeometry(from, to);
+	EXPECT_EQ(to->GetGeometry(), from->GetGeometry());
+	EXPECT_EQ(geometry_system->GetSharedGeometryBytes(), bytes);
+	EXPECT_EQ(geometry_system->GetCopiedGeometryBytes(), 0u);
+
+	auto mutableGeometry = geometry_system->GetMutableGeometry(to);
+	EXPECT_NE(mutableGeometry, from->GetGeometry());
+	EXPECT_EQ(to->GetGeometry(), mutableGeometry);
+	EXPECT_EQ(mutableGeometry->GetFaceCount(), from->GetGeometry()->GetFaceCount());
+	EXPECT_EQ(geometry_system->GetCopiedGeometryBytes(), bytes);
+	EXPECT_EQ(geometry_system->GetSharedGeometryBytes(), 0u);
+
+	mutableGeometry = geometry_system->GetMutableGeometry(from);
+	EXPECT_EQ(mutableGeometry, from->GetGeometry());
+	EXPECT_EQ(geometry_system->GetCopiedGeometryBytes(), bytes);
+}
+
+TEST_F(GeometrySystemTest, when_transforming_a_geometry_should_compose_the_transforms_until_it_is_needed)
+{
+	CreateRect<Geometry>(2, 3).Execute(geometry);
+	std::vector<Vec3F> positions;
+	for (auto p = geometry->PointsBegin(); p != geometry->PointsEnd(); ++p)
+	{
+		positions.push_back(geometry->GetPosition(*p));
+	}
+	const auto bytes = geometry->GetMemoryBytes();
+	auto from = geometry_system->CreateComponentAs<GeometryComponent>(std::make_shared<ProceduralObject>());
+	auto to = geometry_system->CreateComponentAs<GeometryComponent>(std::make_shared<ProceduralObject>());
+	from->SetGeometry(geometry);
+	geometry = nullptr;
+
+	geometry_system->ShareGeometry(from, to);
+	geometry_system->TransformGeometry(to, boost::qvm::translation_mat(Vec3F{1, 2, 3}));
+	geometry_system->TransformGeometry(to, boost::qvm::diag_mat(Vec4F{2, 2, 2, 1}));
+	EXPECT_TRUE(to->HasPendingTransform());
+	EXPECT_FALSE(from->HasPendingTransform());
+	EXPECT_EQ(geometry_system->GetCopiedGeometryBytes(), 0u);
+
+	auto transformed = geometry_system->GetGeometry(to);
+	EXPECT_FALSE(to->HasPendingTransform());
+	EXPECT_NE(transformed, from->GetGeometry());
+	EXPECT_EQ(geometry_system->GetCopiedGeometryBytes(), bytes);
+	auto i = 0u;
+	for (auto p = transformed->PointsBegin(); p != transformed->PointsEnd(); ++p, ++i)
+	{
+		EXPECT_TRUE(transformed->GetPosition(*p) == (positions[i] + Vec3F{1, 2, 3}) * 2.0f);
+		EXPECT_TRUE(from->GetGeometry()->GetPosition(*p) == positions[i]);
+	}
+}
+
+TEST_F(GeometrySystemTest, when_getting_a_mutable_geometry_should_apply_the_pending_transform)
+{
+	CreateRect<Geometry>(2, 3).Execute(geometry);
+	auto component = geometry_system->CreateComponentAs<GeometryComponent>(std::make_shared<ProceduralObject>());
+	component->SetGeometry(geometry);
+	const auto position = geometry->GetPosition(*geometry->PointsBegin());
+	geometry = nullptr;
+
+	geometry_system->TransformGeometry(component, boost::qvm::translation_mat(Vec3F{1, 0, 0}));
+	auto mutableGeometry = geometry_system->GetMutableGeometry(component);
+	EXPECT_FALSE(component->HasPendingTransform());
+	EXPECT_TRUE(mutableGeometry->GetPosition(*mutableGeometry->PointsBegin()) == (position + Vec3F{1, 0, 0}));
+	EXPECT_EQ(geometry_system->GetCopiedGeometryBytes(), 0u);
+}
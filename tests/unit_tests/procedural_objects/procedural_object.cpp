@@ -29,6 +29,20 @@ TEST(ProceduralObject, hierarchical_component_set_parent)
 	EXPECT_EQ(parent->cbegin(), parent->cend());
 }
 
+TEST(ProceduralObject, when_destroying_an_object_should_reuse_its_id_index_with_another_generation)
+{
+	auto object = std::make_shared<ProceduralObject>();
+	auto other = std::make_shared<ProceduralObject>();
+	const auto id = object->GetId();
+	EXPECT_NE(other->GetId().m_index, id.m_index);
+
+	object = nullptr;
+	object = std::make_shared<ProceduralObject>();
+
+	EXPECT_EQ(object->GetId().m_index, id.m_index);
+	EXPECT_NE(object->GetId(), id);
+}
+
 class ProceduralObjectSystemTest : public ::testing::Test
 {
 protected:
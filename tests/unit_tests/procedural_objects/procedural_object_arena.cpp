@@ -0,0 +1,121 @@
+#include <dynamic_value/integer_value.h>
+#include <procedural_graph/graph.h>
+#include <procedural_graph/operation_node.h>
+#include <procedural_graph/reader.h>
+#include <procedural_objects/geometry_component.h>
+#include <procedural_objects/geometry_system.h>
+#include <procedural_objects/procedural_object.h>
+#include <procedural_objects/procedural_object_arena.h>
+#include <procedural_objects/procedural_object_system.h>
+#include <procedural_objects/procedural_operation.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "../procedural_graph/graph_test_fixture.h"
+
+using namespace pagoda;
+
+class ProceduralObjectArenaTest : public GraphTestFixture
+{
+protected:
+	void SetUp() override
+	{
+		GraphTestFixture::SetUp();
+		m_objectSystem = m_pagoda.GetProceduralObjectSystem();
+		m_geometrySystem = m_objectSystem->GetComponentSystem<GeometrySystem>();
+		m_arena = ProceduralObjectArena::Create();
+	}
+
+	ProceduralObjectSystemPtr m_objectSystem;
+	std::shared_ptr<GeometrySystem> m_geometrySystem;
+	ProceduralObjectArenaPtr m_arena;
+};
+
+TEST_F(ProceduralObjectArenaTest, when_creating_an_object_in_an_arena_should_keep_the_arena)
+{
+	auto object = m_objectSystem->CreateProceduralObject(m_arena.get());
+
+	EXPECT_EQ(object->GetArena(), m_arena.get());
+	EXPECT_EQ(m_objectSystem->CreateProceduralObject()->GetArena(), nullptr);
+}
+
+TEST_F(ProceduralObjectArenaTest, when_the_arena_is_dropped_should_keep_its_objects_valid)
+{
+	auto object = m_objectSystem->CreateProceduralObject(m_arena.get());
+	auto component = m_geometrySystem->CreateComponentAs<GeometryComponent>(object);
+	m_arena = nullptr;
+
+	object->RegisterOrSetMember("count", std::make_shared<Integer>(3));
+	component->SetGeometry(std::make_shared<Geometry>());
+
+	EXPECT_EQ(static_cast<int>(*std::dynamic_pointer_cast<Integer>(object->GetMember("count"))), 3);
+	EXPECT_EQ(m_geometrySystem->GetComponentAs<GeometryComponent>(object), component);
+	m_objectSystem->KillProceduralObject(object);
+}
+
+TEST_F(ProceduralObjectArenaTest, when_destroying_an_executed_graph_should_kill_its_objects)
+{
+	auto graph = GraphReader(m_pagoda.GetNodeFactory())
+	                 .Read(GetExtrusionGraph("1", (m_directory / "geometry.obj").string()));
+	graph->Execute();
+	ASSERT_EQ(m_objectSystem->GetProceduralObjects().size(), 2u);
+	for (const auto &o : m_objectSystem->GetProceduralObjects())
+	{
+		EXPECT_NE(o->GetArena(), nullptr);
+	}
+
+	graph = nullptr;
+
+	EXPECT_TRUE(m_objectSystem->GetProceduralObjects().empty());
+}
+
+TEST_F(ProceduralObjectArenaTest, when_an_execution_finishes_should_not_keep_its_arena_in_the_graph)
+{
+	auto graph = GraphReader(m_pagoda.GetNodeFactory())
+	                 .Read(GetExtrusionGraph("1", (m_directory / "geometry.obj").string()));
+	graph->Execute();
+
+	auto extrusion = std::dynamic_pointer_cast<OperationNode>(GetNode(graph, "extrusion"));
+	ASSERT_NE(extrusion, nullptr);
+	EXPECT_EQ(extrusion->GetOperation()->GetArena(), nullptr);
+	for (const auto &o : m_objectSystem->GetProceduralObjects())
+	{
+		EXPECT_NE(o->GetArena(), nullptr);
+	}
+}
+
+TEST_F(ProceduralObjectArenaTest, when_creating_values_from_multiple_threads_should_keep_them_apart)
+{
+	const auto valueCount = 10000;
+	std::vector<std::vector<std::shared_ptr<int64_t>>> values(4);
+	std::vector<std::thread> threads;
+	for (auto t = 0u; t < values.size(); ++t)
+	{
+		threads.emplace_back([&, t]() {
+			for (auto i = 0; i < valueCount; ++i)
+			{
+				values[t].push_back(m_arena->MakeShared<int64_t>(t * valueCount + i));
+				// Half of the values are destroyed so that their memory is reused
+				if (i % 2 == 1)
+				{
+					values[t][i - 1] = nullptr;
+				}
+			}
+		});
+	}
+	for (auto &t : threads)
+	{
+		t.join();
+	}
+	m_arena = nullptr;
+
+	for (auto t = 0u; t < values.size(); ++t)
+	{
+		for (auto i = 1; i < valueCount; i += 2)
+		{
+			EXPECT_EQ(*values[t][i], t * valueCount + i);
+		}
+	}
+}
@@ -42,3 +42,50 @@ TEST_F(ProceduralOperationObjectInterfaceTest, test_add_and_pop_object)
 	// Test the object is removed
 	EXPECT_EQ(interface.GetFrontProceduralObject(), nullptr);
 }
+
+TEST_F(ProceduralOperationObjectInterfaceTest, when_adding_batches_and_objects_should_keep_their_order)
+{
+	ProceduralOperationObjectInterface interface(std::string(""));
+	auto first = std::make_shared<ProceduralObject>();
+	auto second = std::make_shared<ProceduralObject>();
+	auto third = std::make_shared<ProceduralObject>();
+
+	interface.AddProceduralObject(procedural_object);
+	interface.AddProceduralObjects(std::make_shared<const ProceduralObjectBatch>(ProceduralObjectBatch{first, second}));
+	interface.AddProceduralObject(third);
+
+	EXPECT_EQ(interface.GetProceduralObjects(), (ProceduralObjectBatch{procedural_object, first, second, third}));
+	EXPECT_EQ(interface.GetAndPopProceduralObject(), procedural_object);
+	EXPECT_EQ(interface.GetAndPopProceduralObject(), first);
+	EXPECT_EQ(interface.GetAndPopProceduralObject(), second);
+	EXPECT_EQ(interface.GetAndPopProceduralObject(), third);
+	EXPECT_FALSE(interface.HasProceduralObjects());
+	EXPECT_EQ(interface.GetAndPopProceduralObject(), nullptr);
+}
+
+TEST_F(ProceduralOperationObjectInterfaceTest, when_taking_a_single_batch_should_not_copy_it)
+{
+	ProceduralOperationObjectInterface interface(std::string(""));
+	auto batch = std::make_shared<const ProceduralObjectBatch>(ProceduralObjectBatch{procedural_object});
+
+	interface.AddProceduralObjects(batch);
+
+	EXPECT_EQ(interface.TakeProceduralObjects(), batch);
+	EXPECT_FALSE(interface.HasProceduralObjects());
+	EXPECT_EQ(interface.TakeProceduralObjects(), nullptr);
+}
+
+TEST_F(ProceduralOperationObjectInterfaceTest, when_taking_objects_should_only_return_the_ones_not_popped)
+{
+	ProceduralOperationObjectInterface interface(std::string(""));
+	auto other = std::make_shared<ProceduralObject>();
+
+	interface.AddProceduralObject(procedural_object);
+	interface.AddProceduralObject(other);
+	interface.GetAndPopProceduralObject();
+
+	auto objects = interface.TakeProceduralObjects();
+	ASSERT_NE(objects, nullptr);
+	EXPECT_EQ(*objects, ProceduralObjectBatch{other});
+	EXPECT_FALSE(interface.HasProceduralObjects());
+}
@@ -0,0 +1,169 @@
+#include <common/exception.h>
+#include <dynamic_value/get_value_as.h>
+#include <dynamic_value/integer_value.h>
+#include <procedural_objects/geometry_component.h>
+#include <procedural_objects/geometry_system.h>
+#include <procedural_objects/procedural_object.h>
+#include <procedural_objects/procedural_object_system.h>
+#include <procedural_objects/procedural_operation.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace pagoda;
+
+namespace
+{
+/**
+ * Creates two objects in "out" and one in "other" for each input object. Each output object has an
+ * "id" computed from the input object id.
+ */
+class PerObjectOperation : public ProceduralOperation
+{
+public:
+	PerObjectOperation(ProceduralObjectSystemPtr objectSystem) : ProceduralOperation(objectSystem)
+	{
+		CreateInputInterface("in");
+		CreateOutputInterface("out");
+		CreateOutputInterface("other");
+		RegisterValues({{"multiplier", std::make_shared<Integer>(10)}});
+	}
+
+	void DoWork() override
+	{
+		ForEachInputObject("in", [this](ProceduralObjectPtr inObject) -> ObjectWork_t {
+			auto multiplier = get_value_as<int>(*GetValue("multiplier"));
+			return [inObject, multiplier](ObjectOutputs &outputs) {
+				auto id = get_value_as<int>(*inObject->GetMember("id")) * multiplier;
+				for (auto i = 0; i < 2; ++i)
+				{
+					auto out = outputs.CreateOutputProceduralObject("out");
+					out->RegisterOrSetMember("id", std::make_shared<Integer>(id + i));
+				}
+				auto other = outputs.CreateOutputProceduralObject("other");
+				other->RegisterOrSetMember("id", std::make_shared<Integer>(id));
+			};
+		});
+	}
+};
+}  // namespace
+
+class ProceduralOperationTest : public ::testing::Test
+{
+protected:
+	void SetUp() { m_objectSystem = std::make_shared<ProceduralObjectSystem>(); }
+
+	void TearDown() { ProceduralOperation::SetObjectWorkerCount(1); }
+
+	std::vector<int> PopIds(ProceduralOperation &operation, const std::string &interface)
+	{
+		std::vector<int> ids;
+		ProceduralObjectPtr object;
+		while ((object = operation.PopProceduralObject(interface)) != nullptr)
+		{
+			ids.push_back(get_value_as<int>(*object->GetMember("id")));
+		}
+		return ids;
+	}
+
+	void PushObjects(ProceduralOperation &operation, int count)
+	{
+		for (auto i = 0; i < count; ++i)
+		{
+			auto object = m_objectSystem->CreateProceduralObject();
+			object->RegisterOrSetMember("id", std::make_shared<Integer>(i));
+			operation.PushProceduralObject("in", object);
+		}
+	}
+
+	ProceduralObjectSystemPtr m_objectSystem;
+};
+
+TEST_F(ProceduralOperationTest, when_using_zero_object_workers_should_use_at_least_one)
+{
+	ProceduralOperation::SetObjectWorkerCount(0);
+	EXPECT_GE(ProceduralOperation::GetObjectWorkerCount(), 1u);
+}
+
+TEST_F(ProceduralOperationTest, when_processing_each_input_object_should_keep_the_input_order_in_each_interface)
+{
+	for (auto workers : {1u, 4u})
+	{
+		ProceduralOperation::SetObjectWorkerCount(workers);
+		PerObjectOperation operation(m_objectSystem);
+		PushObjects(operation, 100);
+
+		operation.Execute();
+
+		auto outIds = PopIds(operation, "out");
+		auto otherIds = PopIds(operation, "other");
+		ASSERT_EQ(outIds.size(), 200u);
+		ASSERT_EQ(otherIds.size(), 100u);
+		for (auto i = 0; i < 100; ++i)
+		{
+			EXPECT_EQ(outIds[2 * i], i * 10);
+			EXPECT_EQ(outIds[2 * i + 1], i * 10 + 1);
+			EXPECT_EQ(otherIds[i], i * 10);
+		}
+	}
+}
+
+TEST_F(ProceduralOperationTest, when_an_object_work_throws_should_propagate_the_exception)
+{
+	class ThrowingOperation : public ProceduralOperation
+	{
+	public:
+		ThrowingOperation(ProceduralObjectSystemPtr objectSystem) : ProceduralOperation(objectSystem)
+		{
+			CreateInputInterface("in");
+		}
+
+		void DoWork() override
+		{
+			ForEachInputObject("in", [](ProceduralObjectPtr) -> ObjectWork_t {
+				return [](ObjectOutputs &) { throw Exception("object work failed"); };
+			});
+		}
+	};
+
+	ProceduralOperation::SetObjectWorkerCount(4);
+	ThrowingOperation operation(m_objectSystem);
+	PushObjects(operation, 10);
+
+	EXPECT_THROW(operation.Execute(), Exception);
+}
+
+TEST_F(ProceduralOperationTest, when_creating_components_from_multiple_threads_should_create_all_of_them)
+{
+	auto geometrySystem = std::make_shared<GeometrySystem>();
+	m_objectSystem->RegisterProceduralComponentSystem(geometrySystem);
+
+	std::vector<std::vector<ProceduralObjectPtr>> objects(4);
+	std::vector<std::thread> threads;
+	for (auto t = 0u; t < objects.size(); ++t)
+	{
+		threads.emplace_back([this, t, &objects]() {
+			auto system = m_objectSystem->GetComponentSystem<GeometrySystem>();
+			for (auto i = 0; i < 250; ++i)
+			{
+				auto object = m_objectSystem->CreateProceduralObject();
+				system->CreateComponentAs<GeometryComponent>(object);
+				objects[t].push_back(object);
+			}
+		});
+	}
+	for (auto &t : threads)
+	{
+		t.join();
+	}
+
+	EXPECT_EQ(m_objectSystem->GetProceduralObjects().size(), 1000u);
+	for (const auto &threadObjects : objects)
+	{
+		for (const auto &o : threadObjects)
+		{
+			EXPECT_NE(geometrySystem->GetComponentAs<GeometryComponent>(o), nullptr);
+		}
+	}
+}
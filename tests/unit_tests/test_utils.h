@@ -55,8 +55,15 @@ public:
     boost::filesystem::path GetCurrentTestFileInputDirectory()
     {
         boost::filesystem::path directory = GetTestFilesDir();
-        directory /= ::testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
-        directory /= ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        const auto testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+        std::string testSuiteName = testInfo->test_suite_name();
+        if (testInfo->type_param() != nullptr)
+        {
+            // All the types of a typed test share the same files
+            testSuiteName = testSuiteName.substr(0, testSuiteName.rfind('/'));
+        }
+        directory /= testSuiteName;
+        directory /= testInfo->name();
         directory /= "input";
         return directory;
     }
@@ -64,8 +71,15 @@ public:
     boost::filesystem::path GetCurrentTestFileResultsDirectory()
     {
         boost::filesystem::path directory = GetTestFilesDir();
-        directory /= ::testing::UnitTest::GetInstance()->current_test_info()->test_suite_name();
-        directory /= ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        const auto testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+        std::string testSuiteName = testInfo->test_suite_name();
+        if (testInfo->type_param() != nullptr)
+        {
+            // All the types of a typed test share the same files
+            testSuiteName = testSuiteName.substr(0, testSuiteName.rfind('/'));
+        }
+        directory /= testSuiteName;
+        directory /= testInfo->name();
         directory /= "results";
         return directory;
     }
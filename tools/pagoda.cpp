@@ -4,19 +4,22 @@
 #include <common/profiler.h>
 #include <common/version.h>
 
-#include <dynamic_value/set_value_from.h>
-#include <dynamic_value/value_visitor.h>
+#include <dynamic_value/type_info.h>
 
 #include <geometry_core/geometry_exporter.h>
+#include <procedural_graph/batch_runner.h>
 #include <procedural_graph/default_scheduler.h>
 #include <procedural_graph/execution_queue.h>
 #include <procedural_graph/graph_dot_exporter.h>
 #include <procedural_graph/input_interface_node.h>
 #include <procedural_graph/node_set_visitor.h>
 #include <procedural_graph/node_visitor.h>
+#include <procedural_graph/operation_cache.h>
 #include <procedural_graph/operation_node.h>
 #include <procedural_graph/output_interface_node.h>
+#include <procedural_graph/parallel_scheduler.h>
 #include <procedural_graph/parameter_node.h>
+#include <procedural_graph/parameter_override.h>
 #include <procedural_graph/parse_result.h>
 #include <procedural_graph/reader.h>
 #include <procedural_graph/router_node.h>
@@ -27,25 +30,28 @@
 #include <procedural_objects/geometry_component.h>
 #include <procedural_objects/geometry_system.h>
 #include <procedural_objects/hierarchical_system.h>
+#include <procedural_objects/procedural_object_system.h>
+#include <procedural_objects/procedural_operation.h>
 #include <procedural_objects/triangulate_geometry.h>
 #include <pagoda.h>
 
 #include <boost/program_options.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
-#include <regex>
 
 namespace po = boost::program_options;
 using namespace pagoda;
 
 bool ParseCommandLine(int argc, char* argv[], po::variables_map* out_vm);
 std::shared_ptr<Graph> ReadGraphFromFile(Pagoda& pagoda, const std::string& file_path);
-void SetParameter(const NodeSet<Node>& nodes, const std::string& param);
 void WriteDotFile(std::shared_ptr<Graph> graph, const std::string& file_path);
 void ListGraph(std::shared_ptr<Graph> graph);
-void ExecuteGraph(std::shared_ptr<Graph> graph);
+void ExecuteGraph(Pagoda& pagoda, std::shared_ptr<Graph> graph);
+void ExecuteInteractively(std::shared_ptr<Graph> graph);
 void PrintProfile();
+int RunBatch(Pagoda& pagoda, const po::variables_map& vm);
 
 int main(int argc, char* argv[])
 {
@@ -58,6 +64,33 @@ int main(int argc, char* argv[])
 		return 0;
 	}
 
+	if (vm.count("workers"))
+	{
+		auto workers = vm["workers"].as<uint32_t>();
+		Graph::SetSchedulerFactory(
+		    [workers](Graph& graph) { return std::make_unique<ParallelScheduler>(graph, workers); });
+	}
+
+	if (vm.count("object-workers"))
+	{
+		ProceduralOperation::SetObjectWorkerCount(vm["object-workers"].as<uint32_t>());
+	}
+
+	if (vm.count("cache-dir"))
+	{
+		OperationNode::SetOperationCache(std::make_shared<OperationCache>(vm["cache-dir"].as<std::string>()));
+	}
+
+	if (vm.count("batch"))
+	{
+		auto result = RunBatch(pagoda, vm);
+		if (vm.count("show-profile"))
+		{
+			PrintProfile();
+		}
+		return result;
+	}
+
 	std::string file_path;
 	std::string dot_file;
 	try
@@ -84,6 +117,11 @@ int main(int argc, char* argv[])
 	{
 		try
 		{
+			if (vm.count("compile"))
+			{
+				pagoda.CompileGraphFile(file_path, vm["compile"].as<std::string>());
+			}
+
 			std::shared_ptr<Graph> graph = ReadGraphFromFile(pagoda, file_path);
 			if (graph == nullptr)
 			{
@@ -97,7 +135,7 @@ int main(int argc, char* argv[])
 				auto nodes = graph->GetGraphNodes();
 				for (const auto& p : params)
 				{
-					SetParameter(nodes, p);
+					OverrideParameter(nodes, p);
 				}
 			}
 
@@ -111,9 +149,13 @@ int main(int argc, char* argv[])
 				WriteDotFile(graph, dot_file);
 			}
 
-			if (vm.count("execute"))
+			if (vm.count("interactive"))
+			{
+				ExecuteInteractively(graph);
+			}
+			else if (vm.count("execute"))
 			{
-				ExecuteGraph(graph);
+				ExecuteGraph(pagoda, graph);
 			}
 		}
 		catch (const Exception& e)
@@ -130,7 +172,75 @@ int main(int argc, char* argv[])
 	return 0;
 }
 
-void ExecuteGraph(std::shared_ptr<Graph> graph) { graph->Execute(); }
+void ExecuteGraph(Pagoda& pagoda, std::shared_ptr<Graph> graph)
+{
+	graph->Execute();
+
+	auto geometrySystem = pagoda.GetProceduralObjectSystem()->GetComponentSystem<GeometrySystem>();
+	LOG_INFO("Geometries: " << geometrySystem->GetSharedGeometryBytes() << " bytes shared, "
+	                        << geometrySystem->GetCopiedGeometryBytes() << " bytes copied");
+
+	if (auto cache = OperationNode::GetOperationCache())
+	{
+		LOG_INFO("Operation cache '" << cache->GetDirectory() << "': " << cache->GetHitCount() << " hits, "
+		                             << cache->GetMissCount() << " misses");
+	}
+}
+
+int RunBatch(Pagoda& pagoda, const po::variables_map& vm)
+{
+	try
+	{
+		auto jobs = BatchRunner::ReadManifest(file_util::LoadFileToString(vm["batch"].as<std::string>()));
+		BatchRunner runner(pagoda.GetNodeFactory(), vm.count("batch-workers") ? vm["batch-workers"].as<uint32_t>() : 0);
+		LOG_INFO("Running " << jobs.size() << " jobs with " << runner.GetWorkerCount() << " workers");
+
+		auto results = runner.Run(jobs);
+		if (vm.count("batch-report"))
+		{
+			std::ofstream report(vm["batch-report"].as<std::string>());
+			BatchRunner::WriteReport(results, report);
+		}
+		else
+		{
+			BatchRunner::WriteReport(results, std::cout);
+		}
+
+		auto failed = std::count_if(results.begin(), results.end(), [](const BatchJobResult& r) { return !r.m_succeeded; });
+		LOG_INFO(results.size() - failed << " jobs succeeded, " << failed << " failed, " << runner.GetLoadedGraphCount()
+		                                 << " graphs loaded");
+		return failed == 0 ? 0 : 1;
+	}
+	catch (const Exception& e)
+	{
+		LOG_FATAL("Exception: " << e.What());
+		return 1;
+	}
+}
+
+void ExecuteInteractively(std::shared_ptr<Graph> graph)
+{
+	graph->ExecuteIncremental();
+
+	auto nodes = graph->GetGraphNodes();
+	std::string line;
+	while (std::getline(std::cin, line) && !line.empty() && line != "quit")
+	{
+		try
+		{
+			for (const auto& n : OverrideParameter(nodes, line))
+			{
+				graph->SetNodeDirty(n);
+			}
+			auto skipped = graph->ExecuteIncremental();
+			LOG_INFO("Executed " << graph->GetNodeCount() - skipped << " nodes, skipped " << skipped << " nodes");
+		}
+		catch (const Exception& e)
+		{
+			LOG_ERROR(e.What());
+		}
+	}
+}
 
 std::shared_ptr<Graph> ReadGraphFromFile(Pagoda& pagoda, const std::string& file_path)
 {
@@ -155,8 +265,8 @@ struct PrintVisitor : NodeVisitor
 		for (auto iter = n->GetMembersBegin(); iter != parametersEnd; ++iter)
 		{
 			std::cout << "    - name: " << iter->first << std::endl;
-			std::cout << "      type: " << iter->second.m_value->GetTypeInfo()->GetTypeName() << std::endl;
-			std::cout << "      value: " << iter->second.m_value->ToString() << std::endl;
+			std::cout << "      type: " << iter->second.m_value.ToDynamicValue()->GetTypeInfo()->GetTypeName() << std::endl;
+			std::cout << "      value: " << iter->second.m_value.ToDynamicValue()->ToString() << std::endl;
 		}
 	}
 };
@@ -175,60 +285,6 @@ void ListGraph(std::shared_ptr<Graph> graph)
 	} while (n != nullptr);
 }
 
-struct ParamSetter : ValueVisitorBase
-{
-	ParamSetter(const std::string& v) : m_value(v) {}
-
-	void Visit(Boolean& v) override
-	{
-		if (m_value != "true" || m_value != "false")
-		{
-			throw Exception("Unable to set Boolean parameter from " + m_value + " value.");
-		}
-		set_value_from<bool>(v, m_value == "true");
-	}
-	void Visit(FloatValue& v) override { set_value_from<float>(v, std::atof(m_value.c_str())); }
-	void Visit(Integer& v) override { set_value_from<float>(v, std::atof(m_value.c_str())); }
-	void Visit(String& v) override { set_value_from<std::string>(v, m_value); }
-	void Visit(NullObject& v) override { throw Exception("Cannot set a NullObject."); }
-	void Visit(TypeInfo& v) override { throw Exception("Cannot set a TypeInfo."); }
-	void Visit(Vector3& v) override { throw Exception("Cannot set a Vector3."); }
-	void Visit(DynamicPlane& v) override { throw Exception("Cannot set a DynamicPlane."); }
-	void Visit(Function& v) override { throw Exception("Cannot set a Function."); }
-	void Visit(DynamicClass& v) override { throw Exception("Cannot set a DynamicClass."); }
-	void Visit(DynamicInstance& v) override { throw Exception("Cannot set a DynamicInstance."); }
-	void Visit(Expression& v) override { throw Exception("Cannot set an Expression."); }
-	void Visit(ProceduralOperation& v) override { throw Exception("Cannot set a ProceduralOperation."); }
-
-	std::string m_value;
-};
-
-void SetParameter(const NodeSet<Node>& nodes, const std::string& param)
-{
-	static const std::regex paramRegex("^(.+)\\.(.+)=(.+)$");
-	std::smatch matches;
-	if (std::regex_search(param, matches, paramRegex) && matches.size() > 3)
-	{
-		std::string nodeName = matches.str(1);
-		std::string paramName = matches.str(2);
-		std::string value = matches.str(3);
-		ParamSetter setter(value);
-		for (auto& n : nodes)
-		{
-			if (n->GetName() == nodeName)
-			{
-				LOG_INFO("Overriding parameter '" << paramName << "' in node '" << n->GetName() << "' with value '"
-				                                  << value << "'");
-				n->GetMember(paramName)->AcceptVisitor(setter);
-			}
-		}
-	}
-	else
-	{
-		throw Exception("Invalid parameter definition: '" + param + "'");
-	}
-}
-
 void WriteDotFile(std::shared_ptr<Graph> graph, const std::string& file_path)
 {
 	std::ofstream outFile(file_path);
@@ -267,7 +323,15 @@ bool ParseCommandLine(int argc, char* argv[], po::variables_map* out_vm)
             ("version", "Print version information and exit.")
             ("file", po::value<std::string>(), "Input Graph specification file.")
             ("dot", po::value<std::string>(), "Outputs the graph in dot format to the specified file.")
+            ("compile", po::value<std::string>(), "Compiles the graph to the specified file (.pgb), which can be loaded as the input file without being parsed.")
             ("execute", "Executes the graph")
+            ("interactive", "Executes the graph and then reads parameter overrides from the standard input, one per line, executing only the nodes affected by each one.\nFormat: '<node name>.<param name>=<value>'. An empty line or 'quit' exits.")
+            ("workers", po::value<uint32_t>(), "Executes the graph in parallel with the given number of workers.\nUse 0 for one worker per hardware thread.")
+            ("object-workers", po::value<uint32_t>(), "Number of threads used by each operation to process its input objects.\nUse 0 for one thread per hardware thread.")
+            ("cache-dir", po::value<std::string>(), "Directory where the results of operations are cached.\nOperations whose values and inputs didn't change are loaded from the cache instead of executed.")
+            ("batch", po::value<std::string>(), "Runs the jobs in the specified manifest file, one per line, and prints a report with the status and time of each job.\nFormat: '<graph file> <output directory> [<node name>.<param name>=<value> ...]'. Relative export paths are written inside the output directory.")
+            ("batch-workers", po::value<uint32_t>(), "Number of batch jobs that run at the same time.\nUse 0 for one job per hardware thread.")
+            ("batch-report", po::value<std::string>(), "Writes the batch report to the specified file (CSV) instead of the standard output.")
             ("list", "Lists all nodes and parameters in a graph")
             ("param", po::value<std::vector<std::string>>(), "Override a parameter in a node.\nFormat: '<node name>.<param name>=<value>'")
             ("show-profile", "Prints profiling information");